@@ -0,0 +1,141 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/bench/bench.h
+ *
+ * Description:
+ *      This file is part of the internal quality checking of the Sol Library.
+ *      It declares the benchmarks for the component modules.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* add header guard */
+#if !defined __SOL_LIBRARY_BENCHMARKS
+#define __SOL_LIBRARY_BENCHMARKS
+
+
+
+
+        /* enable the POSIX clocks; this header must be included before any
+         * other in the benchmark files */
+#if (!defined _POSIX_C_SOURCE)
+#       define _POSIX_C_SOURCE 200809L
+#endif
+
+
+
+
+        /* include required header files */
+#include "../inc/hint.h"
+#include "../inc/prim.h"
+#include <stdio.h>
+#include <time.h>
+
+
+
+
+/*
+ *      bench_now() - reads the monotonic clock
+ *
+ *      Return:
+ *        - current monotonic time in nanoseconds
+ */
+static sol_inline sol_w64 bench_now(void)
+{
+        auto struct timespec ts;
+
+        (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (sol_w64) ts.tv_sec * 1000000000ULL + (sol_w64) ts.tv_nsec;
+}
+
+
+
+
+/*
+ *      bench_mibps() - computes throughput in MiB/s
+ *        - bytes: bytes processed
+ *        - ns: elapsed time in nanoseconds
+ */
+static sol_inline double bench_mibps(double bytes, sol_w64 ns)
+{
+        return ns ? (bytes / (1024.0 * 1024.0)) / ((double) ns / 1e9) : 0.0;
+}
+
+
+
+
+        /*
+         * __sol_bench_mem() - benchmarks for the memory kernels module
+         */
+extern void __sol_bench_mem(void);
+
+
+
+
+        /*
+         * __sol_bench_ptr() - benchmarks for the pointer module
+         */
+extern void __sol_bench_ptr(void);
+
+
+
+
+        /*
+         * __sol_bench_handle() - benchmarks for the handle table module
+         */
+extern void __sol_bench_handle(void);
+
+
+
+
+        /*
+         * __sol_bench_rc() - benchmarks for the reference counted buffer module
+         */
+extern void __sol_bench_rc(void);
+
+
+
+
+        /*
+         * __sol_bench_ring() - benchmarks for the ring buffer module
+         */
+extern void __sol_bench_ring(void);
+
+
+
+
+        /*
+         * __sol_bench_log() - benchmarks for the logging module
+         */
+extern void __sol_bench_log(void);
+
+
+
+
+#endif /* !defined __SOL_LIBRARY_BENCHMARKS */
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -0,0 +1,196 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/bench/bm-handle.c
+ *
+ * Description:
+ *      This file is part of the internal quality checking of the Sol Library.
+ *      It implements the benchmarks for the handle table module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "bench.h"
+#include "../inc/handle.h"
+#include <unistd.h>
+
+
+
+
+/*
+ *      SOAK_DAYS - simulated days of soak benchmark
+ *      SOAK_OPS - operations per simulated hour
+ *      LIVE_LO - live objects per table at the quietest hour
+ *      LIVE_HI - live objects per table at the busiest hour
+ *      NTBL - number of handle tables, each of a different object size
+ *
+ *      The soak benchmark compresses a week of a long-lived process into a few
+ *      seconds: the load follows a daily cycle between LIVE_LO and LIVE_HI
+ *      live objects, with objects allocated, touched and freed at random. The
+ *      length of the soak can be changed by defining SOAK_DAYS at compile-time.
+ */
+#if (!defined SOAK_DAYS)
+#       define SOAK_DAYS 7
+#endif
+#define SOAK_OPS (64 * 1024)
+#define LIVE_LO 2000
+#define LIVE_HI 50000
+#define NTBL 3
+
+
+
+
+/*
+ *      obj_sz - object sizes of handle tables
+ *      hnd - live handles of each table
+ *      rnd_state - state of pseudo-random generator
+ */
+static const sol_size obj_sz[NTBL] = {48, 200, 1000};
+static sol_handle hnd[NTBL][LIVE_HI];
+static sol_w64 rnd_state = 88172645463325252ULL;
+
+
+
+
+/*
+ *      rnd() - generates pseudo-random number
+ *
+ *      The fixed seed makes every run of the soak benchmark identical.
+ */
+static sol_inline sol_w64 rnd(void)
+{
+        rnd_state ^= rnd_state << 13;
+        rnd_state ^= rnd_state >> 7;
+        rnd_state ^= rnd_state << 17;
+        return rnd_state;
+}
+
+
+
+
+/*
+ *      rss() - gets resident set size of process
+ *
+ *      Return:
+ *        - resident set size in bytes, or zero if it cannot be read
+ */
+static sol_size rss(void)
+{
+        auto FILE *file;
+        auto unsigned long vsz = 0, res = 0;
+
+        if ((file = fopen("/proc/self/statm", "r"))) {
+                if (fscanf(file, "%lu %lu", &vsz, &res) != 2) {
+                        res = 0;
+                }
+
+                (void) fclose(file);
+        }
+
+        return (sol_size) res * (sol_size) sysconf(_SC_PAGESIZE);
+}
+
+
+
+
+/*
+ *      __sol_bench_handle() - declared in sol/bench/bench.h
+ */
+extern void __sol_bench_handle(void)
+{
+        auto sol_htable tbl[NTBL];
+        auto sol_size live[NTBL] = {0}, target, sum, cap, tcap;
+        auto sol_ptr *obj;
+        auto sol_w64 t0;
+        register sol_index day, hour, op, t, i;
+
+        for (t = 0; t < NTBL; t++) {
+                (void) sol_htable_init(&tbl[t], obj_sz[t]);
+        }
+
+        printf("\nsol_htable soak, %d simulated days\n", SOAK_DAYS);
+        printf("%10s %10s %12s %12s %10s\n",
+               "day", "live", "table KiB", "RSS KiB", "ns/op");
+
+        for (day = 1; day <= SOAK_DAYS; day++) {
+                t0 = bench_now();
+
+                for (hour = 0; hour < 24; hour++) {
+                                /* load rises until midday and falls after */
+                        target = LIVE_LO + (LIVE_HI - LIVE_LO)
+                                 * (hour < 12 ? hour : 24 - hour) / 12;
+
+                        for (op = 0; op < SOAK_OPS; op++) {
+                                t = (sol_index) (rnd() % NTBL);
+
+                                        /* drift towards the target load */
+                                if ((rnd() & 3) ? live[t] < target
+                                                : live[t] >= target) {
+                                        if (live[t] < LIVE_HI) {
+                                                i = live[t]++;
+                                                hnd[t][i] = SOL_HANDLE_NULL;
+                                                (void) sol_htable_new(&tbl[t],
+                                                                &hnd[t][i]);
+                                        }
+                                } else if (live[t]) {
+                                        i = (sol_index) (rnd() % live[t]);
+                                        sol_htable_free(&tbl[t], &hnd[t][i]);
+                                        hnd[t][i] = hnd[t][--live[t]];
+                                }
+
+                                        /* touch a random live object */
+                                if (live[t]) {
+                                        i = (sol_index) (rnd() % live[t]);
+                                        (void) sol_htable_get(&tbl[t],
+                                                              hnd[t][i], &obj);
+                                        *(volatile sol_w8*) obj = (sol_w8) op;
+                                }
+                        }
+                }
+
+                t0 = bench_now() - t0;
+
+                for (t = sum = tcap = 0; t < NTBL; t++) {
+                        (void) sol_htable_cap(&tbl[t], &cap);
+                        sum += live[t];
+                        tcap += cap;
+                }
+
+                printf("%10lu %10lu %12lu %12lu %10.2f\n",
+                       (unsigned long) day,
+                       (unsigned long) sum,
+                       (unsigned long) tcap / 1024,
+                       (unsigned long) rss() / 1024,
+                       (double) t0 / (24.0 * SOAK_OPS));
+        }
+
+        for (t = 0; t < NTBL; t++) {
+                sol_htable_term(&tbl[t]);
+        }
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -0,0 +1,512 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/bench/bm-log.c
+ *
+ * Description:
+ *      This file is part of the internal quality checking of the Sol Library.
+ *      It implements the benchmarks for the logging module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "bench.h"
+#include <stdlib.h>
+#include "../inc/log.h"
+#include "../inc/ptr.h"
+#if (defined SOL_LOG_ASYNC)
+#       include <pthread.h>
+#endif
+
+
+
+
+/*
+ *      PATH - path to benchmark log file
+ *      ENTRIES - number of entries logged per mode
+ *      CAP - queue capacity of asynchronous modes
+ *
+ *      The queue is large enough to absorb a whole burst of entries, so that
+ *      the asynchronous timings reflect the cost seen by callers rather than
+ *      the throughput of the file system.
+ */
+#define PATH "bld/bench.log"
+#define ENTRIES 200000
+#define CAP 262144
+
+
+
+
+/*
+ *      burst() - times a burst of log entries
+ *        - fmt: log file format
+ *        - backend: log file backend
+ *        - cap: queue capacity, or 0 for synchronous mode
+ *        - close: time spent closing log file
+ *
+ *      Return:
+ *        - time in nanoseconds spent by callers logging, or 0 if the mode is
+ *          unavailable
+ */
+static sol_w64 burst(SOL_LOG_FORMAT fmt,
+                     SOL_LOG_BACKEND backend,
+                     sol_size cap,
+                     sol_w64 *close)
+{
+        auto sol_w64 t0, t;
+        register int i;
+
+        if (sol_log_open4(PATH, 1, fmt, backend)) {
+                return 0;
+        }
+
+        if (cap && sol_log_async(cap, SOL_LOG_POLICY_BLOCK)) {
+                sol_log_close();
+                return 0;
+        }
+
+                /* log an untimed entry first, so that the queue of the thread
+                 * is allocated before timing starts in asynchronous modes */
+        sol_log_trace("Warming up.");
+
+        t0 = bench_now();
+        for (i = 0; i < ENTRIES; i++) {
+                sol_log_trace("The quick brown fox jumps over the lazy dog.");
+        }
+        t = bench_now() - t0;
+
+        t0 = bench_now();
+        sol_log_close();
+        *close = bench_now() - t0;
+
+        return t;
+}
+
+
+
+
+/*
+ *      formatted() - times a burst of formatted log entries
+ *        - cap: queue capacity, or 0 for synchronous mode
+ *        - own: flag indicating that sol_log_tracef() formats the entries
+ *        - close: time spent closing log file
+ *
+ *      Unless @own is set, each entry is first formatted with snprintf() into
+ *      a buffer of the caller, and then logged with sol_log_trace().
+ *
+ *      Return:
+ *        - time in nanoseconds spent by callers logging, or 0 if the mode is
+ *          unavailable
+ */
+static sol_w64 formatted(sol_size cap,
+                         int own,
+                         sol_w64 *close)
+{
+        const char *FMT = "Request %d from %s took %.3f ms, flags %#x.";
+        auto char msg[128];
+        auto sol_w64 t0, t;
+        register int i;
+
+        if (sol_log_open(PATH)) {
+                return 0;
+        }
+
+        if (cap && sol_log_async(cap, SOL_LOG_POLICY_BLOCK)) {
+                sol_log_close();
+                return 0;
+        }
+
+        sol_log_trace("Warming up.");
+
+        t0 = bench_now();
+        if (own) {
+                for (i = 0; i < ENTRIES; i++) {
+                        sol_log_tracef(FMT, i, "client", i * 0.001,
+                                       (unsigned) i);
+                }
+        } else {
+                for (i = 0; i < ENTRIES; i++) {
+                        (void) snprintf(msg, sizeof msg, FMT, i, "client",
+                                        i * 0.001, (unsigned) i);
+                        sol_log_trace(msg);
+                }
+        }
+        t = bench_now() - t0;
+
+        t0 = bench_now();
+        sol_log_close();
+        *close = bench_now() - t0;
+
+        return t;
+}
+
+
+
+
+/*
+ *      legacy() - times a burst of entries logged the legacy way
+ *        - hnd: handle to log file, or null if logging is disabled
+ *
+ *      The legacy logger called time() and ctime() for every entry, whether or
+ *      not a log file was open, and only then wrote the entry with fprintf().
+ *
+ *      Return:
+ *        - time in nanoseconds spent logging
+ */
+static sol_w64 legacy(FILE *hnd)
+{
+        const char *FMT = "[%s] [%.24s] [%s():%s:%d] %s\n";
+        auto sol_w64 t0 = bench_now();
+        auto time_t tm;
+        auto char *ctm;
+        register int i;
+
+        for (i = 0; i < ENTRIES; i++) {
+                (void) time(&tm);
+                ctm = ctime(&tm);
+
+                if (hnd) {
+                        (void) fprintf(hnd, FMT, "T", ctm, "legacy", __FILE__,
+                                       __LINE__, "The quick brown fox jumps"
+                                       " over the lazy dog.");
+                }
+        }
+
+        return bench_now() - t0;
+}
+
+
+
+
+/*
+ *      disabled() - times a burst of entries logged with no log file open
+ */
+static sol_w64 disabled(void)
+{
+        auto sol_w64 t0 = bench_now();
+        register int i;
+
+        for (i = 0; i < ENTRIES; i++) {
+                sol_log_trace("The quick brown fox jumps over the lazy dog.");
+        }
+
+        return bench_now() - t0;
+}
+
+
+
+
+        /* threads are available only if the asynchronous logging mode has
+         * been compiled in */
+#if (defined SOL_LOG_ASYNC)
+
+
+
+
+/*
+ *      THREADS - number of threads logging at the same time
+ *      SHARE - number of entries logged by each thread
+ *      SHARE_CAP - queue capacity of each thread in asynchronous modes
+ */
+#define THREADS 32
+#define SHARE (ENTRIES / THREADS)
+#define SHARE_CAP (CAP / THREADS)
+
+
+
+
+/*
+ *      worker() - logs a share of a burst of entries
+ *        - arg: barrier at which all threads start timing
+ *
+ *      As in burst(), an untimed entry is logged first.
+ */
+static void *worker(void *arg)
+{
+        register int i;
+
+        sol_log_trace("Warming up.");
+        (void) pthread_barrier_wait(arg);
+
+        for (i = 0; i < SHARE; i++) {
+                sol_log_trace("The quick brown fox jumps over the lazy dog.");
+        }
+
+        return SOL_PTR_NULL;
+}
+
+
+
+
+/*
+ *      crowd() - times a burst of log entries shared by THREADS threads
+ *        - fmt: log file format
+ *        - backend: log file backend
+ *        - cap: queue capacity, or 0 for synchronous mode
+ *        - close: time spent closing log file
+ *
+ *      Return:
+ *        - wall time in nanoseconds until all threads have logged their
+ *          entries, or 0 if the mode is unavailable
+ */
+static sol_w64 crowd(SOL_LOG_FORMAT fmt,
+                     SOL_LOG_BACKEND backend,
+                     sol_size cap,
+                     sol_w64 *close)
+{
+        auto pthread_t thrd[THREADS];
+        auto pthread_barrier_t bar;
+        auto sol_w64 t0, t;
+        register int i;
+
+        if (sol_log_open4(PATH, 1, fmt, backend)) {
+                return 0;
+        }
+
+        if ((cap && sol_log_async(cap, SOL_LOG_POLICY_BLOCK))
+            || pthread_barrier_init(&bar, SOL_PTR_NULL, THREADS + 1)) {
+                sol_log_close();
+                return 0;
+        }
+
+        for (i = 0; i < THREADS; i++) {
+                if (pthread_create(&thrd[i], SOL_PTR_NULL, &worker, &bar)) {
+                        abort();
+                }
+        }
+
+        (void) pthread_barrier_wait(&bar);
+        t0 = bench_now();
+
+        for (i = 0; i < THREADS; i++) {
+                (void) pthread_join(thrd[i], SOL_PTR_NULL);
+        }
+        t = bench_now() - t0;
+
+        t0 = bench_now();
+        sol_log_close();
+        *close = bench_now() - t0;
+
+        (void) pthread_barrier_destroy(&bar);
+        return t;
+}
+
+
+
+
+#endif /* defined SOL_LOG_ASYNC */
+
+
+
+
+/*
+ *      report() - prints timings of a burst
+ *        - mode: logging mode
+ *        - t: time spent by callers logging, or 0 if @mode is unavailable
+ *        - close: time spent closing log file
+ */
+static void report(const char *mode,
+                   sol_w64 t,
+                   sol_w64 close)
+{
+        if (t) {
+                printf("%10s %10.1f %10.1f\n", mode, (double) t / ENTRIES,
+                       (double) close / ENTRIES);
+        } else {
+                printf("%10s %10s\n", mode, "unavailable");
+        }
+}
+
+
+
+
+/*
+ *      throughput() - prints throughput of a log file backend
+ *        - name: name of backend
+ *        - backend: log file backend
+ *
+ *      Throughput is measured over a burst of text entries in both logging
+ *      modes, counting the time spent closing the log file, so that entries
+ *      still buffered or being written out are accounted for.
+ */
+static void throughput(const char *name,
+                       SOL_LOG_BACKEND backend)
+{
+        auto char rate[2][16];
+        auto sol_w64 t, c = 0;
+        register int i;
+
+        for (i = 0; i < 2; i++) {
+                t = burst(SOL_LOG_FORMAT_TEXT, backend, i ? CAP : 0, &c);
+
+                if (t) {
+                        (void) snprintf(rate[i], sizeof rate[i], "%.1f",
+                                        1e6 * ENTRIES / (double) (t + c));
+                } else {
+                        (void) snprintf(rate[i], sizeof rate[i], "%s", "-");
+                }
+        }
+
+        printf("%10s %10s %10s\n", name, rate[0], rate[1]);
+}
+
+
+
+
+/*
+ *      __sol_bench_log() - declared in sol/bench/bench.h
+ */
+extern void __sol_bench_log(void)
+{
+        auto sol_w64 t, c = 0;
+        auto FILE *hnd;
+
+        printf("\nlog entry latency, %d entries, ns/entry\n", ENTRIES);
+        printf("%10s %10s %10s\n", "mode", "caller", "close");
+
+        t = legacy(SOL_PTR_NULL);
+        printf("%10s %10.1f\n", "off/ctime", (double) t / ENTRIES);
+
+        t = disabled();
+        printf("%10s %10.1f\n", "off", (double) t / ENTRIES);
+
+        if ((hnd = fopen(PATH, "w"))) {
+                t = legacy(hnd);
+                (void) fclose(hnd);
+                printf("%10s %10.1f\n", "sync/ctime", (double) t / ENTRIES);
+        }
+
+        t = burst(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_STDIO, 0, &c);
+        report("sync", t, c);
+
+        t = burst(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_STDIO, CAP, &c);
+        report("async", t, c);
+
+        t = burst(SOL_LOG_FORMAT_BINARY, SOL_LOG_BACKEND_STDIO, 0, &c);
+        report("sync/bin", t, c);
+
+        t = burst(SOL_LOG_FORMAT_BINARY, SOL_LOG_BACKEND_STDIO, CAP, &c);
+        report("async/bin", t, c);
+
+        t = burst(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_MMAP, 0, &c);
+        report("sync/mmap", t, c);
+
+        t = burst(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_MMAP, CAP, &c);
+        report("async/mmap", t, c);
+
+        t = burst(SOL_LOG_FORMAT_BINARY, SOL_LOG_BACKEND_MMAP, 0, &c);
+        report("bin/mmap", t, c);
+
+        t = burst(SOL_LOG_FORMAT_BINARY, SOL_LOG_BACKEND_MMAP, CAP, &c);
+        report("abin/mmap", t, c);
+
+        t = burst(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_WRITEV, 0, &c);
+        report("sync/wv", t, c);
+
+        t = burst(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_WRITEV, CAP, &c);
+        report("async/wv", t, c);
+
+        t = burst(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_URING, 0, &c);
+        report("sync/iou", t, c);
+
+        t = burst(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_URING, CAP, &c);
+        report("async/iou", t, c);
+
+                /* time the rate limits with a rate that lets every entry
+                 * through, and with one that drops nearly all of them */
+        (void) sol_log_limit_set(2 * ENTRIES, 1);
+        t = burst(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_STDIO, 0, &c);
+        report("sync/limit", t, c);
+
+        (void) sol_log_limit_set(1, 1);
+        t = burst(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_STDIO, 0, &c);
+        report("sync/drop", t, c);
+        (void) sol_log_limit_set(0, 1);
+
+        printf("\nformatted log entry latency, %d entries, ns/entry\n",
+               ENTRIES);
+        printf("%10s %10s %10s\n", "mode", "caller", "close");
+
+        t = formatted(0, 0, &c);
+        report("sync/snpf", t, c);
+
+        t = formatted(0, 1, &c);
+        report("sync/f", t, c);
+
+        t = formatted(CAP, 0, &c);
+        report("async/snpf", t, c);
+
+        t = formatted(CAP, 1, &c);
+        report("async/f", t, c);
+
+        printf("\nlog file throughput, %d entries, k entries/s including"
+               " close\n", ENTRIES);
+        printf("%10s %10s %10s\n", "backend", "sync", "async");
+
+        throughput("stdio", SOL_LOG_BACKEND_STDIO);
+        throughput("mmap", SOL_LOG_BACKEND_MMAP);
+        throughput("writev", SOL_LOG_BACKEND_WRITEV);
+        throughput("uring", SOL_LOG_BACKEND_URING);
+
+#if (defined SOL_LOG_ASYNC)
+        printf("\nshared log entry latency, %d threads, wall ns/entry\n",
+               THREADS);
+        printf("%10s %10s %10s\n", "mode", "callers", "close");
+
+        t = crowd(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_STDIO, 0, &c);
+        report("sync", t, c);
+
+        t = crowd(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_STDIO, SHARE_CAP, &c);
+        report("async", t, c);
+
+        t = crowd(SOL_LOG_FORMAT_BINARY, SOL_LOG_BACKEND_STDIO, 0, &c);
+        report("sync/bin", t, c);
+
+        t = crowd(SOL_LOG_FORMAT_BINARY, SOL_LOG_BACKEND_STDIO, SHARE_CAP, &c);
+        report("async/bin", t, c);
+
+        t = crowd(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_MMAP, 0, &c);
+        report("sync/mmap", t, c);
+
+        t = crowd(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_MMAP, SHARE_CAP, &c);
+        report("async/mmap", t, c);
+
+        t = crowd(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_WRITEV, 0, &c);
+        report("sync/wv", t, c);
+
+        t = crowd(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_WRITEV, SHARE_CAP, &c);
+        report("async/wv", t, c);
+
+        t = crowd(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_URING, 0, &c);
+        report("sync/iou", t, c);
+
+        t = crowd(SOL_LOG_FORMAT_TEXT, SOL_LOG_BACKEND_URING, SHARE_CAP, &c);
+        report("async/iou", t, c);
+#endif
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
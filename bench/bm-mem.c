@@ -0,0 +1,134 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/bench/bm-mem.c
+ *
+ * Description:
+ *      This file is part of the internal quality checking of the Sol Library.
+ *      It implements the benchmarks for the memory kernels module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "bench.h"
+#include "../inc/mem.h"
+
+
+
+
+/*
+ *      BFR_MAX - size of largest benchmarked buffer (1 MiB)
+ *      VOLUME - bytes processed per benchmarked size (64 MiB)
+ */
+#define BFR_MAX (1024 * 1024)
+#define VOLUME (64.0 * 1024 * 1024)
+
+
+
+
+/*
+ *      bfr_src - source buffer
+ *      bfr_dst - destination buffer
+ */
+static sol_w8 bfr_src[BFR_MAX];
+static sol_w8 bfr_dst[BFR_MAX];
+
+
+
+
+/*
+ *      copy_byte() - byte-wise copy previously used by sol_ptr_copy(); the
+ *      vectoriser is disabled so that the baseline is not silently upgraded
+ */
+__attribute__((noinline, optimize("no-tree-vectorize",
+                                  "no-tree-loop-distribute-patterns")))
+static void copy_byte(sol_w8 *dst, const sol_w8 *src, sol_size len)
+{
+        for (; len; len--, *dst++ = *src++); /* NOLINT */
+}
+
+
+
+
+/*
+ *      __sol_bench_mem() - declared in sol/bench/bench.h
+ */
+extern void __sol_bench_mem(void)
+{
+        const char *KERN[] = {"word", "sse2", "avx2", "neon"};
+        register sol_size sz, itr, i;
+        auto sol_w64 t0, tbyte, tcopy, tset, tcmp;
+        auto volatile int sink = 0;
+
+        printf("\nsol_mem (%s kernels), MiB/s\n", KERN[sol_mem_kernel()]);
+        printf("%10s %10s %10s %10s %10s\n",
+               "size", "byte", "copy", "set", "cmp");
+
+        for (i = 0; i < BFR_MAX; i++) {
+                bfr_src[i] = (sol_w8) i;
+        }
+
+        for (sz = 8; sz <= BFR_MAX; sz *= 2) {
+                itr = (sol_size) (VOLUME / sz);
+
+                t0 = bench_now();
+                for (i = 0; i < itr; i++) {
+                        copy_byte(bfr_dst, bfr_src, sz);
+                }
+                tbyte = bench_now() - t0;
+
+                t0 = bench_now();
+                for (i = 0; i < itr; i++) {
+                        sol_mem_copy(bfr_dst, bfr_src, sz);
+                }
+                tcopy = bench_now() - t0;
+
+                t0 = bench_now();
+                for (i = 0; i < itr; i++) {
+                        sol_mem_set(bfr_dst, (sol_w8) i, sz);
+                }
+                tset = bench_now() - t0;
+
+                sol_mem_copy(bfr_dst, bfr_src, sz);
+                t0 = bench_now();
+                for (i = 0; i < itr; i++) {
+                        sink += sol_mem_cmp(bfr_dst, bfr_src, sz);
+                }
+                tcmp = bench_now() - t0;
+
+                printf("%10lu %10.0f %10.0f %10.0f %10.0f\n",
+                       (unsigned long) sz,
+                       bench_mibps(VOLUME, tbyte),
+                       bench_mibps(VOLUME, tcopy),
+                       bench_mibps(VOLUME, tset),
+                       bench_mibps(VOLUME, tcmp));
+        }
+
+        (void) sink;
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -0,0 +1,375 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/bench/bm-ptr.c
+ *
+ * Description:
+ *      This file is part of the internal quality checking of the Sol Library.
+ *      It implements the benchmarks for the pointer module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "bench.h"
+#include "../inc/libc.h"
+#include "../inc/mem.h"
+#include "../inc/ptr.h"
+
+
+
+
+/*
+ *      BFR_MIN - size of smallest benchmarked buffer (1 MiB)
+ *      BFR_MAX - size of largest benchmarked buffer (64 MiB)
+ *      STEP - bytes appended to buffers at each step (4 KiB)
+ *      CYCLES - allocation and free cycles timed per allocator
+ */
+#define BFR_MIN (1024 * 1024)
+#define BFR_MAX (64 * 1024 * 1024)
+#define STEP (4 * 1024)
+#define CYCLES (4 * 1024 * 1024)
+
+
+
+
+/*
+ *      BATCH_MAX - largest batch of objects allocated at once
+ *      OBJECTS - objects allocated per batch size
+ *
+ *      Batched objects are 16 to 64 bytes, like the nodes of a parse tree.
+ */
+#define BATCH_MAX 512
+#define OBJECTS (4 * 1024 * 1024)
+
+
+
+
+/*
+ *      grow_copy() - grows a buffer by the new, copy and free pattern
+ *        - sz: final size of buffer
+ *
+ *      The buffer capacity grows by the same policy as sol_ptr_reserve(), so
+ *      that only the cost of moving the payload differs.
+ */
+static void grow_copy(sol_size sz)
+{
+        auto sol_ptr *ptr = SOL_PTR_NULL, *nptr;
+        auto sol_size len, cap = 0, ncap;
+
+        for (len = 0; len < sz; len += STEP) {
+                if (len + STEP > cap) {
+                        ncap = cap + cap / 2 < 64 ? 64 : cap + cap / 2;
+                        if (ncap < len + STEP) {
+                                ncap = len + STEP;
+                        }
+
+                        nptr = SOL_PTR_NULL;
+                        (void) sol_ptr_new(&nptr, ncap);
+                        if (len) {
+                                sol_mem_copy(nptr, ptr, len);
+                        }
+
+                        sol_ptr_free(&ptr);
+                        ptr = nptr;
+                        cap = ncap;
+                }
+
+                sol_mem_set((sol_w8*) ptr + len, (sol_w8) len, STEP);
+        }
+
+        sol_ptr_free(&ptr);
+}
+
+
+
+
+/*
+ *      grow_reserve() - grows a buffer through sol_ptr_reserve()
+ *        - sz: final size of buffer
+ */
+static void grow_reserve(sol_size sz)
+{
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+        auto sol_size len, cap = 0;
+
+        for (len = 0; len < sz; len += STEP) {
+                (void) sol_ptr_reserve(&ptr, &cap, len + STEP);
+                sol_mem_set((sol_w8*) ptr + len, (sol_w8) len, STEP);
+        }
+
+        sol_ptr_free(&ptr);
+}
+
+
+
+
+/*
+ *      grow_resize() - grows a buffer through sol_ptr_resize() at each step
+ *        - sz: final size of buffer
+ */
+static void grow_resize(sol_size sz)
+{
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+        auto sol_size len;
+
+        (void) sol_ptr_new(&ptr, STEP);
+        for (len = 0; len < sz; len += STEP) {
+                if (len) {
+                        (void) sol_ptr_resize(&ptr, len + STEP);
+                }
+
+                sol_mem_set((sol_w8*) ptr + len, (sol_w8) len, STEP);
+        }
+
+        sol_ptr_free(&ptr);
+}
+
+
+
+
+/*
+ *      heap_alloc() - allocator callback for alloc
+ *      heap_realloc() - allocator callback for realloc
+ *      heap_free() - allocator callback for free
+ *
+ *      These callbacks forward to the heap, so that timing them through a
+ *      sol_allocator measures only the cost of the indirection.
+ */
+static sol_ptr *heap_alloc(sol_ptr *ctx,
+                           sol_size sz)
+{
+        (void) ctx;
+        return malloc(sz);
+}
+
+static sol_ptr *heap_realloc(sol_ptr *ctx,
+                             sol_ptr *ptr,
+                             sol_size sz)
+{
+        (void) ctx;
+        return realloc(ptr, sz);
+}
+
+static void heap_free(sol_ptr *ctx,
+                      sol_ptr *ptr)
+{
+        (void) ctx;
+        free(ptr);
+}
+
+
+
+
+/*
+ *      cycle_ptr() - times allocation and free cycles through sol_ptr
+ *        - sz: size in bytes of each allocation
+ */
+static sol_w64 cycle_ptr(sol_size sz)
+{
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+        auto sol_w64 t0;
+        register sol_index i;
+
+        t0 = bench_now();
+        for (i = 0; i < CYCLES; i++) {
+                (void) sol_ptr_new(&ptr, sz);
+                *(volatile sol_w8*) ptr = (sol_w8) i;
+                sol_ptr_free(&ptr);
+        }
+
+        return bench_now() - t0;
+}
+
+
+
+
+/*
+ *      cycle_heap() - times allocation and free cycles through the heap
+ *        - sz: size in bytes of each allocation
+ */
+static sol_w64 cycle_heap(sol_size sz)
+{
+        auto sol_ptr *ptr;
+        auto sol_w64 t0;
+        register sol_index i;
+
+        t0 = bench_now();
+        for (i = 0; i < CYCLES; i++) {
+                ptr = malloc(sz);
+                *(volatile sol_w8*) ptr = (sol_w8) i;
+                free(ptr);
+        }
+
+        return bench_now() - t0;
+}
+
+
+
+
+/*
+ *      batch_one() - times batches allocated one object at a time
+ *      batch_n() - times batches allocated through sol_ptr_new_n()
+ *      batch_n2() - times batches allocated through sol_ptr_new_n2()
+ *        - ptr: array of @n null pointers
+ *        - sz: sizes in bytes of objects
+ *        - n: number of objects per batch
+ */
+static sol_w64 batch_one(sol_ptr **ptr,
+                         const sol_size *sz,
+                         sol_size n)
+{
+        auto sol_w64 t0;
+        register sol_index i, r;
+
+        t0 = bench_now();
+        for (r = 0; r < OBJECTS / n; r++) {
+                for (i = 0; i < n; i++) {
+                        (void) sol_ptr_new(&ptr[i], sz[i]);
+                }
+
+                *(volatile sol_w8*) ptr[n - 1] = (sol_w8) r;
+
+                for (i = 0; i < n; i++) {
+                        sol_ptr_free_sized(&ptr[i], sz[i]);
+                }
+        }
+
+        return bench_now() - t0;
+}
+
+static sol_w64 batch_n(sol_ptr **ptr,
+                       const sol_size *sz,
+                       sol_size n)
+{
+        auto sol_w64 t0;
+        register sol_index r;
+
+        t0 = bench_now();
+        for (r = 0; r < OBJECTS / n; r++) {
+                (void) sol_ptr_new_n(ptr, sz, n);
+                *(volatile sol_w8*) ptr[n - 1] = (sol_w8) r;
+                sol_ptr_free_n(ptr, n);
+        }
+
+        return bench_now() - t0;
+}
+
+static sol_w64 batch_n2(sol_ptr **ptr,
+                        const sol_size *sz,
+                        sol_size n)
+{
+        auto sol_w64 t0;
+        register sol_index r;
+
+        t0 = bench_now();
+        for (r = 0; r < OBJECTS / n; r++) {
+                (void) sol_ptr_new_n2(ptr, sz, n);
+                *(volatile sol_w8*) ptr[n - 1] = (sol_w8) r;
+                sol_ptr_free_n2(ptr, sz, n);
+        }
+
+        return bench_now() - t0;
+}
+
+
+
+
+/*
+ *      __sol_bench_ptr() - declared in sol/bench/bench.h
+ */
+extern void __sol_bench_ptr(void)
+{
+        const sol_allocator alloc = {heap_alloc, heap_realloc, heap_free,
+                                     SOL_PTR_NULL};
+        static sol_ptr *ptr[BATCH_MAX];
+        static sol_size bsz[BATCH_MAX];
+        register sol_size sz, n;
+        auto sol_w64 t0, tcopy, treserve, tresize, theap, tdflt, tcust;
+        auto sol_w64 tone, tn, tn2;
+
+        printf("\nsol_ptr growth in %d KiB appends, ms\n", STEP / 1024);
+        printf("%10s %10s %10s %10s\n", "size", "copy", "reserve", "resize");
+
+        for (sz = BFR_MIN; sz <= BFR_MAX; sz *= 2) {
+                t0 = bench_now();
+                grow_copy(sz);
+                tcopy = bench_now() - t0;
+
+                t0 = bench_now();
+                grow_reserve(sz);
+                treserve = bench_now() - t0;
+
+                t0 = bench_now();
+                grow_resize(sz);
+                tresize = bench_now() - t0;
+
+                printf("%10lu %10.2f %10.2f %10.2f\n",
+                       (unsigned long) sz,
+                       (double) tcopy / 1e6,
+                       (double) treserve / 1e6,
+                       (double) tresize / 1e6);
+        }
+
+        printf("\nsol_ptr allocate and free cycles, ns/cycle\n");
+        printf("%10s %10s %10s %10s\n", "size", "heap", "default", "custom");
+
+        for (sz = 16; sz <= 4096; sz *= 4) {
+                theap = cycle_heap(sz);
+                tdflt = cycle_ptr(sz);
+                (void) sol_ptr_allocator_local(&alloc);
+                tcust = cycle_ptr(sz);
+                (void) sol_ptr_allocator_local(SOL_PTR_NULL);
+
+                printf("%10lu %10.2f %10.2f %10.2f\n",
+                       (unsigned long) sz,
+                       (double) theap / CYCLES,
+                       (double) tdflt / CYCLES,
+                       (double) tcust / CYCLES);
+        }
+
+        for (n = 0; n < BATCH_MAX; n++) {
+                bsz[n] = 16 + (n % 4) * 16;
+        }
+
+        printf("\nsol_ptr batch allocate and free, ns/object\n");
+        printf("%10s %10s %10s %10s\n", "batch", "single", "new_n",
+               "new_n2");
+
+        for (n = 8; n <= BATCH_MAX; n *= 4) {
+                tone = batch_one(ptr, bsz, n);
+                tn = batch_n(ptr, bsz, n);
+                tn2 = batch_n2(ptr, bsz, n);
+
+                printf("%10lu %10.2f %10.2f %10.2f\n",
+                       (unsigned long) n,
+                       (double) tone / OBJECTS,
+                       (double) tn / OBJECTS,
+                       (double) tn2 / OBJECTS);
+        }
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -0,0 +1,154 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/bench/bm-rc.c
+ *
+ * Description:
+ *      This file is part of the internal quality checking of the Sol Library.
+ *      It implements the benchmarks for the reference counted buffer module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "bench.h"
+#include "../inc/mem.h"
+#include "../inc/rc.h"
+
+
+
+
+/*
+ *      STAGES - processing stages each request payload is handed to
+ *      ROUNDS - requests timed per payload size
+ *
+ *      Only the last stage writes to its duplicate of the payload, which
+ *      models read-mostly request fan-out.
+ */
+#define STAGES 8
+#define ROUNDS 4096
+
+
+
+
+/*
+ *      fan_copy() - fans payload out through sol_ptr_copy()
+ *        - src: payload
+ *        - sz: size in bytes of @src
+ */
+static void fan_copy(const sol_ptr *src,
+                     sol_size sz)
+{
+        auto sol_ptr *dup[STAGES];
+        register sol_index i;
+
+        for (i = 0; i < STAGES; i++) {
+                dup[i] = SOL_PTR_NULL;
+                (void) sol_ptr_copy(&dup[i], src, sz);
+        }
+
+        *(volatile sol_w8*) dup[STAGES - 1] = 1;
+
+        for (i = 0; i < STAGES; i++) {
+                sol_ptr_free(&dup[i]);
+        }
+}
+
+
+
+
+/*
+ *      fan_cow() - fans payload out through sol_rc_copy2()
+ *        - src: reference counted payload
+ */
+static void fan_cow(sol_rc *src)
+{
+        auto sol_rc *dup[STAGES];
+        register sol_index i;
+
+        for (i = 0; i < STAGES; i++) {
+                dup[i] = SOL_PTR_NULL;
+                (void) sol_rc_copy2(&dup[i], src);
+        }
+
+        (void) sol_rc_write(&dup[STAGES - 1]);
+        *(volatile sol_w8*) dup[STAGES - 1] = 1;
+
+        for (i = 0; i < STAGES; i++) {
+                sol_rc_release(&dup[i]);
+        }
+}
+
+
+
+
+/*
+ *      __sol_bench_rc() - declared in sol/bench/bench.h
+ */
+extern void __sol_bench_rc(void)
+{
+        auto sol_ptr *src = SOL_PTR_NULL;
+        auto sol_rc *rc = SOL_PTR_NULL;
+        auto sol_w64 t0, tcopy, tcow;
+        register sol_size sz;
+        register sol_index i;
+
+        printf("\nrequest fan-out to %d stages, one writer, us/request\n",
+               STAGES);
+        printf("%10s %10s %10s %12s %12s\n",
+               "size", "copy", "cow", "copy KiB", "cow KiB");
+
+        for (sz = 1024; sz <= 1024 * 1024; sz *= 8) {
+                (void) sol_ptr_new(&src, sz);
+                (void) sol_rc_new(&rc, sz);
+                sol_mem_set(src, 0x5A, sz);
+                sol_mem_set(rc, 0x5A, sz);
+
+                t0 = bench_now();
+                for (i = 0; i < ROUNDS; i++) {
+                        fan_copy(src, sz);
+                }
+                tcopy = bench_now() - t0;
+
+                t0 = bench_now();
+                for (i = 0; i < ROUNDS; i++) {
+                        fan_cow(rc);
+                }
+                tcow = bench_now() - t0;
+
+                printf("%10lu %10.2f %10.2f %12lu %12lu\n",
+                       (unsigned long) sz,
+                       (double) tcopy / ROUNDS / 1e3,
+                       (double) tcow / ROUNDS / 1e3,
+                       (unsigned long) (STAGES * sz / 1024),
+                       (unsigned long) (sz / 1024));
+
+                sol_ptr_free(&src);
+                sol_rc_release(&rc);
+        }
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -0,0 +1,187 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/bench/bm-ring.c
+ *
+ * Description:
+ *      This file is part of the internal quality checking of the Sol Library.
+ *      It implements the benchmarks for the ring buffer module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "bench.h"
+#include "../inc/ring.h"
+
+
+
+
+/*
+ *      CAP - requested capacity in bytes of each ring buffer
+ *      BYTES - bytes streamed through each ring buffer per record size
+ *
+ *      Records are written and read back one at a time, with one record left
+ *      unread so that the head and tail keep wrapping around at different
+ *      offsets.
+ */
+#define CAP (64 * 1024)
+#define BYTES ((sol_size) 64 * 1024 * 1024)
+
+
+
+
+/*
+ *      modulo - conventional ring buffer
+ *        - buf: storage
+ *        - cap: capacity in bytes
+ *        - rd: offset of head
+ *        - len: length in bytes of unread data
+ *
+ *      The modulo ring buffer is the textbook baseline, which wraps every byte
+ *      offset with the modulo operator.
+ */
+typedef struct __modulo {
+        sol_w8 buf[CAP];
+        sol_size cap;
+        sol_size rd;
+        sol_size len;
+} modulo;
+
+
+
+
+/*
+ *      modulo_write() - writes a record to a modulo ring buffer
+ *      modulo_read() - reads a record from a modulo ring buffer
+ */
+static void modulo_write(modulo *ring,
+                         const sol_w8 *src,
+                         sol_size len)
+{
+        register sol_size i, wr = ring->rd + ring->len;
+
+        for (i = 0; i < len; i++) {
+                ring->buf[(wr + i) % ring->cap] = src[i];
+        }
+
+        ring->len += len;
+}
+
+static void modulo_read(modulo *ring,
+                        sol_w8 *dst,
+                        sol_size len)
+{
+        register sol_size i;
+
+        for (i = 0; i < len; i++) {
+                dst[i] = ring->buf[(ring->rd + i) % ring->cap];
+        }
+
+        ring->rd = (ring->rd + len) % ring->cap;
+        ring->len -= len;
+}
+
+
+
+
+/*
+ *      stream() - streams records through a sol_ring
+ *        - ring: contextual ring buffer
+ *        - rec: record buffer
+ *        - sz: size in bytes of each record
+ */
+static sol_w64 stream(sol_ring *ring,
+                      sol_w8 *rec,
+                      sol_size sz)
+{
+        auto sol_w64 t0 = bench_now();
+        register sol_size n;
+
+        (void) sol_ring_write(ring, rec, sz);
+        for (n = 0; n < BYTES; n += sz) {
+                (void) sol_ring_write(ring, rec, sz);
+                (void) sol_ring_read(ring, rec, sz);
+        }
+        (void) sol_ring_skip(ring, sz);
+
+        return bench_now() - t0;
+}
+
+
+
+
+/*
+ *      __sol_bench_ring() - declared in sol/bench/bench.h
+ */
+extern void __sol_bench_ring(void)
+{
+        static modulo mod;
+        static sol_w8 rec[4096];
+        auto sol_ring split, mirror;
+        auto sol_w64 t0, tmod, tsplit, tmirror;
+        register sol_size sz, n;
+
+        split.buf = mirror.buf = SOL_PTR_NULL;
+        if (sol_ring_init2(&split, CAP, SOL_BOOL_FALSE)
+            || sol_ring_init2(&mirror, CAP, SOL_BOOL_TRUE)) {
+                printf("\nring buffer: mirrored buffers unavailable\n");
+                sol_ring_term(&split);
+                return;
+        }
+
+        printf("\nring buffer record streaming, %lu KiB ring, MiB/s\n",
+               (unsigned long) (CAP / 1024));
+        printf("%10s %10s %10s %10s\n", "record", "modulo", "split",
+               "mirror");
+
+        for (sz = 16; sz <= sizeof rec; sz *= 4) {
+                mod.cap = CAP;
+                mod.rd = mod.len = 0;
+
+                t0 = bench_now();
+                modulo_write(&mod, rec, sz);
+                for (n = 0; n < BYTES; n += sz) {
+                        modulo_write(&mod, rec, sz);
+                        modulo_read(&mod, rec, sz);
+                }
+                modulo_read(&mod, rec, sz);
+                tmod = bench_now() - t0;
+
+                tsplit = stream(&split, rec, sz);
+                tmirror = stream(&mirror, rec, sz);
+
+                printf("%10lu %10.0f %10.0f %10.0f\n", (unsigned long) sz,
+                       bench_mibps((double) BYTES, tmod),
+                       bench_mibps((double) BYTES, tsplit),
+                       bench_mibps((double) BYTES, tmirror));
+        }
+
+        sol_ring_term(&split);
+        sol_ring_term(&mirror);
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -0,0 +1,79 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/bench/runner.c
+ *
+ * Description:
+ *      This file is part of the internal quality checking of the Sol Library.
+ *      It implements the benchmark runner to execute all the benchmarks.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+#include "bench.h"
+
+
+
+
+/*
+ *      bench - function pointer to benchmarks
+ */
+typedef void (bench)(void);
+
+
+
+
+/*
+ *      bench_hnd - benchmark handles
+ */
+static bench *bench_hnd[] = {
+        __sol_bench_mem,
+        __sol_bench_ptr,
+        __sol_bench_handle,
+        __sol_bench_rc,
+        __sol_bench_ring,
+        __sol_bench_log
+};
+
+
+
+
+/*
+ *      main() - main entry point of benchmark runner
+ */
+int main(void)
+{
+        register sol_index i;
+
+                /* execute benchmarks in turn */
+        for (i = 0; i < sizeof bench_hnd / sizeof *bench_hnd; i++) {
+                bench_hnd[i]();
+        }
+
+        return 0;
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -0,0 +1,192 @@
+/******************************************************************************
+ *                           SOL LIBRARY v0.1.0+41
+ *
+ * File: sol/inc/arena.h
+ *
+ * Description:
+ *      This file is part of the API of the Sol Library. It declares the
+ *      interface of the arena allocator module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* create header guard */
+#if (!defined __SOL_ARENA_ALLOCATOR_MODULE)
+#define __SOL_ARENA_ALLOCATOR_MODULE
+
+
+
+
+        /* include required header files */
+#include "./error.h"
+#include "./prim.h"
+#include "./ptr.h"
+
+
+
+
+/*
+ *      sol_arena - region based allocator
+ *
+ *      The sol_arena type abstracts a region of heap memory from which objects
+ *      are allocated by bumping a pointer, and which are all released together
+ *      through sol_arena_reset(). The region is made up of a list of chunks
+ *      allocated through sol_ptr_new(), or through sol_ptr_new_huge() if the
+ *      arena was initialised with sol_arena_init2(); the chunks are retained
+ *      across resets so that a long-running process reusing an arena for each
+ *      request does not go back to the heap once the arena has warmed up.
+ *
+ *      Although the sol_arena type is defined as a transparent type so that it
+ *      can be declared on the stack, it should be treated as an opaque type,
+ *      and used only through its interface functions declared below.
+ */
+typedef struct __sol_arena {
+        sol_ptr *head;
+        sol_ptr *cur;
+        sol_w8 *top;
+        sol_w8 *end;
+        sol_size chunk;
+        SOL_BOOL huge;
+} sol_arena;
+
+
+
+
+/*
+ *      sol_arena_init() - initialises an arena
+ *        - arena: contextual arena
+ *        - chunk: size in bytes of each chunk
+ *
+ *      The sol_arena_init() interface function initialises an arena @arena that
+ *      obtains its memory in chunks of @chunk bytes. No memory is obtained
+ *      until the first allocation is made. This function **must** be called
+ *      before any of the other interface functions are called on @arena.
+ *
+ *      @arena is required to be a valid pointer, and @chunk is required to be
+ *      greater than zero; an appropriate exception is thrown if either of these
+ *      conditions is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ */
+extern sol_erno sol_arena_init(sol_arena *arena,
+                               sol_size chunk);
+
+
+
+
+/*
+ *      sol_arena_init2() - initialises an arena backed by huge pages
+ *        - arena: contextual arena
+ *        - chunk: size in bytes of each chunk
+ *        - huge: flag to back chunks with huge pages
+ *
+ *      The sol_arena_init2() interface function is an overloaded form of the
+ *      sol_arena_init() function declared above. If @huge is SOL_BOOL_TRUE,
+ *      then the chunks of @arena are obtained through sol_ptr_new_huge() so
+ *      that they may be backed by transparent huge pages; this is worthwhile
+ *      only for large arenas, with @chunk of at least 2 MiB. Otherwise, this
+ *      function behaves exactly as sol_arena_init().
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ */
+extern sol_erno sol_arena_init2(sol_arena *arena,
+                                sol_size chunk,
+                                SOL_BOOL huge);
+
+
+
+
+/*
+ *      sol_arena_term() - terminates an arena
+ *        - arena: contextual arena
+ *
+ *      The sol_arena_term() interface function releases all the chunks held by
+ *      an arena @arena back to the heap through sol_ptr_free(). All pointers
+ *      allocated from @arena become invalid after this call. A safe no-op
+ *      occurs if @arena is null.
+ */
+extern void sol_arena_term(sol_arena *arena);
+
+
+
+
+/*
+ *      sol_arena_alloc() - allocates from an arena
+ *        - arena: contextual arena
+ *        - ptr: contextual pointer instance
+ *        - sz: size in bytes to allocate
+ *        - align: alignment in bytes of allocation
+ *
+ *      The sol_arena_alloc() interface function allocates a buffer of @sz bytes
+ *      aligned to @align bytes from an arena @arena, and assigns it to @ptr. A
+ *      new chunk is obtained through sol_ptr_new() only if the current chunk
+ *      is exhausted; allocations larger than the chunk size are given a chunk
+ *      of their own. The buffer must **not** be passed to sol_ptr_free(); it
+ *      is released along with all the other buffers of @arena by a call to
+ *      sol_arena_reset() or sol_arena_term().
+ *
+ *      @arena and @ptr are required to be valid pointers, and just as in the
+ *      case of sol_ptr_new(), @ptr must point to a null pointer. @sz must be
+ *      greater than zero, and @align must be a power of two. An appropriate
+ *      exception is thrown if any of these conditions is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size or alignment has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_arena_alloc(sol_arena *arena,
+                                sol_ptr **ptr,
+                                sol_size sz,
+                                sol_size align);
+
+
+
+
+/*
+ *      sol_arena_reset() - releases all allocations of an arena
+ *        - arena: contextual arena
+ *
+ *      The sol_arena_reset() interface function releases in one step all the
+ *      buffers that have been allocated from an arena @arena since it was
+ *      initialised or last reset. The chunks of @arena are retained for reuse
+ *      by subsequent allocations. A safe no-op occurs if @arena is null.
+ */
+extern void sol_arena_reset(sol_arena *arena);
+
+
+
+
+#endif /* !defined __SOL_ARENA_ALLOCATOR_MODULE */
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -0,0 +1,281 @@
+/******************************************************************************
+ *                           SOL LIBRARY v0.1.0+41
+ *
+ * File: sol/inc/budget.h
+ *
+ * Description:
+ *      This file is part of the API of the Sol Library. It declares the
+ *      interface of the memory budget module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* create header guard */
+#if (!defined __SOL_MEMORY_BUDGET_MODULE)
+#define __SOL_MEMORY_BUDGET_MODULE
+
+
+
+
+        /* include required header files */
+#include "./error.h"
+#include "./prim.h"
+#include "./ptr.h"
+
+
+
+
+/*
+ *      SOL_BUDGET_SHARDS - number of accounting shards of a budget
+ *
+ *      The SOL_BUDGET_SHARDS symbolic constant sets the number of per-thread
+ *      accounting shards of each memory budget. Threads are spread over the
+ *      shards round-robin, so that threads charging the same budget rarely
+ *      contend unless there are more threads than shards. It may be redefined
+ *      by client code at compile-time to a power of two, in which case the
+ *      whole library must be compiled with the same setting.
+ */
+#if (!defined SOL_BUDGET_SHARDS)
+#       define SOL_BUDGET_SHARDS 16
+#endif
+
+#if (SOL_BUDGET_SHARDS & (SOL_BUDGET_SHARDS - 1))
+#       error "[!] SOL_BUDGET_SHARDS must be a power of two"
+#endif
+
+
+
+
+/*
+ *      sol_budget - memory budget
+ *
+ *      The sol_budget type represents a quota of memory that the allocations of
+ *      a subsystem, such as a logger, a cache or a request handler, are charged
+ *      to, so that the subsystem can shed load by failing its own allocations
+ *      with SOL_ERNO_BUDGET long before the host runs out of memory.
+ *
+ *      Charges are accounted per thread and reconciled lazily. Each shard holds
+ *      a small credit of bytes that has already been reserved against the
+ *      limit, and most charges and uncharges only adjust the credit of the
+ *      shard of the calling thread; the shared reservation is touched once per
+ *      batch of bytes. When the limit is reached, the credits idling in other
+ *      shards are reclaimed before a charge is refused, so a budget never
+ *      refuses a charge that fits within its limit once quiescent.
+ *
+ *      Although the sol_budget type is defined as a transparent type so that it
+ *      can be declared statically or on the stack, it should be treated as an
+ *      opaque type, and used only through its interface functions declared
+ *      below. Each shard is padded to 64 bytes to avoid false sharing.
+ */
+typedef struct __sol_budget {
+        union {
+                sol_size credit;
+                sol_w8 pad[64];
+        } shard[SOL_BUDGET_SHARDS];
+        sol_size limit;
+        sol_size resv;
+        sol_size batch;
+} sol_budget;
+
+
+
+
+/*
+ *      sol_budget_init() - initialises a memory budget
+ *        - budget: contextual budget
+ *        - limit: quota in bytes
+ *
+ *      The sol_budget_init() interface function initialises a memory budget
+ *      @budget with a quota of @limit bytes, nothing of which is charged. This
+ *      function **must** be called before any of the other interface functions
+ *      are called on @budget. A budget holds no resources, so it needs no
+ *      termination, but it must outlive all the charges made to it.
+ *
+ *      @budget is required to be a valid pointer, and @limit is required to be
+ *      greater than zero; an appropriate exception is thrown if either of these
+ *      conditions is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid quota has been passed
+ */
+extern sol_erno sol_budget_init(sol_budget *budget,
+                                sol_size limit);
+
+
+
+
+/*
+ *      sol_budget_charge() - charges bytes to a memory budget
+ *        - budget: contextual budget
+ *        - sz: number of bytes to charge
+ *
+ *      The sol_budget_charge() interface function charges @sz bytes to a
+ *      memory budget @budget, failing if this would exceed its quota. It allows
+ *      memory not obtained through sol_budget_new(), such as the chunks of an
+ *      arena or the slabs of a pool, to be charged to a budget. Every charge
+ *      must eventually be matched by an uncharge of the same size through
+ *      sol_budget_uncharge().
+ *
+ *      @budget is required to be a valid pointer, or else an exception is
+ *      thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_BUDGET if the quota of @budget would be exceeded
+ */
+extern sol_erno sol_budget_charge(sol_budget *budget,
+                                  sol_size sz);
+
+
+
+
+/*
+ *      sol_budget_uncharge() - uncharges bytes from a memory budget
+ *        - budget: contextual budget
+ *        - sz: number of bytes to uncharge
+ *
+ *      The sol_budget_uncharge() interface function returns @sz bytes that were
+ *      charged earlier through sol_budget_charge() to a memory budget @budget.
+ *      Uncharging more than was charged results in undefined behaviour. A safe
+ *      no-op occurs if @budget is null.
+ */
+extern void sol_budget_uncharge(sol_budget *budget,
+                                sol_size sz);
+
+
+
+
+/*
+ *      sol_budget_new() - initialises a new generic pointer charged to a budget
+ *        - budget: contextual budget
+ *        - ptr: contextual pointer instance
+ *        - sz: size in bytes of pointer buffer
+ *
+ *      The sol_budget_new() interface function charges @sz bytes to a memory
+ *      budget @budget, and then creates a new generic pointer @ptr through
+ *      sol_ptr_new(). If the quota of @budget would be exceeded, then nothing
+ *      is allocated and SOL_ERNO_BUDGET is thrown; if the heap is exhausted,
+ *      then the charge is undone and SOL_ERNO_HEAP is thrown. The buffer of
+ *      @ptr must be released through sol_budget_free() with the same @budget.
+ *
+ *      @budget is required to be a valid pointer, @ptr must be a valid pointer
+ *      to a **null** pointer, and @sz must be greater than zero. An appropriate
+ *      exception is thrown if any of these conditions is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ *        - SOL_ERNO_BUDGET if the quota of @budget would be exceeded
+ */
+extern sol_erno sol_budget_new(sol_budget *budget,
+                               sol_ptr **ptr,
+                               sol_size sz);
+
+
+
+
+/*
+ *      sol_budget_resize() - resizes a generic pointer charged to a budget
+ *        - budget: contextual budget
+ *        - ptr: contextual pointer instance
+ *        - old: current size in bytes of pointer buffer
+ *        - sz: new size in bytes of pointer buffer
+ *
+ *      The sol_budget_resize() interface function resizes the buffer of a
+ *      generic pointer @ptr, obtained through sol_budget_new(), from @old to
+ *      @sz bytes through sol_ptr_resize(), adjusting the charge to the memory
+ *      budget @budget by the difference. Growing a buffer beyond the quota of
+ *      @budget throws SOL_ERNO_BUDGET, in which case @ptr is left unchanged.
+ *
+ *      @budget is required to be a valid pointer, @ptr must be a valid pointer
+ *      to a **non-null** pointer, and @sz must be greater than zero. An
+ *      appropriate exception is thrown if any of these conditions is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ *        - SOL_ERNO_BUDGET if the quota of @budget would be exceeded
+ */
+extern sol_erno sol_budget_resize(sol_budget *budget,
+                                  sol_ptr **ptr,
+                                  sol_size old,
+                                  sol_size sz);
+
+
+
+
+/*
+ *      sol_budget_free() - frees a generic pointer charged to a budget
+ *        - budget: contextual budget
+ *        - ptr: contextual pointer instance
+ *        - sz: size in bytes of pointer buffer
+ *
+ *      The sol_budget_free() interface function releases the buffer of a
+ *      generic pointer @ptr through sol_ptr_free_sized(), and uncharges @sz
+ *      bytes from the memory budget @budget. @sz must be the size that was
+ *      passed to sol_budget_new() or the last call to sol_budget_resize() for
+ *      @ptr. @ptr is guaranteed to be null after this operation. A safe no-op
+ *      occurs if @budget or @ptr is null, or if @ptr points to a null pointer.
+ */
+extern void sol_budget_free(sol_budget *budget,
+                            sol_ptr **ptr,
+                            sol_size sz);
+
+
+
+
+/*
+ *      sol_budget_used() - bytes charged to a memory budget
+ *        - budget: contextual budget
+ *        - used: count of bytes charged
+ *
+ *      The sol_budget_used() interface function reconciles the per-thread
+ *      accounts of a memory budget @budget, and returns the number of bytes
+ *      @used that are currently charged to it. The count is exact when no
+ *      other thread is charging or uncharging @budget at the same time. Both
+ *      @budget and @used are required to be valid pointers, or else an
+ *      exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_budget_used(const sol_budget *budget,
+                                sol_size *used);
+
+
+
+
+#endif /* !defined __SOL_MEMORY_BUDGET_MODULE */
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -149,6 +149,19 @@ typedef sol_word sol_erno;
 
 
 
+/*
+ *      SOL_ERNO_BUDGET - memory budget exceeded
+ *
+ *      The SOL_ERNO_BUDGET symbolic constant indicates that an allocation was
+ *      refused because it would have exceeded the quota of the memory budget
+ *      it was charged to, as opposed to SOL_ERNO_HEAP, which indicates that the
+ *      heap itself is exhausted.
+ */
+#define SOL_ERNO_BUDGET ((sol_erno)0x8)
+
+
+
+
 /*
  *      SOL_TRY - start of try block
  *
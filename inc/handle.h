@@ -0,0 +1,288 @@
+/******************************************************************************
+ *                           SOL LIBRARY v0.1.0+41
+ *
+ * File: sol/inc/handle.h
+ *
+ * Description:
+ *      This file is part of the API of the Sol Library. It declares the
+ *      interface of the handle table module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* create header guard */
+#if (!defined __SOL_HANDLE_TABLE_MODULE)
+#define __SOL_HANDLE_TABLE_MODULE
+
+
+
+
+        /* include required header files */
+#include "./error.h"
+#include "./prim.h"
+#include "./ptr.h"
+
+
+
+
+/*
+ *      sol_handle - generational handle
+ *
+ *      The sol_handle type is a stable reference to an object held in a handle
+ *      table (see sol_htable below). Unlike a pointer, a handle survives the
+ *      relocation of its object, and a handle to an object that has been freed
+ *      is detected as stale rather than aliasing whichever object reuses its
+ *      storage. A handle packs the index of a slot in its lower 32 bits and the
+ *      generation of that slot in its upper 32 bits; it should however be
+ *      treated as an opaque value.
+ */
+typedef sol_w64 sol_handle;
+
+
+
+
+/*
+ *      SOL_HANDLE_NULL - null handle
+ *
+ *      The SOL_HANDLE_NULL symbolic constant is a handle that never refers to
+ *      any object, and so can be used to initialise handles.
+ */
+#define SOL_HANDLE_NULL ((sol_handle) 0)
+
+
+
+
+/*
+ *      sol_htable - handle table
+ *
+ *      The sol_htable type abstracts a table of equal-sized objects referred to
+ *      through generational handles. The objects are kept densely packed in a
+ *      single buffer: freeing an object moves the last object into its place,
+ *      and the buffer shrinks once it is mostly empty, so that a table never
+ *      fragments however long it lives. A separate table of slots maps each
+ *      handle to the current position of its object, making handle resolution
+ *      a constant time operation.
+ *
+ *      Since objects move, a pointer to an object obtained from
+ *      sol_htable_get() remains valid only until the next call to
+ *      sol_htable_new(), sol_htable_free() or sol_htable_compact() on the same
+ *      table; handles should be stored instead.
+ *
+ *      Although the sol_htable type is defined as a transparent type so that it
+ *      can be declared on the stack, it should be treated as an opaque type,
+ *      and used only through its interface functions declared below.
+ */
+typedef struct __sol_htable {
+        sol_w8 *obj;
+        sol_w32 *owner;
+        sol_ptr *slot;
+        sol_size sz;
+        sol_size len;
+        sol_size nslot;
+        sol_size ocap;
+        sol_size wcap;
+        sol_size scap;
+        sol_w32 free;
+} sol_htable;
+
+
+
+
+/*
+ *      sol_htable_init() - initialises a handle table
+ *        - tbl: contextual handle table
+ *        - sz: size in bytes of each object
+ *
+ *      The sol_htable_init() interface function initialises an empty handle
+ *      table @tbl for objects of @sz bytes. Objects are aligned suitably for
+ *      any object type. No memory is reserved until the first object is
+ *      allocated. This function **must** be called before any of the other
+ *      interface functions are called on @tbl.
+ *
+ *      @tbl is required to be a valid pointer, and @sz is required to be
+ *      greater than zero; an appropriate exception is thrown if either of these
+ *      conditions is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ */
+extern sol_erno sol_htable_init(sol_htable *tbl,
+                                sol_size sz);
+
+
+
+
+/*
+ *      sol_htable_term() - terminates a handle table
+ *        - tbl: contextual handle table
+ *
+ *      The sol_htable_term() interface function releases all the memory held by
+ *      a handle table @tbl through sol_ptr_free(). All handles to objects of
+ *      @tbl become invalid after this call. A safe no-op occurs if @tbl is
+ *      null.
+ */
+extern void sol_htable_term(sol_htable *tbl);
+
+
+
+
+/*
+ *      sol_htable_new() - allocates an object in a handle table
+ *        - tbl: contextual handle table
+ *        - hnd: handle to new object
+ *
+ *      The sol_htable_new() interface function allocates a new object at the
+ *      end of the objects of the handle table @tbl, and assigns a handle to it
+ *      to @hnd. The contents of the new object are indeterminate. The storage
+ *      of @tbl grows geometrically through sol_ptr_reserve(), and so this
+ *      function runs in amortised constant time.
+ *
+ *      @tbl and @hnd are required to be valid pointers, and @hnd must hold
+ *      SOL_HANDLE_NULL; an exception is thrown if either of these conditions
+ *      is not met. An exception is also thrown if @tbl already holds 2^32 - 1
+ *      objects.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if @tbl is full
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_htable_new(sol_htable *tbl,
+                               sol_handle *hnd);
+
+
+
+
+/*
+ *      sol_htable_free() - frees an object of a handle table
+ *        - tbl: contextual handle table
+ *        - hnd: handle to object
+ *
+ *      The sol_htable_free() interface function frees the object referred to
+ *      by @hnd in the handle table @tbl, moving the last object of @tbl into
+ *      its place. Every other handle to the freed object becomes stale, and
+ *      @hnd is guaranteed to hold SOL_HANDLE_NULL after this operation.
+ *
+ *      @tbl and @hnd are expected to be valid, and @hnd is expected to hold a
+ *      handle to a live object of @tbl, but in case these conditions are not
+ *      met, then a safe no-op occurs.
+ */
+extern void sol_htable_free(sol_htable *tbl,
+                            sol_handle *hnd);
+
+
+
+
+/*
+ *      sol_htable_get() - resolves a handle
+ *        - tbl: contextual handle table
+ *        - hnd: handle to object
+ *        - ptr: current address of object
+ *
+ *      The sol_htable_get() interface function resolves a handle @hnd of the
+ *      handle table @tbl to the current address @ptr of its object in constant
+ *      time. @ptr remains valid only until @tbl is next modified.
+ *
+ *      @tbl and @ptr are required to be valid pointers, and @hnd is required
+ *      to refer to a live object of @tbl; SOL_ERNO_PTR is thrown if any of
+ *      these conditions is not met, and in particular if @hnd is stale.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer or stale handle has been passed
+ */
+extern sol_erno sol_htable_get(const sol_htable *tbl,
+                               sol_handle hnd,
+                               sol_ptr **ptr);
+
+
+
+
+/*
+ *      sol_htable_compact() - releases unused storage of a handle table
+ *        - tbl: contextual handle table
+ *
+ *      The sol_htable_compact() interface function shrinks the object storage
+ *      of the handle table @tbl to fit its live objects, returning the excess
+ *      to the heap. Since objects are always densely packed, no object needs
+ *      to be moved other than by the heap itself. @tbl is required to be a
+ *      valid pointer, or else an exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_htable_compact(sol_htable *tbl);
+
+
+
+
+/*
+ *      sol_htable_len() - count of live objects
+ *        - tbl: contextual handle table
+ *        - len: count of live objects
+ *
+ *      The sol_htable_len() interface function returns the number of live
+ *      objects @len of a handle table @tbl. Both @tbl and @len are required to
+ *      be valid pointers, or else an exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_htable_len(const sol_htable *tbl,
+                               sol_size *len);
+
+
+
+
+/*
+ *      sol_htable_cap() - size of storage of a handle table
+ *        - tbl: contextual handle table
+ *        - cap: size in bytes of storage
+ *
+ *      The sol_htable_cap() interface function returns the total size @cap in
+ *      bytes of the heap memory currently reserved by a handle table @tbl for
+ *      its objects and slots. Both @tbl and @cap are required to be valid
+ *      pointers, or else an exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_htable_cap(const sol_htable *tbl,
+                               sol_size *cap);
+
+
+
+
+#endif /* !defined __SOL_HANDLE_TABLE_MODULE */
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
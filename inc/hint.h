@@ -208,6 +208,29 @@
 
 
 
+/*
+ *      sol_format() - hint that function takes a printf() style format
+ *        - fmt: position of format string parameter
+ *        - args: position of first variadic argument
+ *
+ *      The sol_format() macro provides a compiler hint that the function it is
+ *      associated with takes a format string at parameter position @fmt, which
+ *      is followed by variadic arguments from position @args, in the manner of
+ *      printf(). Using this hint allows the compiler to check the arguments
+ *      against the format string. This hint is available on GCC-compatible
+ *      compilation environments, and degrades gracefully to a safe no-op on
+ *      other environments, but with an appropriate warning.
+ */
+#if (SOL_ENV_CC_GNUC == sol_env_cc() || SOL_ENV_CC_CLANG == sol_env_cc())
+#       define sol_format(fmt, args) __attribute__((format(printf, fmt, args)))
+#else
+#       define sol_format(fmt, args)
+#       warning "sol_format() has no effect"
+#endif
+
+
+
+
 #endif /* !defined __SOL_COMPILER_HINTS_MODULE */
 
 
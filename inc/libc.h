@@ -139,12 +139,16 @@
 
 /*
  *      SOL_LIBC_MALLOC_DEFINED - stdlib.h malloc() defined
+ *
+ *      In freestanding environments that do not provide malloc(), free() and
+ *      realloc(), the pointer module falls back to the TLSF heap declared in
+ *      sol/inc/tlsf.h by defining SOL_PTR_TLSF.
  */
 #if (sol_env_host() == SOL_ENV_HOST_NONE)
 #       if (defined SOL_LIBC_MALLOC_DEFINED)
                 extern void *malloc(size_t);
-#       else
-#               error "[!] Sol libc error: malloc() not defined"
+#       elif (!defined SOL_PTR_TLSF)
+#               define SOL_PTR_TLSF
 #       endif
 #else
 #       define SOL_LIBC_FPRINTF_DEFINED
@@ -159,7 +163,7 @@
 #if (sol_env_host() == SOL_ENV_HOST_NONE)
 #       if (defined SOL_LIBC_MALLOC_DEFINED)
                 extern void free(void*);
-#       else
+#       elif (!defined SOL_PTR_TLSF)
 #               error "[!] Sol libc error: free() not defined"
 #       endif
 #else
@@ -169,6 +173,37 @@
 
 
 
+/*
+ *      SOL_LIBC_REALLOC_DEFINED - stdlib.h realloc() defined
+ */
+#if (sol_env_host() == SOL_ENV_HOST_NONE)
+#       if (defined SOL_LIBC_REALLOC_DEFINED)
+                extern void *realloc(void*, size_t);
+#       elif (!defined SOL_PTR_TLSF)
+#               error "[!] Sol libc error: realloc() not defined"
+#       endif
+#else
+#       define SOL_LIBC_REALLOC_DEFINED
+#endif
+
+
+
+
+/*
+ *      SOL_LIBC_ALIGNED_ALLOC_DEFINED - stdlib.h aligned_alloc() defined
+ *
+ *      This hook is optional in freestanding environments;
+ *      sol_ptr_new_aligned() falls back to malloc() if it is not defined.
+ */
+#if (sol_env_host() == SOL_ENV_HOST_NONE)
+#       if (defined SOL_LIBC_ALIGNED_ALLOC_DEFINED)
+                extern void *aligned_alloc(size_t, size_t);
+#       endif
+#endif
+
+
+
+
 /*
  *      SOL_LIBC_TIME_DEFINED - time.h time() defined
  */
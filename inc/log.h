@@ -48,11 +48,18 @@
  *      @path, and sets it as the default log file where the log entries will be
  *      written by the logging module. This function flushes out the contents of
  *      the log file at @path if it exists, and creates it if it does not exist.
+ *      Each log entry is stamped with the local time in the format of ctime(),
+ *      followed by milliseconds, and with the number of the thread that logged
+ *      it; threads are numbered from one in the order of their first entries.
+ *
+ *      The log file is shared by all the threads of the process, so it needs
+ *      to be opened only once. It must however be opened and closed while no
+ *      other thread is logging.
  *
  *      @path is required to be a valid non-null string, or else an exception is
  *      thrown. An error is also raised in case the log file at @path has
- *      already been opened by an earlier call to either sol_log_open() or
- *      sol_log_open2().
+ *      already been opened by an earlier call to sol_log_open(),
+ *      sol_log_open2(), sol_log_open3() or sol_log_open4().
  *
  *      Return:
  *        - SOL_ERNO_NULL if no error occurs
@@ -81,8 +88,8 @@ extern sol_erno sol_log_open(const char *path);
  *
  *      @path is required to be a valid non-null string, or else an exception is
  *      thrown. An error is also raised in case the log file at @path has
- *      already been opened by an earlier call to either sol_log_open() or
- *      sol_log_open2().
+ *      already been opened by an earlier call to sol_log_open(),
+ *      sol_log_open2(), sol_log_open3() or sol_log_open4().
  *
  *      Return:
  *        - SOL_ERNO_NULL if no error occurs
@@ -96,22 +103,444 @@ extern sol_erno sol_log_open2(const char *path,
 
 
 
+/*
+ *      SOL_LOG_FORMAT - enumerates log file formats
+ *        - SOL_LOG_FORMAT_TEXT: plain text, one line per entry
+ *        - SOL_LOG_FORMAT_BINARY: compact binary records
+ *
+ *      The SOL_LOG_FORMAT type enumerates the formats in which log entries can
+ *      be written. Text entries are formatted as they are logged. Binary
+ *      entries hold only an identifier of their call site, a thread number, a
+ *      raw timestamp and the message; each call site is described once per log
+ *      file, the first time that it logs an entry. Binary log files are turned
+ *      back into text log files by sol_log_decode(), so that formatting is
+ *      moved off the hot path altogether.
+ */
+#define SOL_LOG_FORMAT int
+#define SOL_LOG_FORMAT_TEXT (0)
+#define SOL_LOG_FORMAT_BINARY (1)
+
+
+
+
+/*
+ *      sol_log_open3() - opens log file
+ *        - path: log file path
+ *        - flush: flag to indicate whether log file should be flushed
+ *        - fmt: log file format
+ *
+ *      The sol_log_open3() interface function is the overloaded form of the
+ *      sol_log_open2() function declared above, and additionally allows the
+ *      format @fmt of the log file to be chosen. Binary log files that are not
+ *      flushed are appended to, and must have been written in binary format
+ *      before.
+ *
+ *      @path is required to be a valid non-null string, and @fmt is required
+ *      to be one of the SOL_LOG_FORMAT constants; an exception is thrown if
+ *      either of these conditions is not met. An error is also raised in case
+ *      a log file has already been opened.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_STATE if log file is already open
+ *        - SOL_ERNO_STR if @path is invalid
+ *        - SOL_ERNO_RANGE if @fmt is invalid
+ *        - SOL_ERNO_FILE if log file can't be opened
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_log_open3(const char *path,
+                              int flush,
+                              SOL_LOG_FORMAT fmt);
+
+
+
+
+/*
+ *      SOL_LOG_BACKEND - enumerates log file backends
+ *        - SOL_LOG_BACKEND_STDIO: buffered stdio stream
+ *        - SOL_LOG_BACKEND_MMAP: memory-mapped file
+ *        - SOL_LOG_BACKEND_WRITEV: gathered writes
+ *        - SOL_LOG_BACKEND_URING: asynchronous writes through io_uring
+ *
+ *      The SOL_LOG_BACKEND type enumerates the ways in which log entries can be
+ *      written out to the log file. The stdio backend hands entries over to a
+ *      buffered stdio stream, which writes them out with periodic calls to
+ *      write().
+ *
+ *      The memory-mapped backend preallocates the log file in large windows
+ *      with posix_fallocate(), maps them into memory, and appends entries with
+ *      plain memory copies, leaving the kernel to write them out. Threads claim
+ *      room for their entries with a single atomic addition, and the next
+ *      window is mapped ahead of time by the thread that crosses the middle of
+ *      the current one, so that no thread blocks on the advance unless it
+ *      outruns it. The log file is truncated to its real length when it is
+ *      closed; until then, it is padded with zeros up to the end of its last
+ *      window. A memory-mapped log file can grow up to 64 GiB (1 GiB on 32-bit
+ *      hosts), after which entries are dropped.
+ *
+ *      The gathered-write backend copies entries into a ring of 16 chunks of
+ *      64 KiB each, and writes out all the filled chunks with a single call to
+ *      writev() once the ring is full, or once per batch in asynchronous mode.
+ *
+ *      The io_uring backend fills the same ring of chunks, but hands each
+ *      chunk to the kernel as soon as it is full, or once per batch in
+ *      asynchronous mode, without waiting for it to be written out. The
+ *      completions of earlier writes are reaped without a system call when a
+ *      chunk is handed over, so a thread waits on the file system only when
+ *      all the chunks are still being written out. This backend is available
+ *      only if SOL_LOG_URING is defined.
+ *
+ *      With both of these backends, entries reach the log file later than
+ *      they do with the stdio backend, but at most when it is closed.
+ */
+#define SOL_LOG_BACKEND int
+#define SOL_LOG_BACKEND_STDIO (0)
+#define SOL_LOG_BACKEND_MMAP (1)
+#define SOL_LOG_BACKEND_WRITEV (2)
+#define SOL_LOG_BACKEND_URING (3)
+
+
+
+
+/*
+ *      SOL_LOG_URING - io_uring log file backend
+ *
+ *      The SOL_LOG_URING symbolic constant, if defined by client code at
+ *      compile-time, makes the SOL_LOG_BACKEND_URING backend described above
+ *      available. The backend drives io_uring through its system calls, and so
+ *      needs the headers of a Linux 5.1 or later kernel, but not liburing.
+ *      When SOL_LOG_URING is not defined, the backend is compiled out, and
+ *      sol_log_open4() throws SOL_ERNO_STATE if it is asked for.
+ */
+#if (defined SOL_LOG_URING)
+#       if (sol_env_host() != SOL_ENV_HOST_LINUX                              \
+            && sol_env_host() != SOL_ENV_HOST_ANDROID)
+#               error "[!] SOL_LOG_URING supported only in Linux hosts"
+#       endif
+#endif
+
+
+
+
+/*
+ *      sol_log_open4() - opens log file
+ *        - path: log file path
+ *        - flush: flag to indicate whether log file should be flushed
+ *        - fmt: log file format
+ *        - backend: log file backend
+ *
+ *      The sol_log_open4() interface function is the overloaded form of the
+ *      sol_log_open3() function declared above, and additionally allows the
+ *      backend @backend through which the log file is written to be chosen.
+ *
+ *      @path is required to be a valid non-null string, and @fmt and @backend
+ *      are required to be one of the SOL_LOG_FORMAT and SOL_LOG_BACKEND
+ *      constants respectively; an exception is thrown if any of these
+ *      conditions is not met. An error is also raised in case a log file has
+ *      already been opened.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_STATE if log file is already open, or if @backend is
+ *          SOL_LOG_BACKEND_URING and SOL_LOG_URING is not defined
+ *        - SOL_ERNO_STR if @path is invalid
+ *        - SOL_ERNO_RANGE if @fmt or @backend is invalid
+ *        - SOL_ERNO_FILE if log file can't be opened or mapped, or if the
+ *          kernel refuses to set up io_uring
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_log_open4(const char *path,
+                              int flush,
+                              SOL_LOG_FORMAT fmt,
+                              SOL_LOG_BACKEND backend);
+
+
+
+
+/*
+ *      sol_log_decode() - decodes binary log file
+ *        - src: binary log file path
+ *        - dst: text log file path
+ *
+ *      The sol_log_decode() interface function reads the binary log file at
+ *      @src, and writes its entries to the text log file at @dst in the same
+ *      format as a text log file, overwriting it if it exists. Entries whose
+ *      call site descriptions are missing from @src, as may happen in a file
+ *      that has been truncated or corrupted, are written with placeholders for
+ *      their type and code location.
+ *
+ *      @src and @dst are required to be valid non-null strings; an exception
+ *      is thrown if this condition is not met, or if either of the log files
+ *      can't be opened, or if @src is not a valid binary log file.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_STR if @src or @dst is invalid
+ *        - SOL_ERNO_FILE if a log file can't be opened or decoded
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_log_decode(const char *src,
+                               const char *dst);
+
+
+
+
 /*
  *      sol_log_close() - closes log file
  *
  *      The sol_log_close() interface function closes the log file that has been
- *      opened by an earlier call to either sol_log_open() or sol_log_open2().
+ *      opened by an earlier call to sol_log_open(), sol_log_open2(),
+ *      sol_log_open3() or sol_log_open4().
  *      Calling this function when no log file is currently open results in a
  *      safe no-op.
  *
  *      This function must be called when the logging module is no longer
- *      required in order to prevent a resource leak.
+ *      required in order to prevent a resource leak. If the log file is in the
+ *      asynchronous mode enabled by sol_log_async(), then this function waits
+ *      for the writer thread to write out all the queued entries, so that the
+ *      log file is complete once it returns. A memory-mapped log file is
+ *      unmapped and truncated to its real length.
  */
 extern void sol_log_close(void);
 
 
 
 
+/*
+ *      SOL_LOG_POLICY - enumerates back-pressure policies
+ *        - SOL_LOG_POLICY_BLOCK: wait until the writer thread frees an entry
+ *        - SOL_LOG_POLICY_DROP_NEWEST: discard the entry being logged
+ *        - SOL_LOG_POLICY_DROP_OLDEST: discard the oldest pending entry
+ *
+ *      The SOL_LOG_POLICY type enumerates the ways in which the asynchronous
+ *      logging mode enabled by sol_log_async() deals with a log entry when its
+ *      queue is full. Entries discarded by either of the dropping policies are
+ *      counted, and their count can be queried through sol_log_dropped().
+ */
+#define SOL_LOG_POLICY int
+#define SOL_LOG_POLICY_BLOCK (0)
+#define SOL_LOG_POLICY_DROP_NEWEST (1)
+#define SOL_LOG_POLICY_DROP_OLDEST (2)
+
+
+
+
+/*
+ *      SOL_LOG_ASYNC - asynchronous logging mode
+ *
+ *      The SOL_LOG_ASYNC symbolic constant, if defined by client code at
+ *      compile-time, makes the asynchronous logging mode of sol_log_async()
+ *      available. In this mode, the logging macros copy their entries straight
+ *      into a bounded lock-free queue owned by the calling thread and return,
+ *      and a dedicated writer thread merges the queues of all threads into the
+ *      log file in batches. Entries are written in the order of their
+ *      timestamps, and are formatted by the writer thread, so that callers
+ *      neither wait on the file system nor contend with each other.
+ *
+ *      In the synchronous mode, on the other hand, the entries of concurrent
+ *      threads are serialised by the lock of the log file stream.
+ *
+ *      This mode is available only in hosted environments that support POSIX
+ *      threads. When SOL_LOG_ASYNC is not defined, the asynchronous mode is
+ *      compiled out, and sol_log_async() throws SOL_ERNO_STATE.
+ */
+#if (defined SOL_LOG_ASYNC)
+#       if (sol_env_host() == SOL_ENV_HOST_NONE)
+#               error "[!] SOL_LOG_ASYNC not supported in freestanding hosts"
+#       endif
+#endif
+
+
+
+
+/*
+ *      sol_log_async() - switches log file to asynchronous mode
+ *        - cap: number of entries that can be queued
+ *        - policy: back-pressure policy
+ *
+ *      The sol_log_async() interface function switches the log file that is
+ *      currently open to the asynchronous logging mode described above. The
+ *      queue of each thread holds @cap entries, rounded up to the next power of
+ *      two, in slots of 512 bytes that truncate messages to about 450 bytes;
+ *      @policy determines what happens when the queue of a thread is full. The
+ *      mode lasts until the log file is closed by sol_log_close(), which writes
+ *      out all the queued entries before returning. Like the log file, the
+ *      mode must be entered while no other thread is logging.
+ *
+ *      @cap is required to be greater than zero, and @policy is required to be
+ *      one of the SOL_LOG_POLICY constants; an exception is thrown if either of
+ *      these conditions is not met, or if no log file is open, or if the log
+ *      file is already in asynchronous mode.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_RANGE if an invalid @cap or @policy has been passed
+ *        - SOL_ERNO_STATE if no log file is open, if it is already in
+ *          asynchronous mode, or if SOL_LOG_ASYNC is not defined
+ *        - SOL_ERNO_HEAP if the queue or writer thread can't be created
+ */
+extern sol_erno sol_log_async(sol_size cap,
+                              SOL_LOG_POLICY policy);
+
+
+
+
+/*
+ *      sol_log_dropped() - gets count of dropped log entries
+ *        - dropped: count of entries dropped
+ *
+ *      The sol_log_dropped() interface function returns the number of log
+ *      entries @dropped that have been discarded by the back-pressure policy of
+ *      the asynchronous logging mode across all threads since sol_log_async()
+ *      was called. The count is zero if the log file is not in asynchronous
+ *      mode. @dropped is required to be a valid pointer, or else an exception
+ *      is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_log_dropped(sol_size *dropped);
+
+
+
+
+/*
+ *      SOL_LOG_LEVEL_TRACE - trace messages and above
+ *      SOL_LOG_LEVEL_DEBUG - debug messages and above
+ *      SOL_LOG_LEVEL_WARN - warning messages and above
+ *      SOL_LOG_LEVEL_ERROR - error messages and error codes only
+ *      SOL_LOG_LEVEL_NONE - no messages
+ *
+ *      These symbolic constants enumerate the log levels, in increasing order
+ *      of severity. A log level lets through the messages of its own severity
+ *      and above, and filters out the rest.
+ */
+#define SOL_LOG_LEVEL_TRACE (0)
+#define SOL_LOG_LEVEL_DEBUG (1)
+#define SOL_LOG_LEVEL_WARN (2)
+#define SOL_LOG_LEVEL_ERROR (3)
+#define SOL_LOG_LEVEL_NONE (4)
+
+
+
+
+/*
+ *      SOL_LOG_LEVEL - compile-time log level
+ *
+ *      The SOL_LOG_LEVEL symbolic constant may be defined by client code at
+ *      compile-time to one of the log levels above, and defaults to
+ *      SOL_LOG_LEVEL_TRACE. The logging macros of the severities filtered out
+ *      by SOL_LOG_LEVEL expand to no code at all, and their arguments are not
+ *      evaluated. The logging macros of the remaining severities are further
+ *      filtered at runtime by the level set through sol_log_level_set().
+ *
+ *      Every logging macro expands to a statement, whether or not it has been
+ *      filtered out by SOL_LOG_LEVEL, since each call site holds static state
+ *      for the rate limits of sol_log_limit_set(). The logging macros can't be
+ *      used as expressions, and so can't be operands of other expressions.
+ */
+#if (!defined SOL_LOG_LEVEL)
+#       define SOL_LOG_LEVEL SOL_LOG_LEVEL_TRACE
+#endif
+
+#if (SOL_LOG_LEVEL < SOL_LOG_LEVEL_TRACE || SOL_LOG_LEVEL > SOL_LOG_LEVEL_NONE)
+#       error "[!] SOL_LOG_LEVEL is not a valid log level"
+#endif
+
+
+
+
+/*
+ *      sol_log_level() - gets runtime log level
+ *        - level: current log level
+ *
+ *      The sol_log_level() interface function returns the log level @level
+ *      that is currently applied at runtime by the logging macros. @level is
+ *      required to be a valid pointer, or else an exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_log_level(int *level);
+
+
+
+
+/*
+ *      sol_log_level_set() - sets runtime log level
+ *        - level: new log level
+ *
+ *      The sol_log_level_set() interface function sets the log level @level
+ *      applied at runtime by the logging macros of all threads, which is
+ *      SOL_LOG_LEVEL_TRACE by default. Severities that have been removed at
+ *      compile-time by SOL_LOG_LEVEL can't be turned back on. @level is
+ *      required to be one of the log levels above, or else an exception is
+ *      thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_RANGE if an invalid @level has been passed
+ */
+extern sol_erno sol_log_level_set(int level);
+
+
+
+
+/*
+ *      sol_log_limit() - gets runtime rate limits
+ *        - rate: most entries written per call site per second, or 0
+ *        - sample: number of calls per call site for each entry sampled
+ *
+ *      The sol_log_limit() interface function returns the rate limits @rate
+ *      and @sample that are currently applied at runtime by the logging
+ *      macros. Both @rate and @sample are required to be valid pointers, or
+ *      else an exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_log_limit(sol_uint *rate,
+                              sol_uint *sample);
+
+
+
+
+/*
+ *      sol_log_limit_set() - sets runtime rate limits
+ *        - rate: most entries written per call site per second, or 0
+ *        - sample: number of calls per call site for each entry sampled
+ *
+ *      The sol_log_limit_set() interface function sets the rate limits that
+ *      the logging macros of all threads apply to each of their call sites,
+ *      so that a single hot call site can't flood the log file. Only one in
+ *      every @sample calls of a call site is written, and of those, at most
+ *      @rate are written per second, or all of them if @rate is 0. By default
+ *      @rate is 0 and @sample is 1, so that every entry is written.
+ *
+ *      Each expansion of a logging macro keeps its own count of calls, which
+ *      is bumped by a single relaxed atomic addition while rate limits are
+ *      set, and seconds are counted from the first call of a call site. The
+ *      first call of a call site let through after a second in which some of
+ *      its calls were dropped for exceeding @rate is preceded by an entry
+ *      reporting how many were dropped, sampled out calls included; calls
+ *      sampled out while @rate is 0 are not reported.
+ *
+ *      @sample is required to be greater than zero, or else an exception is
+ *      thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_RANGE if an invalid @sample has been passed
+ */
+extern sol_erno sol_log_limit_set(sol_uint rate,
+                                  sol_uint sample);
+
+
+
+
 /*
  *      sol_log_trace() - logs a trace message
  *        - msg: message
@@ -121,12 +550,13 @@ extern void sol_log_close(void);
  *      are automatically prefixed to @msg. It is safe to call this macro even
  *      if no log file is currently open.
  */
-#define /* void */ sol_log_trace(/* const char* */ msg) \
-        __sol_log_write("T",                            \
-                        sol_env_func(),                 \
-                        sol_env_file(),                 \
-                        sol_env_line(),                 \
-                        (msg))
+#if (SOL_LOG_LEVEL <= SOL_LOG_LEVEL_TRACE)
+#define /* void */ sol_log_trace(/* const char* */ msg)               \
+        __sol_log_entry(SOL_LOG_LEVEL_TRACE, __sol_log_write, (msg))
+#else
+#define /* void */ sol_log_trace(/* const char* */ msg)               \
+        do { (void) sizeof (msg); } while (0)
+#endif
 
 
 
@@ -140,12 +570,13 @@ extern void sol_log_close(void);
  *      are automatically prefixed to @msg. It is safe to call this macro even
  *      if no log file is currently open.
  */
-#define /* void */ sol_log_debug(/* const char* */ msg) \
-        __sol_log_write("D",                            \
-                        sol_env_func(),                 \
-                        sol_env_file(),                 \
-                        sol_env_line(),                 \
-                        (msg))
+#if (SOL_LOG_LEVEL <= SOL_LOG_LEVEL_DEBUG)
+#define /* void */ sol_log_debug(/* const char* */ msg)               \
+        __sol_log_entry(SOL_LOG_LEVEL_DEBUG, __sol_log_write, (msg))
+#else
+#define /* void */ sol_log_debug(/* const char* */ msg)               \
+        do { (void) sizeof (msg); } while (0)
+#endif
 
 
 
@@ -159,12 +590,13 @@ extern void sol_log_close(void);
  *      are automatically prefixed to @msg. It is safe to call this macro even
  *      if no log file is currently open.
  */
-#define /* void */ sol_log_warn(/* const char* */ msg) \
-        __sol_log_write("W",                           \
-                        sol_env_func(),                \
-                        sol_env_file(),                \
-                        sol_env_line(),                \
-                        (msg))
+#if (SOL_LOG_LEVEL <= SOL_LOG_LEVEL_WARN)
+#define /* void */ sol_log_warn(/* const char* */ msg)                \
+        __sol_log_entry(SOL_LOG_LEVEL_WARN, __sol_log_write, (msg))
+#else
+#define /* void */ sol_log_warn(/* const char* */ msg)                \
+        do { (void) sizeof (msg); } while (0)
+#endif
 
 
 
@@ -178,12 +610,13 @@ extern void sol_log_close(void);
  *      are automatically prefixed to @msg. It is safe to call this macro even
  *      if no log file is currently open.
  */
-#define /* void */ sol_log_error(/* const char* */ msg) \
-        __sol_log_write("E",                            \
-                        sol_env_func(),                 \
-                        sol_env_file(),                 \
-                        sol_env_line(),                 \
-                        (msg))
+#if (SOL_LOG_LEVEL <= SOL_LOG_LEVEL_ERROR)
+#define /* void */ sol_log_error(/* const char* */ msg)               \
+        __sol_log_entry(SOL_LOG_LEVEL_ERROR, __sol_log_write, (msg))
+#else
+#define /* void */ sol_log_error(/* const char* */ msg)               \
+        do { (void) sizeof (msg); } while (0)
+#endif
 
 
 
@@ -197,12 +630,190 @@ extern void sol_log_close(void);
  *      are automatically prefixed to @msg. It is safe to call this macro even
  *      if no log file is currently open.
  */
-#define /* void */ sol_log_erno(/* sol_erno */ erno) \
-        __sol_log_write("E",                         \
-                        sol_env_func(),              \
-                        sol_env_file(),              \
-                        sol_env_line(),              \
+#if (SOL_LOG_LEVEL <= SOL_LOG_LEVEL_ERROR)
+#define /* void */ sol_log_erno(/* sol_erno */ erno)                  \
+        __sol_log_entry(SOL_LOG_LEVEL_ERROR,                          \
+                        __sol_log_write,                              \
                         sol_erno_str((erno)))
+#else
+#define /* void */ sol_log_erno(/* sol_erno */ erno)                  \
+        do { (void) sizeof (erno); } while (0)
+#endif
+
+
+
+
+/*
+ *      sol_log_tracef() - logs a formatted trace message
+ *        - fmt: format string
+ *        - ...: arguments of @fmt
+ *
+ *      The sol_log_tracef() interface macro records a trace message, formatted
+ *      from @fmt and its arguments, to the currently open log file in the same
+ *      manner as sol_log_trace(). @fmt is interpreted as by __sol_log_writef().
+ *      The arguments are not evaluated if the message is filtered out by the
+ *      log level.
+ */
+#if (SOL_LOG_LEVEL <= SOL_LOG_LEVEL_TRACE)
+#define /* void */ sol_log_tracef(/* fmt, */ ...)                     \
+        __sol_log_entry(SOL_LOG_LEVEL_TRACE, __sol_log_writef, __VA_ARGS__)
+#else
+#define /* void */ sol_log_tracef(/* fmt, */ ...)                     \
+        do { (void) sizeof (__sol_log_nop(__VA_ARGS__)); } while (0)
+#endif
+
+
+
+
+/*
+ *      sol_log_debugf() - logs a formatted debug message
+ *        - fmt: format string
+ *        - ...: arguments of @fmt
+ *
+ *      The sol_log_debugf() interface macro records a debug message, formatted
+ *      from @fmt and its arguments, to the currently open log file in the same
+ *      manner as sol_log_debug(). @fmt is interpreted as by __sol_log_writef().
+ *      The arguments are not evaluated if the message is filtered out by the
+ *      log level.
+ */
+#if (SOL_LOG_LEVEL <= SOL_LOG_LEVEL_DEBUG)
+#define /* void */ sol_log_debugf(/* fmt, */ ...)                     \
+        __sol_log_entry(SOL_LOG_LEVEL_DEBUG, __sol_log_writef, __VA_ARGS__)
+#else
+#define /* void */ sol_log_debugf(/* fmt, */ ...)                     \
+        do { (void) sizeof (__sol_log_nop(__VA_ARGS__)); } while (0)
+#endif
+
+
+
+
+/*
+ *      sol_log_warnf() - logs a formatted warning message
+ *        - fmt: format string
+ *        - ...: arguments of @fmt
+ *
+ *      The sol_log_warnf() interface macro records a warning message, formatted
+ *      from @fmt and its arguments, to the currently open log file in the same
+ *      manner as sol_log_warn(). @fmt is interpreted as by __sol_log_writef().
+ *      The arguments are not evaluated if the message is filtered out by the
+ *      log level.
+ */
+#if (SOL_LOG_LEVEL <= SOL_LOG_LEVEL_WARN)
+#define /* void */ sol_log_warnf(/* fmt, */ ...)                      \
+        __sol_log_entry(SOL_LOG_LEVEL_WARN, __sol_log_writef, __VA_ARGS__)
+#else
+#define /* void */ sol_log_warnf(/* fmt, */ ...)                      \
+        do { (void) sizeof (__sol_log_nop(__VA_ARGS__)); } while (0)
+#endif
+
+
+
+
+/*
+ *      sol_log_errorf() - logs a formatted error message
+ *        - fmt: format string
+ *        - ...: arguments of @fmt
+ *
+ *      The sol_log_errorf() interface macro records an error message, formatted
+ *      from @fmt and its arguments, to the currently open log file in the same
+ *      manner as sol_log_error(). @fmt is interpreted as by __sol_log_writef().
+ *      The arguments are not evaluated if the message is filtered out by the
+ *      log level.
+ */
+#if (SOL_LOG_LEVEL <= SOL_LOG_LEVEL_ERROR)
+#define /* void */ sol_log_errorf(/* fmt, */ ...)                     \
+        __sol_log_entry(SOL_LOG_LEVEL_ERROR, __sol_log_writef, __VA_ARGS__)
+#else
+#define /* void */ sol_log_errorf(/* fmt, */ ...)                     \
+        do { (void) sizeof (__sol_log_nop(__VA_ARGS__)); } while (0)
+#endif
+
+
+
+
+/*
+ *      __sol_log_site - call site state
+ *
+ *      The __sol_log_site type is **not** a part of the interface of the
+ *      logging module, and must **not** be used directly. Each expansion of
+ *      the logging macros defined above holds a static instance of this type,
+ *      in which the calls of the call site are counted against the rate limits
+ *      set by sol_log_limit_set(), along with the start of the second that is
+ *      being counted. It also holds the identifier of the call site in binary
+ *      log files, and the session of the log file in which it was assigned.
+ */
+typedef struct __sol_log_site {
+        sol_w32 calls;
+        sol_w32 id;
+        sol_w64 start;
+        sol_w32 gen;
+} __sol_log_site;
+
+
+
+
+/*
+ *      __sol_log_desc - call site descriptor
+ *
+ *      The __sol_log_desc type is **not** a part of the interface of the
+ *      logging module, and must **not** be used directly. Each expansion of
+ *      the logging macros defined above holds a static constant instance of
+ *      this type, which describes the level and code location of the call
+ *      site, and points to its state. Since the descriptor is built at compile
+ *      time, a call site passes only its address and the message to the
+ *      logging module instead of five separate arguments.
+ */
+typedef struct __sol_log_desc {
+        int level;
+        int line;
+        const char *func;
+        const char *file;
+        __sol_log_site *site;
+} __sol_log_desc;
+
+
+
+
+/*
+ *      __sol_log_entry() - expands a logging macro
+ *        - lvl: log level of call site
+ *        - write: __sol_log_write() or __sol_log_writef()
+ *        - ...: message, or format string and its arguments
+ *
+ *      The __sol_log_entry() macro is **not** a part of the interface of the
+ *      logging module, and must **not** be used directly. It defines the state
+ *      and descriptor of a call site, and calls @write with the address of the
+ *      descriptor if the runtime log level lets @lvl through.
+ */
+#define /* void */ __sol_log_entry(lvl, write, ...)                   \
+        do {                                                          \
+                static __sol_log_site __sol_log_st;                   \
+                static const __sol_log_desc __sol_log_dsc = {         \
+                        (lvl),                                        \
+                        sol_env_line(),                               \
+                        sol_env_func(),                               \
+                        sol_env_file(),                               \
+                        &__sol_log_st                                 \
+                };                                                    \
+                if (__atomic_load_n(&__sol_log_lvl, __ATOMIC_RELAXED) \
+                    <= (lvl)) {                                       \
+                        write(&__sol_log_dsc, __VA_ARGS__);           \
+                }                                                     \
+        } while (0)
+
+
+
+
+/*
+ *      __sol_log_lvl - runtime log level
+ *
+ *      The __sol_log_lvl global variable is **not** a part of the interface of
+ *      the logging module, and must **not** be accessed directly. It holds the
+ *      log level set by sol_log_level_set(), and has been declared in this file
+ *      so that the logging macros defined above can test it inline with a
+ *      single relaxed load.
+ */
+extern int __sol_log_lvl;
 
 
 
@@ -214,17 +825,67 @@ extern void sol_log_close(void);
  *      logging module, and must **not** be called directly. This function is a
  *      utility function that helps in writing log entries to the log file, and
  *      has been declared in this file so that it can be called by the logging
- *      macros defined above.
+ *      macros defined above with the descriptor @desc of their call site.
  */
-extern void __sol_log_write(const char *type,
-                            const char *func,
-                            const char *file,
-                            int line,
+extern void __sol_log_write(const __sol_log_desc *desc,
                             const char *msg);
 
 
 
 
+/*
+ *      __sol_log_writef() - writes a formatted log entry
+ *
+ *      The __sol_log_writef() function is **not** a part of the interface of
+ *      the logging module, and must **not** be called directly. This function
+ *      formats a message from @fmt and its arguments into a buffer of the
+ *      calling thread, and writes it out through __sol_log_write(); nothing is
+ *      formatted if no log file is open.
+ *
+ *      The formatter is purpose-built, and bypasses vfprintf() and the locale.
+ *      It accepts the conversions of printf() with their flags, widths,
+ *      precisions and length modifiers, except that %n writes nothing and %a
+ *      is printed as %e. Floating point values are printed with the 17 digits
+ *      held by sol_f64, so their last digits may differ from those printed by
+ *      printf(), and their precision is capped to 40. The formatted message is
+ *      truncated to 1023 bytes.
+ */
+extern void __sol_log_writef(const __sol_log_desc *desc,
+                             const char *fmt,
+                             ...) sol_format(2, 3);
+
+
+
+
+/*
+ *      __sol_log_nop() - checks arguments of a filtered log entry
+ *
+ *      The __sol_log_nop() function is **not** a part of the interface of the
+ *      logging module, and must **not** be called directly. It is declared but
+ *      never defined, and appears only as the unevaluated operand of sizeof in
+ *      the formatted logging macros that SOL_LOG_LEVEL removes, so that their
+ *      arguments are still checked against the format string.
+ */
+extern int __sol_log_nop(const char *fmt,
+                         ...) sol_format(1, 2);
+
+
+
+
+/*
+ *      __sol_log_limit_win() - sets length of rate limit seconds
+ *        - win: length in nanoseconds of each second counted by rate limits
+ *
+ *      The __sol_log_limit_win() function is **not** a part of the interface
+ *      of the logging module, and must **not** be called directly. It lets the
+ *      unit tests of sol_log_limit_set() end a second of a call site without
+ *      waiting for it to pass; @win is one second by default.
+ */
+extern void __sol_log_limit_win(sol_w64 win);
+
+
+
+
 #endif /* !defined __SOL_LOGGING_MODULE */
 
 
@@ -0,0 +1,166 @@
+/******************************************************************************
+ *                           SOL LIBRARY v0.1.0+41
+ *
+ * File: sol/inc/mem.h
+ *
+ * Description:
+ *      This file is part of the API of the Sol Library. It declares the
+ *      interface of the memory kernels module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* create header guard */
+#if (!defined __SOL_MEMORY_KERNELS_MODULE)
+#define __SOL_MEMORY_KERNELS_MODULE
+
+
+
+
+        /* include required header files */
+#include "./prim.h"
+#include "./ptr.h"
+
+
+
+
+/*
+ *      SOL_MEM_KERNEL - enumerates memory kernel sets
+ *        - SOL_MEM_KERNEL_WORD: portable word-wise kernels
+ *        - SOL_MEM_KERNEL_SSE2: 128-bit x86 SSE2 kernels
+ *        - SOL_MEM_KERNEL_AVX2: 256-bit x86 AVX2 kernels
+ *        - SOL_MEM_KERNEL_NEON: 128-bit ARM NEON kernels
+ *
+ *      The SOL_MEM_KERNEL type enumerates the kernel sets that may back the
+ *      interface functions of this module. The SSE2 and NEON kernels are
+ *      selected at compile-time if the target supports them, and the AVX2
+ *      kernels are selected at load-time if the host processor supports them;
+ *      the word-wise kernels are used in all other cases.
+ */
+#define SOL_MEM_KERNEL int
+#define SOL_MEM_KERNEL_WORD (0)
+#define SOL_MEM_KERNEL_SSE2 (1)
+#define SOL_MEM_KERNEL_AVX2 (2)
+#define SOL_MEM_KERNEL_NEON (3)
+
+
+
+
+/*
+ *      sol_mem_kernel() - determines active memory kernel set
+ *
+ *      The sol_mem_kernel() interface function returns the kernel set that has
+ *      been selected to back the memory kernels of this module. This is mainly
+ *      useful for diagnostics and benchmarking.
+ *
+ *      Return:
+ *        - one of the constants enumerated by SOL_MEM_KERNEL
+ */
+extern SOL_MEM_KERNEL sol_mem_kernel(void);
+
+
+
+
+/*
+ *      sol_mem_copy() - copies a buffer
+ *        - dst: destination buffer
+ *        - src: source buffer
+ *        - len: length in bytes to copy
+ *
+ *      The sol_mem_copy() interface function copies @len bytes from the buffer
+ *      @src on to the buffer @dst using the widest kernel available. @dst and
+ *      @src must not overlap; sol_mem_move() should be used instead if they do.
+ *
+ *      This function lies on the hot path, and so does not throw exceptions. A
+ *      safe no-op occurs if either @dst or @src is null, or if @len is zero.
+ */
+extern void sol_mem_copy(sol_ptr *dst,
+                         const sol_ptr *src,
+                         sol_size len);
+
+
+
+
+/*
+ *      sol_mem_move() - moves a buffer
+ *        - dst: destination buffer
+ *        - src: source buffer
+ *        - len: length in bytes to move
+ *
+ *      The sol_mem_move() interface function copies @len bytes from the buffer
+ *      @src on to the buffer @dst, correctly handling the case where @dst and
+ *      @src overlap. A safe no-op occurs if either @dst or @src is null, or if
+ *      @len is zero.
+ */
+extern void sol_mem_move(sol_ptr *dst,
+                         const sol_ptr *src,
+                         sol_size len);
+
+
+
+
+/*
+ *      sol_mem_set() - fills a buffer
+ *        - dst: destination buffer
+ *        - val: byte value to fill with
+ *        - len: length in bytes to fill
+ *
+ *      The sol_mem_set() interface function fills the first @len bytes of the
+ *      buffer @dst with the byte value @val. A safe no-op occurs if @dst is
+ *      null or if @len is zero.
+ */
+extern void sol_mem_set(sol_ptr *dst,
+                        sol_w8 val,
+                        sol_size len);
+
+
+
+
+/*
+ *      sol_mem_cmp() - compares two buffers
+ *        - lhs: left hand side buffer
+ *        - rhs: right hand side buffer
+ *        - len: length in bytes to compare
+ *
+ *      The sol_mem_cmp() interface function lexicographically compares the
+ *      first @len bytes of the buffers @lhs and @rhs, treating each byte as an
+ *      unsigned value. Null buffers, or a zero @len, compare as equal.
+ *
+ *      Return:
+ *        - 0 if @lhs and @rhs are equal
+ *        - < 0 if @lhs is less than @rhs
+ *        - > 0 if @lhs is greater than @rhs
+ */
+extern int sol_mem_cmp(const sol_ptr *lhs,
+                       const sol_ptr *rhs,
+                       sol_size len);
+
+
+
+
+#endif /* !defined __SOL_MEMORY_KERNELS_MODULE */
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
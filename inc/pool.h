@@ -0,0 +1,230 @@
+/******************************************************************************
+ *                           SOL LIBRARY v0.1.0+41
+ *
+ * File: sol/inc/pool.h
+ *
+ * Description:
+ *      This file is part of the API of the Sol Library. It declares the
+ *      interface of the object pool module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* create header guard */
+#if (!defined __SOL_OBJECT_POOL_MODULE)
+#define __SOL_OBJECT_POOL_MODULE
+
+
+
+
+        /* include required header files */
+#include "./error.h"
+#include "./prim.h"
+#include "./ptr.h"
+
+
+
+
+/*
+ *      sol_pool - fixed-size object pool
+ *
+ *      The sol_pool type abstracts a pool of equal-sized slots from which
+ *      objects can be allocated and freed in constant time. Slots are reserved
+ *      in slabs obtained through sol_ptr_new(), and freed slots are kept on an
+ *      intrusive free list threaded through the slots themselves, so that no
+ *      bookkeeping memory is needed beyond the slabs.
+ *
+ *      Although the sol_pool type is defined as a transparent type so that it
+ *      can be declared on the stack, it should be treated as an opaque type,
+ *      and used only through its interface functions declared below.
+ */
+typedef struct __sol_pool {
+        sol_ptr *free;
+        sol_ptr *slab;
+        sol_w8 *top;
+        sol_w8 *end;
+        sol_size sz;
+        sol_size nslot;
+        sol_size cap;
+        sol_size used;
+        sol_size peak;
+} sol_pool;
+
+
+
+
+/*
+ *      sol_pool_init() - initialises an object pool
+ *        - pool: contextual pool
+ *        - sz: size in bytes of each slot
+ *        - nslot: number of slots per slab
+ *
+ *      The sol_pool_init() interface function initialises an object pool @pool
+ *      with slots of @sz bytes, and reserves the first slab of @nslot slots.
+ *      Slots are aligned suitably for any object type. This function **must**
+ *      be called before any of the other interface functions are called on
+ *      @pool.
+ *
+ *      @pool is required to be a valid pointer, and both @sz and @nslot are
+ *      required to be greater than zero; an appropriate exception is thrown if
+ *      any of these conditions is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_pool_init(sol_pool *pool,
+                              sol_size sz,
+                              sol_size nslot);
+
+
+
+
+/*
+ *      sol_pool_term() - terminates an object pool
+ *        - pool: contextual pool
+ *
+ *      The sol_pool_term() interface function releases all the slabs of an
+ *      object pool @pool back to the heap through sol_ptr_free(). All objects
+ *      allocated from @pool become invalid after this call. A safe no-op
+ *      occurs if @pool is null.
+ */
+extern void sol_pool_term(sol_pool *pool);
+
+
+
+
+/*
+ *      sol_pool_alloc() - allocates an object from a pool
+ *        - pool: contextual pool
+ *        - ptr: contextual pointer instance
+ *
+ *      The sol_pool_alloc() interface function allocates a slot from an object
+ *      pool @pool and assigns it to @ptr. A slot is taken from the free list if
+ *      one is available, or else carved from the current slab; a new slab is
+ *      reserved through sol_ptr_new() only when the current one is exhausted.
+ *
+ *      @pool and @ptr are required to be valid pointers, and just as in the
+ *      case of sol_ptr_new(), @ptr must point to a null pointer. An appropriate
+ *      exception is thrown if either of these conditions is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_pool_alloc(sol_pool *pool,
+                               sol_ptr **ptr);
+
+
+
+
+/*
+ *      sol_pool_free() - returns an object to a pool
+ *        - pool: contextual pool
+ *        - ptr: contextual pointer instance
+ *
+ *      The sol_pool_free() interface function returns the slot pointed to by
+ *      @ptr to the free list of the object pool @pool from which it was
+ *      allocated. @ptr is guaranteed to be null after this operation. The slot
+ *      is **not** validated against @pool; freeing a slot to a pool other than
+ *      the one it was allocated from results in undefined behaviour.
+ *
+ *      @pool and @ptr are expected to be valid, and @ptr is expected to point
+ *      to a non-null pointer, but in case these conditions are not met, then
+ *      a safe no-op occurs.
+ */
+extern void sol_pool_free(sol_pool *pool,
+                          sol_ptr **ptr);
+
+
+
+
+/*
+ *      sol_pool_cap() - capacity of an object pool
+ *        - pool: contextual pool
+ *        - cap: count of slots reserved
+ *
+ *      The sol_pool_cap() interface function returns the total number of slots
+ *      @cap that have been reserved by an object pool @pool across all its
+ *      slabs. Both @pool and @cap are required to be valid pointers, or else an
+ *      exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_pool_cap(const sol_pool *pool,
+                             sol_size *cap);
+
+
+
+
+/*
+ *      sol_pool_used() - count of objects in use
+ *        - pool: contextual pool
+ *        - used: count of slots in use
+ *
+ *      The sol_pool_used() interface function returns the number of slots
+ *      @used of an object pool @pool that are currently allocated. Both @pool
+ *      and @used are required to be valid pointers, or else an exception is
+ *      thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_pool_used(const sol_pool *pool,
+                              sol_size *used);
+
+
+
+
+/*
+ *      sol_pool_peak() - high-water mark of objects in use
+ *        - pool: contextual pool
+ *        - peak: highest count of slots in use
+ *
+ *      The sol_pool_peak() interface function returns the highest number of
+ *      slots @peak of an object pool @pool that have been simultaneously in use
+ *      since it was initialised. Both @pool and @peak are required to be valid
+ *      pointers, or else an exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_pool_peak(const sol_pool *pool,
+                              sol_size *peak);
+
+
+
+
+#endif /* !defined __SOL_OBJECT_POOL_MODULE */
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
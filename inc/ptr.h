@@ -99,6 +99,200 @@ extern sol_erno sol_ptr_new(sol_ptr **ptr,
 
 
 
+/*
+ *      SOL_PTR_MMAP_MIN - minimum size of mapped aligned buffers
+ *
+ *      The SOL_PTR_MMAP_MIN symbolic constant sets the size in bytes from which
+ *      sol_ptr_new_aligned() obtains buffers aligned to no more than a page
+ *      directly from the virtual memory system through mmap() in hosted
+ *      environments, rather than from the heap. Client code may define this
+ *      constant at compile-time to override the default of 1 MiB.
+ */
+#if (!defined SOL_PTR_MMAP_MIN)
+#       define SOL_PTR_MMAP_MIN (1024 * 1024)
+#endif
+
+
+
+
+/*
+ *      sol_ptr_new_aligned() - initialises a new aligned generic pointer
+ *        - ptr: contextual pointer instance
+ *        - sz: size in bytes of pointer buffer
+ *        - align: alignment in bytes of pointer buffer
+ *
+ *      The sol_ptr_new_aligned() interface function creates a new instance of
+ *      a generic pointer @ptr with a buffer of size @sz bytes aligned to @align
+ *      bytes, such as the 64 or 128 byte cache line alignment needed by SIMD
+ *      kernels, or the page alignment needed by direct I/O. In hosted
+ *      environments, buffers of at least SOL_PTR_MMAP_MIN bytes aligned to no
+ *      more than a page are mapped directly through mmap(), and smaller buffers
+ *      are obtained through posix_memalign(). In freestanding environments,
+ *      this function uses an externally defined aligned_alloc() function if
+ *      SOL_LIBC_ALIGNED_ALLOC_DEFINED is defined, and falls back to malloc()
+ *      otherwise, in which case @align can be no more than twice the size of a
+ *      pointer.
+ *
+ *      If an allocator has been set through sol_ptr_allocator_global() or
+ *      sol_ptr_allocator_local(), then heap buffers are obtained from it, and
+ *      @align can be no more than twice the size of a pointer.
+ *
+ *      @ptr must be a valid pointer to a **null** pointer. @sz must be greater
+ *      than zero, and @align must be a power of two. An appropriate exception
+ *      is thrown if any of these conditions is not met. The buffer of @ptr must
+ *      be released with sol_ptr_free(); it must **not** be passed to either
+ *      sol_ptr_resize() or sol_ptr_free_sized().
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size or alignment has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ *        - SOL_ERNO_STATE if @align is too large for the allocator in effect
+ */
+extern sol_erno sol_ptr_new_aligned(sol_ptr **ptr,
+                                    sol_size sz,
+                                    sol_size align);
+
+
+
+
+/*
+ *      sol_ptr_new_huge() - initialises a new huge page backed generic pointer
+ *        - ptr: contextual pointer instance
+ *        - sz: size in bytes of pointer buffer
+ *
+ *      The sol_ptr_new_huge() interface function creates a new instance of a
+ *      generic pointer @ptr with a buffer of size @sz bytes that is mapped
+ *      through mmap() on a 2 MiB boundary, and is advised through madvise() to
+ *      be backed by transparent huge pages where the host supports them. This
+ *      reduces TLB misses for large, randomly accessed buffers such as the
+ *      chunks of big arenas. The buffer is rounded up to a multiple of 2 MiB,
+ *      so this function is best suited to buffers of at least that size. In
+ *      freestanding environments, this function behaves like sol_ptr_new().
+ *
+ *      @ptr must be a valid pointer to a **null** pointer, and @sz must be
+ *      greater than zero. An appropriate exception is thrown if either of these
+ *      conditions is not met. Just as in the case of sol_ptr_new_aligned(),
+ *      the buffer of @ptr must be released only with sol_ptr_free().
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_ptr_new_huge(sol_ptr **ptr,
+                                 sol_size sz);
+
+
+
+
+/*
+ *      sol_ptr_new_mirror() - initialises a new mirrored generic pointer
+ *        - ptr: contextual pointer instance
+ *        - sz: size in bytes of pointer buffer
+ *
+ *      The sol_ptr_new_mirror() interface function creates a new instance of a
+ *      generic pointer @ptr with a buffer of at least @sz bytes whose pages are
+ *      mapped twice, back to back, in the address space, so that the byte at
+ *      offset i + @sz aliases the byte at offset i. This lets ring buffers read
+ *      and write records that wrap around their end with a single contiguous
+ *      copy. The buffer is rounded up to a whole number of pages, and the
+ *      rounded size is written back to @sz; 2 * @sz bytes are addressable from
+ *      @ptr.
+ *
+ *      Mirroring is available only in hosted environments that support
+ *      memfd_create(), such as Linux and Android; elsewhere this function
+ *      throws SOL_ERNO_STATE, and callers are expected to fall back to a buffer
+ *      obtained through sol_ptr_new(), splitting copies at its end.
+ *
+ *      @ptr must be a valid pointer to a **null** pointer, @sz must be a valid
+ *      pointer, and *@sz must be greater than zero. An appropriate exception is
+ *      thrown if any of these conditions is not met. Just as in the case of
+ *      sol_ptr_new_aligned(), the buffer of @ptr must be released only with
+ *      sol_ptr_free().
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ *        - SOL_ERNO_HEAP if the buffer could not be mapped
+ *        - SOL_ERNO_STATE if mirroring is not supported by the host
+ */
+extern sol_erno sol_ptr_new_mirror(sol_ptr **ptr,
+                                   sol_size *sz);
+
+
+
+
+/*
+ *      sol_ptr_new_n() - initialises several generic pointers in one block
+ *        - ptr: array of contextual pointer instances
+ *        - sz: array of sizes in bytes of pointer buffers
+ *        - n: number of pointers in @ptr and sizes in @sz
+ *
+ *      The sol_ptr_new_n() interface function creates @n new instances of
+ *      generic pointers @ptr[i] with buffers of @sz[i] bytes, carved from a
+ *      single heap memory block so that the whole batch costs one allocation.
+ *      Each buffer is aligned suitably for any object type, and the buffers
+ *      are laid out in order, which suits building trees and lists of small
+ *      nodes that live and die together. The preconditions of every pointer
+ *      are checked once, up front, and nothing is allocated if any of them
+ *      fails.
+ *
+ *      The buffers share a single block, so they must be released together
+ *      through sol_ptr_free_n(); none of them may be passed to sol_ptr_free(),
+ *      sol_ptr_free_sized() or sol_ptr_resize(). Buffers that need to be freed
+ *      individually should be obtained through sol_ptr_new_n2() instead.
+ *
+ *      @ptr and @sz must be valid pointers, every @ptr[i] must be a **null**
+ *      pointer, @n must be greater than zero, and every @sz[i] must be greater
+ *      than zero. An appropriate exception is thrown if any of these
+ *      conditions is not met, in which case @ptr is left unchanged.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size or count has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_ptr_new_n(sol_ptr **ptr,
+                              const sol_size *sz,
+                              sol_size n);
+
+
+
+
+/*
+ *      sol_ptr_new_n2() - initialises several independent generic pointers
+ *        - ptr: array of contextual pointer instances
+ *        - sz: array of sizes in bytes of pointer buffers
+ *        - n: number of pointers in @ptr and sizes in @sz
+ *
+ *      The sol_ptr_new_n2() interface function is similar to sol_ptr_new_n(),
+ *      except that each buffer is a separate heap allocation, served from the
+ *      size classes of the thread-caching front-end if SOL_PTR_TCACHE is
+ *      defined. The batch still pays for its precondition checks and error
+ *      handling only once, but its buffers may be released individually
+ *      through sol_ptr_free() or sol_ptr_free_sized(), resized through
+ *      sol_ptr_resize(), or released together through sol_ptr_free_n2(). If
+ *      heap memory runs out part way, then the buffers already allocated are
+ *      released, and @ptr is left unchanged.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size or count has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_ptr_new_n2(sol_ptr **ptr,
+                               const sol_size *sz,
+                               sol_size n);
+
+
+
+
 /*
  *      sol_ptr_copy() - copies an existing generic pointer
  *        - ptr: contextual pointer instance
@@ -134,13 +328,76 @@ extern sol_erno sol_ptr_copy(sol_ptr **ptr,
 
 
 
+/*
+ *      sol_ptr_resize() - resizes an existing generic pointer
+ *        - ptr: contextual pointer instance
+ *        - sz: new size in bytes of pointer buffer
+ *
+ *      The sol_ptr_resize() interface function resizes the heap memory buffer
+ *      of a generic pointer @ptr, previously allocated by sol_ptr_new() or
+ *      sol_ptr_copy(), to @sz bytes. The contents of @ptr are preserved up to
+ *      the lesser of the old and new sizes; the buffer is grown in place where
+ *      the heap allows, and is moved otherwise, so @ptr may change. This
+ *      function requires an externally defined realloc() function to be
+ *      present in freestanding environments; in hosted environments, it
+ *      automatically uses the realloc() supplied by the standard library.
+ *
+ *      @ptr must be a valid pointer to a **non-null** pointer, and @sz must be
+ *      greater than zero. An appropriate exception is thrown if either of these
+ *      conditions is not met. @ptr is left unchanged if an exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_ptr_resize(sol_ptr **ptr,
+                               sol_size sz);
+
+
+
+
+/*
+ *      sol_ptr_reserve() - reserves capacity in a growing generic pointer
+ *        - ptr: contextual pointer instance
+ *        - cap: current capacity in bytes of pointer buffer
+ *        - need: required capacity in bytes of pointer buffer
+ *
+ *      The sol_ptr_reserve() interface function ensures that a generic pointer
+ *      @ptr with a buffer of @cap bytes can hold at least @need bytes, and is
+ *      intended for buffers that are repeatedly appended to. If @need exceeds
+ *      @cap, then @ptr is resized through sol_ptr_resize() to the greater of
+ *      @need and one and a half times @cap (with a floor of 64 bytes), and @cap
+ *      is updated to the new capacity; otherwise this function does nothing.
+ *      This geometric growth policy amortises the cost of resizing to a
+ *      constant per appended byte.
+ *
+ *      @ptr and @cap are required to be valid pointers. @ptr may point to a
+ *      null pointer, in which case @cap must be zero and the buffer is freshly
+ *      allocated. An appropriate exception is thrown if these conditions are
+ *      not met, and @ptr and @cap are left unchanged.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_ptr_reserve(sol_ptr **ptr,
+                                sol_size *cap,
+                                sol_size need);
+
+
+
+
 /*
  *      sol_ptr_free() - frees an existing generic pointer
  *        - ptr: contextual pointer instance
  *
  *      The sol_ptr_free() interface function frees a generic pointer @ptr by
- *      releasing the heap memory allocated to it by a previous call to either
- *      sol_ptr_new() or sol_ptr_copy(). This function requires an externally
+ *      releasing the heap memory allocated to it by a previous call to any of
+ *      the allocating functions declared above; buffers mapped by the virtual
+ *      memory system are unmapped. This function requires an externally
  *      defined free() function to be present in freestanding environments, and
  *      automatically uses the free() function provided by the standard library
  *      in hosted environments. @ptr is guaranteed to be null after this
@@ -154,6 +411,396 @@ extern void sol_ptr_free(sol_ptr **ptr);
 
 
 
+/*
+ *      sol_ptr_free_sized() - frees an existing generic pointer of known size
+ *        - ptr: contextual pointer instance
+ *        - sz: size in bytes of pointer buffer
+ *
+ *      The sol_ptr_free_sized() interface function is the sized form of the
+ *      sol_ptr_free() function declared above, and behaves identically to it.
+ *      @sz must be the size that was passed to sol_ptr_new(), sol_ptr_copy()
+ *      or the last call to sol_ptr_resize() for @ptr; this allows the
+ *      thread-caching front-end (see SOL_PTR_TCACHE below) to find the size
+ *      class of @ptr without having to look it up. Passing any other size
+ *      results in undefined behaviour.
+ */
+extern void sol_ptr_free_sized(sol_ptr **ptr,
+                               sol_size sz);
+
+
+
+
+/*
+ *      sol_ptr_free_n() - frees generic pointers allocated in one block
+ *        - ptr: array of contextual pointer instances
+ *        - n: number of pointers in @ptr
+ *
+ *      The sol_ptr_free_n() interface function releases the heap memory block
+ *      shared by the @n generic pointers @ptr[i] that were allocated together
+ *      through sol_ptr_new_n(). @n must be the count that was passed to
+ *      sol_ptr_new_n(). Every @ptr[i] is guaranteed to be null after this
+ *      operation. A safe no-op occurs if @ptr is null, or if @ptr[0] is null.
+ */
+extern void sol_ptr_free_n(sol_ptr **ptr,
+                           sol_size n);
+
+
+
+
+/*
+ *      sol_ptr_free_n2() - frees several independent generic pointers
+ *        - ptr: array of contextual pointer instances
+ *        - sz: array of sizes in bytes of pointer buffers
+ *        - n: number of pointers in @ptr and sizes in @sz
+ *
+ *      The sol_ptr_free_n2() interface function releases the @n generic
+ *      pointers @ptr[i] through sol_ptr_free_sized(), and so @sz[i] must be the
+ *      current size of each buffer, or through sol_ptr_free() if @sz is null.
+ *      It is the batch counterpart of sol_ptr_new_n2(), but may be used with
+ *      any pointers obtained through sol_ptr_new(). Every @ptr[i] is
+ *      guaranteed to be null after this operation. Null @ptr[i] are skipped,
+ *      and a safe no-op occurs if @ptr is null.
+ */
+extern void sol_ptr_free_n2(sol_ptr **ptr,
+                            const sol_size *sz,
+                            sol_size n);
+
+
+
+
+/*
+ *      sol_allocator - pluggable allocator
+ *        - alloc: allocates @sz bytes
+ *        - realloc: resizes @ptr to @sz bytes
+ *        - free: frees @ptr
+ *        - ctx: user context passed to each of the above
+ *
+ *      The sol_allocator type is a table of callbacks through which the pointer
+ *      module obtains and releases heap memory in place of malloc(), realloc()
+ *      and free(). This allows client code to route the heap memory of a given
+ *      subsystem, such as the slabs of a sol_pool, to an allocator of its own.
+ *      The callbacks follow the contract of their standard library namesakes,
+ *      returning a null pointer on failure; @alloc must return buffers aligned
+ *      suitably for any object type.
+ *
+ *      An allocator can be put into effect for the calling thread alone with
+ *      sol_ptr_allocator_local(), or for all threads that have not set their
+ *      own with sol_ptr_allocator_global(). A buffer must be resized and freed
+ *      while the allocator that allocated it is in effect. When no allocator
+ *      has been set, the pointer module calls the heap directly without going
+ *      through a table.
+ */
+typedef struct __sol_allocator {
+        sol_ptr *(*alloc)(sol_ptr *ctx, sol_size sz);
+        sol_ptr *(*realloc)(sol_ptr *ctx, sol_ptr *ptr, sol_size sz);
+        void (*free)(sol_ptr *ctx, sol_ptr *ptr);
+        sol_ptr *ctx;
+} sol_allocator;
+
+
+
+
+/*
+ *      sol_ptr_allocator_global() - sets the global allocator
+ *        - alloc: allocator to set, or null for the default allocator
+ *
+ *      The sol_ptr_allocator_global() interface function puts the allocator
+ *      @alloc into effect for all threads that have not set an allocator of
+ *      their own through sol_ptr_allocator_local(). The table pointed to by
+ *      @alloc is not copied, and must remain valid for as long as it is in
+ *      effect. Passing a null pointer restores the default allocator.
+ *
+ *      If @alloc is not null, then all its callbacks are required to be
+ *      valid; an exception is thrown if this condition is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_ptr_allocator_global(const sol_allocator *alloc);
+
+
+
+
+/*
+ *      sol_ptr_allocator_local() - sets the allocator of the calling thread
+ *        - alloc: allocator to set, or null to defer to the global allocator
+ *
+ *      The sol_ptr_allocator_local() interface function puts the allocator
+ *      @alloc into effect for the calling thread only, taking precedence over
+ *      the global allocator. Just as in the case of sol_ptr_allocator_global(),
+ *      the table pointed to by @alloc is not copied. Passing a null pointer
+ *      makes the calling thread defer to the global allocator again.
+ *
+ *      If @alloc is not null, then all its callbacks are required to be
+ *      valid; an exception is thrown if this condition is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_ptr_allocator_local(const sol_allocator *alloc);
+
+
+
+
+/*
+ *      sol_ptr_allocator() - gets the allocator in effect
+ *        - alloc: allocator in effect for the calling thread
+ *
+ *      The sol_ptr_allocator() interface function returns the allocator @alloc
+ *      in effect for the calling thread; @alloc is null if the default
+ *      allocator is in effect. This is useful to save and later restore the
+ *      allocator around a subsystem. @alloc is required to be a valid pointer,
+ *      or else an exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_ptr_allocator(const sol_allocator **alloc);
+
+
+
+
+/*
+ *      SOL_PTR_PROFILE - allocation profiler
+ *
+ *      The SOL_PTR_PROFILE symbolic constant, if defined by client code at
+ *      compile-time, enables an allocation profiler for the heap memory of the
+ *      pointer module. The allocating interface functions declared above are
+ *      then wrapped by macros that capture their call sites through
+ *      sol_env_func(), sol_env_file() and sol_env_line(), and each call site
+ *      accumulates counts of allocations and frees, bytes allocated and freed,
+ *      and a histogram of allocation sizes in tables private to each thread
+ *      so that no locks are taken. A resize is counted as a free of the old
+ *      buffer followed by an allocation of the new one at the resizing call
+ *      site. Buffers mapped by sol_ptr_new_aligned(), sol_ptr_new_huge() and
+ *      sol_ptr_new_mirror() are not profiled.
+ *
+ *      Each profiled buffer carries a small hidden header, so the whole library
+ *      and all client code must be compiled with the same setting of
+ *      SOL_PTR_PROFILE. When SOL_PTR_PROFILE is not defined, the profiler is
+ *      compiled out entirely, and the profiler interface functions declared
+ *      below throw SOL_ERNO_STATE.
+ */
+
+
+
+
+/*
+ *      sol_ptr_prof_live() - gets profiled live bytes
+ *        - live: bytes currently allocated
+ *
+ *      The sol_ptr_prof_live() interface function returns the number of bytes
+ *      @live currently allocated across all threads by the pointer module, as
+ *      recorded by the allocation profiler. @live is required to be a valid
+ *      pointer, or else an exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_STATE if the profiler has been compiled out
+ */
+extern sol_erno sol_ptr_prof_live(sol_size *live);
+
+
+
+
+/*
+ *      sol_ptr_prof_peak() - gets profiled high-water mark
+ *        - peak: highest number of bytes allocated
+ *
+ *      The sol_ptr_prof_peak() interface function returns the highest number of
+ *      bytes @peak that have been simultaneously allocated across all threads
+ *      by the pointer module, as recorded by the allocation profiler. @peak is
+ *      required to be a valid pointer, or else an exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_STATE if the profiler has been compiled out
+ */
+extern sol_erno sol_ptr_prof_peak(sol_size *peak);
+
+
+
+
+/*
+ *      sol_ptr_prof_report() - writes allocation profile
+ *        - path: path to report file
+ *
+ *      The sol_ptr_prof_report() interface function writes a report of the
+ *      allocation profile to the file at @path, overwriting it if it exists.
+ *      The report lists each call site with its counts, bytes and live bytes
+ *      summed across all threads, sorted by descending live bytes and then by
+ *      descending bytes allocated, followed by its size histogram. Counters of
+ *      threads that are still allocating are read without synchronisation, so
+ *      the report is a close but not necessarily exact snapshot.
+ *
+ *      @path is required to be a valid string; an exception is thrown if this
+ *      condition is not met, or if the report file can't be written.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_STR if an invalid string has been passed
+ *        - SOL_ERNO_FILE if the report file can't be written
+ *        - SOL_ERNO_STATE if the profiler has been compiled out
+ */
+extern sol_erno sol_ptr_prof_report(const char *path);
+
+
+
+
+/*
+ *      __sol_ptr_prof_site() - sets call site of next allocation
+ *      __sol_ptr_prof_resite() - sets call site of next allocation by id
+ *      __sol_ptr_prof_unsite() - resets call site of next allocation
+ *      __sol_ptr_prof_alloc() - records an allocation
+ *      __sol_ptr_prof_free() - records a free
+ *
+ *      These functions are **not** a part of the interface of the pointer
+ *      module, and must **not** be called directly. They implement the
+ *      allocation profiler enabled by SOL_PTR_PROFILE, and have been declared
+ *      in this file so that they can be called by the pointer module and by the
+ *      call site macros below. __sol_ptr_prof_alloc() returns the identifier of
+ *      the call site set by __sol_ptr_prof_site(), which is then reset;
+ *      __sol_ptr_prof_resite() restores such an identifier, so that batches of
+ *      allocations are attributed to a single call site. Since a call that
+ *      fails, or that returns a mapped buffer, never reaches
+ *      __sol_ptr_prof_alloc(), __sol_ptr_prof_unsite() resets the call site
+ *      after each call, passing @erno through, so that the call site isn't
+ *      charged with the next allocation of the thread.
+ */
+#if (defined SOL_PTR_PROFILE)
+extern void __sol_ptr_prof_site(const char *func,
+                                const char *file,
+                                int line);
+extern void __sol_ptr_prof_resite(sol_w32 site);
+extern sol_erno __sol_ptr_prof_unsite(sol_erno erno);
+extern sol_w32 __sol_ptr_prof_alloc(sol_size sz);
+extern void __sol_ptr_prof_free(sol_w32 site,
+                                sol_size sz);
+#endif
+
+
+
+
+/*
+ *      call site macros
+ *
+ *      These macros shadow the allocating interface functions declared above
+ *      when SOL_PTR_PROFILE is defined, recording the call site before calling
+ *      through to the function of the same name and resetting it once that
+ *      function returns. They are not defined for the translation units of the
+ *      pointer module itself, which define __SOL_POINTER_SOURCE.
+ */
+#if (defined SOL_PTR_PROFILE && !defined __SOL_POINTER_SOURCE)
+#       define __sol_ptr_prof_here()                                        \
+                __sol_ptr_prof_site(sol_env_func(), sol_env_file(),         \
+                                    sol_env_line())
+#       define sol_ptr_new(ptr, sz)                                         \
+                (__sol_ptr_prof_here(),                                     \
+                 __sol_ptr_prof_unsite(sol_ptr_new(ptr, sz)))
+#       define sol_ptr_new_aligned(ptr, sz, align)                          \
+                (__sol_ptr_prof_here(),                                     \
+                 __sol_ptr_prof_unsite(sol_ptr_new_aligned(ptr, sz, align)))
+#       define sol_ptr_new_huge(ptr, sz)                                    \
+                (__sol_ptr_prof_here(),                                     \
+                 __sol_ptr_prof_unsite(sol_ptr_new_huge(ptr, sz)))
+#       define sol_ptr_new_n(ptr, sz, n)                                    \
+                (__sol_ptr_prof_here(),                                     \
+                 __sol_ptr_prof_unsite(sol_ptr_new_n(ptr, sz, n)))
+#       define sol_ptr_new_n2(ptr, sz, n)                                   \
+                (__sol_ptr_prof_here(),                                     \
+                 __sol_ptr_prof_unsite(sol_ptr_new_n2(ptr, sz, n)))
+#       define sol_ptr_copy(ptr, src, len)                                  \
+                (__sol_ptr_prof_here(),                                     \
+                 __sol_ptr_prof_unsite(sol_ptr_copy(ptr, src, len)))
+#       define sol_ptr_resize(ptr, sz)                                      \
+                (__sol_ptr_prof_here(),                                     \
+                 __sol_ptr_prof_unsite(sol_ptr_resize(ptr, sz)))
+#       define sol_ptr_reserve(ptr, cap, need)                              \
+                (__sol_ptr_prof_here(),                                     \
+                 __sol_ptr_prof_unsite(sol_ptr_reserve(ptr, cap, need)))
+#endif
+
+
+
+
+/*
+ *      __sol_ptr_map_new() - maps a buffer
+ *      __sol_ptr_map_mirror() - maps a buffer twice, back to back
+ *      __sol_ptr_map_free() - unmaps a buffer if it was mapped
+ *
+ *      These functions are **not** a part of the interface of the pointer
+ *      module, and must **not** be called directly. They implement the mapped
+ *      buffers of hosted environments, and have been declared in this file so
+ *      that they can be called by the pointer and ring buffer modules; the ring
+ *      buffer module probes for mirroring through __sol_ptr_map_mirror() so
+ *      that a host without it doesn't log an error. __sol_ptr_map_free()
+ *      returns SOL_BOOL_FALSE if @ptr was not mapped by __sol_ptr_map_new() or
+ *      __sol_ptr_map_mirror(). __sol_ptr_map_mirror() rounds @sz up to whole
+ *      pages on success, and sets it to zero if the host can't mirror buffers.
+ */
+#if (sol_env_host() != SOL_ENV_HOST_NONE)
+extern sol_ptr *__sol_ptr_map_new(sol_size sz,
+                                  SOL_BOOL huge);
+extern sol_ptr *__sol_ptr_map_mirror(sol_size *sz);
+extern SOL_BOOL __sol_ptr_map_free(sol_ptr *ptr);
+#endif
+
+
+
+
+/*
+ *      SOL_PTR_TCACHE - thread-caching front-end
+ *
+ *      The SOL_PTR_TCACHE symbolic constant, if defined by client code at
+ *      compile-time, enables a thread-caching front-end to the heap memory
+ *      used by sol_ptr_new(), sol_ptr_copy() and sol_ptr_free(). Small
+ *      buffers are served from sol_tls per-thread caches of size classes that
+ *      are refilled from and drained to a shared central list in batches, so
+ *      that worker threads rarely contend on the global malloc() lock; larger
+ *      buffers fall back to malloc() directly.
+ *
+ *      This front-end is available only in hosted environments that support
+ *      POSIX threads, and where sol_tls is effective. The whole library must be
+ *      compiled with the same setting of SOL_PTR_TCACHE.
+ */
+#if (defined SOL_PTR_TCACHE)
+#       if (sol_env_host() == SOL_ENV_HOST_NONE)
+#               error "[!] SOL_PTR_TCACHE not supported in freestanding hosts"
+#       endif
+
+
+
+
+/*
+ *      __sol_ptr_tcache_alloc() - allocates from thread cache
+ *      __sol_ptr_tcache_alloc_aligned() - allocates aligned via thread cache
+ *      __sol_ptr_tcache_realloc() - resizes through thread cache
+ *      __sol_ptr_tcache_free() - frees to thread cache
+ *      __sol_ptr_tcache_free_sized() - frees to thread cache by size
+ *
+ *      These functions are **not** a part of the interface of the pointer
+ *      module, and must **not** be called directly. They implement the
+ *      thread-caching front-end enabled by SOL_PTR_TCACHE, and have been
+ *      declared in this file so that they can be called by the pointer module.
+ */
+extern sol_ptr *__sol_ptr_tcache_alloc(sol_size sz);
+extern sol_ptr *__sol_ptr_tcache_alloc_aligned(sol_size sz,
+                                               sol_size align);
+extern sol_ptr *__sol_ptr_tcache_realloc(sol_ptr *ptr,
+                                         sol_size sz);
+extern void __sol_ptr_tcache_free(sol_ptr *ptr);
+extern void __sol_ptr_tcache_free_sized(sol_ptr *ptr,
+                                        sol_size sz);
+#endif /* defined SOL_PTR_TCACHE */
+
+
+
+
 #endif /* !defined __SOL_POINTER_MODULE */
 
 
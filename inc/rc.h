@@ -0,0 +1,295 @@
+/******************************************************************************
+ *                           SOL LIBRARY v0.1.0+41
+ *
+ * File: sol/inc/rc.h
+ *
+ * Description:
+ *      This file is part of the API of the Sol Library. It declares the
+ *      interface of the reference counted buffer module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* create header guard */
+#if (!defined __SOL_REFERENCE_COUNT_MODULE)
+#define __SOL_REFERENCE_COUNT_MODULE
+
+
+
+
+        /* include required header files */
+#include "./error.h"
+#include "./prim.h"
+#include "./ptr.h"
+
+
+
+
+/*
+ *      sol_rc - reference counted buffer
+ *
+ *      The sol_rc type is an abstract type representing a heap memory buffer
+ *      that is shared by several owners, and which is freed when the last of
+ *      them releases it. Like sol_ptr, this type can be declared only as a
+ *      pointer, and points directly to the payload of the buffer, so that a
+ *      sol_rc can be used wherever a buffer is expected.
+ *
+ *      The reference count and size of the buffer sit in a small header just
+ *      below the payload in the same allocation, obtained through
+ *      sol_ptr_new(). The header is aligned such that it never straddles a
+ *      cache line, and so retaining or releasing a buffer touches only one
+ *      cache line. A buffer is either non-atomic, in which case it must only
+ *      be retained and released by one thread at a time, or atomic, in which
+ *      case it may be retained and released concurrently by any thread.
+ *
+ *      Reference counted buffers also serve as copy-on-write duplicates: a
+ *      buffer obtained through sol_rc_copy2() is shared with its source until
+ *      it is first written to through sol_rc_write().
+ */
+typedef void sol_rc;
+
+
+
+
+/*
+ *      sol_rc_new() - creates a new reference counted buffer
+ *        - rc: contextual reference counted buffer
+ *        - sz: size in bytes of payload
+ *
+ *      The sol_rc_new() interface function creates a new non-atomic reference
+ *      counted buffer @rc with a payload of @sz bytes, and with a reference
+ *      count of one. The payload is aligned suitably for any object type, and
+ *      its contents are indeterminate.
+ *
+ *      @rc must be a valid pointer to a **null** pointer, and @sz must be
+ *      greater than zero; an appropriate exception is thrown if either of these
+ *      conditions is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_rc_new(sol_rc **rc,
+                           sol_size sz);
+
+
+
+
+/*
+ *      sol_rc_new2() - creates a new reference counted buffer
+ *        - rc: contextual reference counted buffer
+ *        - sz: size in bytes of payload
+ *        - atomic: flag to make reference count atomic
+ *
+ *      The sol_rc_new2() interface function is an overloaded form of the
+ *      sol_rc_new() function declared above. If @atomic is SOL_BOOL_TRUE, then
+ *      the reference count of @rc is updated atomically, so that @rc may be
+ *      shared across threads; otherwise, this function behaves exactly as
+ *      sol_rc_new().
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_rc_new2(sol_rc **rc,
+                            sol_size sz,
+                            SOL_BOOL atomic);
+
+
+
+
+/*
+ *      sol_rc_retain() - shares a reference counted buffer
+ *        - rc: contextual reference counted buffer
+ *        - src: reference counted buffer to share
+ *
+ *      The sol_rc_retain() interface function increments the reference count of
+ *      the buffer @src, and assigns @src to @rc as a new owner. The payload is
+ *      not copied; this replaces the use of sol_ptr_copy() to hand a buffer to
+ *      another stage of processing that needs to keep it.
+ *
+ *      @rc must be a valid pointer to a **null** pointer, and @src must be a
+ *      valid reference counted buffer; an exception is thrown if either of
+ *      these conditions is not met. An exception is also thrown if the
+ *      reference count of @src would overflow.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if the reference count would overflow
+ */
+extern sol_erno sol_rc_retain(sol_rc **rc,
+                              sol_rc *src);
+
+
+
+
+/*
+ *      sol_rc_release() - releases a reference counted buffer
+ *        - rc: contextual reference counted buffer
+ *
+ *      The sol_rc_release() interface function decrements the reference count
+ *      of the buffer @rc, and frees it through sol_ptr_free() if the count
+ *      falls to zero. @rc is guaranteed to be null after this operation,
+ *      thereby preventing the onset of dangling pointers.
+ *
+ *      @rc is expected to be a valid handle to a **non-null** pointer, but in
+ *      case this condition is not met, then a safe no-op occurs.
+ */
+extern void sol_rc_release(sol_rc **rc);
+
+
+
+
+/*
+ *      sol_rc_copy() - creates a reference counted copy of a buffer
+ *        - rc: contextual reference counted buffer
+ *        - src: buffer to copy
+ *        - len: length in bytes of @src
+ *
+ *      The sol_rc_copy() interface function is the reference counted
+ *      counterpart of sol_ptr_copy(). It creates @rc as a new non-atomic
+ *      reference counted buffer holding a copy of the first @len bytes of
+ *      @src, which may be any readable buffer. @src is always copied, even if
+ *      it happens to be a reference counted buffer; use sol_rc_copy2() to
+ *      share one instead. @rc must be released through sol_rc_release().
+ *
+ *      @rc must be a valid pointer to a **null** pointer, @src must be a valid
+ *      pointer, and @len must be greater than zero; an appropriate exception
+ *      is thrown if any of these conditions is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_rc_copy(sol_rc **rc,
+                            const sol_ptr *src,
+                            sol_size len);
+
+
+
+
+/*
+ *      sol_rc_copy2() - creates a copy-on-write duplicate of a buffer
+ *        - rc: contextual reference counted buffer
+ *        - src: reference counted buffer to duplicate
+ *
+ *      The sol_rc_copy2() interface function is the lazy counterpart of
+ *      sol_rc_copy(). The reference counted buffer @src is shared with @rc
+ *      through sol_rc_retain() rather than copied, and @rc must be passed
+ *      through sol_rc_write() before it is written to, at which point it gets
+ *      a private copy if it is still shared. @rc must be released through
+ *      sol_rc_release().
+ *
+ *      @rc must be a valid pointer to a **null** pointer, and @src must be a
+ *      valid reference counted buffer; an appropriate exception is thrown if
+ *      either of these conditions is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if the reference count of @src would overflow
+ */
+extern sol_erno sol_rc_copy2(sol_rc **rc,
+                             sol_rc *src);
+
+
+
+
+/*
+ *      sol_rc_write() - prepares a buffer for writing
+ *        - rc: contextual reference counted buffer
+ *
+ *      The sol_rc_write() interface function is the write barrier of
+ *      copy-on-write buffers. If @rc is shared with other owners, then its
+ *      payload is copied to a new buffer of the same kind that is owned by @rc
+ *      alone, and the shared buffer is released; otherwise this function does
+ *      nothing. @rc may thus change, and may be written to until it is next
+ *      shared. Owners that never write to a buffer never pay for a copy.
+ *
+ *      @rc must be a valid pointer to a **non-null** pointer; an exception is
+ *      thrown if this condition is not met. @rc is left unchanged if an
+ *      exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_rc_write(sol_rc **rc);
+
+
+
+
+/*
+ *      sol_rc_count() - gets reference count
+ *        - rc: contextual reference counted buffer
+ *        - count: reference count
+ *
+ *      The sol_rc_count() interface function returns the current reference
+ *      count @count of a buffer @rc. For atomic buffers, @count may be stale
+ *      by the time it is returned if other threads are sharing @rc. Both @rc
+ *      and @count are required to be valid pointers, or else an exception is
+ *      thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_rc_count(const sol_rc *rc,
+                             sol_size *count);
+
+
+
+
+/*
+ *      sol_rc_size() - gets payload size
+ *        - rc: contextual reference counted buffer
+ *        - sz: size in bytes of payload
+ *
+ *      The sol_rc_size() interface function returns the size @sz of the
+ *      payload of a buffer @rc. Both @rc and @sz are required to be valid
+ *      pointers, or else an exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_rc_size(const sol_rc *rc,
+                            sol_size *sz);
+
+
+
+
+#endif /* !defined __SOL_REFERENCE_COUNT_MODULE */
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
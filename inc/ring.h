@@ -0,0 +1,281 @@
+/******************************************************************************
+ *                           SOL LIBRARY v0.1.0+41
+ *
+ * File: sol/inc/ring.h
+ *
+ * Description:
+ *      This file is part of the API of the Sol Library. It declares the
+ *      interface of the ring buffer module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* create header guard */
+#if (!defined __SOL_RING_BUFFER_MODULE)
+#define __SOL_RING_BUFFER_MODULE
+
+
+
+
+        /* include required header files */
+#include "./error.h"
+#include "./prim.h"
+#include "./ptr.h"
+
+
+
+
+/*
+ *      sol_ring - byte ring buffer
+ *
+ *      The sol_ring type abstracts a fixed-capacity FIFO queue of bytes, such
+ *      as the staging buffer of a log writer or a network stream. Where the
+ *      host supports it, the storage of a ring buffer is obtained through
+ *      sol_ptr_new_mirror(), so that data wrapping around the end of the
+ *      storage is still contiguous in memory, and can be written, read and
+ *      peeked at with single copies. Otherwise, the storage is obtained through
+ *      sol_ptr_new(), and copies that wrap around are split in two.
+ *
+ *      Although the sol_ring type is defined as a transparent type so that it
+ *      can be declared on the stack, it should be treated as an opaque type,
+ *      and used only through its interface functions declared below.
+ */
+typedef struct __sol_ring {
+        sol_w8 *buf;
+        sol_size cap;
+        sol_size rd;
+        sol_size len;
+        SOL_BOOL mirror;
+} sol_ring;
+
+
+
+
+/*
+ *      sol_ring_init() - initialises a ring buffer
+ *        - ring: contextual ring buffer
+ *        - sz: minimum capacity in bytes
+ *
+ *      The sol_ring_init() interface function initialises an empty ring buffer
+ *      @ring with a capacity of at least @sz bytes. A mirrored buffer is used
+ *      where the host supports one, in which case the capacity is rounded up to
+ *      a whole number of pages; otherwise the capacity is exactly @sz bytes.
+ *      This function **must** be called before any of the other interface
+ *      functions are called on @ring.
+ *
+ *      @ring is required to be a valid pointer, and @sz is required to be
+ *      greater than zero; an appropriate exception is thrown if either of these
+ *      conditions is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ */
+extern sol_erno sol_ring_init(sol_ring *ring,
+                              sol_size sz);
+
+
+
+
+/*
+ *      sol_ring_init2() - initialises a ring buffer with explicit mirroring
+ *        - ring: contextual ring buffer
+ *        - sz: minimum capacity in bytes
+ *        - mirror: flag to request a mirrored buffer
+ *
+ *      The sol_ring_init2() interface function is similar to sol_ring_init(),
+ *      except that it does not fall back silently. If @mirror is true, then the
+ *      storage of @ring **must** be mirrored, and SOL_ERNO_STATE is thrown if
+ *      the host does not support mirrored buffers; if @mirror is false, then
+ *      the storage is always obtained through sol_ptr_new().
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ *        - SOL_ERNO_STATE if a mirrored buffer is not supported by the host
+ */
+extern sol_erno sol_ring_init2(sol_ring *ring,
+                               sol_size sz,
+                               SOL_BOOL mirror);
+
+
+
+
+/*
+ *      sol_ring_term() - terminates a ring buffer
+ *        - ring: contextual ring buffer
+ *
+ *      The sol_ring_term() interface function releases the storage of a ring
+ *      buffer @ring, discarding any unread data. A safe no-op occurs if @ring
+ *      is null.
+ */
+extern void sol_ring_term(sol_ring *ring);
+
+
+
+
+/*
+ *      sol_ring_write() - writes data to a ring buffer
+ *        - ring: contextual ring buffer
+ *        - src: data to write
+ *        - len: length in bytes of @src
+ *
+ *      The sol_ring_write() interface function appends @len bytes from @src to
+ *      the tail of a ring buffer @ring. Both @ring and @src are required to be
+ *      valid pointers, and @ring is required to have at least @len bytes of
+ *      free space; an appropriate exception is thrown if any of these
+ *      conditions is not met, in which case @ring is left unchanged.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if @ring does not have enough free space
+ */
+extern sol_erno sol_ring_write(sol_ring *ring,
+                               const sol_ptr *src,
+                               sol_size len);
+
+
+
+
+/*
+ *      sol_ring_read() - reads data from a ring buffer
+ *        - ring: contextual ring buffer
+ *        - dst: buffer to receive data
+ *        - len: length in bytes to read
+ *
+ *      The sol_ring_read() interface function removes @len bytes from the head
+ *      of a ring buffer @ring, and copies them to @dst. Both @ring and @dst are
+ *      required to be valid pointers, and @ring is required to hold at least
+ *      @len bytes; an appropriate exception is thrown if any of these
+ *      conditions is not met, in which case @ring is left unchanged.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if @ring does not hold enough data
+ */
+extern sol_erno sol_ring_read(sol_ring *ring,
+                              sol_ptr *dst,
+                              sol_size len);
+
+
+
+
+/*
+ *      sol_ring_peek() - peeks at data in a ring buffer
+ *        - ring: contextual ring buffer
+ *        - data: start of unread data
+ *        - len: length in bytes of @data
+ *
+ *      The sol_ring_peek() interface function returns a pointer @data to the
+ *      head of a ring buffer @ring without copying or removing anything, along
+ *      with the length @len of the data that is contiguous from @data. If @ring
+ *      is mirrored, then all unread data is contiguous; otherwise @len stops at
+ *      the end of the storage of @ring, and the rest of the data can be peeked
+ *      at after calling sol_ring_skip(). @data remains valid until @ring is
+ *      next read from, skipped or terminated. @ring, @data and @len are
+ *      required to be valid pointers, or else an exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_ring_peek(const sol_ring *ring,
+                              const sol_ptr **data,
+                              sol_size *len);
+
+
+
+
+/*
+ *      sol_ring_skip() - discards data from a ring buffer
+ *        - ring: contextual ring buffer
+ *        - len: length in bytes to discard
+ *
+ *      The sol_ring_skip() interface function removes @len bytes from the head
+ *      of a ring buffer @ring without copying them, typically after they have
+ *      been consumed in place through sol_ring_peek(). @ring is required to be
+ *      a valid pointer, and to hold at least @len bytes; an appropriate
+ *      exception is thrown if either of these conditions is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if @ring does not hold enough data
+ */
+extern sol_erno sol_ring_skip(sol_ring *ring,
+                              sol_size len);
+
+
+
+
+/*
+ *      sol_ring_len() - length of data in a ring buffer
+ *        - ring: contextual ring buffer
+ *        - len: length in bytes of unread data
+ *
+ *      The sol_ring_len() interface function returns the number of unread
+ *      bytes @len held by a ring buffer @ring. Both @ring and @len are required
+ *      to be valid pointers, or else an exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_ring_len(const sol_ring *ring,
+                             sol_size *len);
+
+
+
+
+/*
+ *      sol_ring_cap() - capacity of a ring buffer
+ *        - ring: contextual ring buffer
+ *        - cap: capacity in bytes
+ *
+ *      The sol_ring_cap() interface function returns the capacity @cap in bytes
+ *      of a ring buffer @ring, which may exceed the size requested when @ring
+ *      was initialised. Both @ring and @cap are required to be valid pointers,
+ *      or else an exception is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_ring_cap(const sol_ring *ring,
+                             sol_size *cap);
+
+
+
+
+#endif /* !defined __SOL_RING_BUFFER_MODULE */
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
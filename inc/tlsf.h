@@ -0,0 +1,327 @@
+/******************************************************************************
+ *                           SOL LIBRARY v0.1.0+41
+ *
+ * File: sol/inc/tlsf.h
+ *
+ * Description:
+ *      This file is part of the API of the Sol Library. It declares the
+ *      interface of the TLSF heap module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* create header guard */
+#if (!defined __SOL_TLSF_HEAP_MODULE)
+#define __SOL_TLSF_HEAP_MODULE
+
+
+
+
+        /* include required header files */
+#include "./env.h"
+#include "./error.h"
+#include "./prim.h"
+#include "./ptr.h"
+
+
+
+
+/*
+ *      SOL_PTR_TLSF - fallback heap of pointer module
+ *
+ *      The SOL_PTR_TLSF symbolic constant, if defined at compile-time, routes
+ *      the heap memory used by sol_ptr_new(), sol_ptr_copy() and sol_ptr_free()
+ *      to a TLSF heap over a static memory region supplied through
+ *      sol_tlsf_heap() instead of to malloc(), realloc() and free(). It is
+ *      defined automatically by sol/inc/libc.h in freestanding environments
+ *      that do not provide their own malloc(), and may be defined by client
+ *      code in hosted environments to mock such environments. Since the
+ *      fallback heap is not a thread-caching allocator, it cannot be combined
+ *      with SOL_PTR_TCACHE.
+ */
+#if (defined SOL_PTR_TLSF && defined SOL_PTR_TCACHE)
+#       error "[!] SOL_PTR_TLSF and SOL_PTR_TCACHE are mutually exclusive"
+#endif
+
+
+
+
+/*
+ *      SOL_TLSF_MIN - minimum size in bytes of TLSF region
+ *
+ *      The SOL_TLSF_MIN symbolic constant is the smallest memory region that
+ *      can be passed to sol_tlsf_init(). It is large enough to hold the control
+ *      structure of the heap along with a handful of small blocks; in practice
+ *      regions are expected to be much larger.
+ */
+#define SOL_TLSF_MIN 8192
+
+
+
+
+/*
+ *      sol_tlsf - TLSF heap
+ *
+ *      The sol_tlsf type is an opaque type representing a Two-Level Segregated
+ *      Fit heap laid out over a memory region supplied by client code. Free
+ *      blocks are kept in segregated lists indexed by a two-level bitmap, so
+ *      that allocating and freeing a block takes a bounded number of steps
+ *      regardless of the size of the region or the number of blocks in it;
+ *      this makes the heap suitable for real-time and freestanding systems.
+ *
+ *      The control structure of the heap is placed at the start of its region,
+ *      and so a sol_tlsf needs no memory other than the region itself. A
+ *      sol_tlsf is **not** thread-safe; client code is responsible for
+ *      serialising access to it.
+ */
+typedef struct __sol_tlsf sol_tlsf;
+
+
+
+
+/*
+ *      sol_tlsf_stat - TLSF heap statistics
+ *        - used: total size in bytes of allocated blocks
+ *        - free: total size in bytes of free blocks
+ *        - largest: size in bytes of largest free block
+ *        - nfree: count of free blocks
+ *        - frag: external fragmentation as a percentage
+ *
+ *      The sol_tlsf_stat type holds a snapshot of the statistics of a TLSF
+ *      heap, as returned by sol_tlsf_stats(). External fragmentation is the
+ *      share of free memory that lies outside the largest free block, and so
+ *      cannot be handed out as part of the largest possible allocation.
+ */
+typedef struct __sol_tlsf_stat {
+        sol_size used;
+        sol_size free;
+        sol_size largest;
+        sol_size nfree;
+        sol_size frag;
+} sol_tlsf_stat;
+
+
+
+
+/*
+ *      sol_tlsf_init() - initialises a TLSF heap
+ *        - tlsf: contextual TLSF heap
+ *        - mem: memory region of heap
+ *        - sz: size in bytes of @mem
+ *
+ *      The sol_tlsf_init() interface function lays out a new TLSF heap @tlsf
+ *      over the memory region @mem of @sz bytes, which remains owned by client
+ *      code and must outlive @tlsf. The whole region, less the control
+ *      structure and block headers, is available for allocation; blocks larger
+ *      than 2 GiB are not supported, and any excess is left unused.
+ *
+ *      @tlsf must be a valid pointer to a **null** pointer, @mem must be a
+ *      valid pointer, and @sz must be at least SOL_TLSF_MIN; an appropriate
+ *      exception is thrown if any of these conditions is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ */
+extern sol_erno sol_tlsf_init(sol_tlsf **tlsf,
+                              sol_ptr *mem,
+                              sol_size sz);
+
+
+
+
+/*
+ *      sol_tlsf_alloc() - allocates a block from a TLSF heap
+ *        - tlsf: contextual TLSF heap
+ *        - ptr: contextual pointer instance
+ *        - sz: size in bytes to allocate
+ *
+ *      The sol_tlsf_alloc() interface function allocates a block of at least
+ *      @sz bytes from a TLSF heap @tlsf and assigns it to @ptr. The block is
+ *      aligned to 16 bytes, and its contents are indeterminate. This function
+ *      runs in constant time.
+ *
+ *      @tlsf and @ptr are required to be valid pointers, @ptr must point to a
+ *      null pointer, and @sz must be greater than zero; an appropriate
+ *      exception is thrown if any of these conditions is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ *        - SOL_ERNO_HEAP if no free block is large enough
+ */
+extern sol_erno sol_tlsf_alloc(sol_tlsf *tlsf,
+                               sol_ptr **ptr,
+                               sol_size sz);
+
+
+
+
+/*
+ *      sol_tlsf_realloc() - resizes a block of a TLSF heap
+ *        - tlsf: contextual TLSF heap
+ *        - ptr: contextual pointer instance
+ *        - sz: new size in bytes
+ *
+ *      The sol_tlsf_realloc() interface function resizes a block @ptr of a
+ *      TLSF heap @tlsf to at least @sz bytes. The block is shrunk or grown in
+ *      place if possible, and otherwise moved to a new block, with its
+ *      contents preserved up to the smaller of the old and new sizes. @ptr is
+ *      left unchanged if an exception is thrown.
+ *
+ *      @tlsf and @ptr are required to be valid pointers, @ptr must point to a
+ *      non-null pointer, and @sz must be greater than zero; an appropriate
+ *      exception is thrown if any of these conditions is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ *        - SOL_ERNO_HEAP if no free block is large enough
+ */
+extern sol_erno sol_tlsf_realloc(sol_tlsf *tlsf,
+                                 sol_ptr **ptr,
+                                 sol_size sz);
+
+
+
+
+/*
+ *      sol_tlsf_free() - returns a block to a TLSF heap
+ *        - tlsf: contextual TLSF heap
+ *        - ptr: contextual pointer instance
+ *
+ *      The sol_tlsf_free() interface function returns the block @ptr to the
+ *      TLSF heap @tlsf from which it was allocated, merging it with its free
+ *      neighbours in constant time. @ptr is guaranteed to be null after this
+ *      operation.
+ *
+ *      @tlsf and @ptr are expected to be valid, and @ptr is expected to point
+ *      to a non-null pointer, but in case these conditions are not met, then
+ *      a safe no-op occurs.
+ */
+extern void sol_tlsf_free(sol_tlsf *tlsf,
+                          sol_ptr **ptr);
+
+
+
+
+/*
+ *      sol_tlsf_stats() - gets statistics of a TLSF heap
+ *        - tlsf: contextual TLSF heap
+ *        - stat: statistics of heap
+ *
+ *      The sol_tlsf_stats() interface function returns a snapshot @stat of the
+ *      usage and fragmentation of a TLSF heap @tlsf. Unlike the functions
+ *      above, this function walks the list of free blocks of the largest size
+ *      class in use, and so is not meant to be called on a hot path. Both
+ *      @tlsf and @stat are required to be valid pointers, or else an exception
+ *      is thrown.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ */
+extern sol_erno sol_tlsf_stats(const sol_tlsf *tlsf,
+                               sol_tlsf_stat *stat);
+
+
+
+
+/*
+ *      sol_tlsf_heap() - sets up fallback heap of pointer module
+ *        - mem: memory region of heap
+ *        - sz: size in bytes of @mem
+ *
+ *      The sol_tlsf_heap() interface function lays out the fallback heap used
+ *      by the pointer module when SOL_PTR_TLSF is defined (see above) over the
+ *      memory region @mem of @sz bytes. This function **must** be called once,
+ *      before any buffer is allocated through the pointer module; until it is
+ *      called, all such allocations fail with SOL_ERNO_HEAP. Unlike a plain
+ *      sol_tlsf, the fallback heap is guarded by a spin lock, and so the
+ *      pointer module remains safe to call from several threads.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_RANGE if an invalid size has been passed
+ *        - SOL_ERNO_STATE if the fallback heap has already been set up
+ */
+extern sol_erno sol_tlsf_heap(sol_ptr *mem,
+                              sol_size sz);
+
+
+
+
+/*
+ *      sol_tlsf_heap_stats() - gets statistics of fallback heap
+ *        - stat: statistics of heap
+ *
+ *      The sol_tlsf_heap_stats() interface function returns a snapshot @stat of
+ *      the fallback heap set up by sol_tlsf_heap(). @stat is required to be a
+ *      valid pointer, and the fallback heap is required to have been set up;
+ *      an appropriate exception is thrown if either condition is not met.
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_PTR if an invalid pointer has been passed
+ *        - SOL_ERNO_STATE if the fallback heap has not been set up
+ */
+extern sol_erno sol_tlsf_heap_stats(sol_tlsf_stat *stat);
+
+
+
+
+/*
+ *      __sol_tlsf_heap_alloc() - allocates from fallback heap
+ *      __sol_tlsf_heap_alloc_aligned() - allocates aligned from fallback heap
+ *      __sol_tlsf_heap_realloc() - resizes buffer of fallback heap
+ *      __sol_tlsf_heap_free() - frees buffer of fallback heap
+ *
+ *      These functions are **not** a part of the interface of this module.
+ *      They follow the contract of malloc(), aligned_alloc(), realloc() and
+ *      free() over the fallback heap, and have been declared in this file so
+ *      that they can be called by the pointer module when SOL_PTR_TLSF is
+ *      defined.
+ */
+extern sol_ptr *__sol_tlsf_heap_alloc(sol_size sz);
+
+extern sol_ptr *__sol_tlsf_heap_alloc_aligned(sol_size sz,
+                                              sol_size align);
+
+extern sol_ptr *__sol_tlsf_heap_realloc(sol_ptr *ptr,
+                                        sol_size sz);
+
+extern void __sol_tlsf_heap_free(sol_ptr *ptr);
+
+
+
+
+#endif /* !defined __SOL_TLSF_HEAP_MODULE */
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -0,0 +1,275 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/src/arena.c
+ *
+ * Description:
+ *      This file is part of the internal implementation of the Sol Library.
+ *      It implements the arena allocator module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "../inc/arena.h"
+#include "../inc/log.h"
+
+
+
+
+/*
+ *      chunk - arena chunk header
+ *        - next: next chunk in arena
+ *        - sz: size in bytes of chunk payload
+ *
+ *      The chunk header sits at the start of each block obtained from
+ *      sol_ptr_new(), and is immediately followed by the payload.
+ */
+typedef struct __chunk {
+        struct __chunk *next;
+        sol_size sz;
+} chunk;
+
+
+
+
+/*
+ *      align_up() - aligns an address upwards
+ *        - addr: address to align
+ *        - align: alignment, which must be a power of two
+ */
+static sol_inline sol_w8 *align_up(sol_w8 *addr,
+                                   sol_size align)
+{
+        return (sol_w8*) (((sol_word) addr + align - 1)
+                          & ~((sol_word) align - 1));
+}
+
+
+
+
+/*
+ *      chunk_enter() - makes a chunk the current chunk of an arena
+ *        - arena: contextual arena
+ *        - cnk: chunk to enter
+ */
+static sol_inline void chunk_enter(sol_arena *arena,
+                                   chunk *cnk)
+{
+        arena->cur = cnk;
+        arena->top = (sol_w8*) (cnk + 1);
+        arena->end = arena->top + cnk->sz;
+}
+
+
+
+
+/*
+ *      chunk_new() - allocates a new chunk after the current chunk
+ *        - arena: contextual arena
+ *        - sz: size in bytes of chunk payload
+ */
+static sol_erno chunk_new(sol_arena *arena,
+                          sol_size sz)
+{
+        auto chunk *cnk = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* check for overflow, and allocate chunk with its header */
+        sol_assert (sz + sizeof *cnk > sz, SOL_ERNO_RANGE);
+        if (arena->huge) {
+                sol_try (sol_ptr_new_huge((sol_ptr**) &cnk, sizeof *cnk + sz));
+        } else {
+                sol_try (sol_ptr_new((sol_ptr**) &cnk, sizeof *cnk + sz));
+        }
+
+        cnk->sz = sz;
+        cnk->next = SOL_PTR_NULL;
+
+                /* link chunk after the current chunk, or as the head if the
+                 * arena is empty; the current chunk is always the last one
+                 * when a new chunk is needed */
+        if (arena->cur) {
+                ((chunk*) arena->cur)->next = cnk;
+        } else {
+                arena->head = cnk;
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_arena_init() - declared in sol/inc/arena.h
+ */
+extern sol_erno sol_arena_init(sol_arena *arena,
+                               sol_size chunk)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (arena, SOL_ERNO_PTR);
+        sol_assert (chunk, SOL_ERNO_RANGE);
+
+                /* set up empty arena; chunks are obtained lazily */
+        arena->head = SOL_PTR_NULL;
+        arena->cur = SOL_PTR_NULL;
+        arena->top = SOL_PTR_NULL;
+        arena->end = SOL_PTR_NULL;
+        arena->chunk = chunk;
+        arena->huge = SOL_BOOL_FALSE;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_arena_init2() - declared in sol/inc/arena.h
+ */
+extern sol_erno sol_arena_init2(sol_arena *arena,
+                                sol_size chunk,
+                                SOL_BOOL huge)
+{
+SOL_TRY:
+                /* initialise @arena, and then set its huge page flag */
+        sol_try (sol_arena_init(arena, chunk));
+        arena->huge = huge;
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_arena_term() - declared in sol/inc/arena.h
+ */
+extern void sol_arena_term(sol_arena *arena)
+{
+        auto chunk *cnk, *nxt;
+
+                /* release all chunks if @arena is valid */
+        if (sol_likely (arena)) {
+                for (cnk = arena->head; cnk; cnk = nxt) {
+                        nxt = cnk->next;
+                        sol_ptr_free((sol_ptr**) &cnk);
+                }
+
+                arena->head = SOL_PTR_NULL;
+                arena->cur = SOL_PTR_NULL;
+                arena->top = SOL_PTR_NULL;
+                arena->end = SOL_PTR_NULL;
+        }
+}
+
+
+
+
+/*
+ *      sol_arena_alloc() - declared in sol/inc/arena.h
+ */
+extern sol_erno sol_arena_alloc(sol_arena *arena,
+                                sol_ptr **ptr,
+                                sol_size sz,
+                                sol_size align)
+{
+        auto sol_w8 *bfr;
+        auto chunk *nxt;
+        auto sol_size need;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (arena && ptr && !*ptr, SOL_ERNO_PTR);
+        sol_assert (sz && align && !(align & (align - 1)), SOL_ERNO_RANGE);
+
+                /* bump the top of the current chunk if there's room for @sz
+                 * bytes at @align; otherwise move on to the next retained
+                 * chunk, allocating a new one when the retained chunks run out,
+                 * until a chunk with enough room is found */
+        bfr = arena->top ? align_up(arena->top, align) : SOL_PTR_NULL;
+        while (sol_unlikely (!bfr || bfr > arena->end
+                             || sz > (sol_size) (arena->end - bfr))) {
+                nxt = arena->cur ? ((chunk*) arena->cur)->next : arena->head;
+
+                if (!nxt) {
+                        need = sz + align - 1;
+                        sol_assert (need >= sz, SOL_ERNO_RANGE);
+                        sol_try (chunk_new(arena, need > arena->chunk
+                                                  ? need
+                                                  : arena->chunk));
+                        nxt = arena->cur ? ((chunk*) arena->cur)->next
+                                         : arena->head;
+                }
+
+                chunk_enter(arena, nxt);
+                bfr = align_up(arena->top, align);
+        }
+
+        arena->top = bfr + sz;
+        *ptr = bfr;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_arena_reset() - declared in sol/inc/arena.h
+ */
+extern void sol_arena_reset(sol_arena *arena)
+{
+                /* rewind to before the first chunk; the next allocation will
+                 * re-enter the retained chunks from the head */
+        if (sol_likely (arena)) {
+                arena->cur = SOL_PTR_NULL;
+                arena->top = SOL_PTR_NULL;
+                arena->end = SOL_PTR_NULL;
+        }
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
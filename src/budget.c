@@ -0,0 +1,378 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/src/budget.c
+ *
+ * Description:
+ *      This file is part of the internal implementation of the Sol Library.
+ *      It implements the memory budget module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "../inc/budget.h"
+#include "../inc/log.h"
+
+
+
+
+/*
+ *      BATCH_MAX - largest credit in bytes refilled into a shard at a time
+ *
+ *      Smaller budgets use proportionally smaller batches, so that the credits
+ *      stranded in idle shards stay well below the limit.
+ */
+#define BATCH_MAX ((sol_size) 64 * 1024)
+
+
+
+
+/*
+ *      shard_tls - accounting shard of the calling thread, plus one
+ *      shard_next - count of threads assigned a shard
+ */
+static sol_tls sol_size shard_tls;
+static sol_size shard_next;
+
+
+
+
+/*
+ *      shard_credit() - gets credit of accounting shard of calling thread
+ *        - budget: contextual budget
+ */
+static sol_inline sol_size *shard_credit(sol_budget *budget)
+{
+        if (sol_unlikely (!shard_tls)) {
+                shard_tls = __atomic_add_fetch(&shard_next, 1,
+                                               __ATOMIC_RELAXED);
+        }
+
+        return &budget->shard[(shard_tls - 1) & (SOL_BUDGET_SHARDS - 1)]
+                .credit;
+}
+
+
+
+
+/*
+ *      reserve() - reserves bytes against the limit of a budget
+ *        - budget: contextual budget
+ *        - sz: number of bytes to reserve
+ *
+ *      Returns SOL_BOOL_FALSE if the reservation would exceed the limit.
+ */
+static SOL_BOOL reserve(sol_budget *budget,
+                        sol_size sz)
+{
+        auto sol_size resv = __atomic_load_n(&budget->resv, __ATOMIC_RELAXED);
+
+        do {
+                if (sz > budget->limit - resv) {
+                        return SOL_BOOL_FALSE;
+                }
+        } while (!__atomic_compare_exchange_n(&budget->resv, &resv, resv + sz,
+                                              SOL_BOOL_TRUE, __ATOMIC_RELAXED,
+                                              __ATOMIC_RELAXED));
+
+        return SOL_BOOL_TRUE;
+}
+
+
+
+
+/*
+ *      reclaim() - returns the credits of all shards of a budget
+ *        - budget: contextual budget
+ */
+static sol_cold void reclaim(sol_budget *budget)
+{
+        register sol_index i;
+        register sol_size credit;
+
+        for (i = 0; i < SOL_BUDGET_SHARDS; i++) {
+                credit = __atomic_exchange_n(&budget->shard[i].credit, 0,
+                                             __ATOMIC_RELAXED);
+                if (credit) {
+                        (void) __atomic_sub_fetch(&budget->resv, credit,
+                                                  __ATOMIC_RELAXED);
+                }
+        }
+}
+
+
+
+
+/*
+ *      sol_budget_init() - declared in sol/inc/budget.h
+ */
+extern sol_erno sol_budget_init(sol_budget *budget,
+                                sol_size limit)
+{
+        register sol_index i;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (budget, SOL_ERNO_PTR);
+        sol_assert (limit, SOL_ERNO_RANGE);
+
+                /* start with nothing reserved and no credit in any shard */
+        for (i = 0; i < SOL_BUDGET_SHARDS; i++) {
+                budget->shard[i].credit = 0;
+        }
+
+        budget->limit = limit;
+        budget->resv = 0;
+        budget->batch = limit / (8 * SOL_BUDGET_SHARDS);
+        if (budget->batch > BATCH_MAX) {
+                budget->batch = BATCH_MAX;
+        }
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_budget_charge() - declared in sol/inc/budget.h
+ */
+extern sol_hot sol_erno sol_budget_charge(sol_budget *budget,
+                                          sol_size sz)
+{
+        auto sol_size *credit, cur;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (budget, SOL_ERNO_PTR);
+
+                /* draw on the credit of the shard of this thread if it can
+                 * cover @sz */
+        credit = shard_credit(budget);
+        cur = __atomic_load_n(credit, __ATOMIC_RELAXED);
+        while (cur >= sz
+               && !__atomic_compare_exchange_n(credit, &cur, cur - sz,
+                                               SOL_BOOL_TRUE,
+                                               __ATOMIC_RELAXED,
+                                               __ATOMIC_RELAXED)) {
+                ;
+        }
+
+                /* otherwise reserve @sz along with a fresh batch of credit,
+                 * then @sz alone, and finally @sz alone after reclaiming the
+                 * credits idling in all shards */
+        if (sol_unlikely (cur < sz)) {
+                if (sz <= SOL_SIZE_MAX - budget->batch
+                    && reserve(budget, sz + budget->batch)) {
+                        (void) __atomic_add_fetch(credit, budget->batch,
+                                                  __ATOMIC_RELAXED);
+                } else if (!reserve(budget, sz)) {
+                        reclaim(budget);
+                        sol_assert (reserve(budget, sz), SOL_ERNO_BUDGET);
+                }
+        }
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_budget_uncharge() - declared in sol/inc/budget.h
+ */
+extern sol_hot void sol_budget_uncharge(sol_budget *budget,
+                                        sol_size sz)
+{
+        auto sol_size *credit, cur;
+
+                /* credit @sz to the shard of this thread if @budget is valid,
+                 * returning the excess over one batch to the reservation once
+                 * the credit exceeds two batches */
+        if (sol_likely (budget)) {
+                credit = shard_credit(budget);
+                cur = __atomic_add_fetch(credit, sz, __ATOMIC_RELAXED);
+
+                while (cur > 2 * budget->batch) {
+                        if (__atomic_compare_exchange_n(credit, &cur,
+                                                        budget->batch,
+                                                        SOL_BOOL_TRUE,
+                                                        __ATOMIC_RELAXED,
+                                                        __ATOMIC_RELAXED)) {
+                                (void) __atomic_sub_fetch(&budget->resv,
+                                                          cur - budget->batch,
+                                                          __ATOMIC_RELAXED);
+                                break;
+                        }
+                }
+        }
+}
+
+
+
+
+/*
+ *      sol_budget_new() - declared in sol/inc/budget.h
+ */
+extern sol_erno sol_budget_new(sol_budget *budget,
+                               sol_ptr **ptr,
+                               sol_size sz)
+{
+        auto SOL_BOOL charged = SOL_BOOL_FALSE;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (budget && ptr && !*ptr, SOL_ERNO_PTR);
+        sol_assert (sz, SOL_ERNO_RANGE);
+
+                /* charge @budget before touching the heap */
+        sol_try (sol_budget_charge(budget, sz));
+        charged = SOL_BOOL_TRUE;
+        sol_try (sol_ptr_new(ptr, sz));
+
+SOL_CATCH:
+                /* undo charge and log current error */
+        if (charged) {
+                sol_budget_uncharge(budget, sz);
+        }
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_budget_resize() - declared in sol/inc/budget.h
+ */
+extern sol_erno sol_budget_resize(sol_budget *budget,
+                                  sol_ptr **ptr,
+                                  sol_size old,
+                                  sol_size sz)
+{
+        auto SOL_BOOL charged = SOL_BOOL_FALSE;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (budget && ptr && *ptr, SOL_ERNO_PTR);
+        sol_assert (sz, SOL_ERNO_RANGE);
+
+                /* charge growth before resizing, and uncharge shrinkage only
+                 * once resizing has succeeded */
+        if (sz > old) {
+                sol_try (sol_budget_charge(budget, sz - old));
+                charged = SOL_BOOL_TRUE;
+        }
+
+        sol_try (sol_ptr_resize(ptr, sz));
+
+        if (sz < old) {
+                sol_budget_uncharge(budget, old - sz);
+        }
+
+SOL_CATCH:
+                /* undo charge and log current error */
+        if (charged) {
+                sol_budget_uncharge(budget, sz - old);
+        }
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_budget_free() - declared in sol/inc/budget.h
+ */
+extern sol_hot void sol_budget_free(sol_budget *budget,
+                                    sol_ptr **ptr,
+                                    sol_size sz)
+{
+                /* release buffer and uncharge @budget if parameters are
+                 * valid */
+        if (sol_likely (budget && ptr && *ptr)) {
+                sol_ptr_free_sized(ptr, sz);
+                sol_budget_uncharge(budget, sz);
+        }
+}
+
+
+
+
+/*
+ *      sol_budget_used() - declared in sol/inc/budget.h
+ */
+extern sol_erno sol_budget_used(const sol_budget *budget,
+                                sol_size *used)
+{
+        register sol_index i;
+        register sol_size credit = 0, resv;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (budget && used, SOL_ERNO_PTR);
+
+                /* subtract the credits of all shards from the reservation;
+                 * concurrent updates may briefly skew the difference, so it is
+                 * clamped at zero */
+        for (i = 0; i < SOL_BUDGET_SHARDS; i++) {
+                credit += __atomic_load_n(&budget->shard[i].credit,
+                                          __ATOMIC_RELAXED);
+        }
+
+        resv = __atomic_load_n(&budget->resv, __ATOMIC_RELAXED);
+        *used = resv > credit ? resv - credit : 0;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
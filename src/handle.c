@@ -0,0 +1,393 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/src/handle.c
+ *
+ * Description:
+ *      This file is part of the internal implementation of the Sol Library.
+ *      It implements the handle table module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "../inc/handle.h"
+#include "../inc/log.h"
+#include "../inc/mem.h"
+
+
+
+
+/*
+ *      OBJ_ALIGN - alignment in bytes of objects
+ *
+ *      Objects are aligned to two pointer widths, which matches the alignment
+ *      guaranteed by malloc() on the supported hosts.
+ */
+#define OBJ_ALIGN (2 * sizeof (sol_ptr*))
+
+
+
+
+/*
+ *      SHRINK_MIN - size in bytes below which storage is never shrunk
+ *
+ *      Object storage is halved whenever a free leaves it less than a quarter
+ *      full, unless it is smaller than this; the gap between the growth and
+ *      shrink thresholds keeps a table at a steady size from resizing back and
+ *      forth.
+ */
+#define SHRINK_MIN 4096
+
+
+
+
+/*
+ *      slot - handle slot
+ *        - gen: generation of slot
+ *        - pos: position of object if live, next free slot plus one otherwise
+ *
+ *      The generation of a slot is bumped whenever its object is freed, which
+ *      makes every outstanding handle to the object stale.
+ */
+typedef struct __slot {
+        sol_w32 gen;
+        sol_w32 pos;
+} slot;
+
+
+
+
+/*
+ *      hnd_idx() - gets slot index of handle
+ *      hnd_gen() - gets generation of handle
+ *
+ *      The slot index is stored plus one, so that SOL_HANDLE_NULL never
+ *      resolves.
+ */
+#define hnd_idx(hnd) ((sol_w32) (hnd) - 1)
+#define hnd_gen(hnd) ((sol_w32) ((hnd) >> 32))
+
+
+
+
+/*
+ *      shrink() - shrinks object storage
+ *        - tbl: contextual handle table
+ *        - n: count of objects to keep room for
+ *
+ *      Storage is released altogether if @n is zero. The table is left as it
+ *      was if heap memory cannot be resized.
+ */
+static sol_erno shrink(sol_htable *tbl,
+                       sol_size n)
+{
+SOL_TRY:
+                /* release or resize object storage and its owner slots */
+        if (!n) {
+                sol_ptr_free((sol_ptr**) &tbl->obj);
+                sol_ptr_free((sol_ptr**) &tbl->owner);
+                tbl->ocap = tbl->wcap = 0;
+        } else if (n * tbl->sz < tbl->ocap) {
+                sol_try (sol_ptr_resize((sol_ptr**) &tbl->obj, n * tbl->sz));
+                tbl->ocap = n * tbl->sz;
+                sol_try (sol_ptr_resize((sol_ptr**) &tbl->owner,
+                                        n * sizeof *tbl->owner));
+                tbl->wcap = n * sizeof *tbl->owner;
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_htable_init() - declared in sol/inc/handle.h
+ */
+extern sol_erno sol_htable_init(sol_htable *tbl,
+                                sol_size sz)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (tbl, SOL_ERNO_PTR);
+        sol_assert (sz && sz <= SOL_SIZE_MAX - OBJ_ALIGN, SOL_ERNO_RANGE);
+
+                /* round object size up so that every object is aligned */
+        tbl->sz = (sz + OBJ_ALIGN - 1) & ~(OBJ_ALIGN - 1);
+        tbl->obj = SOL_PTR_NULL;
+        tbl->owner = SOL_PTR_NULL;
+        tbl->slot = SOL_PTR_NULL;
+        tbl->len = 0;
+        tbl->nslot = 0;
+        tbl->ocap = 0;
+        tbl->wcap = 0;
+        tbl->scap = 0;
+        tbl->free = 0;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_htable_term() - declared in sol/inc/handle.h
+ */
+extern void sol_htable_term(sol_htable *tbl)
+{
+                /* release all storage if @tbl is valid */
+        if (sol_likely (tbl)) {
+                sol_ptr_free((sol_ptr**) &tbl->obj);
+                sol_ptr_free((sol_ptr**) &tbl->owner);
+                sol_ptr_free(&tbl->slot);
+
+                tbl->len = 0;
+                tbl->nslot = 0;
+                tbl->ocap = 0;
+                tbl->wcap = 0;
+                tbl->scap = 0;
+                tbl->free = 0;
+        }
+}
+
+
+
+
+/*
+ *      sol_htable_new() - declared in sol/inc/handle.h
+ */
+extern sol_hot sol_erno sol_htable_new(sol_htable *tbl,
+                                       sol_handle *hnd)
+{
+        auto slot *sl;
+        auto sol_w32 idx;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (tbl && hnd && !*hnd, SOL_ERNO_PTR);
+        sol_assert (tbl->len < SOL_W32_MAX - 1, SOL_ERNO_RANGE);
+        sol_assert (tbl->len < (SOL_SIZE_MAX / tbl->sz) - 1, SOL_ERNO_RANGE);
+
+                /* reserve room for one more object */
+        sol_try (sol_ptr_reserve((sol_ptr**) &tbl->obj, &tbl->ocap,
+                                 (tbl->len + 1) * tbl->sz));
+        sol_try (sol_ptr_reserve((sol_ptr**) &tbl->owner, &tbl->wcap,
+                                 (tbl->len + 1) * sizeof *tbl->owner));
+
+                /* recycle a free slot if possible, and otherwise append a new
+                 * one of the first generation */
+        if (sol_likely (tbl->free)) {
+                idx = tbl->free - 1;
+                sl = (slot*) tbl->slot + idx;
+                tbl->free = sl->pos;
+        } else {
+                sol_try (sol_ptr_reserve(&tbl->slot, &tbl->scap,
+                                         (tbl->nslot + 1) * sizeof *sl));
+                idx = (sol_w32) tbl->nslot++;
+                sl = (slot*) tbl->slot + idx;
+                sl->gen = 1;
+        }
+
+                /* bind slot to the object at the end of storage */
+        sl->pos = (sol_w32) tbl->len;
+        tbl->owner[tbl->len++] = idx;
+        *hnd = (sol_handle) sl->gen << 32 | (sol_handle) (idx + 1);
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_htable_free() - declared in sol/inc/handle.h
+ */
+extern sol_hot void sol_htable_free(sol_htable *tbl,
+                                    sol_handle *hnd)
+{
+        auto slot *sl, *tail;
+        register sol_w32 idx, last;
+
+                /* proceed only if @hnd is live */
+        if (sol_unlikely (!tbl || !hnd || hnd_idx(*hnd) >= tbl->nslot)) {
+                return;
+        }
+
+        idx = hnd_idx(*hnd);
+        sl = (slot*) tbl->slot + idx;
+        if (sol_unlikely (sl->gen != hnd_gen(*hnd))) {
+                return;
+        }
+
+                /* move last object into the hole, keeping storage dense */
+        last = (sol_w32) --tbl->len;
+        if (sl->pos != last) {
+                sol_mem_copy(tbl->obj + (sol_size) sl->pos * tbl->sz,
+                             tbl->obj + (sol_size) last * tbl->sz,
+                             tbl->sz);
+                tbl->owner[sl->pos] = tbl->owner[last];
+                tail = (slot*) tbl->slot + tbl->owner[last];
+                tail->pos = sl->pos;
+        }
+
+                /* retire slot to free list under a new generation, skipping
+                 * zero so that no handle is ever null */
+        if (!++sl->gen) {
+                sl->gen = 1;
+        }
+
+        sl->pos = tbl->free;
+        tbl->free = idx + 1;
+        *hnd = SOL_HANDLE_NULL;
+
+                /* halve storage once it is less than a quarter full */
+        if (sol_unlikely (tbl->ocap > SHRINK_MIN
+                          && tbl->len * tbl->sz < tbl->ocap / 4)) {
+                (void) shrink(tbl, tbl->ocap / tbl->sz / 2);
+        }
+}
+
+
+
+
+/*
+ *      sol_htable_get() - declared in sol/inc/handle.h
+ */
+extern sol_hot sol_erno sol_htable_get(const sol_htable *tbl,
+                                       sol_handle hnd,
+                                       sol_ptr **ptr)
+{
+        auto const slot *sl;
+
+SOL_TRY:
+                /* check preconditions, rejecting stale handles */
+        sol_assert (tbl && ptr && hnd_idx(hnd) < tbl->nslot, SOL_ERNO_PTR);
+        sol_assert ((sl = (const slot*) tbl->slot + hnd_idx(hnd))->gen
+                    == hnd_gen(hnd), SOL_ERNO_PTR);
+
+                /* return current address of object */
+        *ptr = tbl->obj + (sol_size) sl->pos * tbl->sz;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_htable_compact() - declared in sol/inc/handle.h
+ */
+extern sol_erno sol_htable_compact(sol_htable *tbl)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (tbl, SOL_ERNO_PTR);
+
+                /* shrink storage to fit live objects */
+        sol_try (shrink(tbl, tbl->len));
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_htable_len() - declared in sol/inc/handle.h
+ */
+extern sol_erno sol_htable_len(const sol_htable *tbl,
+                               sol_size *len)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (tbl && len, SOL_ERNO_PTR);
+
+                /* return count of live objects */
+        *len = tbl->len;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_htable_cap() - declared in sol/inc/handle.h
+ */
+extern sol_erno sol_htable_cap(const sol_htable *tbl,
+                               sol_size *cap)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (tbl && cap, SOL_ERNO_PTR);
+
+                /* return total size of reserved storage */
+        *cap = tbl->ocap + tbl->wcap + tbl->scap;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -26,19 +26,3035 @@
 
 
 
+        /* enable POSIX threads in strict C99 mode, and mmap() flags beyond
+         * POSIX */
+#if (!defined _POSIX_C_SOURCE)
+#       define _POSIX_C_SOURCE 200809L
+#endif
+
+#if (!defined _DEFAULT_SOURCE)
+#       define _DEFAULT_SOURCE
+#endif
+
+
+
+
         /* include required header files */
 #include "../inc/hint.h"
 #include "../inc/libc.h"
 #include "../inc/log.h"
+#include "../inc/mem.h"
 #include "../inc/ptr.h"
+#include <errno.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#if (defined SOL_LOG_ASYNC)
+#       include <pthread.h>
+#endif
+#if (defined SOL_LOG_URING)
+#       include <linux/io_uring.h>
+#       include <sys/syscall.h>
+#endif
+
+
+
+
+/*
+ *      log_hnd - handle to log file
+ *      log_fmt - format of log file
+ *      log_backend - backend of log file
+ *
+ *      The log file is shared by all the threads of the process. The logging
+ *      macros read @log_hnd with an acquire load, pairing with the release
+ *      store that publishes it, so that they also see the format and backend
+ *      with which it was opened. The stream of a log file written through any
+ *      backend other than stdio is kept open for its descriptor and lock, but
+ *      is not written through.
+ */
+static FILE *log_hnd = SOL_PTR_NULL;
+static SOL_LOG_FORMAT log_fmt = SOL_LOG_FORMAT_TEXT;
+static SOL_LOG_BACKEND log_backend = SOL_LOG_BACKEND_STDIO;
+
+
+
+
+/*
+ *      log_tid - identifier of thread
+ *      log_tids - count of thread identifiers assigned
+ *
+ *      Threads are numbered from one in the order in which they log their first
+ *      entry, and their numbers are recorded in their entries.
+ */
+static sol_tls sol_w32 log_tid = 0;
+static sol_w32 log_tids = 0;
+
+
+
+
+/*
+ *      __sol_log_lvl - declared in sol/inc/log.h
+ */
+int __sol_log_lvl = SOL_LOG_LEVEL_TRACE;
+
+
+
+
+/*
+ *      STAMP_CLOCK - clock read for timestamps
+ *
+ *      The coarse real-time clock is preferred where it is available, since it
+ *      is read without a system call and its resolution of a few milliseconds
+ *      is fine enough for log entries.
+ */
+#if (defined CLOCK_REALTIME_COARSE)
+#       define STAMP_CLOCK CLOCK_REALTIME_COARSE
+#else
+#       define STAMP_CLOCK CLOCK_REALTIME
+#endif
+
+
+
+
+/*
+ *      DATE_FMT - strftime() format of date, matching that of ctime()
+ *      DATE_SZ - size in bytes of date, leaving room for milliseconds
+ */
+#define DATE_FMT "%a %b %e %H:%M:%S %Y"
+#define DATE_SZ (sizeof log_stamp.buf - 4)
+
+
+
+
+/*
+ *      log_stamp - timestamp cache of thread
+ *        - sec: second in which @buf was formatted
+ *        - len: length of date in @buf
+ *        - buf: formatted timestamp
+ */
+static sol_tls struct {
+        time_t sec;
+        sol_size len;
+        char buf[32];
+} log_stamp;
+
+
+
+
+/*
+ *      stamp_fmt() - formats timestamp
+ *        - ts: time to format
+ *
+ *      The timestamp is the local date and time in the format of ctime(),
+ *      followed by milliseconds. The date is formatted only when the second
+ *      changes, and the milliseconds are patched in on every call.
+ *
+ *      Return:
+ *        - formatted timestamp, valid until the next call by the same thread
+ */
+static const char *stamp_fmt(const struct timespec *ts)
+{
+        auto struct tm tm;
+        auto char *ms;
+        auto long n;
+
+                /* reformat the date if the cached one is stale */
+        if (sol_unlikely (ts->tv_sec != log_stamp.sec || !log_stamp.len)) {
+                (void) localtime_r(&ts->tv_sec, &tm);
+                log_stamp.len = strftime(log_stamp.buf, DATE_SZ, DATE_FMT,
+                                         &tm);
+                log_stamp.sec = ts->tv_sec;
+        }
+
+                /* append milliseconds */
+        n = ts->tv_nsec / 1000000;
+        ms = log_stamp.buf + log_stamp.len;
+        ms[0] = '.';
+        ms[1] = (char) ('0' + n / 100);
+        ms[2] = (char) ('0' + n / 10 % 10);
+        ms[3] = (char) ('0' + n % 10);
+        ms[4] = '\0';
+
+        return log_stamp.buf;
+}
+
+
+
+
+/*
+ *      stamp_get() - gets current timestamp
+ *
+ *      Return:
+ *        - current time formatted by stamp_fmt()
+ */
+static const char *stamp_get(void)
+{
+        auto struct timespec ts;
+
+        (void) clock_gettime(STAMP_CLOCK, &ts);
+        return stamp_fmt(&ts);
+}
+
+
+
+
+/*
+ *      clock_ns() - reads clock in nanoseconds
+ *        - clk: clock to read
+ */
+static sol_inline sol_w64 clock_ns(clockid_t clk)
+{
+        auto struct timespec ts;
+
+        (void) clock_gettime(clk, &ts);
+        return (sol_w64) ts.tv_sec * 1000000000ULL + (sol_w64) ts.tv_nsec;
+}
+
+
+
+
+/*
+ *      tid_get() - gets identifier of thread, assigning it if required
+ */
+static sol_inline sol_w32 tid_get(void)
+{
+        if (sol_unlikely (!log_tid)) {
+                log_tid = __atomic_add_fetch(&log_tids, 1, __ATOMIC_RELAXED);
+        }
+
+        return log_tid;
+}
+
+
+
+
+/*
+ *      BIN_MAGIC - magic bytes opening binary log files
+ *      BIN_MAGIC_SZ - length in bytes of BIN_MAGIC
+ *      BIN_SITE - tag of call site records
+ *      BIN_SITE_SZ - size in bytes of the fixed part of call site records
+ *      BIN_ENTRY - tag of entry records
+ *      BIN_ENTRY_SZ - size in bytes of the fixed part of entry records
+ *
+ *      A binary log file opens with BIN_MAGIC, and is followed by a stream of
+ *      records, each starting with a tag byte. All integers are little-endian.
+ *
+ *      A call site record describes a call site the first time that it logs an
+ *      entry, and assigns it an identifier. It holds the identifier (4 bytes),
+ *      the entry type (1 byte), the line number (4 bytes), and the lengths of
+ *      the function and file names (2 bytes each), followed by the names.
+ *
+ *      An entry record holds the identifier of its call site (4 bytes), the
+ *      identifier of the thread that logged it (4 bytes), the time in
+ *      nanoseconds since the epoch (8 bytes), and the length of the message (4
+ *      bytes), followed by the message.
+ */
+#define BIN_MAGIC "SOLBLOG1"
+#define BIN_MAGIC_SZ 8
+#define BIN_SITE 'S'
+#define BIN_SITE_SZ 14
+#define BIN_ENTRY 'E'
+#define BIN_ENTRY_SZ 21
+
+
+
+
+/*
+ *      LEVEL_TYPE - log entry types of the log levels of call sites
+ */
+static const char *LEVEL_TYPE[] = {"T", "D", "W", "E"};
+
+
+
+
+/*
+ *      log_sites - call sites known to binary log file
+ *        - gen: session of binary log file, never 0
+ *        - len: number of call sites known to binary log file
+ *
+ *      BUF_SZ - size in bytes of output buffer of binary log file
+ *
+ *      log_buf - output buffer of binary log file
+ *        - data: buffered records
+ *        - len: length in bytes of @data
+ *
+ *      Records are gathered into the output buffer and handed over to stdio
+ *      only when it fills up, so that each entry costs a couple of copies
+ *      instead of calls to fwrite(). The identifier of a call site is kept in
+ *      its own state along with the session in which it was assigned, so that
+ *      it is found without a lookup, and is assigned afresh in later sessions.
+ *      The call site count, output buffer and call site states are shared by
+ *      all threads; in synchronous mode they are used under the lock of the log
+ *      file stream, and in asynchronous mode only by the writer thread.
+ */
+static struct {
+        sol_w32 gen;
+        sol_w32 len;
+} log_sites = {1, 0};
+
+#define BUF_SZ 4096
+
+static struct {
+        sol_w8 *data;
+        sol_size len;
+} log_buf;
+
+
+
+
+/*
+ *      str_len() - gets length of string, capped to a limit
+ *        - str: string
+ *        - max: limit
+ */
+static sol_inline sol_size str_len(const char *str,
+                                   sol_size max)
+{
+        register sol_size len = 0;
+
+        while (len < max && str[len]) {
+                len++;
+        }
+
+        return len;
+}
+
+
+
+
+/*
+ *      put_le() - writes little-endian integer
+ *      get_le() - reads little-endian integer
+ *        - buf: buffer
+ *        - val: value
+ *        - n: width in bytes
+ */
+static sol_inline void put_le(sol_w8 *buf,
+                              sol_w64 val,
+                              sol_size n)
+{
+        register sol_size i;
+
+        for (i = 0; i < n; i++, val >>= 8) {
+                buf[i] = (sol_w8) val;
+        }
+}
+
+static sol_inline sol_w64 get_le(const sol_w8 *buf,
+                                 sol_size n)
+{
+        auto sol_w64 val = 0;
+
+        while (n--) {
+                val = (val << 8) | buf[n];
+        }
+
+        return val;
+}
+
+
+
+
+/*
+ *      bin_site() - encodes fixed part of call site record
+ *        - rec: record buffer
+ *        - desc: call site descriptor
+ *        - flen: length of function name
+ *        - nlen: length of file name
+ */
+static sol_size bin_site(sol_w8 *rec,
+                         const __sol_log_desc *desc,
+                         sol_size flen,
+                         sol_size nlen)
+{
+        rec[0] = BIN_SITE;
+        put_le(rec + 1, desc->site->id, 4);
+        rec[5] = (sol_w8) *LEVEL_TYPE[desc->level];
+        put_le(rec + 6, (sol_w32) desc->line, 4);
+        put_le(rec + 10, flen, 2);
+        put_le(rec + 12, nlen, 2);
+
+        return BIN_SITE_SZ;
+}
+
+
+
+
+/*
+ *      bin_entry() - encodes fixed part of entry record
+ *        - rec: record buffer
+ *        - id: identifier of call site
+ *        - tid: identifier of thread
+ *        - ns: time in nanoseconds since the epoch
+ *        - mlen: length of message
+ */
+static sol_size bin_entry(sol_w8 *rec,
+                          sol_w32 id,
+                          sol_w32 tid,
+                          sol_w64 ns,
+                          sol_size mlen)
+{
+        rec[0] = BIN_ENTRY;
+        put_le(rec + 1, id, 4);
+        put_le(rec + 5, tid, 4);
+        put_le(rec + 9, ns, 8);
+        put_le(rec + 17, mlen, 4);
+
+        return BIN_ENTRY_SZ;
+}
+
+
+
+
+/*
+ *      MAP_ANONYMOUS - anonymous mapping flag
+ *
+ *      Older BSD and OSX hosts name this flag MAP_ANON.
+ */
+#if (!defined MAP_ANONYMOUS)
+#       define MAP_ANONYMOUS MAP_ANON
+#endif
+
+
+
+
+/*
+ *      MAP_WIN - size in bytes of the windows in which log files are mapped
+ *      MAP_SPAN - size in bytes of the address range reserved for windows
+ */
+#define MAP_WIN ((sol_w64) 16 << 20)
+#define MAP_SPAN ((sol_w64) (sizeof (sol_ptr*) < 8 ? 1 : 64) << 30)
+
+
+
+
+/*
+ *      log_map - memory-mapped log file
+ *        - base: address range reserved for windows
+ *        - fd: descriptor of log file
+ *        - len: length in bytes of log file claimed by entries so far
+ *        - mapped: file offset up to which windows are mapped
+ *        - cut: file offset at which log file is cut on closing
+ *        - lock: flag indicating that a thread is mapping windows
+ *
+ *      Each window is mapped into the reserved range at the offset of the file
+ *      that it maps, so entries are copied to the same place however far the
+ *      windows have advanced, and a window is never moved while it is in use.
+ *      Windows stay mapped until the log file is closed, leaving the kernel to
+ *      write out and reclaim their pages.
+ */
+static struct {
+        sol_w8 *base;
+        int fd;
+        sol_w64 len;
+        sol_w64 mapped;
+        sol_w64 cut;
+        int lock;
+} log_map;
+
+
+
+
+/*
+ *      map_extend() - extends memory-mapped log file to cover a window
+ *        - at: file offset of window
+ *
+ *      The log file is extended with posix_fallocate(), so that the kernel
+ *      reserves its blocks up front, or with ftruncate() on file systems that
+ *      don't support it.
+ *
+ *      Return:
+ *        - 0 if log file could not be extended
+ *        - 1 if log file has been extended
+ */
+static int map_extend(sol_w64 at)
+{
+        auto struct stat st;
+
+        if (!posix_fallocate(log_map.fd, (off_t) at, (off_t) MAP_WIN)) {
+                return 1;
+        }
+
+        return !fstat(log_map.fd, &st)
+               && ((sol_w64) st.st_size >= at + MAP_WIN
+                   || !ftruncate(log_map.fd, (off_t) (at + MAP_WIN)));
+}
+
+
+
+
+/*
+ *      map_grow() - maps windows of memory-mapped log file
+ *        - end: file offset up to which windows are needed
+ *
+ *      Only one thread maps windows at a time.
+ *
+ *      Return:
+ *        - 0 if windows could not be mapped up to @end
+ *        - 1 if windows are mapped up to @end
+ */
+static int map_grow(sol_w64 end)
+{
+        register sol_w64 at;
+
+        if (sol_unlikely (end > MAP_SPAN)) {
+                return 0;
+        }
+
+        while (__atomic_exchange_n(&log_map.lock, 1, __ATOMIC_ACQUIRE)) {
+                (void) sched_yield();
+        }
+
+        for (at = log_map.mapped; at < end; at += MAP_WIN) {
+                if (!map_extend(at)) {
+                        break;
+                }
+
+                if (mmap(log_map.base + at, MAP_WIN, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_FIXED, log_map.fd, (off_t) at)
+                    == MAP_FAILED) {
+                        break;
+                }
+
+                __atomic_store_n(&log_map.mapped, at + MAP_WIN,
+                                 __ATOMIC_RELEASE);
+        }
+
+        __atomic_store_n(&log_map.lock, 0, __ATOMIC_RELEASE);
+        return __atomic_load_n(&log_map.mapped, __ATOMIC_ACQUIRE) >= end;
+}
+
+
+
+
+/*
+ *      map_claim() - claims room at end of memory-mapped log file
+ *        - len: length in bytes of room
+ *
+ *      Room is claimed with a single atomic addition, so threads don't block
+ *      each other. The thread whose room crosses the middle of a window maps
+ *      the next window ahead of time, so that threads wait for windows to be
+ *      mapped only if they outrun it. Room that can't be mapped is lost, and
+ *      the log file is cut where it starts on closing.
+ *
+ *      Return:
+ *        - start of room, or null if it can't be mapped
+ */
+static sol_w8 *map_claim(sol_size len)
+{
+        register sol_w64 off, end;
+        auto sol_w64 cut;
+
+        off = __atomic_fetch_add(&log_map.len, len, __ATOMIC_RELAXED);
+        end = off + len;
+
+        if (sol_unlikely (end > __atomic_load_n(&log_map.mapped,
+                                                __ATOMIC_ACQUIRE)
+                          && !map_grow(end))) {
+                cut = __atomic_load_n(&log_map.cut, __ATOMIC_RELAXED);
+                while (off < cut
+                       && !__atomic_compare_exchange_n(&log_map.cut, &cut, off,
+                                                       1, __ATOMIC_RELAXED,
+                                                       __ATOMIC_RELAXED));
+                return SOL_PTR_NULL;
+        }
+
+        if (sol_unlikely (((off + MAP_WIN / 2) ^ (end + MAP_WIN / 2))
+                          >= MAP_WIN)) {
+                (void) map_grow((end / MAP_WIN + 2) * MAP_WIN);
+        }
+
+        return log_map.base + off;
+}
+
+
+
+
+/*
+ *      map_open() - maps log file
+ *        - hnd: stream of log file, opened for reading and writing
+ *
+ *      Return:
+ *        - 0 if log file could not be mapped
+ *        - 1 if log file has been mapped
+ */
+static int map_open(FILE *hnd)
+{
+        auto struct stat st;
+
+        log_map.fd = fileno(hnd);
+        if (fstat(log_map.fd, &st)) {
+                return 0;
+        }
+
+        log_map.base = mmap(SOL_PTR_NULL, MAP_SPAN, PROT_NONE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (log_map.base == MAP_FAILED) {
+                log_map.base = SOL_PTR_NULL;
+                return 0;
+        }
+
+                /* existing entries are appended to, so start with the window
+                 * holding the end of the file */
+        log_map.len = (sol_w64) st.st_size;
+        log_map.mapped = log_map.len / MAP_WIN * MAP_WIN;
+        log_map.cut = MAP_SPAN;
+        log_map.lock = 0;
+
+        return map_grow(log_map.len + 1);
+}
+
+
+
+
+/*
+ *      map_close() - unmaps log file, truncating it to its real length
+ */
+static void map_close(void)
+{
+        if (log_map.base) {
+                (void) munmap(log_map.base, MAP_SPAN);
+                (void) ftruncate(log_map.fd, (off_t) (log_map.len < log_map.cut
+                                                      ? log_map.len
+                                                      : log_map.cut));
+                log_map.base = SOL_PTR_NULL;
+        }
+}
+
+
+
+
+/*
+ *      VEC_SZ - size in bytes of the chunks in which entries are gathered
+ *      VEC_N - number of chunks
+ *
+ *      VEC_N is the lowest IOV_MAX allowed by POSIX, so that all the chunks
+ *      can be written out by a single call to writev().
+ */
+#define VEC_SZ 65536
+#define VEC_N 16
+
+
+
+
+/*
+ *      log_vec - chunks of log file with gathered or io_uring writes
+ *        - data: memory of chunks
+ *        - iov: extent of each chunk, whose length is the count of bytes in it
+ *        - head: sequence number of chunk being filled
+ *        - done: sequence number of oldest chunk still being written out
+ *        - fd: descriptor of log file
+ *        - off: file offset at which the next chunk is written
+ *
+ *      Chunks are numbered in the order in which they are filled, and chunk
+ *      @head is stored at index @head % VEC_N. The chunks from @done up to
+ *      @head have been handed to io_uring and can't be reused until their
+ *      writes complete; with gathered writes, @done is always @head. The
+ *      chunks are guarded by the lock of the log file stream.
+ */
+static struct {
+        sol_w8 *data;
+        struct iovec iov[VEC_N];
+        sol_size head;
+        sol_size done;
+        int fd;
+        sol_w64 off;
+} log_vec;
+
+
+
+
+        /* the io_uring backend is compiled only if it has been requested */
+#if (defined SOL_LOG_URING)
+
+
+
+
+/*
+ *      log_ring - io_uring instance of log file
+ *        - fd: descriptor of io_uring instance
+ *        - sq: mapping of submission queue ring
+ *        - cq: mapping of completion queue ring
+ *        - sqes: submission queue entries
+ *        - cqes: completion queue entries
+ *        - sq_sz: size in bytes of @sq
+ *        - cq_sz: size in bytes of @cq, or 0 if it shares the mapping of @sq
+ *        - sqes_sz: size in bytes of @sqes
+ *        - sq_tail, sq_mask, sq_array: fields of submission queue ring
+ *        - cq_head, cq_tail, cq_mask: fields of completion queue ring
+ *        - at: file offset at which each chunk is being written
+ *        - busy: flag indicating that each chunk is being written
+ *
+ *      The rings are shared with the kernel, which consumes submission queue
+ *      entries up to @sq_tail and posts completion queue entries up to
+ *      @cq_tail, so both of these are accessed atomically.
+ */
+static struct {
+        int fd;
+        sol_w8 *sq;
+        sol_w8 *cq;
+        struct io_uring_sqe *sqes;
+        struct io_uring_cqe *cqes;
+        sol_size sq_sz;
+        sol_size cq_sz;
+        sol_size sqes_sz;
+        unsigned *sq_tail;
+        unsigned *sq_mask;
+        unsigned *sq_array;
+        unsigned *cq_head;
+        unsigned *cq_tail;
+        unsigned *cq_mask;
+        sol_w64 at[VEC_N];
+        int busy[VEC_N];
+} log_ring;
+
+
+
+
+/*
+ *      ring_enter() - submits queued writes, and waits for completions
+ *        - n: number of writes to submit
+ *        - wait: flag to indicate whether to wait for a completion
+ */
+static void ring_enter(unsigned n,
+                       int wait)
+{
+        while (syscall(__NR_io_uring_enter, log_ring.fd, n, wait ? 1 : 0,
+                       wait ? IORING_ENTER_GETEVENTS : 0, SOL_PTR_NULL, 0) < 0
+               && errno == EINTR);
+}
+
+
+
+
+/*
+ *      ring_submit() - hands chunk to io_uring
+ *        - seq: sequence number of chunk
+ *
+ *      The chunk is written at the next file offset, so chunks land in order
+ *      whatever the order in which their writes complete.
+ */
+static void ring_submit(sol_size seq)
+{
+        register sol_size i = seq % VEC_N;
+        register unsigned tail, idx;
+        auto struct io_uring_sqe *sqe;
+
+        tail = *log_ring.sq_tail;
+        idx = tail & *log_ring.sq_mask;
+        sqe = log_ring.sqes + idx;
+
+        sol_mem_set(sqe, 0, sizeof *sqe);
+        sqe->opcode = IORING_OP_WRITEV;
+        sqe->fd = log_vec.fd;
+        sqe->addr = (sol_w64) (uintptr_t) &log_vec.iov[i];
+        sqe->len = 1;
+        sqe->off = log_vec.off;
+        sqe->user_data = seq;
+
+        log_ring.at[i] = log_vec.off;
+        log_ring.busy[i] = 1;
+        log_vec.off += log_vec.iov[i].iov_len;
+
+        log_ring.sq_array[idx] = idx;
+        __atomic_store_n(log_ring.sq_tail, tail + 1, __ATOMIC_RELEASE);
+        ring_enter(1, 0);
+}
+
+
+
+
+/*
+ *      ring_reap() - reaps completed writes
+ *        - wait: flag to indicate whether to wait for a write to complete
+ *
+ *      The rest of a chunk that io_uring has written out only partly, or not
+ *      at all, is written out directly with pwrite().
+ */
+static void ring_reap(int wait)
+{
+        register unsigned head;
+        register sol_size i, n;
+        register ssize_t w;
+        auto struct io_uring_cqe *cqe;
+
+        head = *log_ring.cq_head;
+        if (wait && head == __atomic_load_n(log_ring.cq_tail,
+                                            __ATOMIC_ACQUIRE)) {
+                ring_enter(0, 1);
+        }
+
+        for (; head != __atomic_load_n(log_ring.cq_tail, __ATOMIC_ACQUIRE);
+             head++) {
+                cqe = log_ring.cqes + (head & *log_ring.cq_mask);
+                i = cqe->user_data % VEC_N;
+                n = cqe->res > 0 ? (sol_size) cqe->res : 0;
+
+                for (; n < log_vec.iov[i].iov_len; n += (sol_size) w) {
+                        w = pwrite(log_vec.fd,
+                                   (sol_w8*) log_vec.iov[i].iov_base + n,
+                                   log_vec.iov[i].iov_len - n,
+                                   (off_t) (log_ring.at[i] + n));
+                        if (w < 0 && errno == EINTR) {
+                                w = 0;
+                        } else if (w <= 0) {
+                                break;
+                        }
+                }
+
+                log_ring.busy[i] = 0;
+        }
+
+        __atomic_store_n(log_ring.cq_head, head, __ATOMIC_RELEASE);
+
+        while (log_vec.done != log_vec.head
+               && !log_ring.busy[log_vec.done % VEC_N]) {
+                log_vec.iov[log_vec.done++ % VEC_N].iov_len = 0;
+        }
+}
+
+
+
+
+/*
+ *      ring_close() - tears down io_uring instance
+ */
+static void ring_close(void)
+{
+        if (log_ring.sqes != MAP_FAILED) {
+                (void) munmap(log_ring.sqes, log_ring.sqes_sz);
+        }
+
+        if (log_ring.cq_sz && log_ring.cq != MAP_FAILED) {
+                (void) munmap(log_ring.cq, log_ring.cq_sz);
+        }
+
+        if (log_ring.sq != MAP_FAILED) {
+                (void) munmap(log_ring.sq, log_ring.sq_sz);
+        }
+
+        if (log_ring.fd >= 0) {
+                (void) close(log_ring.fd);
+        }
+}
+
+
+
+
+/*
+ *      ring_open() - sets up io_uring instance
+ *
+ *      Whatever has been set up is torn down again if setting up fails.
+ *
+ *      Return:
+ *        - 0 if io_uring instance could not be set up
+ *        - 1 if io_uring instance has been set up
+ */
+static int ring_open(void)
+{
+        auto struct io_uring_params p;
+
+        sol_mem_set(&p, 0, sizeof p);
+        sol_mem_set(&log_ring, 0, sizeof log_ring);
+        log_ring.sq = log_ring.cq = MAP_FAILED;
+        log_ring.sqes = MAP_FAILED;
+
+        if ((log_ring.fd = (int) syscall(__NR_io_uring_setup, VEC_N, &p)) < 0) {
+                return 0;
+        }
+
+                /* map the rings, which newer kernels place in one mapping */
+        log_ring.sq_sz = p.sq_off.array + p.sq_entries * sizeof (unsigned);
+        log_ring.cq_sz = p.cq_off.cqes
+                         + p.cq_entries * sizeof (struct io_uring_cqe);
+        log_ring.sqes_sz = p.sq_entries * sizeof (struct io_uring_sqe);
+
+        if (p.features & IORING_FEAT_SINGLE_MMAP) {
+                if (log_ring.cq_sz > log_ring.sq_sz) {
+                        log_ring.sq_sz = log_ring.cq_sz;
+                }
+                log_ring.cq_sz = 0;
+        }
+
+        log_ring.sq = mmap(SOL_PTR_NULL, log_ring.sq_sz,
+                           PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                           log_ring.fd, IORING_OFF_SQ_RING);
+        log_ring.cq = !log_ring.cq_sz
+                      ? log_ring.sq
+                      : mmap(SOL_PTR_NULL, log_ring.cq_sz,
+                             PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, log_ring.fd,
+                             IORING_OFF_CQ_RING);
+        log_ring.sqes = mmap(SOL_PTR_NULL, log_ring.sqes_sz,
+                             PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, log_ring.fd,
+                             IORING_OFF_SQES);
+
+        if (log_ring.sq == MAP_FAILED || log_ring.cq == MAP_FAILED
+            || log_ring.sqes == MAP_FAILED) {
+                ring_close();
+                return 0;
+        }
+
+        log_ring.sq_tail = (unsigned*) (log_ring.sq + p.sq_off.tail);
+        log_ring.sq_mask = (unsigned*) (log_ring.sq + p.sq_off.ring_mask);
+        log_ring.sq_array = (unsigned*) (log_ring.sq + p.sq_off.array);
+        log_ring.cq_head = (unsigned*) (log_ring.cq + p.cq_off.head);
+        log_ring.cq_tail = (unsigned*) (log_ring.cq + p.cq_off.tail);
+        log_ring.cq_mask = (unsigned*) (log_ring.cq + p.cq_off.ring_mask);
+        log_ring.cqes = (struct io_uring_cqe*) (log_ring.cq + p.cq_off.cqes);
+
+        return 1;
+}
+
+
+
+
+#endif /* defined SOL_LOG_URING */
+
+
+
+
+/*
+ *      vec_write() - writes out chunks with a single call to writev()
+ *        - n: number of chunks, starting from the first one
+ */
+static void vec_write(sol_size n)
+{
+        auto struct iovec *iov = log_vec.iov;
+        register sol_size i;
+        register ssize_t w;
+
+                /* advance past whatever has been written out, in case a call
+                 * writes out less than asked */
+        while (n) {
+                if ((w = writev(log_vec.fd, iov, (int) n)) <= 0) {
+                        if (w && errno == EINTR) {
+                                continue;
+                        }
+                        break;
+                }
+
+                for (; n && (sol_size) w >= iov->iov_len; n--, iov++) {
+                        w -= (ssize_t) iov->iov_len;
+                }
+
+                if (n) {
+                        iov->iov_base = (sol_w8*) iov->iov_base + w;
+                        iov->iov_len -= (sol_size) w;
+                }
+        }
+
+        for (i = 0; i < VEC_N; i++) {
+                log_vec.iov[i].iov_base = log_vec.data + i * VEC_SZ;
+                log_vec.iov[i].iov_len = 0;
+        }
+
+        log_vec.head = log_vec.done = 0;
+}
+
+
+
+
+/*
+ *      vec_next() - hands over chunk being filled, and moves to next one
+ *
+ *      Gathered writes wait until the last chunk has been handed over, and
+ *      then write out all the chunks at once. With io_uring, the chunk is
+ *      handed over straight away, and completions are reaped so that the next
+ *      chunk is free, waiting only if it is still being written out.
+ */
+static void vec_next(void)
+{
+#if (defined SOL_LOG_URING)
+        if (log_backend == SOL_LOG_BACKEND_URING) {
+                ring_submit(log_vec.head++);
+
+                do {
+                        ring_reap(log_vec.head - log_vec.done == VEC_N);
+                } while (log_vec.head - log_vec.done == VEC_N);
+
+                return;
+        }
+#endif
+
+        if (++log_vec.head == VEC_N) {
+                vec_write(VEC_N);
+        }
+
+        log_vec.done = log_vec.head;
+}
+
+
+
+
+/*
+ *      vec_put() - copies bytes into chunks
+ *        - src: bytes to copy
+ *        - len: number of bytes
+ *
+ *      This function must be called with the log file stream locked.
+ */
+static void vec_put(const sol_ptr *src,
+                    sol_size len)
+{
+        register const sol_w8 *s = src;
+        register struct iovec *iov;
+        register sol_size n;
+
+        while (len) {
+                iov = &log_vec.iov[log_vec.head % VEC_N];
+                if (!(n = VEC_SZ - iov->iov_len)) {
+                        vec_next();
+                        continue;
+                }
+
+                if (n > len) {
+                        n = len;
+                }
+
+                sol_mem_copy((sol_w8*) iov->iov_base + iov->iov_len, s, n);
+                iov->iov_len += n;
+                s += n;
+                len -= n;
+        }
+}
+
+
+
+
+/*
+ *      vec_flush() - hands over all the bytes in the chunks
+ *
+ *      This function must be called with the log file stream locked.
+ */
+static void vec_flush(void)
+{
+        if (log_vec.iov[log_vec.head % VEC_N].iov_len) {
+#if (defined SOL_LOG_URING)
+                if (log_backend == SOL_LOG_BACKEND_URING) {
+                        vec_next();
+                        return;
+                }
+#endif
+
+                vec_write(log_vec.head + 1);
+        } else if (log_vec.head) {
+                vec_write(log_vec.head);
+        }
+}
+
+
+
+
+/*
+ *      vec_open() - sets up chunks of log file
+ *        - hnd: stream of log file
+ *
+ *      Return:
+ *        - SOL_ERNO_NULL if no error occurs
+ *        - SOL_ERNO_HEAP if heap memory failure occurs
+ *        - SOL_ERNO_FILE if log file or io_uring instance can't be set up
+ */
+static sol_erno vec_open(FILE *hnd)
+{
+        auto struct stat st;
+        register sol_size i;
+#if (defined SOL_LOG_URING)
+        auto int flags;
+#endif
+
+SOL_TRY:
+                /* allocate chunks */
+        sol_try (sol_ptr_new((sol_ptr**) &log_vec.data, VEC_N * VEC_SZ));
+
+        for (i = 0; i < VEC_N; i++) {
+                log_vec.iov[i].iov_base = log_vec.data + i * VEC_SZ;
+                log_vec.iov[i].iov_len = 0;
+        }
+
+        log_vec.head = log_vec.done = 0;
+        log_vec.fd = fileno(hnd);
+        sol_assert (!fstat(log_vec.fd, &st), SOL_ERNO_FILE);
+        log_vec.off = (sol_w64) st.st_size;
+
+#if (defined SOL_LOG_URING)
+                /* chunks written by io_uring are placed at explicit offsets,
+                 * which appending to the log file would override */
+        if (log_backend == SOL_LOG_BACKEND_URING) {
+                sol_assert ((flags = fcntl(log_vec.fd, F_GETFL)) >= 0
+                            && !fcntl(log_vec.fd, F_SETFL, flags & ~O_APPEND),
+                            SOL_ERNO_FILE);
+
+                sol_assert (ring_open(), SOL_ERNO_FILE);
+        }
+#endif
+
+SOL_CATCH:
+                /* release chunks */
+        sol_ptr_free((sol_ptr**) &log_vec.data);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      vec_close() - writes out chunks, and releases them
+ */
+static void vec_close(void)
+{
+        if (log_vec.data) {
+                vec_flush();
+
+#if (defined SOL_LOG_URING)
+                if (log_backend == SOL_LOG_BACKEND_URING) {
+                        while (log_vec.done != log_vec.head) {
+                                ring_reap(1);
+                        }
+
+                        ring_close();
+                }
+#endif
+
+                sol_ptr_free((sol_ptr**) &log_vec.data);
+        }
+}
+
+
+
+
+/*
+ *      sink_put() - writes bytes out to log file
+ *        - hnd: stream of log file
+ *        - src: bytes to write
+ *        - len: number of bytes
+ *
+ *      A single call is atomic with respect to other threads writing to the
+ *      log file with any backend.
+ */
+static sol_inline void sink_put(FILE *hnd,
+                                const sol_ptr *src,
+                                sol_size len)
+{
+        auto sol_w8 *dst;
+
+        if (log_backend == SOL_LOG_BACKEND_MMAP) {
+                if (sol_likely ((dst = map_claim(len)))) {
+                        sol_mem_copy(dst, src, len);
+                }
+
+                return;
+        }
+
+        if (log_backend == SOL_LOG_BACKEND_STDIO) {
+                (void) fwrite(src, 1, len, hnd);
+                return;
+        }
+
+        flockfile(hnd);
+        vec_put(src, len);
+        funlockfile(hnd);
+}
+
+
+
+
+/*
+ *      buf_flush() - writes out output buffer
+ */
+static void buf_flush(void)
+{
+        if (log_buf.len) {
+                sink_put(log_hnd, log_buf.data, log_buf.len);
+                log_buf.len = 0;
+        }
+}
+
+
+
+
+/*
+ *      buf_put() - appends bytes to output buffer
+ *        - src: bytes to append
+ *        - len: number of bytes
+ *
+ *      Bytes that don't fit in an empty buffer are written out directly.
+ */
+static sol_inline void buf_put(const sol_ptr *src,
+                               sol_size len)
+{
+        if (sol_unlikely (len > BUF_SZ - log_buf.len)) {
+                buf_flush();
+
+                if (len > BUF_SZ) {
+                        sink_put(log_hnd, src, len);
+                        return;
+                }
+        }
+
+        sol_mem_copy(log_buf.data + log_buf.len, src, len);
+        log_buf.len += len;
+}
+
+
+
+
+/*
+ *      site_put() - gets identifier of call site, writing its call site record
+ *                   if it's new to the binary log file
+ *        - desc: call site descriptor
+ */
+static sol_w32 site_put(const __sol_log_desc *desc)
+{
+        auto sol_w8 rec[BIN_SITE_SZ];
+        register sol_size flen, nlen;
+        auto __sol_log_site *st = desc->site;
+
+        if (sol_likely (st->gen == log_sites.gen)) {
+                return st->id;
+        }
+
+        st->id = log_sites.len++;
+        st->gen = log_sites.gen;
+
+        flen = str_len(desc->func, 0xffff);
+        nlen = str_len(desc->file, 0xffff);
+
+        buf_put(rec, bin_site(rec, desc, flen, nlen));
+        buf_put(desc->func, flen);
+        buf_put(desc->file, nlen);
+
+        return st->id;
+}
+
+
+
+
+/*
+ *      bin_write() - writes binary log entry
+ *        - desc: call site descriptor
+ *        - msg: log message
+ *
+ *      This function must be called with the log file stream locked.
+ */
+static void bin_write(const __sol_log_desc *desc,
+                      const char *msg)
+{
+        auto sol_w8 rec[BIN_ENTRY_SZ], *dst, *end;
+        register const char *src;
+        register sol_w64 ns;
+        register sol_size mlen;
+        register sol_w32 id;
+
+        id = site_put(desc);
+
+                /* copy the message straight into the buffer after room for
+                 * the entry record, measuring it on the way; fall back to
+                 * measuring it first if it doesn't fit */
+        ns = clock_ns(STAMP_CLOCK);
+        dst = log_buf.data + log_buf.len + BIN_ENTRY_SZ;
+        end = log_buf.data + BUF_SZ;
+
+        if (sol_likely (dst < end)) {
+                for (src = msg; *src && dst < end; *dst++ = (sol_w8) *src++);
+
+                if (sol_likely (!*src)) {
+                        mlen = (sol_size) (src - msg);
+                        log_buf.len += bin_entry(log_buf.data + log_buf.len,
+                                                 id, tid_get(), ns, mlen)
+                                       + mlen;
+                        return;
+                }
+        }
+
+        mlen = str_len(msg, 0xffffffff);
+        buf_put(rec, bin_entry(rec, id, tid_get(), ns, mlen));
+        buf_put(msg, mlen);
+}
+
+
+
+
+/*
+ *      MSG_SZ - size in bytes of formatted messages, including terminator
+ *      LINE_SZ - size in bytes of the text entries written out in one call
+ *      FLT_PREC - highest precision of floating point conversions
+ *      FLT_SZ - size in bytes of formatted floating point values
+ *
+ *      A sol_f64 holds no more than 17 significant digits, so the digits of a
+ *      floating point value beyond those are written out as zeros.
+ */
+#define MSG_SZ 1024
+#define LINE_SZ 2048
+#define FLT_PREC 40
+#define FLT_SZ 400
+
+
+
+
+/*
+ *      log_text - text buffers of thread
+ *        - msg: message formatted by __sol_log_writef()
+ *        - line: text entry being assembled by line_put()
+ */
+static sol_tls struct {
+        char msg[MSG_SZ];
+        char line[LINE_SZ];
+} log_text;
+
+
+
+
+/*
+ *      out - output cursor of formatter
+ *        - pos: next byte to write
+ *        - end: end of output buffer
+ *
+ *      Output beyond @end is silently dropped.
+ */
+typedef struct __out {
+        char *pos;
+        char *end;
+} out;
+
+
+
+
+/*
+ *      spec - conversion specification
+ *        - left: flag indicating left justification
+ *        - zero: flag indicating padding with zeros
+ *        - alt: flag indicating alternative form
+ *        - sign: sign character of non-negative values, or 0 if none
+ *        - width: minimum width of field
+ *        - prec: precision, or -1 if none
+ */
+typedef struct __spec {
+        int left;
+        int zero;
+        int alt;
+        char sign;
+        int width;
+        int prec;
+} spec;
+
+
+
+
+/*
+ *      POW10 - powers of ten that fit in a sol_w64
+ *      DIGITS - lowercase and uppercase digits
+ */
+static const sol_w64 POW10[] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+        10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+        100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+        100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+        100000000000000000ULL
+};
+
+static const char *DIGITS[] = {
+        "0123456789abcdef",
+        "0123456789ABCDEF"
+};
+
+
+
+
+/*
+ *      out_chr() - writes character
+ *      out_str() - writes string of known length
+ *      out_cstr() - writes null-terminated string
+ *      out_pad() - writes character repeatedly
+ *        - o: output cursor
+ *        - c: character
+ *        - str: string
+ *        - len: length of @str
+ *        - n: number of times to write @c; nothing is written if negative
+ *
+ *      The strings written are mostly a few bytes long, so they are copied a
+ *      byte at a time rather than through sol_mem_copy().
+ */
+static sol_inline void out_chr(out *o,
+                               char c)
+{
+        if (sol_likely (o->pos < o->end)) {
+                *o->pos++ = c;
+        }
+}
+
+static sol_inline void out_str(out *o,
+                               const char *str,
+                               sol_size len)
+{
+        while (len-- && o->pos < o->end) {
+                *o->pos++ = *str++;
+        }
+}
+
+static sol_inline void out_cstr(out *o,
+                                const char *str)
+{
+        while (*str && o->pos < o->end) {
+                *o->pos++ = *str++;
+        }
+}
+
+static sol_inline void out_pad(out *o,
+                               char c,
+                               int n)
+{
+        while (n-- > 0 && o->pos < o->end) {
+                *o->pos++ = c;
+        }
+}
+
+
+
+
+/*
+ *      out_field() - writes padded field
+ *        - o: output cursor
+ *        - sp: conversion specification
+ *        - pfx: prefix of field, such as a sign
+ *        - plen: length of @pfx
+ *        - body: body of field
+ *        - blen: length of @body
+ *        - zeros: number of zeros between @pfx and @body
+ */
+static void out_field(out *o,
+                      const spec *sp,
+                      const char *pfx,
+                      sol_size plen,
+                      const char *body,
+                      sol_size blen,
+                      int zeros)
+{
+        register int fill;
+
+        if (zeros < 0) {
+                zeros = 0;
+        }
+
+        fill = sp->width - (int) (plen + blen) - zeros;
+
+        if (!sp->left && !sp->zero) {
+                out_pad(o, ' ', fill);
+        }
+
+        out_str(o, pfx, plen);
+
+        if (!sp->left && sp->zero) {
+                out_pad(o, '0', fill);
+        }
+
+        out_pad(o, '0', zeros);
+        out_str(o, body, blen);
+
+        if (sp->left) {
+                out_pad(o, ' ', fill);
+        }
+}
+
+
+
+
+/*
+ *      dig_put() - formats integer backwards
+ *        - end: end of buffer
+ *        - val: value to format
+ *        - base: base of digits
+ *        - dig: digit set
+ *
+ *      Decimal digits are divided out by a constant, and hexadecimal and octal
+ *      digits are shifted out, so that no division instruction is issued.
+ *
+ *      Return:
+ *        - first digit written
+ */
+static sol_inline char *dig_put(char *end,
+                                sol_w64 val,
+                                unsigned base,
+                                const char *dig)
+{
+        register unsigned shift = base == 16 ? 4 : 3;
+
+        if (sol_likely (base == 10)) {
+                do {
+                        *--end = dig[val % 10];
+                        val /= 10;
+                } while (val);
+
+                return end;
+        }
+
+        do {
+                *--end = dig[val & (base - 1)];
+                val >>= shift;
+        } while (val);
+
+        return end;
+}
+
+
+
+
+/*
+ *      fmt_int() - formats integer conversion
+ *        - o: output cursor
+ *        - sp: conversion specification
+ *        - val: magnitude of value
+ *        - neg: flag indicating negative value
+ *        - base: base of digits
+ *        - upper: flag indicating uppercase digits
+ */
+static void fmt_int(out *o,
+                    spec *sp,
+                    sol_w64 val,
+                    int neg,
+                    unsigned base,
+                    int upper)
+{
+        auto char buf[24], pfx[2], *dig = buf + sizeof buf;
+        register sol_size plen = 0, blen;
+        register int zeros = 0;
+
+                /* a zero precision leaves no digits for a zero value */
+        if (val || sp->prec) {
+                dig = dig_put(dig, val, base, DIGITS[upper]);
+        }
+
+        blen = (sol_size) (buf + sizeof buf - dig);
+
+        if (neg || sp->sign) {
+                pfx[plen++] = neg ? '-' : sp->sign;
+        }
+
+        if (sp->alt && val && base == 16) {
+                pfx[plen++] = '0';
+                pfx[plen++] = upper ? 'X' : 'x';
+        }
+
+        if (sp->prec >= 0) {
+                zeros = sp->prec - (int) blen;
+                sp->zero = 0;
+        }
+
+        if (sp->alt && base == 8 && zeros < 1 && (!blen || *dig != '0')) {
+                zeros = 1;
+        }
+
+        out_field(o, sp, pfx, plen, dig, blen, zeros);
+}
+
+
+
+
+/*
+ *      flt_fix() - formats floating point value in fixed notation
+ *      flt_exp() - formats floating point value in exponent notation
+ *        - buf: buffer of FLT_SZ bytes
+ *        - val: non-negative finite value
+ *        - prec: precision, no higher than FLT_PREC
+ *        - alt: flag indicating that the decimal point is always written
+ *        - upper: flag indicating uppercase exponent
+ *        - exp: decimal exponent of @val after rounding
+ *
+ *      Return:
+ *        - length of formatted value
+ */
+static sol_size flt_fix(char *buf,
+                        sol_f64 val,
+                        int prec,
+                        int alt)
+{
+        register int p = prec < 17 ? prec : 17, scale = 0;
+        register sol_w64 ip, fp = 0;
+        auto char tmp[24], *dig, *pos = buf;
+
+                /* scale values too large for a sol_w64 down, making up for it
+                 * with zeros; their fractional part is lost in any case */
+        while (val >= 1e19) {
+                val /= 10;
+                scale++;
+        }
+
+        ip = (sol_w64) val;
+        if (!scale) {
+                fp = (sol_w64) ((val - (sol_f64) ip) * (sol_f64) POW10[p]
+                                + 0.5);
+                if (fp >= POW10[p]) {
+                        fp -= POW10[p];
+                        ip++;
+                }
+        }
+
+        dig = dig_put(tmp + sizeof tmp, ip, 10, DIGITS[0]);
+        while (dig < tmp + sizeof tmp) {
+                *pos++ = *dig++;
+        }
+
+        while (scale--) {
+                *pos++ = '0';
+        }
+
+        if (prec || alt) {
+                *pos++ = '.';
+        }
+
+                /* write fraction padded with leading zeros to @p digits, and
+                 * trailing zeros to @prec digits */
+        prec -= p;
+        if (p) {
+                dig = dig_put(tmp + sizeof tmp, fp, 10, DIGITS[0]);
+                for (; p > tmp + sizeof tmp - dig; p--) {
+                        *pos++ = '0';
+                }
+
+                while (dig < tmp + sizeof tmp) {
+                        *pos++ = *dig++;
+                }
+        }
+
+        while (prec-- > 0) {
+                *pos++ = '0';
+        }
+
+        return (sol_size) (pos - buf);
+}
+
+static sol_size flt_exp(char *buf,
+                        sol_f64 val,
+                        int prec,
+                        int alt,
+                        int upper,
+                        int *exp)
+{
+        register int p = prec < 16 ? prec : 16, x = 0;
+        register sol_w64 m;
+        auto char *pos = buf;
+
+                /* normalise @val to a single integral digit */
+        if (val != 0.0) {
+                for (; val >= 1e16; val /= 1e16, x += 16);
+                for (; val >= 10.0; val /= 10.0, x++);
+                for (; val < 1e-16; val *= 1e16, x -= 16);
+                for (; val < 1.0; val *= 10.0, x--);
+        }
+
+                /* round mantissa to @p digits, renormalising on overflow */
+        m = (sol_w64) (val * (sol_f64) POW10[p] + 0.5);
+        if (m >= POW10[p + 1]) {
+                m /= 10;
+                x++;
+        }
+
+        *pos++ = (char) ('0' + m / POW10[p]);
+        if (prec || alt) {
+                *pos++ = '.';
+        }
+
+        for (; p; p--, prec--) {
+                *pos++ = (char) ('0' + m / POW10[p - 1] % 10);
+        }
+
+        while (prec-- > 0) {
+                *pos++ = '0';
+        }
+
+        *pos++ = upper ? 'E' : 'e';
+        *pos++ = x < 0 ? '-' : '+';
+        *exp = x;
+
+        if (x < 0) {
+                x = -x;
+        }
+
+        if (x >= 100) {
+                *pos++ = (char) ('0' + x / 100);
+        }
+
+        *pos++ = (char) ('0' + x / 10 % 10);
+        *pos++ = (char) ('0' + x % 10);
+
+        return (sol_size) (pos - buf);
+}
+
+
+
+
+/*
+ *      flt_gen() - formats floating point value in general notation
+ *        - buf: buffer of FLT_SZ bytes
+ *        - val: non-negative finite value
+ *        - prec: number of significant digits, no higher than FLT_PREC
+ *        - alt: flag indicating that trailing zeros are kept
+ *        - upper: flag indicating uppercase exponent
+ *
+ *      Return:
+ *        - length of formatted value
+ */
+static sol_size flt_gen(char *buf,
+                        sol_f64 val,
+                        int prec,
+                        int alt,
+                        int upper)
+{
+        register sol_size len, end, cut;
+        auto int x;
+
+        if (!prec) {
+                prec = 1;
+        }
+
+                /* use fixed notation if the exponent is within the precision,
+                 * and exponent notation otherwise */
+        len = flt_exp(buf, val, prec - 1, alt, upper, &x);
+        if (x >= -4 && x < prec) {
+                len = flt_fix(buf, val, prec - 1 - x, alt);
+        }
+
+        if (alt) {
+                return len;
+        }
+
+                /* strip trailing zeros of the fraction, and a bare decimal
+                 * point, moving the exponent, if any, down over them */
+        for (end = 0; end < len && buf[end] != 'e' && buf[end] != 'E'; end++);
+        for (cut = 0; cut < end && buf[cut] != '.'; cut++);
+
+        if (cut == end) {
+                return len;
+        }
+
+        for (cut = end; buf[cut - 1] == '0'; cut--);
+        if (buf[cut - 1] == '.') {
+                cut--;
+        }
+
+        sol_mem_move(buf + cut, buf + end, len - end);
+        return len - (end - cut);
+}
+
+
+
+
+/*
+ *      fmt_flt() - formats floating point conversion
+ *        - o: output cursor
+ *        - sp: conversion specification
+ *        - val: value
+ *        - conv: conversion character
+ */
+static void fmt_flt(out *o,
+                    spec *sp,
+                    sol_f64 val,
+                    char conv)
+{
+        auto char buf[FLT_SZ], pfx;
+        auto int upper = conv >= 'A' && conv <= 'Z', prec = sp->prec, x;
+        auto sol_size len;
+
+        if (signbit(val)) {
+                pfx = '-';
+                val = -val;
+        } else {
+                pfx = sp->sign;
+        }
+
+        if (prec < 0) {
+                prec = 6;
+        } else if (prec > FLT_PREC) {
+                prec = FLT_PREC;
+        }
+
+        if (isnan(val) || isinf(val)) {
+                sp->zero = 0;
+                out_field(o, sp, &pfx, pfx != 0,
+                          isnan(val) ? (upper ? "NAN" : "nan")
+                                     : (upper ? "INF" : "inf"),
+                          3, 0);
+                return;
+        }
+
+        switch (conv | 0x20) {
+        case 'f':
+                len = flt_fix(buf, val, prec, sp->alt);
+                break;
+
+        case 'g':
+                len = flt_gen(buf, val, prec, sp->alt, upper);
+                break;
+
+        default:
+                len = flt_exp(buf, val, prec, sp->alt, upper, &x);
+                break;
+        }
+
+        out_field(o, sp, &pfx, pfx != 0, buf, len, 0);
+}
+
+
+
+
+/*
+ *      fmt_put() - formats message
+ *        - o: output cursor
+ *        - fmt: format string
+ *        - ap: arguments of @fmt
+ *
+ *      The conversions of printf() are recognised together with their flags,
+ *      widths, precisions and length modifiers, so that every argument is
+ *      consumed with its proper type. Hexadecimal floating point conversions
+ *      are formatted in exponent notation, %n conversions write nothing, and
+ *      an unknown conversion is copied out as is.
+ */
+static void fmt_put(out *o,
+                    const char *fmt,
+                    va_list ap)
+{
+        auto spec sp;
+        auto const char *lit, *str;
+        auto sol_w64 val;
+        auto sol_i64 sval;
+        auto char mod, conv;
+
+        for (;;) {
+                        /* copy literal text up to next conversion */
+                for (lit = fmt; *fmt && *fmt != '%'; fmt++);
+                out_str(o, lit, (sol_size) (fmt - lit));
+
+                if (!*fmt++) {
+                        return;
+                }
+
+                        /* parse flags */
+                sp.left = sp.zero = sp.alt = 0;
+                sp.sign = 0;
+                sp.width = 0;
+                sp.prec = -1;
+
+                for (;; fmt++) {
+                        if (*fmt == '-') {
+                                sp.left = 1;
+                        } else if (*fmt == '0') {
+                                sp.zero = 1;
+                        } else if (*fmt == '#') {
+                                sp.alt = 1;
+                        } else if (*fmt == '+') {
+                                sp.sign = '+';
+                        } else if (*fmt == ' ') {
+                                sp.sign = sp.sign ? sp.sign : ' ';
+                        } else {
+                                break;
+                        }
+                }
+
+                        /* parse width and precision */
+                if (*fmt == '*') {
+                        if ((sp.width = va_arg(ap, int)) < 0) {
+                                sp.left = 1;
+                                sp.width = -sp.width;
+                        }
+
+                        fmt++;
+                } else {
+                        for (; *fmt >= '0' && *fmt <= '9'; fmt++) {
+                                sp.width = sp.width * 10 + (*fmt - '0');
+                        }
+                }
+
+                if (*fmt == '.') {
+                        if (*++fmt == '*') {
+                                sp.prec = va_arg(ap, int);
+                                sp.prec = sp.prec < 0 ? -1 : sp.prec;
+                                fmt++;
+                        } else {
+                                for (sp.prec = 0; *fmt >= '0' && *fmt <= '9';
+                                     fmt++) {
+                                        sp.prec = sp.prec * 10 + (*fmt - '0');
+                                }
+                        }
+                }
+
+                if (sp.left) {
+                        sp.zero = 0;
+                }
+
+                        /* parse length modifier, folding hh into H and ll into
+                         * q */
+                mod = 0;
+                if (*fmt == 'h' || *fmt == 'l' || *fmt == 'z' || *fmt == 'j'
+                    || *fmt == 't' || *fmt == 'L') {
+                        mod = *fmt++;
+                        if ((mod == 'h' || mod == 'l') && *fmt == mod) {
+                                mod = mod == 'h' ? 'H' : 'q';
+                                fmt++;
+                        }
+                }
+
+                if (!(conv = *fmt++)) {
+                        return;
+                }
+
+                switch (conv) {
+                case 'd':
+                case 'i':
+                        switch (mod) {
+                        case 'H':
+                                sval = (signed char) va_arg(ap, int);
+                                break;
+                        case 'h':
+                                sval = (short) va_arg(ap, int);
+                                break;
+                        case 'l':
+                                sval = va_arg(ap, long);
+                                break;
+                        case 'q':
+                                sval = va_arg(ap, long long);
+                                break;
+                        case 'z':
+                                sval = (sol_i64) va_arg(ap, size_t);
+                                break;
+                        case 'j':
+                                sval = va_arg(ap, intmax_t);
+                                break;
+                        case 't':
+                                sval = va_arg(ap, ptrdiff_t);
+                                break;
+                        default:
+                                sval = va_arg(ap, int);
+                                break;
+                        }
+
+                        fmt_int(o, &sp, sval < 0 ? 0 - (sol_w64) sval
+                                                 : (sol_w64) sval,
+                                sval < 0, 10, 0);
+                        break;
+
+                case 'u':
+                case 'x':
+                case 'X':
+                case 'o':
+                        switch (mod) {
+                        case 'H':
+                                val = (unsigned char) va_arg(ap, unsigned);
+                                break;
+                        case 'h':
+                                val = (unsigned short) va_arg(ap, unsigned);
+                                break;
+                        case 'l':
+                                val = va_arg(ap, unsigned long);
+                                break;
+                        case 'q':
+                                val = va_arg(ap, unsigned long long);
+                                break;
+                        case 'z':
+                                val = va_arg(ap, size_t);
+                                break;
+                        case 'j':
+                                val = va_arg(ap, uintmax_t);
+                                break;
+                        case 't':
+                                val = (sol_w64) va_arg(ap, ptrdiff_t);
+                                break;
+                        default:
+                                val = va_arg(ap, unsigned);
+                                break;
+                        }
+
+                        sp.sign = 0;
+                        fmt_int(o, &sp, val, 0, conv == 'u'
+                                                ? 10 : conv == 'o' ? 8 : 16,
+                                conv == 'X');
+                        break;
+
+                case 'p':
+                        if ((val = (sol_w64) (uintptr_t) va_arg(ap, void*))) {
+                                sp.alt = 1;
+                                sp.sign = 0;
+                                fmt_int(o, &sp, val, 0, 16, 0);
+                        } else {
+                                sp.zero = 0;
+                                out_field(o, &sp, "", 0, "(nil)", 5, 0);
+                        }
+                        break;
+
+                case 's':
+                        if (!(str = va_arg(ap, const char*))) {
+                                str = "(null)";
+                        }
+
+                        sp.zero = 0;
+                        out_field(o, &sp, "", 0, str,
+                                  str_len(str, sp.prec < 0
+                                               ? SOL_SIZE_MAX
+                                               : (sol_size) sp.prec),
+                                  0);
+                        break;
+
+                case 'c':
+                        conv = (char) va_arg(ap, int);
+                        sp.zero = 0;
+                        out_field(o, &sp, "", 0, &conv, 1, 0);
+                        break;
+
+                case 'f':
+                case 'F':
+                case 'e':
+                case 'E':
+                case 'g':
+                case 'G':
+                case 'a':
+                case 'A':
+                        fmt_flt(o, &sp, mod == 'L'
+                                        ? (sol_f64) va_arg(ap, long double)
+                                        : va_arg(ap, double),
+                                conv);
+                        break;
+
+                case 'n':
+                        (void) va_arg(ap, void*);
+                        break;
+
+                case '%':
+                        out_chr(o, '%');
+                        break;
+
+                default:
+                        out_chr(o, '%');
+                        out_chr(o, conv);
+                        break;
+                }
+        }
+}
+
+
+
+
+/*
+ *      line_put() - writes out text entry
+ *        - hnd: log file stream
+ *        - type: log entry type
+ *        - stamp: formatted timestamp
+ *        - tid: thread identifier
+ *        - func: function name of log entry source
+ *        - file: file name of log entry source
+ *        - line: line number of log entry source
+ *        - msg: log message
+ *        - len: length of @msg, or SOL_SIZE_MAX if it is null-terminated
+ *
+ *      The entry is assembled in the line buffer of the thread and written
+ *      out by a single call to sink_put(). A message too long for the buffer
+ *      is written out piecemeal with the stream held locked instead, or in a
+ *      single claim on a memory-mapped log file.
+ */
+static void line_put(FILE *hnd,
+                     const char *type,
+                     const char *stamp,
+                     sol_w32 tid,
+                     const char *func,
+                     const char *file,
+                     int line,
+                     const char *msg,
+                     sol_size len)
+{
+        auto char num[12], *dig;
+        auto sol_w8 *dst;
+        auto sol_size plen;
+        auto out o;
+
+                /* assemble prefix, leaving room for the newline */
+        o.pos = log_text.line;
+        o.end = log_text.line + LINE_SZ - 1;
+
+        out_chr(&o, '[');
+        out_cstr(&o, type);
+        out_str(&o, "] [", 3);
+        out_cstr(&o, stamp);
+        out_str(&o, "] [#", 4);
+        dig = dig_put(num + sizeof num, tid, 10, DIGITS[0]);
+        out_str(&o, dig, (sol_size) (num + sizeof num - dig));
+        out_str(&o, "] [", 3);
+        out_cstr(&o, func);
+        out_str(&o, "():", 3);
+        out_cstr(&o, file);
+        out_chr(&o, ':');
+        dig = dig_put(num + sizeof num,
+                      line < 0 ? 0 - (sol_w64) line : (sol_w64) line, 10,
+                      DIGITS[0]);
+        if (line < 0) {
+                *--dig = '-';
+        }
+        out_str(&o, dig, (sol_size) (num + sizeof num - dig));
+        out_str(&o, "] ", 2);
+
+                /* copy message, measuring it on the way */
+        for (; len && *msg && o.pos < o.end; len--) {
+                *o.pos++ = *msg++;
+        }
+
+        if (sol_likely (!len || !*msg)) {
+                *o.pos++ = '\n';
+                sink_put(hnd, log_text.line,
+                         (sol_size) (o.pos - log_text.line));
+                return;
+        }
+
+                /* write out the rest of an overlong message separately; a
+                 * memory-mapped log file takes the whole entry in one claim */
+        if (log_backend == SOL_LOG_BACKEND_MMAP) {
+                plen = (sol_size) (o.pos - log_text.line);
+                len = str_len(msg, len);
+
+                if (sol_likely ((dst = map_claim(plen + len + 1)))) {
+                        sol_mem_copy(dst, log_text.line, plen);
+                        sol_mem_copy(dst + plen, msg, len);
+                        dst[plen + len] = '\n';
+                }
+
+                return;
+        }
+
+        flockfile(hnd);
+        if (log_backend == SOL_LOG_BACKEND_STDIO) {
+                (void) fwrite(log_text.line, 1,
+                              (sol_size) (o.pos - log_text.line), hnd);
+                for (; len && *msg; len--) {
+                        (void) putc_unlocked(*msg++, hnd);
+                }
+                (void) putc_unlocked('\n', hnd);
+        } else {
+                vec_put(log_text.line, (sol_size) (o.pos - log_text.line));
+                vec_put(msg, str_len(msg, len));
+                vec_put("\n", 1);
+        }
+        funlockfile(hnd);
+}
+
+
+
+
+        /* the asynchronous logging mode is compiled only if it has been
+         * requested */
+#if (defined SOL_LOG_ASYNC)
+
+
+
+
+/*
+ *      SLOT_SZ - size in bytes of a queue slot
+ *      WAIT_NS - longest time in nanoseconds that the idle writer sleeps
+ *      BUSY - busy mark of a queue whose thread is reading the clock
+ */
+#define SLOT_SZ 512
+#define WAIT_NS 10000000L
+#define BUSY 1
+
+
+
+
+/*
+ *      ORDER_CLOCK - clock read for ordering entries
+ *
+ *      Queued entries are stamped with a monotonic clock so that steps of the
+ *      real-time clock can't hold back the writer thread, and their stamps are
+ *      converted to real time as they are written out. The coarse clock is
+ *      preferred for the same reason as in the case of STAMP_CLOCK.
+ */
+#if (defined CLOCK_MONOTONIC_COARSE)
+#       define ORDER_CLOCK CLOCK_MONOTONIC_COARSE
+#else
+#       define ORDER_CLOCK CLOCK_MONOTONIC
+#endif
+
+
+
+
+/*
+ *      slot - queue slot
+ *        - ns: order stamp of entry
+ *        - seq: sequence number of slot
+ *        - len: length in bytes of message
+ *        - desc: descriptor of call site of entry
+ *        - tid: identifier of thread that logged entry
+ *        - msg: log message, without its terminating null character
+ *
+ *      The sequence number of a slot is its position in the queue while it is
+ *      free, one more than its position once it holds an entry, and advances
+ *      by the queue capacity when the entry is taken, so that the thread and
+ *      the writer thread can claim slots with a single compare-and-swap each.
+ *
+ *      Entries are queued unformatted, and are formatted by the writer thread.
+ *      The type and code location of an entry are held by the static
+ *      descriptor of its call site, so only its message needs to be copied.
+ */
+typedef struct __slot {
+        sol_w64 ns;
+        sol_size seq;
+        sol_size len;
+        const __sol_log_desc *desc;
+        sol_w32 tid;
+        char msg[SLOT_SZ - sizeof (sol_w64) - 2 * sizeof (sol_size)
+                 - sizeof (__sol_log_desc*) - sizeof (sol_w32)];
+} slot;
+
+
+
+
+/*
+ *      chan - entry queue of thread
+ *        - head: position of next slot to fill
+ *        - tail: position of next slot to take
+ *        - busy: busy mark
+ *        - ring: queue slots
+ *        - mask: queue capacity less one
+ *        - gen: session for which @ring has been allocated, or 0 if none
+ *        - dropped: count of dropped entries
+ *        - live: flag indicating that the queue is owned by a thread
+ *        - next: next queue
+ *
+ *      Each thread queues its entries on a queue of its own, so that threads
+ *      logging at the same time never contend with each other. The busy mark
+ *      of a queue is 0 while its thread is not queueing an entry, BUSY while
+ *      the thread reads the clock, and the stamp that it read after that; see
+ *      merge().
+ *
+ *      Queues are never freed, so that they can be reached safely from any
+ *      thread at any time. The queue of a thread that exits is adopted by the
+ *      next thread that needs one, and the slots of all queues are released by
+ *      sol_log_close(). @head, @tail and @busy are padded on to cache lines of
+ *      their own.
+ */
+typedef struct __chan {
+        union {
+                sol_size pos;
+                sol_w8 pad[64];
+        } head, tail;
+        union {
+                sol_w64 ns;
+                sol_w8 pad[64];
+        } busy;
+        slot *ring;
+        sol_size mask;
+        sol_size gen;
+        sol_size dropped;
+        int live;
+        struct __chan *next;
+} chan;
+
+
+
+
+/*
+ *      async - asynchronous mode state
+ *        - gen: session number
+ *        - cap: capacity of queues
+ *        - policy: back-pressure policy
+ *        - stop: flag indicating that the writer thread must exit
+ *        - idle: flag indicating that the writer thread is waiting
+ *        - hnd: handle to log file
+ *        - thrd: writer thread
+ *        - lock: lock guarding @cond
+ *        - cond: condition on which the idle writer thread waits
+ */
+typedef struct __async {
+        sol_size gen;
+        sol_size cap;
+        SOL_LOG_POLICY policy;
+        int stop;
+        int idle;
+        FILE *hnd;
+        pthread_t thrd;
+        pthread_mutex_t lock;
+        pthread_cond_t cond;
+} async;
+
+
+
+
+/*
+ *      log_async - asynchronous mode state of log file
+ *      log_gen - count of asynchronous mode sessions
+ *      log_chans - entry queues of all threads
+ *      log_chan - entry queue of thread
+ *      log_key - key used to release entry queue of thread on its exit
+ *      log_once - control for one-time initialisation of @log_key
+ */
+static async *log_async = SOL_PTR_NULL;
+static sol_size log_gen = 0;
+static chan *log_chans = SOL_PTR_NULL;
+static sol_tls chan *log_chan = SOL_PTR_NULL;
+static pthread_key_t log_key;
+static pthread_once_t log_once = PTHREAD_ONCE_INIT;
+
+
+
+
+/*
+ *      chan_exit() - releases entry queue when its thread exits
+ *        - arg: entry queue
+ */
+static void chan_exit(void *arg)
+{
+        __atomic_store_n(&((chan*) arg)->live, 0, __ATOMIC_RELEASE);
+}
+
+
+
+
+/*
+ *      key_init() - creates thread exit key
+ */
+static void key_init(void)
+{
+        (void) pthread_key_create(&log_key, &chan_exit);
+}
+
+
+
+
+/*
+ *      chan_get() - gets entry queue of thread for the current session
+ *        - as: contextual state
+ *
+ *      A thread logging its first entry adopts a queue released by an exited
+ *      thread, or else creates a new one. The slots of the queue are allocated
+ *      the first time that the thread logs an entry in each session.
+ *
+ *      Return:
+ *        - entry queue, or null if heap memory is exhausted
+ */
+static chan *chan_get(async *as)
+{
+        auto chan *ch = log_chan;
+        register sol_size i;
+        auto int live;
+
+        if (sol_likely (ch && __atomic_load_n(&ch->gen, __ATOMIC_RELAXED)
+                              == as->gen)) {
+                return ch;
+        }
+
+                /* adopt or create queue of thread */
+        if (!ch) {
+                for (ch = __atomic_load_n(&log_chans, __ATOMIC_ACQUIRE); ch;
+                     ch = ch->next) {
+                        live = 0;
+                        if (__atomic_compare_exchange_n(&ch->live, &live, 1, 0,
+                                                        __ATOMIC_ACQUIRE,
+                                                        __ATOMIC_RELAXED)) {
+                                break;
+                        }
+                }
+
+                if (!ch) {
+                        if (sol_unlikely (!(ch = malloc(sizeof *ch)))) {
+                                return SOL_PTR_NULL;
+                        }
+
+                        ch->ring = SOL_PTR_NULL;
+                        ch->gen = 0;
+                        ch->live = 1;
+                        ch->next = __atomic_load_n(&log_chans,
+                                                   __ATOMIC_RELAXED);
+                        while (!__atomic_compare_exchange_n(&log_chans,
+                                                            &ch->next, ch, 1,
+                                                            __ATOMIC_RELEASE,
+                                                            __ATOMIC_RELAXED));
+                }
+
+                (void) pthread_once(&log_once, &key_init);
+                (void) pthread_setspecific(log_key, ch);
+                log_chan = ch;
+
+                if (ch->gen == as->gen) {
+                        return ch;
+                }
+        }
+
+                /* allocate slots for the current session, and number them;
+                 * the release store of the session number publishes them to
+                 * the writer thread */
+        if (sol_unlikely (sol_ptr_new((sol_ptr**) &ch->ring,
+                                      as->cap * sizeof *ch->ring))) {
+                return SOL_PTR_NULL;
+        }
+
+        for (i = 0; i < as->cap; i++) {
+                ch->ring[i].seq = i;
+        }
+
+        ch->head.pos = ch->tail.pos = 0;
+        ch->busy.ns = 0;
+        ch->mask = as->cap - 1;
+        ch->dropped = 0;
+        __atomic_store_n(&ch->gen, as->gen, __ATOMIC_RELEASE);
+
+        return ch;
+}
+
+
+
+
+/*
+ *      chan_live() - checks whether entry queue is in use in current session
+ *        - as: contextual state
+ *        - ch: entry queue
+ */
+static sol_inline int chan_live(async *as,
+                                chan *ch)
+{
+        return __atomic_load_n(&ch->gen, __ATOMIC_ACQUIRE) == as->gen;
+}
+
+
+
+
+/*
+ *      slot_claim() - claims a free slot
+ *        - ch: entry queue
+ *        - pos: position of claimed slot
+ *
+ *      Returns null if the queue is full.
+ */
+static sol_inline slot *slot_claim(chan *ch,
+                                   sol_size *pos)
+{
+        auto sol_size p = __atomic_load_n(&ch->head.pos, __ATOMIC_RELAXED);
+        auto sol_int diff;
+        auto slot *sl;
+
+        for (;;) {
+                sl = &ch->ring[p & ch->mask];
+                diff = (sol_int) (__atomic_load_n(&sl->seq, __ATOMIC_ACQUIRE)
+                                  - p);
+
+                if (!diff) {
+                        if (__atomic_compare_exchange_n(&ch->head.pos, &p,
+                                                        p + 1, 1,
+                                                        __ATOMIC_RELAXED,
+                                                        __ATOMIC_RELAXED)) {
+                                *pos = p;
+                                return sl;
+                        }
+                } else if (diff < 0) {
+                        return SOL_PTR_NULL;
+                } else {
+                        p = __atomic_load_n(&ch->head.pos, __ATOMIC_RELAXED);
+                }
+        }
+}
+
+
+
+
+/*
+ *      slot_peek() - peeks at the oldest slot
+ *        - ch: entry queue
+ *        - pos: position of oldest slot
+ *
+ *      Returns null if the queue is empty, or if its oldest slot is still
+ *      being filled.
+ */
+static sol_inline slot *slot_peek(chan *ch,
+                                  sol_size *pos)
+{
+        auto sol_size p = __atomic_load_n(&ch->tail.pos, __ATOMIC_RELAXED);
+        auto slot *sl = &ch->ring[p & ch->mask];
+
+        *pos = p;
+        return __atomic_load_n(&sl->seq, __ATOMIC_ACQUIRE) == p + 1
+               ? sl
+               : SOL_PTR_NULL;
+}
+
+
+
+
+/*
+ *      slot_take() - takes the oldest slot
+ *        - ch: entry queue
+ *        - pos: expected position of oldest slot
+ *
+ *      Fails if the oldest slot has already been taken by another thread.
+ */
+static sol_inline int slot_take(chan *ch,
+                                sol_size pos)
+{
+        return __atomic_compare_exchange_n(&ch->tail.pos, &pos, pos + 1, 0,
+                                           __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+
+
+
+
+/*
+ *      slot_release() - frees a taken slot
+ *        - ch: entry queue
+ *        - sl: taken slot
+ *        - pos: position of @sl
+ */
+static sol_inline void slot_release(chan *ch,
+                                    slot *sl,
+                                    sol_size pos)
+{
+        __atomic_store_n(&sl->seq, pos + ch->mask + 1, __ATOMIC_RELEASE);
+}
+
+
+
+
+/*
+ *      slot_ready() - checks whether any queue holds an entry
+ *        - as: contextual state
+ */
+static int slot_ready(async *as)
+{
+        auto sol_size pos;
+        auto chan *ch;
+
+        for (ch = __atomic_load_n(&log_chans, __ATOMIC_ACQUIRE); ch;
+             ch = ch->next) {
+                if (chan_live(as, ch) && slot_peek(ch, &pos)) {
+                        return 1;
+                }
+        }
+
+        return 0;
+}
+
+
+
+
+/*
+ *      writer_wake() - wakes the writer thread if it's idle
+ *        - as: contextual state
+ *
+ *      The full fence orders the check of the idle flag after the publication
+ *      of the caller's entry, pairing with the fence in writer_wait().
+ */
+static void writer_wake(async *as)
+{
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        if (__atomic_load_n(&as->idle, __ATOMIC_RELAXED)) {
+                (void) pthread_mutex_lock(&as->lock);
+                (void) pthread_cond_signal(&as->cond);
+                (void) pthread_mutex_unlock(&as->lock);
+        }
+}
+
+
+
+
+/*
+ *      writer_wait() - waits for entries to be queued
+ *        - as: contextual state
+ *
+ *      The wait is bounded by WAIT_NS so that a missed wake-up only delays the
+ *      writer thread instead of stalling it.
+ */
+static void writer_wait(async *as)
+{
+        auto struct timespec ts;
+
+        (void) pthread_mutex_lock(&as->lock);
+        __atomic_store_n(&as->idle, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        if (!slot_ready(as) && !__atomic_load_n(&as->stop, __ATOMIC_ACQUIRE)) {
+                (void) clock_gettime(CLOCK_REALTIME, &ts);
+                if ((ts.tv_nsec += WAIT_NS) >= 1000000000L) {
+                        ts.tv_sec++;
+                        ts.tv_nsec -= 1000000000L;
+                }
+
+                (void) pthread_cond_timedwait(&as->cond, &as->lock, &ts);
+        }
+
+        __atomic_store_n(&as->idle, 0, __ATOMIC_RELAXED);
+        (void) pthread_mutex_unlock(&as->lock);
+}
+
+
+
+
+/*
+ *      entry_put() - writes out queued entry
+ *        - sl: slot holding entry
+ *        - ns: time of entry in nanoseconds since the epoch
+ */
+static void entry_put(const slot *sl,
+                      sol_w64 ns)
+{
+        auto sol_w8 rec[BIN_ENTRY_SZ];
+        auto struct timespec ts;
+        register sol_w32 id;
+
+        if (log_fmt == SOL_LOG_FORMAT_BINARY) {
+                id = site_put(sl->desc);
+                buf_put(rec, bin_entry(rec, id, sl->tid, ns, sl->len));
+                buf_put(sl->msg, sl->len);
+                return;
+        }
+
+        ts.tv_sec = (time_t) (ns / 1000000000ULL);
+        ts.tv_nsec = (long) (ns % 1000000000ULL);
+        line_put(log_hnd, LEVEL_TYPE[sl->desc->level], stamp_fmt(&ts),
+                 sl->tid, sl->desc->func, sl->desc->file, sl->desc->line,
+                 sl->msg, sl->len);
+}
+
+
+
+
+/*
+ *      merge() - writes out queued entries in time order
+ *        - as: contextual state
+ *
+ *      The queues are merged by the stamps of their entries. An entry can be
+ *      written out only once no thread can still queue an entry stamped before
+ *      it, so the clock is read first, and the entries stamped up to a bound
+ *      are written out. The bound is the clock reading, lowered to the stamp
+ *      of any entry that is being queued. A thread marks its queue busy before
+ *      it reads the clock, so a thread found idle can only queue entries that
+ *      are stamped no earlier than the clock reading, and a thread found
+ *      reading the clock is waited on until it has read it.
+ *
+ *      Return:
+ *        - number of entries written out
+ */
+static sol_size merge(async *as)
+{
+        auto sol_size n = 0, pos, mpos = 0;
+        auto sol_w64 bound, next, off, ns, mns = 0;
+        auto chan *ch, *min;
+        auto slot *sl, *msl = SOL_PTR_NULL;
+
+                /* read the clocks, taking the offset of real time from order
+                 * stamps, and lower the bound to the stamps of busy queues */
+        off = clock_ns(STAMP_CLOCK);
+        bound = clock_ns(ORDER_CLOCK);
+        off -= bound;
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        for (ch = __atomic_load_n(&log_chans, __ATOMIC_ACQUIRE); ch;
+             ch = ch->next) {
+                if (chan_live(as, ch)) {
+                        while ((ns = __atomic_load_n(&ch->busy.ns,
+                                                     __ATOMIC_ACQUIRE))
+                               == BUSY) {
+                                (void) sched_yield();
+                        }
+
+                        if (ns && ns < bound) {
+                                bound = ns;
+                        }
+                }
+        }
+
+                /* find the queue with the oldest entry within the bound, and
+                 * write out its entries up to the stamp of the next oldest
+                 * queue, for as long as there is such a queue; an entry being
+                 * dropped by its thread at the same time ends the run */
+        for (;;) {
+                min = SOL_PTR_NULL;
+                next = bound;
+
+                for (ch = __atomic_load_n(&log_chans, __ATOMIC_ACQUIRE); ch;
+                     ch = ch->next) {
+                        if (chan_live(as, ch) && (sl = slot_peek(ch, &pos))
+                            && (ns = __atomic_load_n(&sl->ns,
+                                                     __ATOMIC_RELAXED))
+                               <= bound) {
+                                if (!min || ns < mns) {
+                                        if (min) {
+                                                next = mns;
+                                        }
+
+                                        min = ch;
+                                        msl = sl;
+                                        mpos = pos;
+                                        mns = ns;
+                                } else if (ns < next) {
+                                        next = ns;
+                                }
+                        }
+                }
+
+                if (!min) {
+                        return n;
+                }
+
+                do {
+                        if (!slot_take(min, mpos)) {
+                                break;
+                        }
+
+                        entry_put(msl, mns + off);
+                        slot_release(min, msl, mpos);
+                        n++;
+                } while ((msl = slot_peek(min, &mpos))
+                         && (mns = __atomic_load_n(&msl->ns, __ATOMIC_RELAXED))
+                            <= next);
+        }
+}
+
+
+
+
+/*
+ *      sink_flush() - hands buffered bytes of log file over to the kernel
+ *        - hnd: stream of log file
+ */
+static void sink_flush(FILE *hnd)
+{
+        if (log_backend == SOL_LOG_BACKEND_STDIO) {
+                (void) fflush(hnd);
+        } else if (log_backend != SOL_LOG_BACKEND_MMAP) {
+                flockfile(hnd);
+                vec_flush();
+                funlockfile(hnd);
+        }
+}
+
+
+
+
+/*
+ *      writer() - writer thread
+ *        - arg: contextual state
+ *
+ *      The writer thread merges the queued entries in batches, flushing the log
+ *      file once per batch, and exits only once it has been asked to stop and
+ *      a batch taken after that request finds the queues empty.
+ */
+static void *writer(void *arg)
+{
+        auto async *as = arg;
+        auto sol_size n;
+        auto int stop;
+
+        do {
+                stop = __atomic_load_n(&as->stop, __ATOMIC_ACQUIRE);
+
+                if ((n = merge(as))) {
+                        buf_flush();
+                        sink_flush(as->hnd);
+                } else if (!stop) {
+                        writer_wait(as);
+                }
+        } while (n || !stop);
+
+        return SOL_PTR_NULL;
+}
+
+
+
+
+/*
+ *      async_write() - queues a log entry
+ *        - as: contextual state
+ *        - desc: call site descriptor
+ *        - msg: log message
+ *
+ *      Messages longer than a slot can hold are truncated.
+ */
+static void async_write(async *as,
+                        const __sol_log_desc *desc,
+                        const char *msg)
+{
+        register sol_size len;
+        auto sol_size pos;
+        auto slot *sl;
+        auto sol_w64 ns;
+        auto chan *ch;
+
+        if (sol_unlikely (!(ch = chan_get(as)))) {
+                return;
+        }
+
+                /* mark queue busy before reading the clock, and then mark it
+                 * with the stamp read; see merge() */
+        __atomic_store_n(&ch->busy.ns, BUSY, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        ns = clock_ns(ORDER_CLOCK);
+        __atomic_store_n(&ch->busy.ns, ns, __ATOMIC_RELAXED);
+
+                /* claim a slot, applying the back-pressure policy for as long
+                 * as the queue is full */
+        while (sol_unlikely (!(sl = slot_claim(ch, &pos)))) {
+                if (as->policy == SOL_LOG_POLICY_DROP_NEWEST) {
+                        (void) __atomic_fetch_add(&ch->dropped, 1,
+                                                  __ATOMIC_RELAXED);
+                        __atomic_store_n(&ch->busy.ns, 0, __ATOMIC_RELEASE);
+                        return;
+                }
+
+                if (as->policy == SOL_LOG_POLICY_DROP_OLDEST
+                    && (sl = slot_peek(ch, &pos)) && slot_take(ch, pos)) {
+                        slot_release(ch, sl, pos);
+                        (void) __atomic_fetch_add(&ch->dropped, 1,
+                                                  __ATOMIC_RELAXED);
+                        continue;
+                }
+
+                writer_wake(as);
+                (void) sched_yield();
+        }
+
+                /* copy entry into slot, publish it, and clear busy mark */
+        for (len = 0; len < sizeof sl->msg && msg[len]; len++) {
+                sl->msg[len] = msg[len];
+        }
+
+        __atomic_store_n(&sl->ns, ns, __ATOMIC_RELAXED);
+        sl->len = len;
+        sl->desc = desc;
+        sl->tid = tid_get();
+        __atomic_store_n(&sl->seq, pos + 1, __ATOMIC_RELEASE);
+        __atomic_store_n(&ch->busy.ns, 0, __ATOMIC_RELEASE);
+
+                /* wake the writer thread only once the queue is half full, so
+                 * that entries are written in batches and callers rarely pay
+                 * for a wake-up; a sleeping writer thread otherwise picks up
+                 * entries within WAIT_NS */
+        if (pos - __atomic_load_n(&ch->tail.pos, __ATOMIC_RELAXED)
+            >= ch->mask >> 1) {
+                writer_wake(as);
+        }
+}
+
+
+
+
+/*
+ *      async_stop() - stops asynchronous mode
+ *        - as: contextual state
+ *
+ *      Asks the writer thread to stop, waits for it to write out the queued
+ *      entries, and releases @as along with the slots of the queues.
+ */
+static void async_stop(async *as)
+{
+        auto chan *ch;
+
+        __atomic_store_n(&as->stop, 1, __ATOMIC_RELEASE);
+        (void) pthread_mutex_lock(&as->lock);
+        (void) pthread_cond_signal(&as->cond);
+        (void) pthread_mutex_unlock(&as->lock);
+        (void) pthread_join(as->thrd, SOL_PTR_NULL);
+
+        for (ch = __atomic_load_n(&log_chans, __ATOMIC_ACQUIRE); ch;
+             ch = ch->next) {
+                if (chan_live(as, ch)) {
+                        sol_ptr_free((sol_ptr**) &ch->ring);
+                        __atomic_store_n(&ch->gen, 0, __ATOMIC_RELAXED);
+                }
+        }
+
+        (void) pthread_cond_destroy(&as->cond);
+        (void) pthread_mutex_destroy(&as->lock);
+        sol_ptr_free((sol_ptr**) &as);
+}
+
+
+
+
+#endif /* defined SOL_LOG_ASYNC */
+
+
+
+
+/*
+ *      LIMIT_CLOCK - clock read for rate limits
+ *      LIMIT_WIN - default length in nanoseconds of the seconds counted by rate
+ *      limits
+ *
+ *      The coarse monotonic clock is preferred for the same reason as in the
+ *      case of STAMP_CLOCK, and is only read by calls that exceed the rate.
+ */
+#if (defined CLOCK_MONOTONIC_COARSE)
+#       define LIMIT_CLOCK CLOCK_MONOTONIC_COARSE
+#else
+#       define LIMIT_CLOCK CLOCK_MONOTONIC
+#endif
+
+#define LIMIT_WIN 1000000000ULL
+
+
+
+
+/*
+ *      log_limit - rate limits
+ *        - rate: most entries written per call site per second, or 0
+ *        - sample: number of calls per call site for each entry sampled
+ *        - win: length in nanoseconds of each second
+ */
+static struct {
+        sol_uint rate;
+        sol_uint sample;
+        sol_w64 win;
+} log_limit = {0, 1, LIMIT_WIN};
+
+
+
+
+/*
+ *      entry_write() - writes a log entry to open log file
+ *        - hnd: stream of log file
+ *        - desc: call site descriptor
+ *        - msg: log message, which is required to be non-empty
+ */
+static void entry_write(FILE *hnd,
+                        const __sol_log_desc *desc,
+                        const char *msg)
+{
+#if (defined SOL_LOG_ASYNC)
+        auto async *as;
+
+        if ((as = __atomic_load_n(&log_async, __ATOMIC_ACQUIRE))) {
+                async_write(as, desc, msg);
+                return;
+        }
+#endif
+
+                /* in synchronous mode, entries of concurrent threads are
+                 * serialised by the lock of the log file stream */
+        if (log_fmt == SOL_LOG_FORMAT_BINARY) {
+                flockfile(hnd);
+                bin_write(desc, msg);
+                funlockfile(hnd);
+                return;
+        }
+
+        line_put(hnd, LEVEL_TYPE[desc->level], stamp_get(), tid_get(),
+                 desc->func, desc->file, desc->line, msg, SOL_SIZE_MAX);
+}
 
 
 
 
 /*
- *      log_hnd - handle to log file
+ *      site_renew() - counts a call beyond the rate of a call site
+ *        - hnd: stream of log file
+ *        - desc: call site descriptor
+ *        - n: count of earlier calls of call site in current second
+ *        - rate: most entries written per second
+ *        - sample: number of calls for each entry sampled
+ *
+ *      The first call of a call site starts its first second. Later calls that
+ *      exceed the rate are dropped until the second is over; the call that
+ *      finds it over starts the next second, and writes out an entry with the
+ *      count of the calls dropped in the previous one. If several calls find
+ *      the second over at once, only one of them starts the next one.
+ *
+ *      Return:
+ *        - 0 if the call is to be dropped
+ *        - 1 if the call is to be written
+ */
+static int site_renew(FILE *hnd,
+                      const __sol_log_desc *desc,
+                      sol_w32 n,
+                      sol_uint rate,
+                      sol_uint sample)
+{
+        auto __sol_log_site *site = desc->site;
+        auto char msg[64], num[12], *dig;
+        register sol_w64 now;
+        auto sol_w64 start;
+        register sol_w32 old, pass;
+        auto out o;
+
+        now = clock_ns(LIMIT_CLOCK);
+        start = __atomic_load_n(&site->start, __ATOMIC_RELAXED);
+
+        if (!n) {
+                __atomic_store_n(&site->start, now, __ATOMIC_RELAXED);
+                return 1;
+        }
+
+        if (now - start < __atomic_load_n(&log_limit.win, __ATOMIC_RELAXED)
+            || !__atomic_compare_exchange_n(&site->start, &start, now, 0,
+                                            __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                return 0;
+        }
+
+                /* count this call as the first of the next second, and the
+                 * calls of the previous second that weren't written out as
+                 * dropped */
+        old = __atomic_exchange_n(&site->calls, 1, __ATOMIC_RELAXED) - 1;
+        pass = (sol_w32) ((old + sample - 1) / sample);
+        if (pass > rate) {
+                pass = (sol_w32) rate;
+        }
+
+        if (old > pass) {
+                o.pos = msg;
+                o.end = msg + sizeof msg - 1;
+                out_str(&o, "Dropped ", 8);
+                dig = dig_put(num + sizeof num, old - pass, 10, DIGITS[0]);
+                out_str(&o, dig, (sol_size) (num + sizeof num - dig));
+                out_cstr(&o, " entries of this call site in the last second.");
+                *o.pos = '\0';
+                entry_write(hnd, desc, msg);
+        }
+
+        return 1;
+}
+
+
+
+
+/*
+ *      site_pass() - applies rate limits to a call
+ *        - hnd: stream of log file
+ *        - desc: call site descriptor
+ *
+ *      No atomic operation is performed on @site unless rate limits are set,
+ *      and even then, only a relaxed atomic addition is performed unless the
+ *      call is the first of the call site or exceeds its rate.
+ *
+ *      Return:
+ *        - 0 if the call is to be dropped
+ *        - 1 if the call is to be written
  */
-static sol_tls FILE *log_hnd = SOL_PTR_NULL;
+static sol_inline int site_pass(FILE *hnd,
+                                const __sol_log_desc *desc)
+{
+        register sol_uint rate, sample;
+        register sol_w32 n;
+
+        rate = __atomic_load_n(&log_limit.rate, __ATOMIC_RELAXED);
+        sample = __atomic_load_n(&log_limit.sample, __ATOMIC_RELAXED);
+
+        if (sol_likely (!rate && sample == 1)) {
+                return 1;
+        }
+
+        n = __atomic_fetch_add(&desc->site->calls, 1, __ATOMIC_RELAXED);
+        if (n % sample) {
+                return 0;
+        }
+
+        if (!rate || (sol_likely (n) && n / sample < rate)) {
+                return 1;
+        }
+
+        return site_renew(hnd, desc, n, rate, sample);
+}
 
 
 
@@ -48,15 +3064,19 @@ static sol_tls FILE *log_hnd = SOL_PTR_NULL;
  */
 extern sol_erno sol_log_open(const char *path)
 {
+        auto FILE *hnd;
+
 SOL_TRY:
                 /* check preconditions */
         sol_assert (!log_hnd, SOL_ERNO_STATE);
         sol_assert (path && *path, SOL_ERNO_STR);
 
                 /* open the log file using the standard fopen() function
-                 * provided by the libc module */
-        log_hnd = fopen(path, "w"); /* NOLINT */
-        sol_assert (log_hnd, SOL_ERNO_FILE);
+                 * provided by the libc module, and publish it to all
+                 * threads */
+        hnd = fopen(path, "w"); /* NOLINT */
+        sol_assert (hnd, SOL_ERNO_FILE);
+        __atomic_store_n(&log_hnd, hnd, __ATOMIC_RELEASE);
 
 SOL_CATCH:
                 /* nothing to do if an exception occurs */
@@ -75,15 +3095,19 @@ SOL_FINALLY:
 extern sol_erno sol_log_open2(const char *path,
                               const int flush)
 {
+        auto FILE *hnd;
+
 SOL_TRY:
                 /* check preconditions */
         sol_assert (!log_hnd, SOL_ERNO_STATE);
         sol_assert (path && *path, SOL_ERNO_STR);
 
-                /* open the log file, flushing it if required; we use the
-                 * standard fopen() function provided by the libc module */
-        log_hnd = fopen(path, flush ? "w" : "a+");
-        sol_assert (log_hnd, SOL_ERNO_FILE);
+                /* open the log file, flushing it if required, and publish it
+                 * to all threads; we use the standard fopen() function
+                 * provided by the libc module */
+        hnd = fopen(path, flush ? "w" : "a+");
+        sol_assert (hnd, SOL_ERNO_FILE);
+        __atomic_store_n(&log_hnd, hnd, __ATOMIC_RELEASE);
 
 SOL_CATCH:
                 /* nothing to do if an exception occurs */
@@ -96,17 +3120,541 @@ SOL_FINALLY:
 
 
 
+/*
+ *      sol_log_open3() - declared in sol/inc/log.h
+ */
+extern sol_erno sol_log_open3(const char *path,
+                              int flush,
+                              SOL_LOG_FORMAT fmt)
+{
+        return sol_log_open4(path, flush, fmt, SOL_LOG_BACKEND_STDIO);
+}
+
+
+
+
+/*
+ *      sol_log_open4() - declared in sol/inc/log.h
+ */
+extern sol_erno sol_log_open4(const char *path,
+                              int flush,
+                              SOL_LOG_FORMAT fmt,
+                              SOL_LOG_BACKEND backend)
+{
+        auto FILE *hnd = SOL_PTR_NULL;
+        auto sol_w8 *dst;
+        auto int map;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (!log_hnd, SOL_ERNO_STATE);
+        sol_assert (path && *path, SOL_ERNO_STR);
+        sol_assert (fmt == SOL_LOG_FORMAT_TEXT || fmt == SOL_LOG_FORMAT_BINARY,
+                    SOL_ERNO_RANGE);
+        sol_assert (backend >= SOL_LOG_BACKEND_STDIO
+                    && backend <= SOL_LOG_BACKEND_URING, SOL_ERNO_RANGE);
+#if (!defined SOL_LOG_URING)
+        sol_assert (backend != SOL_LOG_BACKEND_URING, SOL_ERNO_STATE);
+#endif
+
+                /* open the log file, flushing it if required; binary log
+                 * files are opened in binary mode, and memory-mapped log files
+                 * need to be readable in order to be mapped */
+        map = backend == SOL_LOG_BACKEND_MMAP;
+        if (fmt == SOL_LOG_FORMAT_BINARY) {
+                hnd = fopen(path, flush ? (map ? "w+b" : "wb")
+                                        : (map ? "a+b" : "ab"));
+        } else {
+                hnd = fopen(path, flush ? (map ? "w+" : "w") : "a+");
+        }
+
+        sol_assert (hnd, SOL_ERNO_FILE);
+        log_backend = backend;
+
+        if (map) {
+                sol_assert (map_open(hnd), SOL_ERNO_FILE);
+        } else if (backend != SOL_LOG_BACKEND_STDIO) {
+                sol_try (vec_open(hnd));
+        }
+
+                /* start binary log files with their magic bytes, unless they
+                 * are being appended to */
+        if (fmt == SOL_LOG_FORMAT_BINARY) {
+                if (map) {
+                        if (!log_map.len) {
+                                sol_assert ((dst = map_claim(BIN_MAGIC_SZ)),
+                                            SOL_ERNO_FILE);
+                                sol_mem_copy(dst, BIN_MAGIC, BIN_MAGIC_SZ);
+                        }
+                } else if (log_vec.data) {
+                        if (!log_vec.off) {
+                                vec_put(BIN_MAGIC, BIN_MAGIC_SZ);
+                        }
+                } else {
+                        sol_assert (!fseek(hnd, 0, SEEK_END), SOL_ERNO_FILE);
+                        if (!ftell(hnd)) {
+                                sol_assert (fwrite(BIN_MAGIC, 1, BIN_MAGIC_SZ,
+                                                   hnd) == BIN_MAGIC_SZ,
+                                            SOL_ERNO_FILE);
+                        }
+                }
+
+                sol_try (sol_ptr_new((sol_ptr**) &log_buf.data, BUF_SZ));
+                log_buf.len = 0;
+        }
+
+        log_fmt = fmt;
+        __atomic_store_n(&log_hnd, hnd, __ATOMIC_RELEASE);
+
+SOL_CATCH:
+                /* unmap and close log file if it was opened */
+        if (hnd) {
+                map_close();
+                vec_close();
+                (void) fclose(hnd);
+                log_backend = SOL_LOG_BACKEND_STDIO;
+        }
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
 /*
  *      sol_log_close() - declared in sol/inc/log.h
  */
 extern void sol_log_close(void)
 {
+        auto FILE *hnd = log_hnd;
+#if (defined SOL_LOG_ASYNC)
+        auto async *as = log_async;
+#endif
+
                 /* close log file if it's open; we use the standard fclose()
                  * function provided by the libc module */
-        if (log_hnd) {
-                (void) fclose(log_hnd);
-                log_hnd = SOL_PTR_NULL;
+        if (hnd) {
+#if (defined SOL_LOG_ASYNC)
+                        /* drain the queues first if in asynchronous mode */
+                if (as) {
+                        __atomic_store_n(&log_async, SOL_PTR_NULL,
+                                         __ATOMIC_RELEASE);
+                        async_stop(as);
+                }
+#endif
+
+                        /* write out buffered records of binary log file */
+                if (log_buf.data) {
+                        buf_flush();
+                        sol_ptr_free((sol_ptr**) &log_buf.data);
+                }
+
+                __atomic_store_n(&log_hnd, SOL_PTR_NULL, __ATOMIC_RELEASE);
+                map_close();
+                vec_close();
+                (void) fclose(hnd);
+
+                        /* forget call sites of binary log file by starting
+                         * a new session, skipping 0 on wrapping around since
+                         * call sites that have never logged are in session 0 */
+                if (!++log_sites.gen) {
+                        log_sites.gen = 1;
+                }
+
+                log_sites.len = 0;
+                log_fmt = SOL_LOG_FORMAT_TEXT;
+                log_backend = SOL_LOG_BACKEND_STDIO;
+        }
+}
+
+
+
+
+/*
+ *      sol_log_async() - declared in sol/inc/log.h
+ */
+#if (defined SOL_LOG_ASYNC)
+extern sol_erno sol_log_async(sol_size cap,
+                              SOL_LOG_POLICY policy)
+{
+        auto async *as = SOL_PTR_NULL;
+        auto sol_size n = 1;
+        auto int sync = 0;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (log_hnd && !log_async, SOL_ERNO_STATE);
+        sol_assert (cap && cap <= SOL_SIZE_MAX / (2 * sizeof (slot)),
+                    SOL_ERNO_RANGE);
+        sol_assert (policy >= SOL_LOG_POLICY_BLOCK
+                    && policy <= SOL_LOG_POLICY_DROP_OLDEST, SOL_ERNO_RANGE);
+
+                /* allocate state for a new session, rounding the capacity of
+                 * the queues up to a power of two; the queues themselves are
+                 * allocated by their threads as they log their first entries
+                 * in the session */
+        while (n < cap) {
+                n <<= 1;
+        }
+
+        sol_try (sol_ptr_new((sol_ptr**) &as, sizeof *as));
+        as->gen = ++log_gen;
+        as->cap = n;
+        as->policy = policy;
+        as->stop = as->idle = 0;
+        as->hnd = log_hnd;
+
+                /* start writer thread, once records already buffered by a
+                 * binary log file have been written out ahead of it */
+        if (log_buf.data) {
+                buf_flush();
+        }
+
+        sol_assert (!pthread_mutex_init(&as->lock, SOL_PTR_NULL),
+                    SOL_ERNO_HEAP);
+        sync++;
+        sol_assert (!pthread_cond_init(&as->cond, SOL_PTR_NULL),
+                    SOL_ERNO_HEAP);
+        sync++;
+        sol_assert (!pthread_create(&as->thrd, SOL_PTR_NULL, &writer, as),
+                    SOL_ERNO_HEAP);
+
+        __atomic_store_n(&log_async, as, __ATOMIC_RELEASE);
+
+SOL_CATCH:
+                /* log current error, and release partially created state */
+        sol_log_erno(sol_erno_get());
+
+        if (as) {
+                if (sync > 1) {
+                        (void) pthread_cond_destroy(&as->cond);
+                }
+
+                if (sync) {
+                        (void) pthread_mutex_destroy(&as->lock);
+                }
+
+                sol_ptr_free((sol_ptr**) &as);
+        }
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+#else
+extern sol_erno sol_log_async(sol_size cap,
+                              SOL_LOG_POLICY policy)
+{
+        (void) cap;
+        (void) policy;
+        return SOL_ERNO_STATE;
+}
+#endif
+
+
+
+
+/*
+ *      sol_log_dropped() - declared in sol/inc/log.h
+ */
+extern sol_erno sol_log_dropped(sol_size *dropped)
+{
+#if (defined SOL_LOG_ASYNC)
+        auto async *as;
+        auto chan *ch;
+#endif
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (dropped, SOL_ERNO_PTR);
+
+                /* return count of entries dropped by all threads, which is
+                 * always zero in synchronous mode */
+        *dropped = 0;
+#if (defined SOL_LOG_ASYNC)
+        if ((as = __atomic_load_n(&log_async, __ATOMIC_ACQUIRE))) {
+                for (ch = __atomic_load_n(&log_chans, __ATOMIC_ACQUIRE); ch;
+                     ch = ch->next) {
+                        if (chan_live(as, ch)) {
+                                *dropped += __atomic_load_n(&ch->dropped,
+                                                            __ATOMIC_RELAXED);
+                        }
+                }
+        }
+#endif
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_log_level() - declared in sol/inc/log.h
+ */
+extern sol_erno sol_log_level(int *level)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (level, SOL_ERNO_PTR);
+
+                /* return runtime log level */
+        *level = __atomic_load_n(&__sol_log_lvl, __ATOMIC_RELAXED);
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_log_level_set() - declared in sol/inc/log.h
+ */
+extern sol_erno sol_log_level_set(int level)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (level >= SOL_LOG_LEVEL_TRACE
+                    && level <= SOL_LOG_LEVEL_NONE, SOL_ERNO_RANGE);
+
+                /* update runtime log level; a relaxed store suffices since
+                 * the logging macros need not see the change immediately */
+        __atomic_store_n(&__sol_log_lvl, level, __ATOMIC_RELAXED);
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_log_limit() - declared in sol/inc/log.h
+ */
+extern sol_erno sol_log_limit(sol_uint *rate,
+                              sol_uint *sample)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (rate && sample, SOL_ERNO_PTR);
+
+                /* return runtime rate limits */
+        *rate = __atomic_load_n(&log_limit.rate, __ATOMIC_RELAXED);
+        *sample = __atomic_load_n(&log_limit.sample, __ATOMIC_RELAXED);
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_log_limit_set() - declared in sol/inc/log.h
+ */
+extern sol_erno sol_log_limit_set(sol_uint rate,
+                                  sol_uint sample)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (sample, SOL_ERNO_RANGE);
+
+                /* update runtime rate limits; relaxed stores suffice for the
+                 * same reason as in sol_log_level_set(), and a call that sees
+                 * only one of them applies the old value of the other */
+        __atomic_store_n(&log_limit.rate, rate, __ATOMIC_RELAXED);
+        __atomic_store_n(&log_limit.sample, sample, __ATOMIC_RELAXED);
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      __sol_log_limit_win() - declared in sol/inc/log.h
+ */
+extern void __sol_log_limit_win(sol_w64 win)
+{
+        __atomic_store_n(&log_limit.win, win, __ATOMIC_RELAXED);
+}
+
+
+
+
+/*
+ *      sol_log_decode() - declared in sol/inc/log.h
+ */
+extern sol_erno sol_log_decode(const char *src,
+                               const char *dst)
+{
+        const char *FMT = "[%c] [%s] [#%lu] [%s():%s:%d] %.*s\n";
+        auto FILE *in = SOL_PTR_NULL, *out = SOL_PTR_NULL;
+        auto struct {
+                char *func;
+                char *file;
+                int line;
+                char type;
+        } *tbl = SOL_PTR_NULL, *st;
+        auto char *msg = SOL_PTR_NULL;
+        auto sol_size cap = 0, mcap = 0, nsite = 0, id, tid, len, flen, nlen;
+        auto sol_w8 rec[BIN_ENTRY_SZ];
+        auto struct timespec ts;
+        auto sol_w64 ns;
+        auto int tag;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (src && *src && dst && *dst, SOL_ERNO_STR);
+
+                /* open log files, checking magic bytes of binary log file */
+        in = fopen(src, "rb");
+        sol_assert (in, SOL_ERNO_FILE);
+        out = fopen(dst, "w");
+        sol_assert (out, SOL_ERNO_FILE);
+
+        sol_assert (fread(rec, 1, BIN_MAGIC_SZ, in) == BIN_MAGIC_SZ
+                    && !sol_mem_cmp(rec, BIN_MAGIC, BIN_MAGIC_SZ),
+                    SOL_ERNO_FILE);
+
+                /* decode records in turn */
+        while ((tag = fgetc(in)) != EOF) {
+                        /* a call site record defines or redefines a call
+                         * site, growing the call site table as required; call
+                         * sites are numbered in turn from 0 in each session,
+                         * so an identifier beyond the next one is corrupt */
+                if (tag == BIN_SITE) {
+                        sol_assert (fread(rec + 1, 1, BIN_SITE_SZ - 1, in)
+                                    == BIN_SITE_SZ - 1, SOL_ERNO_FILE);
+                        id = (sol_size) get_le(rec + 1, 4);
+                        flen = (sol_size) get_le(rec + 10, 2);
+                        nlen = (sol_size) get_le(rec + 12, 2);
+
+                        sol_assert (id <= nsite, SOL_ERNO_FILE);
+                        if (id == nsite) {
+                                nsite++;
+                        }
+
+                        if (id >= cap) {
+                                sol_assert (id < SOL_SIZE_MAX / sizeof *tbl
+                                                 - 64, SOL_ERNO_FILE);
+                                len = id + 64;
+                                if (tbl) {
+                                        sol_try (sol_ptr_resize((sol_ptr**)
+                                                                &tbl,
+                                                                len * sizeof
+                                                                *tbl));
+                                } else {
+                                        sol_try (sol_ptr_new((sol_ptr**) &tbl,
+                                                             len * sizeof
+                                                             *tbl));
+                                }
+
+                                while (cap < len) {
+                                        tbl[cap++].func = SOL_PTR_NULL;
+                                }
+                        }
+
+                        st = &tbl[id];
+                        sol_ptr_free((sol_ptr**) &st->func);
+                        sol_try (sol_ptr_new((sol_ptr**) &st->func,
+                                             flen + nlen + 2));
+                        st->file = st->func + flen + 1;
+                        st->func[flen] = st->file[nlen] = '\0';
+                        st->type = (char) rec[5];
+                        st->line = (int) get_le(rec + 6, 4);
+
+                        sol_assert (fread(st->func, 1, flen, in) == flen
+                                    && fread(st->file, 1, nlen, in) == nlen,
+                                    SOL_ERNO_FILE);
+                        continue;
+                }
+
+                        /* an entry record is printed in text format; entries
+                         * of call sites whose records are missing, which only
+                         * a truncated or corrupt file has, are printed with
+                         * placeholders */
+                sol_assert (tag == BIN_ENTRY
+                            && fread(rec + 1, 1, BIN_ENTRY_SZ - 1, in)
+                               == BIN_ENTRY_SZ - 1, SOL_ERNO_FILE);
+                id = (sol_size) get_le(rec + 1, 4);
+                tid = (sol_size) get_le(rec + 5, 4);
+                ns = get_le(rec + 9, 8);
+                len = (sol_size) get_le(rec + 17, 4);
+
+                if (len >= mcap) {
+                        sol_assert (len < SOL_SIZE_MAX - 256, SOL_ERNO_FILE);
+                        sol_ptr_free((sol_ptr**) &msg);
+                        sol_try (sol_ptr_new((sol_ptr**) &msg, len + 256));
+                        mcap = len + 256;
+                }
+
+                sol_assert (fread(msg, 1, len, in) == len, SOL_ERNO_FILE);
+                ts.tv_sec = (time_t) (ns / 1000000000ULL);
+                ts.tv_nsec = (long) (ns % 1000000000ULL);
+
+                st = id < cap && tbl[id].func ? &tbl[id] : SOL_PTR_NULL;
+                (void) fprintf(out, FMT, st ? st->type : '?', stamp_fmt(&ts),
+                               (unsigned long) tid, st ? st->func : "?",
+                               st ? st->file : "?", st ? st->line : 0,
+                               (int) len, msg);
+        }
+
+        sol_assert (!ferror(in) && !ferror(out), SOL_ERNO_FILE);
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* release call site table and message buffer, and close log
+                 * files */
+        for (id = 0; tbl && id < cap; id++) {
+                sol_ptr_free((sol_ptr**) &tbl[id].func);
+        }
+
+        sol_ptr_free((sol_ptr**) &tbl);
+        sol_ptr_free((sol_ptr**) &msg);
+
+        if (in) {
+                (void) fclose(in);
+        }
+
+        if (out) {
+                (void) fclose(out);
         }
+
+        return sol_erno_get();
 }
 
 
@@ -114,31 +3662,59 @@ extern void sol_log_close(void)
 
 /*
  *      __sol_log_write() - declared in sol/inc/log.h
- *        - type: log entry type - (T)race, (D)ebug, or (E)rror
- *        - func: function name of log entry source
- *        - file: file name of log entry source
- *        - line: line number of log entry source
+ *        - desc: call site descriptor
  *        - msg: log message
  */
-extern void __sol_log_write(const char *type,
-                            const char *func,
-                            const char *file,
-                            int line,
+extern void __sol_log_write(const __sol_log_desc *desc,
                             const char *msg)
 {
-        const char *FMT = "[%s] [%.24s] [%s():%s:%d] %s\n";
-        auto time_t tm;
-        auto char *ctm;
+        auto FILE *hnd;
+
+                /* write entry to log file if it's open, @msg is valid and the
+                 * rate limits let it through; the first check is necessary
+                 * because the logging macros may be called even if the log
+                 * file hasn't been opened, and is made first so that no time
+                 * is spent on timestamps in that case */
+        if (sol_likely ((hnd = __atomic_load_n(&log_hnd, __ATOMIC_ACQUIRE))
+                        && msg && *msg
+                        && site_pass(hnd, desc))) {
+                entry_write(hnd, desc, msg);
+        }
+}
+
+
+
+
+/*
+ *      __sol_log_writef() - declared in sol/inc/log.h
+ *        - desc: call site descriptor
+ *        - fmt: format string of log message
+ */
+extern void __sol_log_writef(const __sol_log_desc *desc,
+                             const char *fmt,
+                             ...)
+{
+        auto va_list ap;
+        auto FILE *hnd;
+        auto out o;
+
+                /* format message only if the log file is open and the rate
+                 * limits let it through, for the same reason as in
+                 * __sol_log_write() */
+        if (sol_likely ((hnd = __atomic_load_n(&log_hnd, __ATOMIC_ACQUIRE))
+                        && fmt
+                        && site_pass(hnd, desc))) {
+                o.pos = log_text.msg;
+                o.end = log_text.msg + MSG_SZ - 1;
 
-                /* determine current local time */
-        (void) time(&tm);
-        ctm = ctime(&tm);
+                va_start(ap, fmt);
+                fmt_put(&o, fmt, ap);
+                va_end(ap);
 
-                /* write entry to log file if it's open and @msg is valid; the
-                 * former check is necessary because the logging macros may be
-                 * called even if the log file hasn't been opened */
-        if (sol_likely (log_hnd && msg && *msg)) {
-                (void) fprintf(log_hnd, FMT, type, ctm, func, file, line, msg);
+                *o.pos = '\0';
+                if (*log_text.msg) {
+                        entry_write(hnd, desc, log_text.msg);
+                }
         }
 }
 
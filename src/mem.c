@@ -0,0 +1,609 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/src/mem.c
+ *
+ * Description:
+ *      This file is part of the internal implementation of the Sol Library.
+ *      It implements the memory kernels module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files; the SIMD intrinsics are pulled in
+         * only for the architectures that support them */
+#include "../inc/env.h"
+#include "../inc/hint.h"
+#include "../inc/mem.h"
+#if (SOL_ENV_ARCH_AMD64 == sol_env_arch() || SOL_ENV_ARCH_X86 == sol_env_arch())
+#       include <immintrin.h>
+#elif (defined __ARM_NEON)
+#       include <arm_neon.h>
+#endif
+
+
+
+
+/*
+ *      HAVE_SSE2 - SSE2 kernels available at compile-time
+ *      HAVE_AVX2 - AVX2 kernels available for load-time selection
+ *      HAVE_NEON - NEON kernels available at compile-time
+ */
+#if (SOL_ENV_ARCH_AMD64 == sol_env_arch() || SOL_ENV_ARCH_X86 == sol_env_arch())
+#       define HAVE_AVX2 1
+#       if (defined __SSE2__)
+#               define HAVE_SSE2 1
+#       endif
+#elif (defined __ARM_NEON)
+#       define HAVE_NEON 1
+#endif
+
+
+
+
+/*
+ *      word_ua - unaligned native word
+ *
+ *      The word_ua type allows native words to be loaded from and stored to
+ *      addresses that are not word-aligned without violating strict aliasing.
+ */
+typedef sol_word __attribute__((__may_alias__, __aligned__(1))) word_ua;
+
+
+
+
+/*
+ *      WORD_SZ - size in bytes of native word
+ */
+#define WORD_SZ (sizeof (sol_word))
+
+
+
+
+/*
+ *      word_copy() - copies a buffer forwards word-wise
+ *        - dst: destination buffer
+ *        - src: source buffer
+ *        - len: length in bytes to copy
+ */
+static void word_copy(sol_w8 *dst,
+                      const sol_w8 *src,
+                      sol_size len)
+{
+                /* copy four words at a time, then single words, and finally
+                 * the trailing bytes */
+        while (len >= 4 * WORD_SZ) {
+                ((word_ua*) dst)[0] = ((const word_ua*) src)[0];
+                ((word_ua*) dst)[1] = ((const word_ua*) src)[1];
+                ((word_ua*) dst)[2] = ((const word_ua*) src)[2];
+                ((word_ua*) dst)[3] = ((const word_ua*) src)[3];
+                dst += 4 * WORD_SZ;
+                src += 4 * WORD_SZ;
+                len -= 4 * WORD_SZ;
+        }
+
+        while (len >= WORD_SZ) {
+                *(word_ua*) dst = *(const word_ua*) src;
+                dst += WORD_SZ;
+                src += WORD_SZ;
+                len -= WORD_SZ;
+        }
+
+        for (; len; len--, *dst++ = *src++); /* NOLINT */
+}
+
+
+
+
+/*
+ *      word_rcopy() - copies a buffer backwards word-wise
+ *        - dst: destination buffer
+ *        - src: source buffer
+ *        - len: length in bytes to copy
+ *
+ *      Each word is loaded before it is stored, so this kernel is safe for
+ *      overlapping buffers where @dst lies above @src.
+ */
+static void word_rcopy(sol_w8 *dst,
+                       const sol_w8 *src,
+                       sol_size len)
+{
+        dst += len;
+        src += len;
+
+        while (len >= WORD_SZ) {
+                dst -= WORD_SZ;
+                src -= WORD_SZ;
+                *(word_ua*) dst = *(const word_ua*) src;
+                len -= WORD_SZ;
+        }
+
+        for (; len; len--, *--dst = *--src); /* NOLINT */
+}
+
+
+
+
+/*
+ *      word_set() - fills a buffer word-wise
+ *        - dst: destination buffer
+ *        - val: byte value to fill with
+ *        - len: length in bytes to fill
+ */
+static void word_set(sol_w8 *dst,
+                     sol_w8 val,
+                     sol_size len)
+{
+                /* broadcast @val across all the bytes of a word */
+        register sol_word pat = (~SOL_WORD_NULL / SOL_W8_MAX) * val;
+
+        while (len >= WORD_SZ) {
+                *(word_ua*) dst = pat;
+                dst += WORD_SZ;
+                len -= WORD_SZ;
+        }
+
+        for (; len; len--, *dst++ = val); /* NOLINT */
+}
+
+
+
+
+/*
+ *      word_cmp() - compares two buffers word-wise
+ *        - lhs: left hand side buffer
+ *        - rhs: right hand side buffer
+ *        - len: length in bytes to compare
+ */
+static int word_cmp(const sol_w8 *lhs,
+                    const sol_w8 *rhs,
+                    sol_size len)
+{
+                /* skip over equal words; the first unequal word, if any, is
+                 * resolved byte-wise along with the trailing bytes */
+        while (len >= WORD_SZ
+               && *(const word_ua*) lhs == *(const word_ua*) rhs) {
+                lhs += WORD_SZ;
+                rhs += WORD_SZ;
+                len -= WORD_SZ;
+        }
+
+        for (; len; len--, lhs++, rhs++) {
+                if (*lhs != *rhs) {
+                        return (int) *lhs - (int) *rhs;
+                }
+        }
+
+        return 0;
+}
+
+
+
+
+#if (defined HAVE_SSE2)
+/*
+ *      sse2_copy() - copies a buffer forwards with SSE2
+ *        - dst: destination buffer
+ *        - src: source buffer
+ *        - len: length in bytes to copy
+ */
+static void sse2_copy(sol_w8 *dst,
+                      const sol_w8 *src,
+                      sol_size len)
+{
+        register __m128i a, b, c, d;
+
+        while (len >= 64) {
+                a = _mm_loadu_si128((const __m128i*) src);
+                b = _mm_loadu_si128((const __m128i*) (src + 16));
+                c = _mm_loadu_si128((const __m128i*) (src + 32));
+                d = _mm_loadu_si128((const __m128i*) (src + 48));
+                _mm_storeu_si128((__m128i*) dst, a);
+                _mm_storeu_si128((__m128i*) (dst + 16), b);
+                _mm_storeu_si128((__m128i*) (dst + 32), c);
+                _mm_storeu_si128((__m128i*) (dst + 48), d);
+                dst += 64;
+                src += 64;
+                len -= 64;
+        }
+
+        while (len >= 16) {
+                _mm_storeu_si128((__m128i*) dst,
+                                 _mm_loadu_si128((const __m128i*) src));
+                dst += 16;
+                src += 16;
+                len -= 16;
+        }
+
+        word_copy(dst, src, len);
+}
+
+
+
+
+/*
+ *      sse2_set() - fills a buffer with SSE2
+ *        - dst: destination buffer
+ *        - val: byte value to fill with
+ *        - len: length in bytes to fill
+ */
+static void sse2_set(sol_w8 *dst,
+                     sol_w8 val,
+                     sol_size len)
+{
+        register __m128i pat = _mm_set1_epi8((char) val);
+
+        while (len >= 16) {
+                _mm_storeu_si128((__m128i*) dst, pat);
+                dst += 16;
+                len -= 16;
+        }
+
+        word_set(dst, val, len);
+}
+
+
+
+
+/*
+ *      sse2_cmp() - compares two buffers with SSE2
+ *        - lhs: left hand side buffer
+ *        - rhs: right hand side buffer
+ *        - len: length in bytes to compare
+ */
+static int sse2_cmp(const sol_w8 *lhs,
+                    const sol_w8 *rhs,
+                    sol_size len)
+{
+        register __m128i eq;
+
+                /* skip over equal blocks; the first unequal block is resolved
+                 * by the word-wise kernel */
+        while (len >= 16) {
+                eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) lhs),
+                                    _mm_loadu_si128((const __m128i*) rhs));
+                if (_mm_movemask_epi8(eq) != 0xFFFF) {
+                        break;
+                }
+
+                lhs += 16;
+                rhs += 16;
+                len -= 16;
+        }
+
+        return word_cmp(lhs, rhs, len);
+}
+#endif /* defined HAVE_SSE2 */
+
+
+
+
+#if (defined HAVE_AVX2)
+/*
+ *      avx2_copy() - copies a buffer forwards with AVX2
+ *        - dst: destination buffer
+ *        - src: source buffer
+ *        - len: length in bytes to copy
+ */
+__attribute__((target("avx2")))
+static void avx2_copy(sol_w8 *dst,
+                      const sol_w8 *src,
+                      sol_size len)
+{
+        register __m256i a, b, c, d;
+
+        while (len >= 128) {
+                a = _mm256_loadu_si256((const __m256i*) src);
+                b = _mm256_loadu_si256((const __m256i*) (src + 32));
+                c = _mm256_loadu_si256((const __m256i*) (src + 64));
+                d = _mm256_loadu_si256((const __m256i*) (src + 96));
+                _mm256_storeu_si256((__m256i*) dst, a);
+                _mm256_storeu_si256((__m256i*) (dst + 32), b);
+                _mm256_storeu_si256((__m256i*) (dst + 64), c);
+                _mm256_storeu_si256((__m256i*) (dst + 96), d);
+                dst += 128;
+                src += 128;
+                len -= 128;
+        }
+
+        while (len >= 32) {
+                _mm256_storeu_si256((__m256i*) dst,
+                                    _mm256_loadu_si256((const __m256i*) src));
+                dst += 32;
+                src += 32;
+                len -= 32;
+        }
+
+        word_copy(dst, src, len);
+}
+
+
+
+
+/*
+ *      avx2_set() - fills a buffer with AVX2
+ *        - dst: destination buffer
+ *        - val: byte value to fill with
+ *        - len: length in bytes to fill
+ */
+__attribute__((target("avx2")))
+static void avx2_set(sol_w8 *dst,
+                     sol_w8 val,
+                     sol_size len)
+{
+        register __m256i pat = _mm256_set1_epi8((char) val);
+
+        while (len >= 32) {
+                _mm256_storeu_si256((__m256i*) dst, pat);
+                dst += 32;
+                len -= 32;
+        }
+
+        word_set(dst, val, len);
+}
+
+
+
+
+/*
+ *      avx2_cmp() - compares two buffers with AVX2
+ *        - lhs: left hand side buffer
+ *        - rhs: right hand side buffer
+ *        - len: length in bytes to compare
+ */
+__attribute__((target("avx2")))
+static int avx2_cmp(const sol_w8 *lhs,
+                    const sol_w8 *rhs,
+                    sol_size len)
+{
+        register __m256i eq;
+
+        while (len >= 32) {
+                eq = _mm256_cmpeq_epi8(
+                        _mm256_loadu_si256((const __m256i*) lhs),
+                        _mm256_loadu_si256((const __m256i*) rhs));
+                if (_mm256_movemask_epi8(eq) != -1) {
+                        break;
+                }
+
+                lhs += 32;
+                rhs += 32;
+                len -= 32;
+        }
+
+        return word_cmp(lhs, rhs, len);
+}
+#endif /* defined HAVE_AVX2 */
+
+
+
+
+#if (defined HAVE_NEON)
+/*
+ *      neon_copy() - copies a buffer forwards with NEON
+ *        - dst: destination buffer
+ *        - src: source buffer
+ *        - len: length in bytes to copy
+ */
+static void neon_copy(sol_w8 *dst,
+                      const sol_w8 *src,
+                      sol_size len)
+{
+        register uint8x16_t a, b, c, d;
+
+        while (len >= 64) {
+                a = vld1q_u8(src);
+                b = vld1q_u8(src + 16);
+                c = vld1q_u8(src + 32);
+                d = vld1q_u8(src + 48);
+                vst1q_u8(dst, a);
+                vst1q_u8(dst + 16, b);
+                vst1q_u8(dst + 32, c);
+                vst1q_u8(dst + 48, d);
+                dst += 64;
+                src += 64;
+                len -= 64;
+        }
+
+        while (len >= 16) {
+                vst1q_u8(dst, vld1q_u8(src));
+                dst += 16;
+                src += 16;
+                len -= 16;
+        }
+
+        word_copy(dst, src, len);
+}
+
+
+
+
+/*
+ *      neon_set() - fills a buffer with NEON
+ *        - dst: destination buffer
+ *        - val: byte value to fill with
+ *        - len: length in bytes to fill
+ */
+static void neon_set(sol_w8 *dst,
+                     sol_w8 val,
+                     sol_size len)
+{
+        register uint8x16_t pat = vdupq_n_u8(val);
+
+        while (len >= 16) {
+                vst1q_u8(dst, pat);
+                dst += 16;
+                len -= 16;
+        }
+
+        word_set(dst, val, len);
+}
+#endif /* defined HAVE_NEON */
+
+
+
+
+/*
+ *      kern - active kernel set
+ *        - copy: forward copy kernel
+ *        - set : fill kernel
+ *        - cmp : comparison kernel
+ *        - id  : kernel set identifier
+ *
+ *      The kernel set is initialised to the best set available at compile-time,
+ *      and may be upgraded at load-time by kern_init() below. The NEON kernels
+ *      fall back to the word-wise comparison kernel since 32-bit ARM lacks a
+ *      cheap horizontal reduction.
+ */
+static struct {
+        void (*copy)(sol_w8*, const sol_w8*, sol_size);
+        void (*set)(sol_w8*, sol_w8, sol_size);
+        int (*cmp)(const sol_w8*, const sol_w8*, sol_size);
+        SOL_MEM_KERNEL id;
+} kern = {
+#if (defined HAVE_SSE2)
+        sse2_copy, sse2_set, sse2_cmp, SOL_MEM_KERNEL_SSE2
+#elif (defined HAVE_NEON)
+        neon_copy, neon_set, word_cmp, SOL_MEM_KERNEL_NEON
+#else
+        word_copy, word_set, word_cmp, SOL_MEM_KERNEL_WORD
+#endif
+};
+
+
+
+
+#if (defined HAVE_AVX2)
+/*
+ *      kern_init() - selects kernel set at load-time
+ *
+ *      The kern_init() function runs before main() and switches to the AVX2
+ *      kernels if the host processor supports them, so that no dispatch check
+ *      is needed on the hot path.
+ */
+__attribute__((constructor))
+static void kern_init(void)
+{
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2")) {
+                kern.copy = avx2_copy;
+                kern.set = avx2_set;
+                kern.cmp = avx2_cmp;
+                kern.id = SOL_MEM_KERNEL_AVX2;
+        }
+}
+#endif /* defined HAVE_AVX2 */
+
+
+
+
+/*
+ *      sol_mem_kernel() - declared in sol/inc/mem.h
+ */
+extern SOL_MEM_KERNEL sol_mem_kernel(void)
+{
+        return kern.id;
+}
+
+
+
+
+/*
+ *      sol_mem_copy() - declared in sol/inc/mem.h
+ */
+extern sol_hot void sol_mem_copy(sol_ptr *dst,
+                                 const sol_ptr *src,
+                                 sol_size len)
+{
+        if (sol_likely (dst && src && len)) {
+                kern.copy((sol_w8*) dst, (const sol_w8*) src, len);
+        }
+}
+
+
+
+
+/*
+ *      sol_mem_move() - declared in sol/inc/mem.h
+ */
+extern sol_hot void sol_mem_move(sol_ptr *dst,
+                                 const sol_ptr *src,
+                                 sol_size len)
+{
+        register sol_w8 *bdst = (sol_w8*) dst;
+        register const sol_w8 *bsrc = (const sol_w8*) src;
+
+                /* nothing to do if parameters are invalid or if @dst and @src
+                 * are the same buffer */
+        if (sol_unlikely (!(dst && src && len) || bdst == bsrc)) {
+                return;
+        }
+
+                /* copy forwards unless @dst overlaps the tail of @src, in which
+                 * case we need to copy backwards; the forward kernels load each
+                 * block before storing it, and so are safe when @dst lies below
+                 * @src */
+        if (bdst < bsrc || bdst >= bsrc + len) {
+                kern.copy(bdst, bsrc, len);
+        } else {
+                word_rcopy(bdst, bsrc, len);
+        }
+}
+
+
+
+
+/*
+ *      sol_mem_set() - declared in sol/inc/mem.h
+ */
+extern sol_hot void sol_mem_set(sol_ptr *dst,
+                                sol_w8 val,
+                                sol_size len)
+{
+        if (sol_likely (dst && len)) {
+                kern.set((sol_w8*) dst, val, len);
+        }
+}
+
+
+
+
+/*
+ *      sol_mem_cmp() - declared in sol/inc/mem.h
+ */
+extern sol_hot int sol_mem_cmp(const sol_ptr *lhs,
+                               const sol_ptr *rhs,
+                               sol_size len)
+{
+        if (sol_unlikely (!(lhs && rhs && len) || lhs == rhs)) {
+                return 0;
+        }
+
+        return kern.cmp((const sol_w8*) lhs, (const sol_w8*) rhs, len);
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
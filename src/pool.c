@@ -0,0 +1,319 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/src/pool.c
+ *
+ * Description:
+ *      This file is part of the internal implementation of the Sol Library.
+ *      It implements the object pool module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "../inc/log.h"
+#include "../inc/pool.h"
+
+
+
+
+/*
+ *      SLOT_ALIGN - alignment in bytes of slots
+ *
+ *      Slots are aligned to two pointer widths, which matches the alignment
+ *      guaranteed by malloc() on the supported hosts.
+ */
+#define SLOT_ALIGN (2 * sizeof (sol_ptr*))
+
+
+
+
+/*
+ *      slab - slab header
+ *        - next: next slab in pool
+ *
+ *      The slab header is padded to SLOT_ALIGN so that the slots immediately
+ *      following it are correctly aligned.
+ */
+typedef union __slab {
+        union __slab *next;
+        sol_w8 pad[SLOT_ALIGN];
+} slab;
+
+
+
+
+/*
+ *      slot - free slot
+ *        - next: next free slot in pool
+ */
+typedef struct __slot {
+        struct __slot *next;
+} slot;
+
+
+
+
+/*
+ *      slab_new() - reserves a new slab
+ *        - pool: contextual pool
+ */
+static sol_erno slab_new(sol_pool *pool)
+{
+        auto slab *sb = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* allocate slab, guarding against overflow of its size */
+        sol_assert (pool->nslot <= (SOL_SIZE_MAX - sizeof *sb) / pool->sz,
+                    SOL_ERNO_RANGE);
+        sol_try (sol_ptr_new((sol_ptr**) &sb,
+                             sizeof *sb + pool->sz * pool->nslot));
+
+                /* push slab on to slab list, and make its slots available for
+                 * carving; the slots are threaded on to the free list only as
+                 * they are released, so that untouched slots cost nothing */
+        sb->next = pool->slab;
+        pool->slab = sb;
+        pool->top = (sol_w8*) (sb + 1);
+        pool->end = pool->top + pool->sz * pool->nslot;
+        pool->cap += pool->nslot;
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_pool_init() - declared in sol/inc/pool.h
+ */
+extern sol_erno sol_pool_init(sol_pool *pool,
+                              sol_size sz,
+                              sol_size nslot)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (pool, SOL_ERNO_PTR);
+        sol_assert (sz && nslot && sz <= SOL_SIZE_MAX - SLOT_ALIGN,
+                    SOL_ERNO_RANGE);
+
+                /* round slot size up so that it can hold a free list link and
+                 * keeps every slot aligned */
+        if (sz < sizeof (slot)) {
+                sz = sizeof (slot);
+        }
+
+        pool->sz = (sz + SLOT_ALIGN - 1) & ~(SLOT_ALIGN - 1);
+        pool->nslot = nslot;
+        pool->free = SOL_PTR_NULL;
+        pool->slab = SOL_PTR_NULL;
+        pool->top = SOL_PTR_NULL;
+        pool->end = SOL_PTR_NULL;
+        pool->cap = 0;
+        pool->used = 0;
+        pool->peak = 0;
+
+                /* reserve first slab */
+        sol_try (slab_new(pool));
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_pool_term() - declared in sol/inc/pool.h
+ */
+extern void sol_pool_term(sol_pool *pool)
+{
+        auto slab *sb, *nxt;
+
+                /* release all slabs if @pool is valid */
+        if (sol_likely (pool)) {
+                for (sb = pool->slab; sb; sb = nxt) {
+                        nxt = sb->next;
+                        sol_ptr_free((sol_ptr**) &sb);
+                }
+
+                pool->free = SOL_PTR_NULL;
+                pool->slab = SOL_PTR_NULL;
+                pool->top = SOL_PTR_NULL;
+                pool->end = SOL_PTR_NULL;
+                pool->cap = 0;
+                pool->used = 0;
+        }
+}
+
+
+
+
+/*
+ *      sol_pool_alloc() - declared in sol/inc/pool.h
+ */
+extern sol_hot sol_erno sol_pool_alloc(sol_pool *pool,
+                                       sol_ptr **ptr)
+{
+        auto slot *sl;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (pool && ptr && !*ptr, SOL_ERNO_PTR);
+
+                /* pop free list if possible; otherwise carve a fresh slot from
+                 * the current slab, reserving a new slab if required */
+        if (sol_likely ((sl = pool->free))) {
+                pool->free = sl->next;
+        } else {
+                if (sol_unlikely (pool->top == pool->end)) {
+                        sol_try (slab_new(pool));
+                }
+
+                sl = (slot*) pool->top;
+                pool->top += pool->sz;
+        }
+
+                /* update statistics */
+        if (++pool->used > pool->peak) {
+                pool->peak = pool->used;
+        }
+
+        *ptr = sl;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_pool_free() - declared in sol/inc/pool.h
+ */
+extern sol_hot void sol_pool_free(sol_pool *pool,
+                                  sol_ptr **ptr)
+{
+        auto slot *sl;
+
+                /* push slot on to free list if parameters are valid */
+        if (sol_likely (pool && ptr && (sl = *ptr))) {
+                sl->next = pool->free;
+                pool->free = sl;
+                pool->used--;
+                *ptr = SOL_PTR_NULL;
+        }
+}
+
+
+
+
+/*
+ *      sol_pool_cap() - declared in sol/inc/pool.h
+ */
+extern sol_erno sol_pool_cap(const sol_pool *pool,
+                             sol_size *cap)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (pool && cap, SOL_ERNO_PTR);
+
+                /* return count of reserved slots */
+        *cap = pool->cap;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_pool_used() - declared in sol/inc/pool.h
+ */
+extern sol_erno sol_pool_used(const sol_pool *pool,
+                              sol_size *used)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (pool && used, SOL_ERNO_PTR);
+
+                /* return count of slots in use */
+        *used = pool->used;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_pool_peak() - declared in sol/inc/pool.h
+ */
+extern sol_erno sol_pool_peak(const sol_pool *pool,
+                              sol_size *peak)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (pool && peak, SOL_ERNO_PTR);
+
+                /* return high-water mark of slots in use */
+        *peak = pool->peak;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
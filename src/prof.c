@@ -0,0 +1,597 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/src/prof.c
+ *
+ * Description:
+ *      This file is part of the internal implementation of the Sol Library.
+ *      It implements the allocation profiler of the pointer module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files; the call site macros of the pointer
+         * module are not needed in this file */
+#define __SOL_POINTER_SOURCE
+#include "../inc/libc.h"
+#include "../inc/log.h"
+#include "../inc/mem.h"
+#include "../inc/ptr.h"
+
+
+
+
+        /* the profiler is compiled in only if it has been requested */
+#if (defined SOL_PTR_PROFILE)
+
+
+
+
+/*
+ *      SITE_MAX - maximum number of call sites
+ *      HIST_MAX - number of size histogram buckets
+ *
+ *      Call sites beyond SITE_MAX are folded into the first site, which also
+ *      collects allocations whose call site is unknown. Histogram bucket n
+ *      counts allocations of up to 2^(n + 4) bytes, with the last bucket
+ *      counting all larger allocations.
+ */
+#define SITE_MAX 512
+#define HIST_MAX 16
+
+
+
+
+/*
+ *      KEY_FREE - key of unused call site descriptors
+ *      KEY_BUSY - key of call site descriptors being claimed
+ *
+ *      Neither value is ever the key of a call site. KEY_BUSY is also the key
+ *      of the first site, which collects allocations of unknown call sites and
+ *      is never probed.
+ */
+#define KEY_FREE ((sol_word) 0)
+#define KEY_BUSY ((sol_word) 1)
+
+
+
+
+/*
+ *      site - call site descriptor
+ *        - key: hash of call site, KEY_FREE if unused, or KEY_BUSY while the
+ *          descriptor is being claimed
+ *        - func: function name of call site
+ *        - file: file name of call site
+ *        - line: line number of call site
+ */
+typedef struct __site {
+        sol_word key;
+        const char *func;
+        const char *file;
+        int line;
+} site;
+
+
+
+
+/*
+ *      table - per-thread profile table
+ *        - next: next table in list of all tables
+ *        - count: allocations of each site
+ *        - frees: frees of each site
+ *        - bytes: bytes allocated by each site
+ *        - freed: bytes freed of each site
+ *        - hist: size histogram of each site
+ *
+ *      Each table is written only by its own thread, with relaxed atomic
+ *      stores so that sol_ptr_prof_report() can read it from another thread.
+ *      Tables are never released, so that the profile of exited threads
+ *      remains in the report.
+ */
+typedef struct __table {
+        struct __table *next;
+        sol_size count[SITE_MAX];
+        sol_size frees[SITE_MAX];
+        sol_size bytes[SITE_MAX];
+        sol_size freed[SITE_MAX];
+        sol_size hist[SITE_MAX][HIST_MAX];
+} table;
+
+
+
+
+/*
+ *      sites - call site descriptors, claimed lock-free by their key
+ *      tables - list of all per-thread tables
+ *      total - bytes currently allocated
+ *      peak - high-water mark of @total
+ */
+static site sites[SITE_MAX] = {{KEY_BUSY, "<unknown>", "<unknown>", 0}};
+static table *tables = SOL_PTR_NULL;
+static sol_size total = 0;
+static sol_size peak = 0;
+
+
+
+
+/*
+ *      cur_tbl - table of current thread
+ *      cur_site - call site of next allocation of current thread
+ */
+static sol_tls table *cur_tbl = SOL_PTR_NULL;
+static sol_tls sol_w32 cur_site = 0;
+
+
+
+
+/*
+ *      add() - adds to a counter of the current thread
+ *        - ctr: counter to add to
+ *        - n: amount to add
+ */
+static sol_inline void add(sol_size *ctr,
+                           sol_size n)
+{
+        __atomic_store_n(ctr, *ctr + n, __ATOMIC_RELAXED);
+}
+
+
+
+
+/*
+ *      tbl_get() - gets table of current thread, creating it if needed
+ */
+static table *tbl_get(void)
+{
+        auto table *tbl;
+
+        if (sol_likely ((tbl = cur_tbl))) {
+                return tbl;
+        }
+
+                /* allocate a zeroed table directly from the heap so that the
+                 * profiler doesn't profile itself, and push it on to the list
+                 * of tables */
+        if (sol_unlikely (!(tbl = malloc(sizeof *tbl)))) {
+                return SOL_PTR_NULL;
+        }
+
+        sol_mem_set(tbl, 0, sizeof *tbl);
+
+        tbl->next = __atomic_load_n(&tables, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&tables, &tbl->next, tbl, 1,
+                                            __ATOMIC_RELEASE,
+                                            __ATOMIC_RELAXED)) {
+                ;
+        }
+
+        return (cur_tbl = tbl);
+}
+
+
+
+
+/*
+ *      bucket() - gets histogram bucket of allocation size
+ *        - sz: size in bytes of allocation
+ */
+static sol_inline sol_size bucket(sol_size sz)
+{
+        register sol_size b = 0;
+
+        for (sz = (sz - 1) >> 4; sz && b < HIST_MAX - 1; sz >>= 1) {
+                b++;
+        }
+
+        return b;
+}
+
+
+
+
+/*
+ *      __sol_ptr_prof_site() - declared in sol/inc/ptr.h
+ */
+extern void __sol_ptr_prof_site(const char *func,
+                                const char *file,
+                                int line)
+{
+        register sol_w32 i, n;
+        auto sol_word key, cur;
+
+                /* hash call site, bumping the hashes that clash with the
+                 * reserved keys */
+        key = (sol_word) file * 31 + (sol_word) line;
+        if (sol_unlikely (key <= KEY_BUSY)) {
+                key += 2;
+        }
+
+        i = (sol_w32) ((key ^ (key >> 17)) % (SITE_MAX - 1)) + 1;
+
+                /* probe for call site, claiming an unused descriptor for it if
+                 * it isn't found; a descriptor is claimed by marking it busy,
+                 * filling it in, and only then publishing its key, so that a
+                 * matching key can be confirmed against the file and line of
+                 * its descriptor, since distinct call sites may share a key */
+        for (n = 1; n < SITE_MAX; n++) {
+                cur = __atomic_load_n(&sites[i].key, __ATOMIC_ACQUIRE);
+
+                if (cur == KEY_FREE) {
+                        if (__atomic_compare_exchange_n(&sites[i].key, &cur,
+                                                        KEY_BUSY, 0,
+                                                        __ATOMIC_ACQUIRE,
+                                                        __ATOMIC_ACQUIRE)) {
+                                sites[i].func = func;
+                                sites[i].file = file;
+                                sites[i].line = line;
+                                __atomic_store_n(&sites[i].key, key,
+                                                 __ATOMIC_RELEASE);
+                                cur_site = i;
+                                return;
+                        }
+                }
+
+                while (sol_unlikely (cur == KEY_BUSY)) {
+                        cur = __atomic_load_n(&sites[i].key, __ATOMIC_ACQUIRE);
+                }
+
+                if (cur == key && sites[i].file == file
+                    && sites[i].line == line) {
+                        cur_site = i;
+                        return;
+                }
+
+                i = i % (SITE_MAX - 1) + 1;
+        }
+
+                /* fold call site into unknown site if the sites are full */
+        cur_site = 0;
+}
+
+
+
+
+/*
+ *      __sol_ptr_prof_resite() - declared in sol/inc/ptr.h
+ */
+extern void __sol_ptr_prof_resite(sol_w32 site)
+{
+        cur_site = site;
+}
+
+
+
+
+/*
+ *      __sol_ptr_prof_unsite() - declared in sol/inc/ptr.h
+ */
+extern sol_erno __sol_ptr_prof_unsite(sol_erno erno)
+{
+        cur_site = 0;
+        return erno;
+}
+
+
+
+
+/*
+ *      __sol_ptr_prof_alloc() - declared in sol/inc/ptr.h
+ */
+extern sol_w32 __sol_ptr_prof_alloc(sol_size sz)
+{
+        register sol_w32 s = cur_site;
+        auto sol_size now, top;
+        auto table *tbl;
+
+                /* consume call site */
+        cur_site = 0;
+
+                /* update per-thread counters of call site */
+        if (sol_likely ((tbl = tbl_get()))) {
+                add(&tbl->count[s], 1);
+                add(&tbl->bytes[s], sz);
+                add(&tbl->hist[s][bucket(sz)], 1);
+        }
+
+                /* update global live bytes and high-water mark */
+        now = __atomic_add_fetch(&total, sz, __ATOMIC_RELAXED);
+        top = __atomic_load_n(&peak, __ATOMIC_RELAXED);
+        while (now > top && !__atomic_compare_exchange_n(&peak, &top, now, 1,
+                                                         __ATOMIC_RELAXED,
+                                                         __ATOMIC_RELAXED)) {
+                ;
+        }
+
+        return s;
+}
+
+
+
+
+/*
+ *      __sol_ptr_prof_free() - declared in sol/inc/ptr.h
+ */
+extern void __sol_ptr_prof_free(sol_w32 site,
+                                sol_size sz)
+{
+        auto table *tbl;
+
+                /* update per-thread counters of allocating call site, and the
+                 * global live bytes */
+        if (sol_likely ((tbl = tbl_get()))) {
+                add(&tbl->frees[site], 1);
+                add(&tbl->freed[site], sz);
+        }
+
+        (void) __atomic_sub_fetch(&total, sz, __ATOMIC_RELAXED);
+}
+
+
+
+
+/*
+ *      row - report row
+ *        - site: call site identifier
+ *        - count: allocations
+ *        - frees: frees
+ *        - bytes: bytes allocated
+ *        - live: bytes currently allocated
+ *        - hist: size histogram
+ */
+typedef struct __row {
+        sol_w32 site;
+        sol_size count;
+        sol_size frees;
+        sol_size bytes;
+        sol_size live;
+        sol_size hist[HIST_MAX];
+} row;
+
+
+
+
+/*
+ *      row_sort() - sorts report rows
+ *        - rows: rows to sort
+ *        - n: number of rows
+ *
+ *      Rows are ordered by descending live bytes, and then by descending bytes
+ *      allocated. There are few enough rows for an insertion sort.
+ */
+static void row_sort(row *rows,
+                     sol_size n)
+{
+        register sol_size i, j;
+        auto row tmp;
+
+        for (i = 1; i < n; i++) {
+                tmp = rows[i];
+                for (j = i; j && (rows[j - 1].live < tmp.live
+                                  || (rows[j - 1].live == tmp.live
+                                      && rows[j - 1].bytes < tmp.bytes)); j--) {
+                        rows[j] = rows[j - 1];
+                }
+
+                rows[j] = tmp;
+        }
+}
+
+
+
+
+/*
+ *      sol_ptr_prof_live() - declared in sol/inc/ptr.h
+ */
+extern sol_erno sol_ptr_prof_live(sol_size *live)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (live, SOL_ERNO_PTR);
+
+                /* return live bytes */
+        *live = __atomic_load_n(&total, __ATOMIC_RELAXED);
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_ptr_prof_peak() - declared in sol/inc/ptr.h
+ */
+extern sol_erno sol_ptr_prof_peak(sol_size *top)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (top, SOL_ERNO_PTR);
+
+                /* return high-water mark */
+        *top = __atomic_load_n(&peak, __ATOMIC_RELAXED);
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_ptr_prof_report() - declared in sol/inc/ptr.h
+ */
+extern sol_erno sol_ptr_prof_report(const char *path)
+{
+        auto row *rows = SOL_PTR_NULL;
+        auto FILE *hnd = SOL_PTR_NULL;
+        auto table *tbl;
+        register sol_w32 s, n = 0;
+        register sol_size b;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (path && *path, SOL_ERNO_STR);
+
+                /* sum the tables of all threads into a row for each call site
+                 * that has allocated */
+        sol_assert ((rows = malloc(SITE_MAX * sizeof *rows)), SOL_ERNO_HEAP);
+        sol_mem_set(rows, 0, SITE_MAX * sizeof *rows);
+
+        for (tbl = __atomic_load_n(&tables, __ATOMIC_ACQUIRE); tbl;
+             tbl = tbl->next) {
+                for (s = 0; s < SITE_MAX; s++) {
+                        rows[s].count += __atomic_load_n(&tbl->count[s],
+                                                         __ATOMIC_RELAXED);
+                        rows[s].frees += __atomic_load_n(&tbl->frees[s],
+                                                         __ATOMIC_RELAXED);
+                        rows[s].bytes += __atomic_load_n(&tbl->bytes[s],
+                                                         __ATOMIC_RELAXED);
+                        rows[s].live -= __atomic_load_n(&tbl->freed[s],
+                                                        __ATOMIC_RELAXED);
+                        for (b = 0; b < HIST_MAX; b++) {
+                                rows[s].hist[b] += __atomic_load_n(
+                                                &tbl->hist[s][b],
+                                                __ATOMIC_RELAXED);
+                        }
+                }
+        }
+
+        for (s = 0; s < SITE_MAX; s++) {
+                if (rows[s].count) {
+                        rows[n] = rows[s];
+                        rows[n].site = s;
+                        rows[n].live += rows[n].bytes;
+                        n++;
+                }
+        }
+
+        row_sort(rows, n);
+
+                /* write report */
+        sol_assert ((hnd = fopen(path, "w")), SOL_ERNO_FILE);
+        (void) fprintf(hnd, "live %lu bytes, peak %lu bytes, %lu sites\n\n",
+                       (unsigned long) __atomic_load_n(&total, __ATOMIC_RELAXED),
+                       (unsigned long) __atomic_load_n(&peak, __ATOMIC_RELAXED),
+                       (unsigned long) n);
+        sol_assert (fprintf(hnd, "%12s %12s %14s %14s  %s\n",
+                            "count", "frees", "bytes", "live", "site") > 0,
+                    SOL_ERNO_FILE);
+
+        for (s = 0; s < n; s++) {
+                (void) fprintf(hnd, "%12lu %12lu %14lu %14lu  %s():%s:%d\n",
+                               (unsigned long) rows[s].count,
+                               (unsigned long) rows[s].frees,
+                               (unsigned long) rows[s].bytes,
+                               (unsigned long) rows[s].live,
+                               sites[rows[s].site].func,
+                               sites[rows[s].site].file,
+                               sites[rows[s].site].line);
+
+                (void) fprintf(hnd, "%12s", "");
+                for (b = 0; b < HIST_MAX; b++) {
+                        if (rows[s].hist[b]) {
+                                (void) fprintf(hnd, " %s%lu:%lu",
+                                               b < HIST_MAX - 1 ? "<=" : ">",
+                                               16UL << (b < HIST_MAX - 1
+                                                        ? b
+                                                        : b - 1),
+                                               (unsigned long) rows[s].hist[b]);
+                        }
+                }
+                (void) fprintf(hnd, "\n");
+        }
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        if (hnd) {
+                (void) fclose(hnd);
+        }
+
+        free(rows);
+        return sol_erno_get();
+}
+
+
+
+
+#else /* !defined SOL_PTR_PROFILE */
+
+
+
+
+/*
+ *      sol_ptr_prof_live() - declared in sol/inc/ptr.h
+ */
+extern sol_erno sol_ptr_prof_live(sol_size *live)
+{
+        (void) live;
+        return SOL_ERNO_STATE;
+}
+
+
+
+
+/*
+ *      sol_ptr_prof_peak() - declared in sol/inc/ptr.h
+ */
+extern sol_erno sol_ptr_prof_peak(sol_size *peak)
+{
+        (void) peak;
+        return SOL_ERNO_STATE;
+}
+
+
+
+
+/*
+ *      sol_ptr_prof_report() - declared in sol/inc/ptr.h
+ */
+extern sol_erno sol_ptr_prof_report(const char *path)
+{
+        (void) path;
+        return SOL_ERNO_STATE;
+}
+
+
+
+
+#endif /* defined SOL_PTR_PROFILE */
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
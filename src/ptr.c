@@ -26,35 +26,344 @@
 
 
 
-        /* include required header files */
+        /* enable posix_memalign() in strict C99 mode */
+#if (!defined _POSIX_C_SOURCE)
+#       define _POSIX_C_SOURCE 200809L
+#endif
+
+
+
+
+        /* include required header files; the call site macros of the pointer
+         * module must not shadow the functions defined in this file */
+#define __SOL_POINTER_SOURCE
 #include "../inc/env.h"
 #include "../inc/libc.h"
 #include "../inc/log.h"
+#include "../inc/mem.h"
 #include "../inc/ptr.h"
+#include "../inc/tlsf.h"
+
+
+
+
+/*
+ *      heap_alloc() - allocates heap memory
+ *      heap_realloc() - resizes heap memory
+ *      heap_free() - frees heap memory
+ *      heap_free_sized() - frees heap memory of known size
+ *
+ *      These macros route heap memory requests to the fallback heap if
+ *      SOL_PTR_TLSF is defined, through the thread-caching front-end if
+ *      SOL_PTR_TCACHE is defined, and directly to malloc(), realloc() and
+ *      free() otherwise.
+ */
+#if (defined SOL_PTR_TLSF)
+#       define heap_alloc(sz) __sol_tlsf_heap_alloc(sz)
+#       define heap_realloc(ptr, sz) __sol_tlsf_heap_realloc(ptr, sz)
+#       define heap_free(ptr) __sol_tlsf_heap_free(ptr)
+#       define heap_free_sized(ptr, sz) ((void) (sz), __sol_tlsf_heap_free(ptr))
+#elif (defined SOL_PTR_TCACHE)
+#       define heap_alloc(sz) __sol_ptr_tcache_alloc(sz)
+#       define heap_realloc(ptr, sz) __sol_ptr_tcache_realloc(ptr, sz)
+#       define heap_free(ptr) __sol_ptr_tcache_free(ptr)
+#       define heap_free_sized(ptr, sz) __sol_ptr_tcache_free_sized(ptr, sz)
+#else
+#       define heap_alloc(sz) malloc(sz)
+#       define heap_realloc(ptr, sz) realloc(ptr, sz)
+#       define heap_free(ptr) free(ptr)
+#       define heap_free_sized(ptr, sz) ((void) (sz), free(ptr))
+#endif
+
+
+
+
+/*
+ *      heap_alloc_aligned() - allocates aligned heap memory
+ *        - sz: size in bytes to allocate
+ *        - align: alignment in bytes, which must be a power of two
+ *
+ *      Returns a null pointer if heap memory is exhausted, or in freestanding
+ *      environments without aligned_alloc(), if @align exceeds the alignment
+ *      guaranteed by malloc().
+ */
+static sol_ptr *heap_alloc_aligned(sol_size sz,
+                                   sol_size align)
+{
+#if (defined SOL_PTR_TLSF)
+        return __sol_tlsf_heap_alloc_aligned(sz, align);
+#elif (defined SOL_PTR_TCACHE)
+        return __sol_ptr_tcache_alloc_aligned(sz, align);
+#elif (sol_env_host() != SOL_ENV_HOST_NONE)
+        auto sol_ptr *ptr;
+
+        if (align < sizeof ptr) {
+                align = sizeof ptr;
+        }
+
+        return posix_memalign(&ptr, align, sz) ? SOL_PTR_NULL : ptr;
+#elif (defined SOL_LIBC_ALIGNED_ALLOC_DEFINED)
+        return sz <= SOL_SIZE_MAX - align
+               ? aligned_alloc(align, (sz + align - 1) & ~(align - 1))
+               : SOL_PTR_NULL;
+#else
+        return align <= 2 * sizeof (sol_ptr*) ? malloc(sz) : SOL_PTR_NULL;
+#endif
+}
+
+
+
+
+/*
+ *      map_free() - unmaps heap memory if it was mapped
+ *        - ptr: heap memory to unmap
+ *
+ *      Mapped buffers exist only in hosted environments; this macro evaluates
+ *      to SOL_BOOL_FALSE in freestanding environments.
+ */
+#if (sol_env_host() != SOL_ENV_HOST_NONE)
+#       define map_free(ptr) __sol_ptr_map_free(ptr)
+#else
+#       define map_free(ptr) ((void) (ptr), SOL_BOOL_FALSE)
+#endif
+
+
+
+
+/*
+ *      alloc_global - global allocator
+ *      alloc_local - allocator of current thread
+ *
+ *      A null pointer in either denotes that no allocator has been set, with
+ *      @alloc_local deferring to @alloc_global, and @alloc_global deferring to
+ *      the default heap functions above.
+ */
+static const sol_allocator *alloc_global = SOL_PTR_NULL;
+static sol_tls const sol_allocator *alloc_local = SOL_PTR_NULL;
+
+
+
+
+/*
+ *      alloc_get() - gets allocator in effect for current thread
+ */
+static sol_inline const sol_allocator *alloc_get(void)
+{
+        auto const sol_allocator *alloc = alloc_local;
+
+        return sol_likely (!alloc)
+               ? __atomic_load_n(&alloc_global, __ATOMIC_ACQUIRE)
+               : alloc;
+}
 
 
 
 
 /*
- *      copy_byte() - copies a buffer on to another byte-wise
- *        - ptr: destination buffer
- *        - src: source buffer
- *        - len: length in bytes to copy
+ *      mem_alloc() - allocates memory
+ *      mem_realloc() - resizes memory
+ *      mem_free() - frees memory
+ *      mem_free_sized() - frees memory of known size
+ *
+ *      These functions dispatch heap memory requests to the allocator in
+ *      effect, and call the default heap functions directly when no allocator
+ *      has been set, so that the default path is not an indirect call.
  */
-static sol_inline void copy_byte(sol_ptr **ptr,
-                                 const sol_ptr *src,
-                                 sol_size len)
+static sol_inline sol_ptr *mem_alloc(sol_size sz)
+{
+        auto const sol_allocator *alloc = alloc_get();
+
+        return sol_likely (!alloc)
+               ? heap_alloc(sz)
+               : alloc->alloc(alloc->ctx, sz);
+}
+
+static sol_inline sol_ptr *mem_realloc(sol_ptr *ptr,
+                                       sol_size sz)
+{
+        auto const sol_allocator *alloc = alloc_get();
+
+        return sol_likely (!alloc)
+               ? heap_realloc(ptr, sz)
+               : alloc->realloc(alloc->ctx, ptr, sz);
+}
+
+static sol_inline void mem_free(sol_ptr *ptr)
+{
+        auto const sol_allocator *alloc = alloc_get();
+
+        if (sol_likely (!alloc)) {
+                heap_free(ptr);
+        } else {
+                alloc->free(alloc->ctx, ptr);
+        }
+}
+
+static sol_inline void mem_free_sized(sol_ptr *ptr,
+                                      sol_size sz)
+{
+        auto const sol_allocator *alloc = alloc_get();
+
+        if (sol_likely (!alloc)) {
+                heap_free_sized(ptr, sz);
+        } else {
+                alloc->free(alloc->ctx, ptr);
+        }
+}
+
+
+
+
+/*
+ *      mem_alloc_aligned() - allocates aligned memory
+ *        - ptr: contextual pointer instance
+ *        - sz: size in bytes to allocate
+ *        - align: alignment in bytes, which must be a power of two
+ *
+ *      Allocators only guarantee the alignment of malloc(), so larger
+ *      alignments are available only from the default heap functions. Throws
+ *      SOL_ERNO_STATE if @align is too large for the allocator in effect.
+ */
+static sol_erno mem_alloc_aligned(sol_ptr **ptr,
+                                  sol_size sz,
+                                  sol_size align)
+{
+        auto const sol_allocator *alloc = alloc_get();
+
+SOL_TRY:
+                /* allocate from allocator in effect */
+        if (sol_likely (!alloc)) {
+                sol_assert ((*ptr = heap_alloc_aligned(sz, align)),
+                            SOL_ERNO_HEAP);
+        } else {
+                sol_assert (align <= 2 * sizeof (sol_ptr*), SOL_ERNO_STATE);
+                sol_assert ((*ptr = alloc->alloc(alloc->ctx, sz)),
+                            SOL_ERNO_HEAP);
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      ptr_alloc() - allocates a buffer
+ *      ptr_alloc_next() - allocates a buffer at the call site of another
+ *      ptr_alloc_aligned() - allocates an aligned buffer
+ *      ptr_realloc() - resizes a buffer
+ *      ptr_free() - frees a buffer
+ *      ptr_free_sized() - frees a buffer of known size
+ *
+ *      These functions are the memory functions above if SOL_PTR_PROFILE is
+ *      not defined. Otherwise, they prefix each buffer with a hidden tag that
+ *      records its call site, size and offset from the start of the memory
+ *      block, and report each allocation and free to the profiler.
+ */
+#if (defined SOL_PTR_PROFILE)
+typedef union __tag {
+        struct {
+                sol_w32 site;
+                sol_w32 off;
+                sol_size sz;
+        } t;
+        sol_w8 pad[16];
+} tag;
+
+static sol_ptr *ptr_alloc(sol_size sz)
+{
+        auto tag *tg;
+
+        if (sol_unlikely (sz > SOL_SIZE_MAX - sizeof *tg
+                          || !(tg = mem_alloc(sizeof *tg + sz)))) {
+                return SOL_PTR_NULL;
+        }
+
+        tg->t.site = __sol_ptr_prof_alloc(sz);
+        tg->t.off = sizeof *tg;
+        tg->t.sz = sz;
+        return tg + 1;
+}
+
+static sol_erno ptr_alloc_aligned(sol_ptr **ptr,
+                                  sol_size sz,
+                                  sol_size align)
 {
-                /* @ptr, @src and @len are valid, as they have already been
-                 * checked by the calling function sol_ptr_copy() */
-        register sol_w8 *bdst = (sol_w8*) *ptr;
-        register sol_w8 *bsrc = (sol_w8*) src;
-        register sol_size itr = len;
+        register sol_size off = align > sizeof (tag) ? align : sizeof (tag);
+        auto sol_ptr *base = SOL_PTR_NULL;
+        auto tag *tg;
+
+SOL_TRY:
+                /* place tag just below the first aligned payload */
+        sol_assert (sz <= SOL_SIZE_MAX - off, SOL_ERNO_RANGE);
+        sol_try (mem_alloc_aligned(&base, off + sz, align));
+
+        tg = (tag*) ((sol_w8*) base + off) - 1;
+        tg->t.site = __sol_ptr_prof_alloc(sz);
+        tg->t.off = (sol_w32) off;
+        tg->t.sz = sz;
+        *ptr = tg + 1;
 
-                /* copy @src to @ptr byte-by-byte for @len bytes */
-        for (; itr; itr--, *bdst++ = *bsrc++); /* NOLINT */
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
 }
 
+static sol_ptr *ptr_realloc(sol_ptr *ptr,
+                            sol_size sz)
+{
+        auto tag *tg = (tag*) ptr - 1;
+        auto sol_w32 site = tg->t.site;
+        auto sol_size old = tg->t.sz;
+
+        if (sol_unlikely (sz > SOL_SIZE_MAX - sizeof *tg
+                          || !(tg = mem_realloc(tg, sizeof *tg + sz)))) {
+                return SOL_PTR_NULL;
+        }
+
+        __sol_ptr_prof_free(site, old);
+        tg->t.site = __sol_ptr_prof_alloc(sz);
+        tg->t.sz = sz;
+        return tg + 1;
+}
+
+static sol_ptr *ptr_alloc_next(const sol_ptr *prev,
+                               sol_size sz)
+{
+        __sol_ptr_prof_resite(((const tag*) prev - 1)->t.site);
+        return ptr_alloc(sz);
+}
+
+static void ptr_free(sol_ptr *ptr)
+{
+        auto tag *tg = (tag*) ptr - 1;
+
+        __sol_ptr_prof_free(tg->t.site, tg->t.sz);
+        mem_free((sol_w8*) ptr - tg->t.off);
+}
+
+static void ptr_free_sized(sol_ptr *ptr,
+                           sol_size sz)
+{
+        auto tag *tg = (tag*) ptr - 1;
+
+        __sol_ptr_prof_free(tg->t.site, sz);
+        mem_free_sized((sol_w8*) ptr - tg->t.off, tg->t.off + sz);
+}
+#else
+#       define ptr_alloc(sz) mem_alloc(sz)
+#       define ptr_alloc_next(prev, sz) ((void) (prev), mem_alloc(sz))
+#       define ptr_alloc_aligned(ptr, sz, align) \
+                mem_alloc_aligned(ptr, sz, align)
+#       define ptr_realloc(ptr, sz) mem_realloc(ptr, sz)
+#       define ptr_free(ptr) mem_free(ptr)
+#       define ptr_free_sized(ptr, sz) mem_free_sized(ptr, sz)
+#endif
+
 
 
 
@@ -70,7 +379,162 @@ SOL_TRY:
         sol_assert (sz, SOL_ERNO_RANGE);
 
                 /* allocate heap memory of size @sz to @ptr */
-        sol_assert ((*ptr = malloc(sz)), SOL_ERNO_HEAP);
+        sol_assert ((*ptr = ptr_alloc(sz)), SOL_ERNO_HEAP);
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_ptr_new_aligned() - declared in sol/inc/ptr.h
+ */
+extern sol_erno sol_ptr_new_aligned(sol_ptr **ptr,
+                                    sol_size sz,
+                                    sol_size align)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (ptr && !*ptr, SOL_ERNO_PTR);
+        sol_assert (sz && align && !(align & (align - 1)), SOL_ERNO_RANGE);
+
+                /* map large buffers that need no more than page alignment in
+                 * hosted environments, and allocate the rest from the heap */
+#if (sol_env_host() != SOL_ENV_HOST_NONE)
+        if (sz >= SOL_PTR_MMAP_MIN && align <= 4096) {
+                sol_assert ((*ptr = __sol_ptr_map_new(sz, SOL_BOOL_FALSE)),
+                            SOL_ERNO_HEAP);
+        } else {
+                sol_try (ptr_alloc_aligned(ptr, sz, align));
+        }
+#elif (defined SOL_LIBC_ALIGNED_ALLOC_DEFINED)
+        sol_try (ptr_alloc_aligned(ptr, sz, align));
+#else
+        sol_assert (align <= 2 * sizeof (sol_ptr*), SOL_ERNO_RANGE);
+        sol_try (ptr_alloc_aligned(ptr, sz, align));
+#endif
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_ptr_new_huge() - declared in sol/inc/ptr.h
+ */
+extern sol_erno sol_ptr_new_huge(sol_ptr **ptr,
+                                 sol_size sz)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (ptr && !*ptr, SOL_ERNO_PTR);
+        sol_assert (sz, SOL_ERNO_RANGE);
+
+                /* map @ptr on a huge page boundary in hosted environments, and
+                 * fall back to the heap in freestanding environments */
+#if (sol_env_host() != SOL_ENV_HOST_NONE)
+        sol_assert ((*ptr = __sol_ptr_map_new(sz, SOL_BOOL_TRUE)),
+                    SOL_ERNO_HEAP);
+#else
+        sol_assert ((*ptr = ptr_alloc(sz)), SOL_ERNO_HEAP);
+#endif
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_ptr_new_mirror() - declared in sol/inc/ptr.h
+ */
+extern sol_erno sol_ptr_new_mirror(sol_ptr **ptr,
+                                   sol_size *sz)
+{
+#if (sol_env_host() != SOL_ENV_HOST_NONE)
+        auto sol_size len;
+#endif
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (ptr && !*ptr && sz, SOL_ERNO_PTR);
+        sol_assert (*sz, SOL_ERNO_RANGE);
+
+                /* map @ptr twice in hosted environments that support it; a
+                 * zeroed length signals that the host can't mirror buffers */
+#if (sol_env_host() != SOL_ENV_HOST_NONE)
+        len = *sz;
+        *ptr = __sol_ptr_map_mirror(&len);
+        sol_assert (len, SOL_ERNO_STATE);
+        sol_assert (*ptr, SOL_ERNO_HEAP);
+        *sz = len;
+#else
+        sol_assert (sol_env_host() != SOL_ENV_HOST_NONE, SOL_ERNO_STATE);
+#endif
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_ptr_new_n() - declared in sol/inc/ptr.h
+ */
+extern sol_erno sol_ptr_new_n(sol_ptr **ptr,
+                              const sol_size *sz,
+                              sol_size n)
+{
+        const sol_size ALIGN = 2 * sizeof (sol_ptr*);
+        register sol_size i, off, len = 0;
+        auto sol_w8 *blk;
+
+SOL_TRY:
+                /* check preconditions of the whole batch, summing the sizes
+                 * of the buffers rounded up to keep each one aligned */
+        sol_assert (ptr && sz, SOL_ERNO_PTR);
+        sol_assert (n, SOL_ERNO_RANGE);
+
+        for (i = 0; i < n; i++) {
+                sol_assert (!ptr[i], SOL_ERNO_PTR);
+                sol_assert (sz[i] && sz[i] <= SOL_SIZE_MAX - ALIGN - len,
+                            SOL_ERNO_RANGE);
+                len += (sz[i] + ALIGN - 1) & ~(ALIGN - 1);
+        }
+
+                /* allocate one block and carve it into the buffers */
+        sol_assert ((blk = ptr_alloc(len)), SOL_ERNO_HEAP);
+
+        for (i = off = 0; i < n; i++) {
+                ptr[i] = blk + off;
+                off += (sz[i] + ALIGN - 1) & ~(ALIGN - 1);
+        }
 
 SOL_CATCH:
                 /* log current error */
@@ -84,6 +548,52 @@ SOL_FINALLY:
 
 
 
+/*
+ *      sol_ptr_new_n2() - declared in sol/inc/ptr.h
+ */
+extern sol_erno sol_ptr_new_n2(sol_ptr **ptr,
+                               const sol_size *sz,
+                               sol_size n)
+{
+        register sol_size i, done = 0;
+
+SOL_TRY:
+                /* check preconditions of the whole batch */
+        sol_assert (ptr && sz, SOL_ERNO_PTR);
+        sol_assert (n, SOL_ERNO_RANGE);
+
+        for (i = 0; i < n; i++) {
+                sol_assert (!ptr[i], SOL_ERNO_PTR);
+                sol_assert (sz[i], SOL_ERNO_RANGE);
+        }
+
+                /* allocate each buffer, attributing all of them to the call
+                 * site of the batch */
+        sol_assert ((ptr[0] = ptr_alloc(sz[0])), SOL_ERNO_HEAP);
+
+        for (done = 1; done < n; done++) {
+                sol_assert ((ptr[done] = ptr_alloc_next(ptr[0], sz[done])),
+                            SOL_ERNO_HEAP);
+        }
+
+SOL_CATCH:
+                /* unwind the buffers allocated before the heap ran out, and
+                 * log current error */
+        while (done) {
+                done--;
+                ptr_free_sized(ptr[done], sz[done]);
+                ptr[done] = SOL_PTR_NULL;
+        }
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
 /*
  *      sol_ptr_copy() - declared in sol/inc/ptr.h
  */
@@ -96,9 +606,98 @@ SOL_TRY:
         sol_assert (ptr && !*ptr && src, SOL_ERNO_PTR);
         sol_assert (len, SOL_ERNO_RANGE);
 
-                /* copy contents of @src to @ptr after allocating it */
-        sol_assert ((*ptr = malloc(len)), SOL_ERNO_HEAP);
-        copy_byte(ptr, src, len);
+                /* copy contents of @src to @ptr after allocating it; the copy
+                 * is delegated to the widest memory kernel available */
+        sol_assert ((*ptr = ptr_alloc(len)), SOL_ERNO_HEAP);
+        sol_mem_copy(*ptr, src, len);
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      GROW_MIN - minimum capacity in bytes reserved by sol_ptr_reserve()
+ */
+#define GROW_MIN 64
+
+
+
+
+/*
+ *      sol_ptr_resize() - declared in sol/inc/ptr.h
+ */
+extern sol_erno sol_ptr_resize(sol_ptr **ptr,
+                               sol_size sz)
+{
+        auto sol_ptr *nptr;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (ptr && *ptr, SOL_ERNO_PTR);
+        sol_assert (sz, SOL_ERNO_RANGE);
+
+                /* resize heap memory of @ptr, leaving it intact on failure */
+        sol_assert ((nptr = ptr_realloc(*ptr, sz)), SOL_ERNO_HEAP);
+        *ptr = nptr;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_ptr_reserve() - declared in sol/inc/ptr.h
+ */
+extern sol_erno sol_ptr_reserve(sol_ptr **ptr,
+                                sol_size *cap,
+                                sol_size need)
+{
+        auto sol_size ncap;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (ptr && cap && (*ptr || !*cap), SOL_ERNO_PTR);
+
+                /* grow @ptr only if it isn't already large enough */
+        if (sol_unlikely (need > *cap)) {
+                        /* grow capacity geometrically by half, saturating on
+                         * overflow and never falling short of @need */
+                ncap = *cap > SOL_SIZE_MAX - *cap / 2
+                       ? SOL_SIZE_MAX
+                       : *cap + *cap / 2;
+
+                if (ncap < GROW_MIN) {
+                        ncap = GROW_MIN;
+                }
+
+                if (ncap < need) {
+                        ncap = need;
+                }
+
+                        /* allocate or resize @ptr as required */
+                if (*ptr) {
+                        sol_try (sol_ptr_resize(ptr, ncap));
+                } else {
+                        sol_try (sol_ptr_new(ptr, ncap));
+                }
+
+                *cap = ncap;
+        }
 
 SOL_CATCH:
                 /* log current error */
@@ -117,9 +716,30 @@ SOL_FINALLY:
  */
 extern void sol_ptr_free(sol_ptr **ptr)
 {
-                /* free heap memory allocated to @ptr if it's valid */
+                /* free heap memory allocated to @ptr if it's valid, unmapping
+                 * it instead if it was mapped */
         if (sol_likely (ptr && *ptr)) {
-                free(*ptr);
+                if (sol_likely (!map_free(*ptr))) {
+                        ptr_free(*ptr);
+                }
+
+                *ptr = SOL_PTR_NULL;
+        }
+}
+
+
+
+
+/*
+ *      sol_ptr_free_sized() - declared in sol/inc/ptr.h
+ */
+extern void sol_ptr_free_sized(sol_ptr **ptr,
+                               sol_size sz)
+{
+                /* free heap memory allocated to @ptr if it's valid, passing
+                 * on its size so that its size class needn't be looked up */
+        if (sol_likely (ptr && *ptr)) {
+                ptr_free_sized(*ptr, sz);
                 *ptr = SOL_PTR_NULL;
         }
 }
@@ -127,6 +747,126 @@ extern void sol_ptr_free(sol_ptr **ptr)
 
 
 
+/*
+ *      sol_ptr_free_n() - declared in sol/inc/ptr.h
+ */
+extern void sol_ptr_free_n(sol_ptr **ptr,
+                           sol_size n)
+{
+        register sol_size i;
+
+                /* free the block that starts with the first buffer if @ptr is
+                 * valid, and null every pointer into it */
+        if (sol_likely (ptr && *ptr)) {
+                ptr_free(*ptr);
+
+                for (i = 0; i < n; i++) {
+                        ptr[i] = SOL_PTR_NULL;
+                }
+        }
+}
+
+
+
+
+/*
+ *      sol_ptr_free_n2() - declared in sol/inc/ptr.h
+ */
+extern void sol_ptr_free_n2(sol_ptr **ptr,
+                            const sol_size *sz,
+                            sol_size n)
+{
+        register sol_size i;
+
+                /* free each buffer through the sized path if sizes are given */
+        if (sol_likely (ptr)) {
+                for (i = 0; i < n; i++) {
+                        if (sz) {
+                                sol_ptr_free_sized(&ptr[i], sz[i]);
+                        } else {
+                                sol_ptr_free(&ptr[i]);
+                        }
+                }
+        }
+}
+
+
+
+
+/*
+ *      sol_ptr_allocator_global() - declared in sol/inc/ptr.h
+ */
+extern sol_erno sol_ptr_allocator_global(const sol_allocator *alloc)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (!alloc || (alloc->alloc && alloc->realloc && alloc->free),
+                    SOL_ERNO_PTR);
+
+                /* set global allocator */
+        __atomic_store_n(&alloc_global, alloc, __ATOMIC_RELEASE);
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_ptr_allocator_local() - declared in sol/inc/ptr.h
+ */
+extern sol_erno sol_ptr_allocator_local(const sol_allocator *alloc)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (!alloc || (alloc->alloc && alloc->realloc && alloc->free),
+                    SOL_ERNO_PTR);
+
+                /* set allocator of current thread */
+        alloc_local = alloc;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_ptr_allocator() - declared in sol/inc/ptr.h
+ */
+extern sol_erno sol_ptr_allocator(const sol_allocator **alloc)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (alloc, SOL_ERNO_PTR);
+
+                /* get allocator in effect */
+        *alloc = alloc_get();
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
 /******************************************************************************
  *                                    EOF
  *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
@@ -0,0 +1,340 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/src/rc.c
+ *
+ * Description:
+ *      This file is part of the internal implementation of the Sol Library.
+ *      It implements the reference counted buffer module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "../inc/log.h"
+#include "../inc/mem.h"
+#include "../inc/rc.h"
+
+
+
+
+/*
+ *      header - buffer header
+ *        - count: reference count
+ *        - atomic: flag indicating if @count is updated atomically
+ *        - sz: size in bytes of payload
+ *
+ *      The buffer header is padded to 16 bytes so that the payload following it
+ *      keeps the alignment guaranteed by sol_ptr_new(), and so that the header
+ *      never straddles a cache line.
+ */
+typedef union __header {
+        struct {
+                sol_w32 count;
+                sol_w32 atomic;
+                sol_size sz;
+        } h;
+        sol_w8 pad[16];
+} header;
+
+
+
+
+/*
+ *      hdr_of() - gets header of buffer
+ *        - rc: payload of buffer
+ *      hdr_atomic() - checks if reference count of header is atomic
+ *        - hdr: header of buffer
+ */
+#define hdr_of(rc) ((header*) (rc) - 1)
+#define hdr_atomic(hdr) ((hdr)->h.atomic)
+
+
+
+
+/*
+ *      sol_rc_new() - declared in sol/inc/rc.h
+ */
+extern sol_erno sol_rc_new(sol_rc **rc,
+                           sol_size sz)
+{
+        return sol_rc_new2(rc, sz, SOL_BOOL_FALSE);
+}
+
+
+
+
+/*
+ *      sol_rc_new2() - declared in sol/inc/rc.h
+ */
+extern sol_erno sol_rc_new2(sol_rc **rc,
+                            sol_size sz,
+                            SOL_BOOL atomic)
+{
+        auto header *hdr = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (rc && !*rc, SOL_ERNO_PTR);
+        sol_assert (sz && sz <= SOL_SIZE_MAX - sizeof *hdr, SOL_ERNO_RANGE);
+
+                /* allocate header and payload together */
+        sol_try (sol_ptr_new((sol_ptr**) &hdr, sizeof *hdr + sz));
+        hdr->h.count = 1;
+        hdr->h.atomic = atomic ? 1 : 0;
+        hdr->h.sz = sz;
+
+        *rc = hdr + 1;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_rc_retain() - declared in sol/inc/rc.h
+ */
+extern sol_hot sol_erno sol_rc_retain(sol_rc **rc,
+                                      sol_rc *src)
+{
+        auto header *hdr;
+        auto sol_w32 count;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (rc && !*rc && src, SOL_ERNO_PTR);
+
+                /* increment reference count, refusing to wrap it; atomic
+                 * buffers need a compare-exchange loop so that the check and
+                 * increment are indivisible */
+        hdr = hdr_of(src);
+
+        if (sol_likely (!hdr_atomic(hdr))) {
+                sol_assert (hdr->h.count < SOL_W32_MAX, SOL_ERNO_RANGE);
+                hdr->h.count++;
+        } else {
+                count = __atomic_load_n(&hdr->h.count, __ATOMIC_RELAXED);
+                do {
+                        sol_assert (count < SOL_W32_MAX, SOL_ERNO_RANGE);
+                } while (!__atomic_compare_exchange_n(&hdr->h.count, &count,
+                                                      count + 1, 1,
+                                                      __ATOMIC_RELAXED,
+                                                      __ATOMIC_RELAXED));
+        }
+
+        *rc = src;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_rc_release() - declared in sol/inc/rc.h
+ */
+extern sol_hot void sol_rc_release(sol_rc **rc)
+{
+        auto header *hdr;
+        register sol_w32 count;
+
+                /* decrement reference count if @rc is valid, freeing buffer
+                 * when the last reference is released; the release ordering
+                 * publishes writes to the payload to the owner that frees it */
+        if (sol_likely (rc && *rc)) {
+                hdr = hdr_of(*rc);
+                count = sol_likely (!hdr_atomic(hdr))
+                        ? --hdr->h.count
+                        : __atomic_sub_fetch(&hdr->h.count, 1,
+                                             __ATOMIC_ACQ_REL);
+
+                if (!count) {
+                        sol_ptr_free_sized((sol_ptr**) &hdr,
+                                           sizeof *hdr + hdr->h.sz);
+                }
+
+                *rc = SOL_PTR_NULL;
+        }
+}
+
+
+
+
+/*
+ *      sol_rc_copy() - declared in sol/inc/rc.h
+ */
+extern sol_erno sol_rc_copy(sol_rc **rc,
+                            const sol_ptr *src,
+                            sol_size len)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (rc && !*rc && src, SOL_ERNO_PTR);
+        sol_assert (len, SOL_ERNO_RANGE);
+
+                /* copy @src eagerly; nothing is known about the memory around
+                 * it, so it is never taken to be a reference counted buffer */
+        sol_try (sol_rc_new(rc, len));
+        sol_mem_copy(*rc, src, len);
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_rc_copy2() - declared in sol/inc/rc.h
+ */
+extern sol_erno sol_rc_copy2(sol_rc **rc,
+                             sol_rc *src)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (rc && !*rc && src, SOL_ERNO_PTR);
+
+                /* share @src until either owner writes to it */
+        sol_try (sol_rc_retain(rc, src));
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_rc_write() - declared in sol/inc/rc.h
+ */
+extern sol_hot sol_erno sol_rc_write(sol_rc **rc)
+{
+        auto header *hdr;
+        auto sol_rc *cp = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (rc && *rc, SOL_ERNO_PTR);
+
+                /* a sole owner may write in place, but a shared buffer is first
+                 * copied to a private one; the acquire ordering makes sure that
+                 * owners that have released the buffer are done reading it */
+        hdr = hdr_of(*rc);
+        if (sol_unlikely ((hdr_atomic(hdr)
+                           ? __atomic_load_n(&hdr->h.count, __ATOMIC_ACQUIRE)
+                           : hdr->h.count) > 1)) {
+                sol_try (sol_rc_new2(&cp, hdr->h.sz, hdr_atomic(hdr)
+                                                     ? SOL_BOOL_TRUE
+                                                     : SOL_BOOL_FALSE));
+                sol_mem_copy(cp, *rc, hdr->h.sz);
+                sol_rc_release(rc);
+                *rc = cp;
+        }
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_rc_count() - declared in sol/inc/rc.h
+ */
+extern sol_erno sol_rc_count(const sol_rc *rc,
+                             sol_size *count)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (rc && count, SOL_ERNO_PTR);
+
+                /* return current reference count */
+        *count = __atomic_load_n(&((const header*) rc - 1)->h.count,
+                                 __ATOMIC_RELAXED);
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_rc_size() - declared in sol/inc/rc.h
+ */
+extern sol_erno sol_rc_size(const sol_rc *rc,
+                            sol_size *sz)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (rc && sz, SOL_ERNO_PTR);
+
+                /* return size of payload */
+        *sz = ((const header*) rc - 1)->h.sz;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -0,0 +1,363 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/src/ring.c
+ *
+ * Description:
+ *      This file is part of the internal implementation of the Sol Library.
+ *      It implements the ring buffer module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "../inc/log.h"
+#include "../inc/mem.h"
+#include "../inc/ring.h"
+
+
+
+
+/*
+ *      wrap() - wraps an offset into a ring buffer
+ *        - ring: contextual ring buffer
+ *        - off: offset less than twice the capacity of @ring
+ */
+static sol_inline sol_size wrap(const sol_ring *ring,
+                                sol_size off)
+{
+        return off >= ring->cap ? off - ring->cap : off;
+}
+
+
+
+
+/*
+ *      mirror() - initialises a ring buffer with a mirrored buffer if possible
+ *        - ring: contextual ring buffer
+ *        - sz: minimum capacity in bytes
+ *
+ *      Unlike sol_ring_init2(), this function does not log a failure, since a
+ *      host that can't mirror buffers isn't an error for sol_ring_init(), which
+ *      falls back to a heap buffer instead.
+ *
+ *      Return:
+ *        - SOL_BOOL_TRUE if @ring has been given a mirrored buffer
+ *        - SOL_BOOL_FALSE if the host can't provide one
+ */
+static SOL_BOOL mirror(sol_ring *ring,
+                       sol_size sz)
+{
+#if (sol_env_host() != SOL_ENV_HOST_NONE)
+                /* let the pointer module map the buffer, rounding its size up
+                 * to whole pages */
+        ring->buf = (sol_w8*) __sol_ptr_map_mirror(&sz);
+        if (ring->buf) {
+                ring->cap = sz;
+                ring->rd = 0;
+                ring->len = 0;
+                ring->mirror = SOL_BOOL_TRUE;
+                return SOL_BOOL_TRUE;
+        }
+#else
+        (void) ring;
+        (void) sz;
+#endif
+
+        return SOL_BOOL_FALSE;
+}
+
+
+
+
+/*
+ *      sol_ring_init() - declared in sol/inc/ring.h
+ */
+extern sol_erno sol_ring_init(sol_ring *ring,
+                              sol_size sz)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (ring, SOL_ERNO_PTR);
+        sol_assert (sz, SOL_ERNO_RANGE);
+
+                /* prefer a mirrored buffer, falling back to a heap buffer if
+                 * the host can't provide one; only a failure of the fallback is
+                 * logged */
+        if (!mirror(ring, sz)) {
+                sol_try (sol_ring_init2(ring, sz, SOL_BOOL_FALSE));
+        }
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_ring_init2() - declared in sol/inc/ring.h
+ */
+extern sol_erno sol_ring_init2(sol_ring *ring,
+                               sol_size sz,
+                               SOL_BOOL mirror)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (ring, SOL_ERNO_PTR);
+        sol_assert (sz, SOL_ERNO_RANGE);
+
+                /* reserve storage, letting the pointer module round the size
+                 * of a mirrored buffer up to whole pages */
+        ring->buf = SOL_PTR_NULL;
+        if (mirror) {
+                sol_try (sol_ptr_new_mirror((sol_ptr**) &ring->buf, &sz));
+        } else {
+                sol_try (sol_ptr_new((sol_ptr**) &ring->buf, sz));
+        }
+
+        ring->cap = sz;
+        ring->rd = 0;
+        ring->len = 0;
+        ring->mirror = mirror;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_ring_term() - declared in sol/inc/ring.h
+ */
+extern void sol_ring_term(sol_ring *ring)
+{
+                /* release storage if @ring is valid */
+        if (sol_likely (ring)) {
+                sol_ptr_free((sol_ptr**) &ring->buf);
+                ring->cap = 0;
+                ring->rd = 0;
+                ring->len = 0;
+        }
+}
+
+
+
+
+/*
+ *      sol_ring_write() - declared in sol/inc/ring.h
+ */
+extern sol_hot sol_erno sol_ring_write(sol_ring *ring,
+                                       const sol_ptr *src,
+                                       sol_size len)
+{
+        register sol_size off, head;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (ring && src, SOL_ERNO_PTR);
+        sol_assert (len <= ring->cap - ring->len, SOL_ERNO_RANGE);
+
+                /* copy @src to the tail in one piece if the buffer is mirrored
+                 * or the data doesn't wrap around, and in two pieces
+                 * otherwise */
+        off = wrap(ring, ring->rd + ring->len);
+        if (sol_likely (ring->mirror || len <= ring->cap - off)) {
+                sol_mem_copy(ring->buf + off, src, len);
+        } else {
+                head = ring->cap - off;
+                sol_mem_copy(ring->buf + off, src, head);
+                sol_mem_copy(ring->buf, (const sol_w8*) src + head, len - head);
+        }
+
+        ring->len += len;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_ring_read() - declared in sol/inc/ring.h
+ */
+extern sol_hot sol_erno sol_ring_read(sol_ring *ring,
+                                      sol_ptr *dst,
+                                      sol_size len)
+{
+        register sol_size head;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (ring && dst, SOL_ERNO_PTR);
+        sol_assert (len <= ring->len, SOL_ERNO_RANGE);
+
+                /* copy from the head in one piece if the buffer is mirrored or
+                 * the data doesn't wrap around, and in two pieces otherwise */
+        if (sol_likely (ring->mirror || len <= ring->cap - ring->rd)) {
+                sol_mem_copy(dst, ring->buf + ring->rd, len);
+        } else {
+                head = ring->cap - ring->rd;
+                sol_mem_copy(dst, ring->buf + ring->rd, head);
+                sol_mem_copy((sol_w8*) dst + head, ring->buf, len - head);
+        }
+
+        ring->rd = wrap(ring, ring->rd + len);
+        ring->len -= len;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_ring_peek() - declared in sol/inc/ring.h
+ */
+extern sol_erno sol_ring_peek(const sol_ring *ring,
+                              const sol_ptr **data,
+                              sol_size *len)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (ring && data && len, SOL_ERNO_PTR);
+
+                /* return the contiguous run of unread data at the head */
+        *data = ring->buf + ring->rd;
+        *len = ring->mirror || ring->len <= ring->cap - ring->rd
+               ? ring->len
+               : ring->cap - ring->rd;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_ring_skip() - declared in sol/inc/ring.h
+ */
+extern sol_erno sol_ring_skip(sol_ring *ring,
+                              sol_size len)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (ring, SOL_ERNO_PTR);
+        sol_assert (len <= ring->len, SOL_ERNO_RANGE);
+
+                /* advance the head past @len bytes */
+        ring->rd = wrap(ring, ring->rd + len);
+        ring->len -= len;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_ring_len() - declared in sol/inc/ring.h
+ */
+extern sol_erno sol_ring_len(const sol_ring *ring,
+                             sol_size *len)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (ring && len, SOL_ERNO_PTR);
+
+                /* return length of unread data */
+        *len = ring->len;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_ring_cap() - declared in sol/inc/ring.h
+ */
+extern sol_erno sol_ring_cap(const sol_ring *ring,
+                             sol_size *cap)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (ring && cap, SOL_ERNO_PTR);
+
+                /* return capacity of storage */
+        *cap = ring->cap;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -0,0 +1,471 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/src/tcache.c
+ *
+ * Description:
+ *      This file is part of the internal implementation of the Sol Library.
+ *      It implements the thread-caching front-end of the pointer module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* enable POSIX threads in strict C99 mode */
+#if (!defined _POSIX_C_SOURCE)
+#       define _POSIX_C_SOURCE 200809L
+#endif
+
+
+
+
+        /* include required header files */
+#include "../inc/libc.h"
+#include "../inc/mem.h"
+#include "../inc/ptr.h"
+
+
+
+
+        /* the rest of this file is compiled only if the thread-caching
+         * front-end has been requested */
+#if (defined SOL_PTR_TCACHE)
+#include <pthread.h>
+
+
+
+
+/*
+ *      CLASS_COUNT - number of size classes
+ *      CLASS_LARGE - pseudo size class of buffers served by malloc()
+ *      CLASS_ALIGNED - pseudo size class of buffers served by posix_memalign()
+ *      CLASS_MAX - size in bytes of the largest size class
+ */
+#define CLASS_COUNT 20
+#define CLASS_LARGE CLASS_COUNT
+#define CLASS_ALIGNED (CLASS_COUNT + 1)
+#define CLASS_MAX 1024
+
+
+
+
+/*
+ *      BATCH - number of blocks moved between thread and central caches
+ *
+ *      A thread cache holding more than twice this many blocks of a class
+ *      drains one batch back to the central cache.
+ */
+#define BATCH 32
+
+
+
+
+/*
+ *      header - block header
+ *        - cls: size class of block
+ *
+ *      The block header is padded to 16 bytes so that the payload following it
+ *      keeps the alignment guaranteed by malloc().
+ */
+typedef union __header {
+        sol_size cls;
+        sol_w8 pad[16];
+} header;
+
+
+
+
+/*
+ *      node - free block
+ *        - next: next free block in cache
+ *
+ *      Free blocks are linked through their payload, so that the caches need no
+ *      bookkeeping memory of their own.
+ */
+typedef struct __node {
+        struct __node *next;
+} node;
+
+
+
+
+/*
+ *      class_sz - payload sizes of the size classes
+ *      class_idx - size class of each 16 byte step up to CLASS_MAX
+ */
+static const sol_size class_sz[CLASS_COUNT] = {
+        16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448,
+        512, 640, 768, 896, 1024
+};
+
+static const sol_w8 class_idx[CLASS_MAX / 16 + 1] = {
+        0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 12, 12,
+        13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15, 16, 16, 16, 16, 16, 16,
+        16, 16, 17, 17, 17, 17, 17, 17, 17, 17, 18, 18, 18, 18, 18, 18, 18, 18,
+        19, 19, 19, 19, 19, 19, 19, 19
+};
+
+
+
+
+/*
+ *      tcache - per-thread cache
+ *        - head: free list of each size class
+ *        - count: length of each free list
+ *        - live: flag indicating if thread exit hook is registered
+ */
+static sol_tls struct {
+        node *head[CLASS_COUNT];
+        sol_size count[CLASS_COUNT];
+        int live;
+} tcache;
+
+
+
+
+/*
+ *      central - shared central cache
+ *        - head: free list of each size class
+ *        - lock: lock guarding @head
+ *        - key: key used to drain thread caches on thread exit
+ *        - once: control for one-time initialisation of @key
+ */
+static struct {
+        node *head[CLASS_COUNT];
+        pthread_mutex_t lock;
+        pthread_key_t key;
+        pthread_once_t once;
+} central = {
+        {SOL_PTR_NULL},
+        PTHREAD_MUTEX_INITIALIZER,
+        0,
+        PTHREAD_ONCE_INIT
+};
+
+
+
+
+/*
+ *      class_of() - gets size class of buffer size
+ *        - sz: size in bytes of buffer
+ */
+static sol_inline sol_size class_of(sol_size sz)
+{
+        return sol_likely (sz <= CLASS_MAX)
+               ? class_idx[(sz + 15) >> 4]
+               : CLASS_LARGE;
+}
+
+
+
+
+/*
+ *      drain() - moves blocks from thread cache to central cache
+ *        - cls: size class of blocks
+ *        - n: number of blocks to move
+ */
+static void drain(sol_size cls,
+                  sol_size n)
+{
+        auto node *first, *last;
+
+                /* detach @n blocks from the thread cache outside the lock */
+        first = last = tcache.head[cls];
+        tcache.count[cls] -= n;
+
+        while (--n) {
+                last = last->next;
+        }
+
+        tcache.head[cls] = last->next;
+
+                /* splice detached blocks on to central cache */
+        (void) pthread_mutex_lock(&central.lock);
+        last->next = central.head[cls];
+        central.head[cls] = first;
+        (void) pthread_mutex_unlock(&central.lock);
+}
+
+
+
+
+/*
+ *      thread_exit() - drains thread cache when its thread exits
+ *        - arg: unused
+ */
+static void thread_exit(void *arg)
+{
+        register sol_size cls;
+
+        (void) arg;
+        for (cls = 0; cls < CLASS_COUNT; cls++) {
+                if (tcache.count[cls]) {
+                        drain(cls, tcache.count[cls]);
+                }
+        }
+
+        tcache.live = 0;
+}
+
+
+
+
+/*
+ *      key_init() - creates thread exit key
+ */
+static void key_init(void)
+{
+        (void) pthread_key_create(&central.key, &thread_exit);
+}
+
+
+
+
+/*
+ *      refill() - moves a batch of blocks into thread cache
+ *        - cls: size class of blocks
+ *
+ *      Blocks are taken from the central cache if possible; otherwise a new
+ *      slab holding a whole batch is obtained from malloc() and carved into
+ *      blocks. Slabs are retained by the caches for the lifetime of the
+ *      process. Returns the number of blocks moved, which is zero only if heap
+ *      memory is exhausted.
+ */
+static sol_size refill(sol_size cls)
+{
+        register sol_size n = 0, stride;
+        auto node *first, *last;
+        auto sol_w8 *slab;
+
+                /* register thread exit hook on first use by this thread */
+        if (sol_unlikely (!tcache.live)) {
+                (void) pthread_once(&central.once, &key_init);
+                (void) pthread_setspecific(central.key, &tcache);
+                tcache.live = 1;
+        }
+
+                /* take up to a batch from central cache */
+        (void) pthread_mutex_lock(&central.lock);
+        if ((first = last = central.head[cls])) {
+                for (n = 1; n < BATCH && last->next; n++) {
+                        last = last->next;
+                }
+
+                central.head[cls] = last->next;
+        }
+        (void) pthread_mutex_unlock(&central.lock);
+
+        if (sol_likely (n)) {
+                last->next = tcache.head[cls];
+                tcache.head[cls] = first;
+                tcache.count[cls] += n;
+                return n;
+        }
+
+                /* central cache is empty, so carve a new slab */
+        stride = sizeof (header) + class_sz[cls];
+        if (sol_unlikely (!(slab = malloc(stride * BATCH)))) {
+                return 0;
+        }
+
+        for (n = 0; n < BATCH; n++, slab += stride) {
+                ((header*) slab)->cls = cls;
+                first = (node*) (slab + sizeof (header));
+                first->next = tcache.head[cls];
+                tcache.head[cls] = first;
+        }
+
+        tcache.count[cls] += BATCH;
+        return BATCH;
+}
+
+
+
+
+/*
+ *      release() - returns block to thread cache
+ *        - ptr: payload of block
+ *        - cls: size class of block
+ */
+static sol_inline void release(sol_ptr *ptr,
+                               sol_size cls)
+{
+        auto node *nd = ptr;
+
+        if (sol_unlikely (cls >= CLASS_LARGE)) {
+                free(cls == CLASS_LARGE
+                     ? (sol_ptr*) ((header*) ptr - 1)
+                     : ((sol_ptr**) ((header*) ptr - 1))[-1]);
+                return;
+        }
+
+        nd->next = tcache.head[cls];
+        tcache.head[cls] = nd;
+
+        if (sol_unlikely (++tcache.count[cls] > 2 * BATCH)) {
+                drain(cls, BATCH);
+        }
+}
+
+
+
+
+/*
+ *      __sol_ptr_tcache_alloc() - declared in sol/inc/ptr.h
+ */
+extern sol_hot sol_ptr *__sol_ptr_tcache_alloc(sol_size sz)
+{
+        register sol_size cls = class_of(sz);
+        auto header *hdr;
+        auto node *nd;
+
+                /* serve large buffers directly from malloc(), guarding against
+                 * overflow of the header */
+        if (sol_unlikely (cls == CLASS_LARGE)) {
+                if (sol_unlikely (sz > SOL_SIZE_MAX - sizeof *hdr
+                                  || !(hdr = malloc(sizeof *hdr + sz)))) {
+                        return SOL_PTR_NULL;
+                }
+
+                hdr->cls = CLASS_LARGE;
+                return hdr + 1;
+        }
+
+                /* pop thread cache, refilling it first if required */
+        if (sol_unlikely (!tcache.head[cls] && !refill(cls))) {
+                return SOL_PTR_NULL;
+        }
+
+        nd = tcache.head[cls];
+        tcache.head[cls] = nd->next;
+        tcache.count[cls]--;
+
+        return nd;
+}
+
+
+
+
+/*
+ *      __sol_ptr_tcache_alloc_aligned() - declared in sol/inc/ptr.h
+ */
+extern sol_ptr *__sol_ptr_tcache_alloc_aligned(sol_size sz,
+                                               sol_size align)
+{
+        auto sol_ptr *base;
+        auto header *hdr;
+
+                /* block payloads are already aligned to the header size */
+        if (align <= sizeof *hdr) {
+                return __sol_ptr_tcache_alloc(sz);
+        }
+
+                /* otherwise over-allocate by @align, placing the header just
+                 * below the first aligned payload, and the base address of the
+                 * allocation just below the header */
+        if (sol_unlikely (sz > SOL_SIZE_MAX - align
+                          || posix_memalign(&base, align, align + sz))) {
+                return SOL_PTR_NULL;
+        }
+
+        hdr = (header*) ((sol_w8*) base + align) - 1;
+        hdr->cls = CLASS_ALIGNED;
+        ((sol_ptr**) hdr)[-1] = base;
+
+        return hdr + 1;
+}
+
+
+
+
+/*
+ *      __sol_ptr_tcache_realloc() - declared in sol/inc/ptr.h
+ */
+extern sol_ptr *__sol_ptr_tcache_realloc(sol_ptr *ptr,
+                                         sol_size sz)
+{
+        register sol_size cls = ((header*) ptr - 1)->cls, ncls = class_of(sz);
+        auto header *hdr;
+        auto sol_ptr *nptr;
+
+                /* keep block if its size class is unchanged, so that sized
+                 * frees continue to find the right class */
+        if (ncls == cls && cls != CLASS_LARGE) {
+                return ptr;
+        }
+
+                /* let realloc() grow large buffers in place */
+        if (ncls == CLASS_LARGE && cls == CLASS_LARGE) {
+                if (sol_unlikely (sz > SOL_SIZE_MAX - sizeof *hdr
+                                  || !(hdr = realloc((header*) ptr - 1,
+                                                     sizeof *hdr + sz)))) {
+                        return SOL_PTR_NULL;
+                }
+
+                return hdr + 1;
+        }
+
+                /* otherwise move buffer to a block of the new class */
+        if (sol_unlikely (!(nptr = __sol_ptr_tcache_alloc(sz)))) {
+                return SOL_PTR_NULL;
+        }
+
+        sol_mem_copy(nptr, ptr, cls == CLASS_LARGE || sz < class_sz[cls]
+                                ? sz
+                                : class_sz[cls]);
+        release(ptr, cls);
+
+        return nptr;
+}
+
+
+
+
+/*
+ *      __sol_ptr_tcache_free() - declared in sol/inc/ptr.h
+ */
+extern sol_hot void __sol_ptr_tcache_free(sol_ptr *ptr)
+{
+        release(ptr, ((header*) ptr - 1)->cls);
+}
+
+
+
+
+/*
+ *      __sol_ptr_tcache_free_sized() - declared in sol/inc/ptr.h
+ */
+extern sol_hot void __sol_ptr_tcache_free_sized(sol_ptr *ptr,
+                                                sol_size sz)
+{
+        release(ptr, class_of(sz));
+}
+
+
+
+
+#endif /* defined SOL_PTR_TCACHE */
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
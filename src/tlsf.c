@@ -0,0 +1,871 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/src/tlsf.c
+ *
+ * Description:
+ *      This file is part of the internal implementation of the Sol Library.
+ *      It implements the TLSF heap module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "../inc/log.h"
+#include "../inc/mem.h"
+#include "../inc/tlsf.h"
+
+
+
+
+/*
+ *      ALIGN - alignment in bytes of blocks
+ *      ALIGN_LOG2 - base two logarithm of ALIGN
+ *
+ *      Blocks are aligned to 16 bytes, which matches the alignment guaranteed
+ *      by malloc() on the supported hosts.
+ */
+#define ALIGN 16
+#define ALIGN_LOG2 4
+
+
+
+
+/*
+ *      SL_LOG2 - base two logarithm of count of second-level lists
+ *      SL_COUNT - count of second-level lists per first-level class
+ *      FL_SHIFT - base two logarithm of smallest first-level class
+ *      FL_MAX - base two logarithm of largest first-level class
+ *      FL_COUNT - count of first-level classes
+ *
+ *      Each power of two range of block sizes from 2^FL_SHIFT upwards forms a
+ *      first-level class, which is split linearly into SL_COUNT second-level
+ *      lists. Sizes below 2^FL_SHIFT share the first first-level class, whose
+ *      second-level lists are ALIGN bytes apart.
+ */
+#define SL_LOG2 4
+#define SL_COUNT (1 << SL_LOG2)
+#define FL_SHIFT (SL_LOG2 + ALIGN_LOG2)
+#define FL_MAX 30
+#define FL_COUNT (FL_MAX - FL_SHIFT + 2)
+
+
+
+
+/*
+ *      BLOCK_MIN - smallest block payload in bytes
+ *      BLOCK_MAX - largest block payload in bytes
+ *      BLOCK_FREE - flag bit of block size marking a free block
+ */
+#define BLOCK_MIN ALIGN
+#define BLOCK_MAX (((sol_size) 1 << (FL_MAX + 1)) - ALIGN)
+#define BLOCK_FREE ((sol_size) 1)
+
+
+
+
+/*
+ *      header - block header
+ *        - phys: previous block in memory
+ *        - sz: size in bytes of payload, tagged with BLOCK_FREE
+ *
+ *      The block header is padded to ALIGN bytes so that the payload following
+ *      it is correctly aligned. Blocks are laid out back to back, with a block
+ *      of zero size marking the end of the region, and so the next block in
+ *      memory is found from the size of a block.
+ */
+typedef union __header {
+        struct {
+                union __header *phys;
+                sol_size sz;
+        } h;
+        sol_w8 pad[ALIGN];
+} header;
+
+
+
+
+/*
+ *      link - free list link
+ *        - next: next free block in list
+ *        - prev: previous free block in list
+ *
+ *      Free blocks are linked through their payload, which is why the payload
+ *      of a block can be no smaller than BLOCK_MIN.
+ */
+typedef struct __link {
+        header *next;
+        header *prev;
+} link;
+
+
+
+
+/*
+ *      sol_tlsf - declared in sol/inc/tlsf.h
+ *        - fl_map: bitmap of non-empty first-level classes
+ *        - sl_map: bitmap of non-empty second-level lists of each class
+ *        - head: free lists
+ *        - used: total size in bytes of allocated blocks
+ *        - free: total size in bytes of free blocks
+ *        - nfree: count of free blocks
+ */
+struct __sol_tlsf {
+        sol_w32 fl_map;
+        sol_w32 sl_map[FL_COUNT];
+        header *head[FL_COUNT][SL_COUNT];
+        sol_size used;
+        sol_size free;
+        sol_size nfree;
+};
+
+
+
+
+/*
+ *      heap - fallback heap of pointer module
+ *        - tlsf: TLSF heap
+ *        - lock: spin lock guarding @tlsf
+ */
+static struct {
+        sol_tlsf *tlsf;
+        char lock;
+} heap = {SOL_PTR_NULL, 0};
+
+
+
+
+/*
+ *      blk_sz() - gets payload size of block
+ *      blk_free() - checks if block is free
+ *      blk_link() - gets free list link of block
+ *      blk_next() - gets next block in memory
+ */
+static sol_inline sol_size blk_sz(const header *blk)
+{
+        return blk->h.sz & ~BLOCK_FREE;
+}
+
+static sol_inline sol_size blk_free(const header *blk)
+{
+        return blk->h.sz & BLOCK_FREE;
+}
+
+static sol_inline link *blk_link(header *blk)
+{
+        return (link*) (blk + 1);
+}
+
+static sol_inline header *blk_next(header *blk)
+{
+        return (header*) ((sol_w8*) (blk + 1) + blk_sz(blk));
+}
+
+
+
+
+/*
+ *      fls() - gets index of most significant set bit
+ *        - sz: non-zero size
+ */
+static sol_inline sol_size fls(sol_size sz)
+{
+        return sizeof (unsigned long long) * 8 - 1
+               - (sol_size) __builtin_clzll((unsigned long long) sz);
+}
+
+
+
+
+/*
+ *      map_insert() - gets free list holding blocks of a given size
+ *        - sz: size in bytes of block
+ *        - fl: first-level class
+ *        - sl: second-level list
+ */
+static sol_inline void map_insert(sol_size sz,
+                                  sol_size *fl,
+                                  sol_size *sl)
+{
+        register sol_size f;
+
+        if (sz < ((sol_size) 1 << FL_SHIFT)) {
+                *fl = 0;
+                *sl = sz >> ALIGN_LOG2;
+        } else {
+                f = fls(sz);
+                *fl = f - FL_SHIFT + 1;
+                *sl = (sz >> (f - SL_LOG2)) ^ SL_COUNT;
+        }
+}
+
+
+
+
+/*
+ *      map_search() - gets first free list whose blocks all fit a given size
+ *        - sz: size in bytes of block
+ *        - fl: first-level class
+ *        - sl: second-level list
+ *
+ *      Rounding @sz up to the next list boundary makes any block of the list
+ *      found large enough, which is what keeps allocation in constant time.
+ */
+static sol_inline void map_search(sol_size sz,
+                                  sol_size *fl,
+                                  sol_size *sl)
+{
+        if (sz >= ((sol_size) 1 << FL_SHIFT)) {
+                sz += ((sol_size) 1 << (fls(sz) - SL_LOG2)) - 1;
+        }
+
+        map_insert(sz, fl, sl);
+}
+
+
+
+
+/*
+ *      list_push() - pushes block on to its free list
+ *        - tlsf: contextual TLSF heap
+ *        - blk: block to push
+ */
+static void list_push(sol_tlsf *tlsf,
+                      header *blk)
+{
+        auto sol_size fl, sl;
+        auto link *lk = blk_link(blk);
+
+        map_insert(blk_sz(blk), &fl, &sl);
+
+        lk->prev = SOL_PTR_NULL;
+        lk->next = tlsf->head[fl][sl];
+        if (lk->next) {
+                blk_link(lk->next)->prev = blk;
+        }
+
+        tlsf->head[fl][sl] = blk;
+        tlsf->fl_map |= (sol_w32) 1 << fl;
+        tlsf->sl_map[fl] |= (sol_w32) 1 << sl;
+
+        blk->h.sz |= BLOCK_FREE;
+        tlsf->free += blk_sz(blk);
+        tlsf->nfree++;
+}
+
+
+
+
+/*
+ *      list_pop() - removes block from its free list
+ *        - tlsf: contextual TLSF heap
+ *        - blk: block to remove
+ */
+static void list_pop(sol_tlsf *tlsf,
+                     header *blk)
+{
+        auto sol_size fl, sl;
+        auto link *lk = blk_link(blk);
+
+        map_insert(blk_sz(blk), &fl, &sl);
+
+        if (lk->next) {
+                blk_link(lk->next)->prev = lk->prev;
+        }
+
+        if (lk->prev) {
+                blk_link(lk->prev)->next = lk->next;
+        } else if (!(tlsf->head[fl][sl] = lk->next)) {
+                tlsf->sl_map[fl] &= ~((sol_w32) 1 << sl);
+                if (!tlsf->sl_map[fl]) {
+                        tlsf->fl_map &= ~((sol_w32) 1 << fl);
+                }
+        }
+
+        blk->h.sz &= ~BLOCK_FREE;
+        tlsf->free -= blk_sz(blk);
+        tlsf->nfree--;
+}
+
+
+
+
+/*
+ *      list_find() - finds a free block fitting a given size
+ *        - tlsf: contextual TLSF heap
+ *        - sz: size in bytes of block
+ *
+ *      Returns a null pointer if no free block is large enough.
+ */
+static header *list_find(sol_tlsf *tlsf,
+                         sol_size sz)
+{
+        auto sol_size fl, sl;
+        register sol_w32 map;
+
+        map_search(sz, &fl, &sl);
+        if (sol_unlikely (fl >= FL_COUNT)) {
+                return SOL_PTR_NULL;
+        }
+
+                /* look for a list of the same class first, and of the next
+                 * non-empty larger class otherwise */
+        if (!(map = tlsf->sl_map[fl] & (~(sol_w32) 0 << sl))) {
+                if (!(map = tlsf->fl_map & (~(sol_w32) 0 << (fl + 1)))) {
+                        return SOL_PTR_NULL;
+                }
+
+                fl = (sol_size) __builtin_ctz(map);
+                map = tlsf->sl_map[fl];
+        }
+
+        return tlsf->head[fl][__builtin_ctz(map)];
+}
+
+
+
+
+/*
+ *      blk_merge() - frees block, merging it with its free neighbours
+ *        - tlsf: contextual TLSF heap
+ *        - blk: block to free
+ */
+static void blk_merge(sol_tlsf *tlsf,
+                      header *blk)
+{
+        auto header *nbr = blk->h.phys;
+
+        if (nbr && blk_free(nbr)) {
+                list_pop(tlsf, nbr);
+                nbr->h.sz += sizeof *blk + blk_sz(blk);
+                blk = nbr;
+                blk_next(blk)->h.phys = blk;
+        }
+
+        nbr = blk_next(blk);
+        if (blk_free(nbr)) {
+                list_pop(tlsf, nbr);
+                blk->h.sz = blk_sz(blk) + sizeof *nbr + blk_sz(nbr);
+                blk_next(blk)->h.phys = blk;
+        }
+
+        list_push(tlsf, blk);
+}
+
+
+
+
+/*
+ *      blk_split() - trims allocated block to a given size
+ *        - tlsf: contextual TLSF heap
+ *        - blk: block to trim
+ *        - sz: size in bytes to keep, which must be a multiple of ALIGN
+ *
+ *      The trimmed tail is freed only if it can hold a block of its own;
+ *      otherwise it remains a part of @blk.
+ */
+static void blk_split(sol_tlsf *tlsf,
+                      header *blk,
+                      sol_size sz)
+{
+        auto header *rem;
+
+        if (blk_sz(blk) >= sz + sizeof *rem + BLOCK_MIN) {
+                rem = (header*) ((sol_w8*) (blk + 1) + sz);
+                rem->h.phys = blk;
+                rem->h.sz = blk_sz(blk) - sz - sizeof *rem;
+                blk->h.sz = sz;
+                blk_next(rem)->h.phys = rem;
+                blk_merge(tlsf, rem);
+        }
+}
+
+
+
+
+/*
+ *      blk_round() - rounds request size up to block size
+ *        - sz: size in bytes requested
+ *
+ *      Returns zero if @sz is too large for any block.
+ */
+static sol_inline sol_size blk_round(sol_size sz)
+{
+        if (sol_unlikely (sz > BLOCK_MAX)) {
+                return 0;
+        }
+
+        return sz < BLOCK_MIN
+               ? BLOCK_MIN
+               : (sz + ALIGN - 1) & ~(sol_size) (ALIGN - 1);
+}
+
+
+
+
+/*
+ *      tlsf_alloc() - allocates block
+ *      tlsf_alloc_aligned() - allocates block aligned to a power of two
+ *      tlsf_realloc() - resizes block
+ *      tlsf_free() - frees block
+ *
+ *      These functions follow the contract of malloc(), aligned_alloc(),
+ *      realloc() and free() over a TLSF heap, and do not check their
+ *      arguments.
+ */
+static sol_hot sol_ptr *tlsf_alloc(sol_tlsf *tlsf,
+                                   sol_size sz)
+{
+        auto header *blk;
+
+        if (sol_unlikely (!(sz = blk_round(sz))
+                          || !(blk = list_find(tlsf, sz)))) {
+                return SOL_PTR_NULL;
+        }
+
+        list_pop(tlsf, blk);
+        blk_split(tlsf, blk, sz);
+        tlsf->used += blk_sz(blk);
+
+        return blk + 1;
+}
+
+static sol_ptr *tlsf_alloc_aligned(sol_tlsf *tlsf,
+                                   sol_size sz,
+                                   sol_size align)
+{
+        register sol_size gap, lead = sizeof (header) + BLOCK_MIN;
+        auto header *blk, *nblk;
+
+        if (align <= ALIGN) {
+                return tlsf_alloc(tlsf, sz);
+        }
+
+                /* find a block with room for @sz bytes at the first aligned
+                 * address that leaves either no gap or a gap large enough to
+                 * become a free block of its own */
+        if (sol_unlikely (!(sz = blk_round(sz))
+                          || sz > BLOCK_MAX - align - lead
+                          || !(blk = list_find(tlsf, sz + align + lead)))) {
+                return SOL_PTR_NULL;
+        }
+
+        list_pop(tlsf, blk);
+
+        gap = (align - ((sol_word) (blk + 1) & (align - 1))) & (align - 1);
+        if (gap && gap < lead) {
+                gap += align;
+        }
+
+                /* free the gap as a block of its own */
+        if (gap) {
+                nblk = (header*) ((sol_w8*) blk + gap);
+                nblk->h.phys = blk;
+                nblk->h.sz = blk_sz(blk) - gap;
+                blk->h.sz = gap - sizeof *blk;
+                blk_next(nblk)->h.phys = nblk;
+                blk_merge(tlsf, blk);
+                blk = nblk;
+        }
+
+        blk_split(tlsf, blk, sz);
+        tlsf->used += blk_sz(blk);
+
+        return blk + 1;
+}
+
+static sol_hot void tlsf_free(sol_tlsf *tlsf,
+                              sol_ptr *ptr)
+{
+        auto header *blk = (header*) ptr - 1;
+
+        tlsf->used -= blk_sz(blk);
+        blk_merge(tlsf, blk);
+}
+
+static sol_ptr *tlsf_realloc(sol_tlsf *tlsf,
+                             sol_ptr *ptr,
+                             sol_size sz)
+{
+        auto header *blk = (header*) ptr - 1, *nbr;
+        auto sol_ptr *nptr;
+        register sol_size cur = blk_sz(blk);
+
+        if (sol_unlikely (!(sz = blk_round(sz)))) {
+                return SOL_PTR_NULL;
+        }
+
+                /* resize in place if shrinking, or if the next block is free
+                 * and large enough to absorb */
+        nbr = blk_next(blk);
+        if (sz > cur && blk_free(nbr)
+            && cur + sizeof *nbr + blk_sz(nbr) >= sz) {
+                list_pop(tlsf, nbr);
+                blk->h.sz = cur + sizeof *nbr + blk_sz(nbr);
+                blk_next(blk)->h.phys = blk;
+        }
+
+        if (sz <= blk_sz(blk)) {
+                blk_split(tlsf, blk, sz);
+                tlsf->used += blk_sz(blk) - cur;
+                return ptr;
+        }
+
+                /* otherwise move block */
+        if (sol_unlikely (!(nptr = tlsf_alloc(tlsf, sz)))) {
+                return SOL_PTR_NULL;
+        }
+
+        sol_mem_copy(nptr, ptr, cur);
+        tlsf_free(tlsf, ptr);
+
+        return nptr;
+}
+
+
+
+
+/*
+ *      heap_lock() - acquires fallback heap lock
+ *      heap_unlock() - releases fallback heap lock
+ */
+static sol_inline void heap_lock(void)
+{
+        while (__atomic_test_and_set(&heap.lock, __ATOMIC_ACQUIRE)) {
+                ;
+        }
+}
+
+static sol_inline void heap_unlock(void)
+{
+        __atomic_clear(&heap.lock, __ATOMIC_RELEASE);
+}
+
+
+
+
+/*
+ *      sol_tlsf_init() - declared in sol/inc/tlsf.h
+ */
+extern sol_erno sol_tlsf_init(sol_tlsf **tlsf,
+                              sol_ptr *mem,
+                              sol_size sz)
+{
+        register sol_size skip, ctl = (sizeof **tlsf + ALIGN - 1)
+                                      & ~(sol_size) (ALIGN - 1);
+        auto header *blk;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (tlsf && !*tlsf && mem, SOL_ERNO_PTR);
+        sol_assert (sz >= SOL_TLSF_MIN, SOL_ERNO_RANGE);
+
+                /* place control structure at the first aligned address of
+                 * @mem, and clear it */
+        skip = (ALIGN - ((sol_word) mem & (ALIGN - 1))) & (ALIGN - 1);
+        *tlsf = (sol_tlsf*) ((sol_w8*) mem + skip);
+        sol_mem_set(*tlsf, 0, ctl);
+
+                /* lay out one free block over the rest of @mem, followed by the
+                 * end marker */
+        sz = (sz - skip - ctl - 2 * sizeof *blk) & ~(sol_size) (ALIGN - 1);
+        blk = (header*) ((sol_w8*) *tlsf + ctl);
+        blk->h.phys = SOL_PTR_NULL;
+        blk->h.sz = sz > BLOCK_MAX ? BLOCK_MAX : sz;
+
+        blk_next(blk)->h.phys = blk;
+        blk_next(blk)->h.sz = 0;
+        list_push(*tlsf, blk);
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_tlsf_alloc() - declared in sol/inc/tlsf.h
+ */
+extern sol_hot sol_erno sol_tlsf_alloc(sol_tlsf *tlsf,
+                                       sol_ptr **ptr,
+                                       sol_size sz)
+{
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (tlsf && ptr && !*ptr, SOL_ERNO_PTR);
+        sol_assert (sz && sz <= BLOCK_MAX, SOL_ERNO_RANGE);
+
+                /* allocate block */
+        sol_assert ((*ptr = tlsf_alloc(tlsf, sz)), SOL_ERNO_HEAP);
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_tlsf_realloc() - declared in sol/inc/tlsf.h
+ */
+extern sol_erno sol_tlsf_realloc(sol_tlsf *tlsf,
+                                 sol_ptr **ptr,
+                                 sol_size sz)
+{
+        auto sol_ptr *nptr;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (tlsf && ptr && *ptr, SOL_ERNO_PTR);
+        sol_assert (sz && sz <= BLOCK_MAX, SOL_ERNO_RANGE);
+
+                /* resize block */
+        sol_assert ((nptr = tlsf_realloc(tlsf, *ptr, sz)), SOL_ERNO_HEAP);
+        *ptr = nptr;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_tlsf_free() - declared in sol/inc/tlsf.h
+ */
+extern sol_hot void sol_tlsf_free(sol_tlsf *tlsf,
+                                  sol_ptr **ptr)
+{
+                /* free block if parameters are valid */
+        if (sol_likely (tlsf && ptr && *ptr)) {
+                tlsf_free(tlsf, *ptr);
+                *ptr = SOL_PTR_NULL;
+        }
+}
+
+
+
+
+/*
+ *      sol_tlsf_stats() - declared in sol/inc/tlsf.h
+ */
+extern sol_erno sol_tlsf_stats(const sol_tlsf *tlsf,
+                               sol_tlsf_stat *stat)
+{
+        register sol_size fl, sl;
+        auto header *blk;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (tlsf && stat, SOL_ERNO_PTR);
+
+                /* copy running totals */
+        stat->used = tlsf->used;
+        stat->free = tlsf->free;
+        stat->nfree = tlsf->nfree;
+        stat->largest = 0;
+
+                /* the largest free block lies in the largest non-empty list,
+                 * which is however not sorted */
+        if (tlsf->fl_map) {
+                fl = fls(tlsf->fl_map);
+                sl = fls(tlsf->sl_map[fl]);
+                for (blk = tlsf->head[fl][sl]; blk; blk = blk_link(blk)->next) {
+                        if (blk_sz(blk) > stat->largest) {
+                                stat->largest = blk_sz(blk);
+                        }
+                }
+        }
+
+        stat->frag = stat->free
+                     ? (sol_size) ((sol_w64) (stat->free - stat->largest) * 100
+                                   / stat->free)
+                     : 0;
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_tlsf_heap() - declared in sol/inc/tlsf.h
+ */
+extern sol_erno sol_tlsf_heap(sol_ptr *mem,
+                              sol_size sz)
+{
+        auto sol_tlsf *tlsf = SOL_PTR_NULL, *nul = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* check preconditions; the heap is published only once it has
+                 * been laid out */
+        sol_assert (!__atomic_load_n(&heap.tlsf, __ATOMIC_ACQUIRE),
+                    SOL_ERNO_STATE);
+        sol_try (sol_tlsf_init(&tlsf, mem, sz));
+        sol_assert (__atomic_compare_exchange_n(&heap.tlsf, &nul, tlsf, 0,
+                                                __ATOMIC_RELEASE,
+                                                __ATOMIC_RELAXED),
+                    SOL_ERNO_STATE);
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      sol_tlsf_heap_stats() - declared in sol/inc/tlsf.h
+ */
+extern sol_erno sol_tlsf_heap_stats(sol_tlsf_stat *stat)
+{
+        auto sol_tlsf *tlsf = __atomic_load_n(&heap.tlsf, __ATOMIC_ACQUIRE);
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (stat, SOL_ERNO_PTR);
+        sol_assert (tlsf, SOL_ERNO_STATE);
+
+                /* take snapshot under lock */
+        heap_lock();
+        (void) sol_tlsf_stats(tlsf, stat);
+        heap_unlock();
+
+SOL_CATCH:
+                /* log current error */
+        sol_log_erno(sol_erno_get());
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      __sol_tlsf_heap_alloc() - declared in sol/inc/tlsf.h
+ */
+extern sol_hot sol_ptr *__sol_tlsf_heap_alloc(sol_size sz)
+{
+        auto sol_tlsf *tlsf = __atomic_load_n(&heap.tlsf, __ATOMIC_ACQUIRE);
+        auto sol_ptr *ptr;
+
+        if (sol_unlikely (!tlsf)) {
+                return SOL_PTR_NULL;
+        }
+
+        heap_lock();
+        ptr = tlsf_alloc(tlsf, sz);
+        heap_unlock();
+
+        return ptr;
+}
+
+
+
+
+/*
+ *      __sol_tlsf_heap_alloc_aligned() - declared in sol/inc/tlsf.h
+ */
+extern sol_ptr *__sol_tlsf_heap_alloc_aligned(sol_size sz,
+                                              sol_size align)
+{
+        auto sol_tlsf *tlsf = __atomic_load_n(&heap.tlsf, __ATOMIC_ACQUIRE);
+        auto sol_ptr *ptr;
+
+        if (sol_unlikely (!tlsf)) {
+                return SOL_PTR_NULL;
+        }
+
+        heap_lock();
+        ptr = tlsf_alloc_aligned(tlsf, sz, align);
+        heap_unlock();
+
+        return ptr;
+}
+
+
+
+
+/*
+ *      __sol_tlsf_heap_realloc() - declared in sol/inc/tlsf.h
+ */
+extern sol_ptr *__sol_tlsf_heap_realloc(sol_ptr *ptr,
+                                        sol_size sz)
+{
+        auto sol_tlsf *tlsf = __atomic_load_n(&heap.tlsf, __ATOMIC_ACQUIRE);
+
+        heap_lock();
+        ptr = tlsf_realloc(tlsf, ptr, sz);
+        heap_unlock();
+
+        return ptr;
+}
+
+
+
+
+/*
+ *      __sol_tlsf_heap_free() - declared in sol/inc/tlsf.h
+ */
+extern sol_hot void __sol_tlsf_heap_free(sol_ptr *ptr)
+{
+        auto sol_tlsf *tlsf = __atomic_load_n(&heap.tlsf, __ATOMIC_ACQUIRE);
+
+        heap_lock();
+        tlsf_free(tlsf, ptr);
+        heap_unlock();
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
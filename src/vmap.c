@@ -0,0 +1,365 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/src/vmap.c
+ *
+ * Description:
+ *      This file is part of the internal implementation of the Sol Library.
+ *      It implements the mapped buffers of the pointer module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* enable mmap() flags beyond POSIX in strict C99 mode */
+#if (!defined _DEFAULT_SOURCE)
+#       define _DEFAULT_SOURCE
+#endif
+
+
+
+
+        /* include required header files */
+#include "../inc/env.h"
+#include "../inc/libc.h"
+#include "../inc/ptr.h"
+
+
+
+
+        /* the rest of this file is compiled only in hosted environments */
+#if (sol_env_host() != SOL_ENV_HOST_NONE)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+
+
+
+/*
+ *      PAGE_MIN - smallest page size in bytes of any supported host
+ *      HUGE_SZ - size in bytes of a transparent huge page
+ */
+#define PAGE_MIN ((sol_size) 4096)
+#define HUGE_SZ ((sol_size) 2 * 1024 * 1024)
+
+
+
+
+/*
+ *      MAP_ANONYMOUS - anonymous mapping flag
+ *
+ *      Older BSD and OSX hosts name this flag MAP_ANON.
+ */
+#if (!defined MAP_ANONYMOUS)
+#       define MAP_ANONYMOUS MAP_ANON
+#endif
+
+
+
+
+/*
+ *      entry - registry entry
+ *        - addr: start address of mapped buffer
+ *        - len: length in bytes of mapping
+ */
+typedef struct __entry {
+        sol_w8 *addr;
+        sol_size len;
+} entry;
+
+
+
+
+/*
+ *      reg - registry of mapped buffers
+ *        - ent: entries of mapped buffers
+ *        - count: number of entries in use
+ *        - cap: number of entries reserved
+ *        - page: host page size in bytes
+ *        - lock: spin lock guarding registry
+ *
+ *      The registry allows sol_ptr_free() to tell mapped buffers apart from
+ *      heap buffers. It is consulted only for page-aligned pointers while
+ *      at least one buffer is mapped, so the common free path costs no more
+ *      than an atomic load. Mapped buffers are large and few, so a linear
+ *      search is adequate.
+ */
+static struct {
+        entry *ent;
+        sol_size count;
+        sol_size cap;
+        sol_size page;
+        char lock;
+} reg;
+
+
+
+
+/*
+ *      reg_lock() - acquires registry lock
+ */
+static sol_inline void reg_lock(void)
+{
+        while (__atomic_test_and_set(&reg.lock, __ATOMIC_ACQUIRE)) {
+                ;
+        }
+}
+
+
+
+
+/*
+ *      reg_unlock() - releases registry lock
+ */
+static sol_inline void reg_unlock(void)
+{
+        __atomic_clear(&reg.lock, __ATOMIC_RELEASE);
+}
+
+
+
+
+/*
+ *      reg_add() - adds a mapped buffer to the registry
+ *        - addr: start address of mapped buffer
+ *        - len: length in bytes of mapping
+ *
+ *      Returns SOL_BOOL_FALSE if the registry could not be grown.
+ */
+static SOL_BOOL reg_add(sol_w8 *addr,
+                        sol_size len)
+{
+        auto entry *ent;
+        auto sol_size cap;
+
+        reg_lock();
+
+        if (sol_unlikely (reg.count == reg.cap)) {
+                cap = reg.cap ? reg.cap * 2 : 16;
+                if (!(ent = realloc(reg.ent, cap * sizeof *ent))) {
+                        reg_unlock();
+                        return SOL_BOOL_FALSE;
+                }
+
+                reg.ent = ent;
+                reg.cap = cap;
+        }
+
+        reg.ent[reg.count].addr = addr;
+        reg.ent[reg.count].len = len;
+        __atomic_store_n(&reg.count, reg.count + 1, __ATOMIC_RELEASE);
+
+        reg_unlock();
+        return SOL_BOOL_TRUE;
+}
+
+
+
+
+/*
+ *      page_size() - gets host page size
+ */
+static sol_size page_size(void)
+{
+        auto long sz;
+
+        if (sol_unlikely (!reg.page)) {
+                sz = sysconf(_SC_PAGESIZE);
+                reg.page = sz > 0 ? (sol_size) sz : PAGE_MIN;
+        }
+
+        return reg.page;
+}
+
+
+
+
+/*
+ *      __sol_ptr_map_new() - declared in sol/inc/ptr.h
+ */
+extern sol_ptr *__sol_ptr_map_new(sol_size sz,
+                                  SOL_BOOL huge)
+{
+        register sol_size unit, len, map;
+        auto sol_w8 *base, *addr;
+
+                /* round @sz up to whole pages, or whole huge pages; huge
+                 * mappings are over-allocated so that they can be trimmed to
+                 * a huge page boundary */
+        unit = huge ? HUGE_SZ : page_size();
+        if (sol_unlikely (sz > SOL_SIZE_MAX - 2 * unit)) {
+                return SOL_PTR_NULL;
+        }
+
+        len = (sz + unit - 1) & ~(unit - 1);
+        map = huge ? len + unit - page_size() : len;
+
+        base = mmap(SOL_PTR_NULL, map, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (sol_unlikely (base == MAP_FAILED)) {
+                return SOL_PTR_NULL;
+        }
+
+                /* trim the mapping to its aligned extent */
+        addr = (sol_w8*) (((sol_word) base + unit - 1) & ~((sol_word) unit - 1));
+        if (addr > base) {
+                (void) munmap(base, (sol_size) (addr - base));
+        }
+
+        if (base + map > addr + len) {
+                (void) munmap(addr + len, (sol_size) (base + map - addr - len));
+        }
+
+                /* request transparent huge pages where supported; this is only
+                 * advice, so failure is not an error */
+#if (defined MADV_HUGEPAGE)
+        if (huge) {
+                (void) madvise(addr, len, MADV_HUGEPAGE);
+        }
+#endif
+
+        if (sol_unlikely (!reg_add(addr, len))) {
+                (void) munmap(addr, len);
+                return SOL_PTR_NULL;
+        }
+
+        return addr;
+}
+
+
+
+
+/*
+ *      __sol_ptr_map_mirror() - declared in sol/inc/ptr.h
+ */
+extern sol_ptr *__sol_ptr_map_mirror(sol_size *sz)
+{
+#if (defined SYS_memfd_create)
+        register sol_size unit = page_size(), len;
+        auto sol_w8 *addr;
+        auto int fd;
+
+                /* round @sz up to whole pages, since each page is mapped twice
+                 * and the mirror must start on a page boundary */
+        if (sol_unlikely (*sz > SOL_SIZE_MAX / 2 - unit)) {
+                return SOL_PTR_NULL;
+        }
+
+        len = (*sz + unit - 1) & ~(unit - 1);
+
+                /* back the buffer with an anonymous file, so that it can be
+                 * mapped more than once; memfd_create() is invoked through
+                 * syscall() as older C libraries don't wrap it */
+        fd = (int) syscall(SYS_memfd_create, "sol", 0);
+        if (sol_unlikely (fd < 0)) {
+                return SOL_PTR_NULL;
+        }
+
+        if (sol_unlikely (ftruncate(fd, (off_t) len))) {
+                (void) close(fd);
+                return SOL_PTR_NULL;
+        }
+
+                /* reserve twice the buffer length, and then map the file over
+                 * each half of the reservation */
+        addr = mmap(SOL_PTR_NULL, 2 * len, PROT_NONE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (sol_unlikely (addr == MAP_FAILED)) {
+                (void) close(fd);
+                return SOL_PTR_NULL;
+        }
+
+        if (sol_unlikely (mmap(addr, len, PROT_READ | PROT_WRITE,
+                               MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+                          || mmap(addr + len, len, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_FIXED, fd, 0)
+                             == MAP_FAILED)) {
+                (void) munmap(addr, 2 * len);
+                (void) close(fd);
+                return SOL_PTR_NULL;
+        }
+
+                /* the mappings keep the file alive once it is closed, and are
+                 * released together by __sol_ptr_map_free() */
+        (void) close(fd);
+
+        if (sol_unlikely (!reg_add(addr, 2 * len))) {
+                (void) munmap(addr, 2 * len);
+                return SOL_PTR_NULL;
+        }
+
+        *sz = len;
+        return addr;
+#else
+        *sz = 0;
+        return SOL_PTR_NULL;
+#endif
+}
+
+
+
+
+/*
+ *      __sol_ptr_map_free() - declared in sol/inc/ptr.h
+ */
+extern sol_hot SOL_BOOL __sol_ptr_map_free(sol_ptr *ptr)
+{
+        register sol_index i;
+        auto sol_size len = 0;
+
+                /* heap buffers that can't be mapped take the fast path */
+        if (sol_likely (!__atomic_load_n(&reg.count, __ATOMIC_ACQUIRE)
+                        || ((sol_word) ptr & (PAGE_MIN - 1)))) {
+                return SOL_BOOL_FALSE;
+        }
+
+                /* look up @ptr, removing its entry if it is found */
+        reg_lock();
+        for (i = 0; i < reg.count; i++) {
+                if (reg.ent[i].addr == ptr) {
+                        len = reg.ent[i].len;
+                        reg.ent[i] = reg.ent[reg.count - 1];
+                        __atomic_store_n(&reg.count, reg.count - 1,
+                                         __ATOMIC_RELEASE);
+                        break;
+                }
+        }
+        reg_unlock();
+
+        if (!len) {
+                return SOL_BOOL_FALSE;
+        }
+
+        (void) munmap(ptr, len);
+        return SOL_BOOL_TRUE;
+}
+
+
+
+
+#endif /* sol_env_host() != SOL_ENV_HOST_NONE */
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
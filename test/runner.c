@@ -27,11 +27,26 @@
 
 
 #include "suite.h"
+#include "../inc/tlsf.h"
 #include <stdio.h>
 
 
 
 
+/*
+ *      heap_mem - memory region of fallback heap
+ *
+ *      If SOL_PTR_TLSF is defined, the pointer module is backed by the TLSF
+ *      fallback heap just as it is in freestanding environments without
+ *      malloc(), and so the test runner supplies the heap with a static region.
+ */
+#if (defined SOL_PTR_TLSF)
+static sol_w8 heap_mem[32 * 1024 * 1024];
+#endif
+
+
+
+
 /*
  *      suite - function pointer to test suites
  *        - log  : logging callback
@@ -61,6 +76,15 @@ typedef sol_erno (suite)(sol_tlog *log,
  *        - SUITE_PTR: pointer module test suite
  *        - SUITE_PTR2: freestanding pointer module test suite
  *        - SUITE_LOG: logging module test suite
+ *        - SUITE_PRIM: primitives module test suite
+ *        - SUITE_MEM: memory kernels module test suite
+ *        - SUITE_ARENA: arena allocator module test suite
+ *        - SUITE_POOL: object pool module test suite
+ *        - SUITE_RC: reference counted buffer module test suite
+ *        - SUITE_TLSF: TLSF heap module test suite
+ *        - SUITE_HANDLE: handle table module test suite
+ *        - SUITE_RING: ring buffer module test suite
+ *        - SUITE_BUDGET: memory budget module test suite
  *        - SUITE_COUNT: count of test suites
  */
 typedef enum {
@@ -72,6 +96,14 @@ typedef enum {
         SUITE_PTR2,
         SUITE_LOG,
         SUITE_PRIM,
+        SUITE_MEM,
+        SUITE_ARENA,
+        SUITE_POOL,
+        SUITE_RC,
+        SUITE_TLSF,
+        SUITE_HANDLE,
+        SUITE_RING,
+        SUITE_BUDGET,
         SUITE_COUNT
 } SUITE;
 
@@ -286,6 +318,14 @@ static void suite_init(void)
         suite_hnd[SUITE_PTR2] = __sol_tests_ptr2;
         suite_hnd[SUITE_LOG] = __sol_tests_log;
         suite_hnd[SUITE_PRIM] = __sol_tests_prim;
+        suite_hnd[SUITE_MEM] = __sol_tests_mem;
+        suite_hnd[SUITE_ARENA] = __sol_tests_arena;
+        suite_hnd[SUITE_POOL] = __sol_tests_pool;
+        suite_hnd[SUITE_RC] = __sol_tests_rc;
+        suite_hnd[SUITE_TLSF] = __sol_tests_tlsf;
+        suite_hnd[SUITE_HANDLE] = __sol_tests_handle;
+        suite_hnd[SUITE_RING] = __sol_tests_ring;
+        suite_hnd[SUITE_BUDGET] = __sol_tests_budget;
 }
 
 
@@ -316,6 +356,9 @@ static void suite_exec(void)
 int main(int argc, char **argv)
 {
                 /* initialise */
+#if (defined SOL_PTR_TLSF)
+        (void) sol_tlsf_heap(heap_mem, sizeof heap_mem);
+#endif
         log_init(argc, argv);
         stat_init();
         suite_init();
@@ -120,6 +120,17 @@ extern sol_erno __sol_tests_log(sol_tlog *log,
 
 
 
+        /*
+         * __sol_tests_mem() - test suite for the memory kernels module
+         */
+extern sol_erno __sol_tests_mem(sol_tlog *log,
+                                sol_uint *pass,
+                                sol_uint *fail,
+                                sol_uint *total);
+
+
+
+
         /*
          * __sol_tests_prim() - test suite for the primitives module
          */
@@ -131,6 +142,83 @@ extern sol_erno __sol_tests_prim(sol_tlog *log,
 
 
 
+        /*
+         * __sol_tests_arena() - test suite for the arena allocator module
+         */
+extern sol_erno __sol_tests_arena(sol_tlog *log,
+                                  sol_uint *pass,
+                                  sol_uint *fail,
+                                  sol_uint *total);
+
+
+
+
+        /*
+         * __sol_tests_pool() - test suite for the object pool module
+         */
+extern sol_erno __sol_tests_pool(sol_tlog *log,
+                                 sol_uint *pass,
+                                 sol_uint *fail,
+                                 sol_uint *total);
+
+
+
+
+        /*
+         * __sol_tests_rc() - test suite for the reference counted buffer module
+         */
+extern sol_erno __sol_tests_rc(sol_tlog *log,
+                               sol_uint *pass,
+                               sol_uint *fail,
+                               sol_uint *total);
+
+
+
+
+        /*
+         * __sol_tests_tlsf() - test suite for the TLSF heap module
+         */
+extern sol_erno __sol_tests_tlsf(sol_tlog *log,
+                                 sol_uint *pass,
+                                 sol_uint *fail,
+                                 sol_uint *total);
+
+
+
+
+        /*
+         * __sol_tests_handle() - test suite for the handle table module
+         */
+extern sol_erno __sol_tests_handle(sol_tlog *log,
+                                   sol_uint *pass,
+                                   sol_uint *fail,
+                                   sol_uint *total);
+
+
+
+
+        /*
+         * __sol_tests_ring() - test suite for the ring buffer module
+         */
+extern sol_erno __sol_tests_ring(sol_tlog *log,
+                                 sol_uint *pass,
+                                 sol_uint *fail,
+                                 sol_uint *total);
+
+
+
+
+        /*
+         * __sol_tests_budget() - test suite for the memory budget module
+         */
+extern sol_erno __sol_tests_budget(sol_tlog *log,
+                                   sol_uint *pass,
+                                   sol_uint *fail,
+                                   sol_uint *total);
+
+
+
+
 #endif /* !defined __SOL_LIBRARY_TEST_SUITES */
 
 
@@ -0,0 +1,371 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/test/ts-arena.c
+ *
+ * Description:
+ *      This file is part of the internal quality checking of the Sol Library.
+ *      It implements the test suite for the arena allocator module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "../inc/arena.h"
+#include "./suite.h"
+
+
+
+
+/*
+ *      test_init1() - sol_arena_init() unit test #1
+ */
+static sol_erno test_init1(void)
+{
+        #define DESC_INIT1 "sol_arena_init() throws SOL_ERNO_PTR when passed" \
+                           " a null pointer for @arena"
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_arena_init(SOL_PTR_NULL, 64));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_init2() - sol_arena_init() unit test #2
+ */
+static sol_erno test_init2(void)
+{
+        #define DESC_INIT2 "sol_arena_init() throws SOL_ERNO_RANGE when passed" \
+                           " 0 for @chunk"
+        auto sol_arena arena;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_arena_init(&arena, 0));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_RANGE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_init3() - sol_arena_init2() unit test #1
+ */
+static sol_erno test_init3(void)
+{
+        #define DESC_INIT3 "sol_arena_init2() sets up an arena backed by huge" \
+                           " page chunks"
+        const sol_size CHUNK = 2 * 1024 * 1024;
+        auto sol_arena arena;
+        auto sol_w8 *bfr;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario spanning two chunks */
+        sol_try (sol_arena_init2(&arena, CHUNK, SOL_BOOL_TRUE));
+
+        for (i = 0; i < 3; i++) {
+                bfr = SOL_PTR_NULL;
+                sol_try (sol_arena_alloc(&arena, (sol_ptr**) &bfr,
+                                         CHUNK / 2, 64));
+                bfr[0] = bfr[CHUNK / 2 - 1] = (sol_w8) i;
+        }
+
+                /* check test condition */
+        sol_assert (arena.huge && bfr[0] == 2 && bfr[CHUNK / 2 - 1] == 2,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_arena_term(&arena);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_alloc1() - sol_arena_alloc() unit test #1
+ */
+static sol_erno test_alloc1(void)
+{
+        #define DESC_ALLOC1 "sol_arena_alloc() throws SOL_ERNO_PTR when passed" \
+                            " a pointer for @ptr that has already been" \
+                            " allocated"
+        auto sol_arena arena;
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (!sol_arena_init(&arena, 64), SOL_ERNO_TEST);
+        sol_assert (!sol_arena_alloc(&arena, &ptr, 8, 8), SOL_ERNO_TEST);
+        sol_try (sol_arena_alloc(&arena, &ptr, 8, 8));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        sol_arena_term(&arena);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_alloc2() - sol_arena_alloc() unit test #2
+ */
+static sol_erno test_alloc2(void)
+{
+        #define DESC_ALLOC2 "sol_arena_alloc() throws SOL_ERNO_RANGE when" \
+                            " passed an @align that is not a power of two"
+        auto sol_arena arena;
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (!sol_arena_init(&arena, 64), SOL_ERNO_TEST);
+        sol_try (sol_arena_alloc(&arena, &ptr, 8, 12));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_RANGE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        sol_arena_term(&arena);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_alloc3() - sol_arena_alloc() unit test #3
+ */
+static sol_erno test_alloc3(void)
+{
+        #define DESC_ALLOC3 "sol_arena_alloc() returns buffers aligned to" \
+                            " @align"
+        auto sol_arena arena;
+        auto sol_ptr *ptr;
+        register sol_size align;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_arena_init(&arena, 256));
+
+                /* check test condition for a range of alignments, with an odd
+                 * sized allocation in between to misalign the top */
+        for (align = 1; align <= 512; align <<= 1) {
+                ptr = SOL_PTR_NULL;
+                sol_try (sol_arena_alloc(&arena, &ptr, 3, 1));
+                ptr = SOL_PTR_NULL;
+                sol_try (sol_arena_alloc(&arena, &ptr, 5, align));
+                sol_assert (!((sol_word) ptr & (align - 1)), SOL_ERNO_TEST);
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_arena_term(&arena);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_alloc4() - sol_arena_alloc() unit test #4
+ */
+static sol_erno test_alloc4(void)
+{
+        #define DESC_ALLOC4 "sol_arena_alloc() returns disjoint buffers across" \
+                            " chunks, including buffers larger than a chunk"
+        const sol_size COUNT = 64;
+        auto sol_arena arena;
+        auto sol_w8 *bfr[64];
+        register sol_index i, j;
+
+SOL_TRY:
+                /* set up test scenario, filling each buffer with its index */
+        sol_try (sol_arena_init(&arena, 100));
+
+        for (i = 0; i < COUNT; i++) {
+                bfr[i] = SOL_PTR_NULL;
+                sol_try (sol_arena_alloc(&arena, (sol_ptr**) &bfr[i],
+                                         i * 5 + 1, 8));
+                for (j = 0; j < i * 5 + 1; j++) {
+                        bfr[i][j] = (sol_w8) i;
+                }
+        }
+
+                /* check test condition */
+        for (i = 0; i < COUNT; i++) {
+                for (j = 0; j < i * 5 + 1; j++) {
+                        sol_assert (bfr[i][j] == (sol_w8) i, SOL_ERNO_TEST);
+                }
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_arena_term(&arena);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_reset1() - sol_arena_reset() unit test #1
+ */
+static sol_erno test_reset1(void)
+{
+        #define DESC_RESET1 "sol_arena_reset() releases all allocations and" \
+                            " reuses the retained chunks"
+        auto sol_arena arena;
+        auto sol_ptr *first = SOL_PTR_NULL;
+        auto sol_ptr *ptr;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario spanning several chunks */
+        sol_try (sol_arena_init(&arena, 64));
+        sol_try (sol_arena_alloc(&arena, &first, 16, 16));
+
+        for (i = 0; i < 32; i++) {
+                ptr = SOL_PTR_NULL;
+                sol_try (sol_arena_alloc(&arena, &ptr, 16, 16));
+        }
+
+        sol_arena_reset(&arena);
+
+                /* check test condition */
+        ptr = SOL_PTR_NULL;
+        sol_try (sol_arena_alloc(&arena, &ptr, 16, 16));
+        sol_assert (ptr == first, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_arena_term(&arena);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_term1() - sol_arena_term() unit test #1
+ */
+static sol_erno test_term1(void)
+{
+        #define DESC_TERM1 "sol_arena_term() and sol_arena_reset() execute even" \
+                           " if passed a null pointer for @arena"
+
+                /* set up test scenario */
+        sol_arena_reset(SOL_PTR_NULL);
+        sol_arena_term(SOL_PTR_NULL);
+        return SOL_ERNO_NULL;
+}
+
+
+
+
+/*
+ *      __sol_tests_arena() - declared in sol/test/suite.h
+ */
+extern sol_erno __sol_tests_arena(sol_tlog *log,
+                                  sol_uint *pass,
+                                  sol_uint *fail,
+                                  sol_uint *total)
+{
+        auto sol_tsuite __ts, *ts = &__ts;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (log && pass && fail && total, SOL_ERNO_PTR);
+
+                /* initialise test suite */
+        sol_try (sol_tsuite_init2(ts, log));
+
+                /* register test cases */
+        sol_try (sol_tsuite_register(ts, &test_init1, DESC_INIT1));
+        sol_try (sol_tsuite_register(ts, &test_init2, DESC_INIT2));
+        sol_try (sol_tsuite_register(ts, &test_init3, DESC_INIT3));
+        sol_try (sol_tsuite_register(ts, &test_alloc1, DESC_ALLOC1));
+        sol_try (sol_tsuite_register(ts, &test_alloc2, DESC_ALLOC2));
+        sol_try (sol_tsuite_register(ts, &test_alloc3, DESC_ALLOC3));
+        sol_try (sol_tsuite_register(ts, &test_alloc4, DESC_ALLOC4));
+        sol_try (sol_tsuite_register(ts, &test_reset1, DESC_RESET1));
+        sol_try (sol_tsuite_register(ts, &test_term1, DESC_TERM1));
+
+                /* execute test cases */
+        sol_try (sol_tsuite_exec(ts));
+
+                /* report test counts */
+        sol_try (sol_tsuite_pass(ts, pass));
+        sol_try (sol_tsuite_fail(ts, fail));
+        sol_try (sol_tsuite_total(ts, total));
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_tsuite_term(ts);
+        return sol_erno_get();
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -0,0 +1,415 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/test/ts-budget.c
+ *
+ * Description:
+ *      This file is part of the internal quality checking of the Sol Library.
+ *      It implements the test suite for the memory budget module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "../inc/budget.h"
+#include "./suite.h"
+
+
+
+
+/*
+ *      test_init1() - sol_budget_init() unit test #1
+ */
+static sol_erno test_init1(void)
+{
+        #define DESC_INIT1 "sol_budget_init() throws SOL_ERNO_PTR when passed" \
+                           " a null pointer for @budget"
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_budget_init(SOL_PTR_NULL, 1024));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_init2() - sol_budget_init() unit test #2
+ */
+static sol_erno test_init2(void)
+{
+        #define DESC_INIT2 "sol_budget_init() throws SOL_ERNO_RANGE when" \
+                           " passed 0 for @limit"
+        auto sol_budget budget;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_budget_init(&budget, 0));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_RANGE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_charge1() - sol_budget_charge() unit test #1
+ */
+static sol_erno test_charge1(void)
+{
+        #define DESC_CHARGE1 "sol_budget_charge() accepts charges up to the" \
+                             " limit, and throws SOL_ERNO_BUDGET beyond it"
+        auto sol_budget budget;
+        auto sol_size used;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario with charges that leave credit behind
+                 * in the shard of this thread */
+        sol_try (sol_budget_init(&budget, 1024 * 1024));
+        for (i = 0; i < 1024; i++) {
+                sol_try (sol_budget_charge(&budget, 1000));
+        }
+
+                /* check test condition */
+        sol_try (sol_budget_used(&budget, &used));
+        sol_assert (used == 1024 * 1000, SOL_ERNO_TEST);
+        sol_try (sol_budget_charge(&budget, 1024 * 1024 - used));
+        sol_assert (sol_budget_charge(&budget, 1) == SOL_ERNO_BUDGET,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_charge2() - sol_budget_charge() unit test #2
+ */
+static sol_erno test_charge2(void)
+{
+        #define DESC_CHARGE2 "sol_budget_charge() reclaims credit idling in" \
+                             " other shards before refusing a charge"
+        auto sol_budget budget;
+        auto sol_size used;
+
+SOL_TRY:
+                /* set up test scenario, stranding credit in another shard */
+        sol_try (sol_budget_init(&budget, 1024 * 1024));
+        sol_try (sol_budget_charge(&budget, 512 * 1024));
+        budget.shard[0].credit += 64 * 1024;
+        budget.shard[1].credit += 64 * 1024;
+        budget.resv += 128 * 1024;
+
+                /* check test condition */
+        sol_try (sol_budget_used(&budget, &used));
+        sol_assert (used == 512 * 1024, SOL_ERNO_TEST);
+        sol_try (sol_budget_charge(&budget, 512 * 1024));
+        sol_try (sol_budget_used(&budget, &used));
+        sol_assert (used == 1024 * 1024, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_uncharge1() - sol_budget_uncharge() unit test #1
+ */
+static sol_erno test_uncharge1(void)
+{
+        #define DESC_UNCHARGE1 "sol_budget_uncharge() makes room for later" \
+                               " charges, and executes even if passed a null" \
+                               " pointer"
+        auto sol_budget budget;
+        auto sol_size used;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_budget_uncharge(SOL_PTR_NULL, 16);
+        sol_try (sol_budget_init(&budget, 4096));
+        sol_try (sol_budget_charge(&budget, 4096));
+
+                /* check test condition */
+        for (i = 0; i < 100; i++) {
+                sol_assert (sol_budget_charge(&budget, 1) == SOL_ERNO_BUDGET,
+                            SOL_ERNO_TEST);
+                sol_budget_uncharge(&budget, 64);
+                sol_try (sol_budget_charge(&budget, 64));
+        }
+
+        sol_budget_uncharge(&budget, 4096);
+        sol_try (sol_budget_used(&budget, &used));
+        sol_assert (!used, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_new1() - sol_budget_new() unit test #1
+ */
+static sol_erno test_new1(void)
+{
+        #define DESC_NEW1 "sol_budget_new() throws SOL_ERNO_PTR when passed" \
+                          " a null pointer for @budget or @ptr"
+        auto sol_budget budget;
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (!sol_budget_init(&budget, 1024), SOL_ERNO_TEST);
+        sol_assert (sol_budget_new(SOL_PTR_NULL, &ptr, 8) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_try (sol_budget_new(&budget, SOL_PTR_NULL, 8));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_new2() - sol_budget_new() unit test #2
+ */
+static sol_erno test_new2(void)
+{
+        #define DESC_NEW2 "sol_budget_new() throws SOL_ERNO_BUDGET instead of" \
+                          " SOL_ERNO_HEAP once the quota is exhausted," \
+                          " leaving @ptr null"
+        auto sol_budget budget;
+        auto sol_ptr *ptr[4] = {SOL_PTR_NULL};
+        auto sol_ptr *extra = SOL_PTR_NULL;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_budget_init(&budget, 4096));
+        for (i = 0; i < 4; i++) {
+                sol_try (sol_budget_new(&budget, &ptr[i], 1024));
+        }
+
+                /* check test condition */
+        sol_assert (sol_budget_new(&budget, &extra, 1) == SOL_ERNO_BUDGET,
+                    SOL_ERNO_TEST);
+        sol_assert (!extra, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        for (i = 0; i < 4; i++) {
+                sol_budget_free(&budget, &ptr[i], 1024);
+        }
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_resize1() - sol_budget_resize() unit test #1
+ */
+static sol_erno test_resize1(void)
+{
+        #define DESC_RESIZE1 "sol_budget_resize() charges growth and" \
+                             " uncharges shrinkage, leaving @ptr unchanged" \
+                             " when the quota would be exceeded"
+        auto sol_budget budget;
+        auto sol_ptr *ptr = SOL_PTR_NULL, *old;
+        auto sol_size used;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_budget_init(&budget, 4096));
+        sol_try (sol_budget_new(&budget, &ptr, 1024));
+        sol_try (sol_budget_resize(&budget, &ptr, 1024, 3000));
+        sol_try (sol_budget_used(&budget, &used));
+        sol_assert (used == 3000, SOL_ERNO_TEST);
+
+                /* check test condition */
+        old = ptr;
+        sol_assert (sol_budget_resize(&budget, &ptr, 3000, 5000)
+                    == SOL_ERNO_BUDGET, SOL_ERNO_TEST);
+        sol_assert (ptr == old, SOL_ERNO_TEST);
+        sol_try (sol_budget_resize(&budget, &ptr, 3000, 100));
+        sol_try (sol_budget_used(&budget, &used));
+        sol_assert (used == 100, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_budget_free(&budget, &ptr, 100);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_free1() - sol_budget_free() unit test #1
+ */
+static sol_erno test_free1(void)
+{
+        #define DESC_FREE1 "sol_budget_free() nulls @ptr and uncharges its" \
+                           " size, and executes even if passed null pointers"
+        auto sol_budget budget;
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+        auto sol_size used;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_budget_free(SOL_PTR_NULL, &ptr, 8);
+        sol_budget_free(&budget, SOL_PTR_NULL, 8);
+        sol_try (sol_budget_init(&budget, 4096));
+        sol_budget_free(&budget, &ptr, 8);
+        sol_try (sol_budget_new(&budget, &ptr, 4096));
+        sol_budget_free(&budget, &ptr, 4096);
+
+                /* check test condition */
+        sol_try (sol_budget_used(&budget, &used));
+        sol_assert (!ptr && !used, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_used1() - sol_budget_used() unit test #1
+ */
+static sol_erno test_used1(void)
+{
+        #define DESC_USED1 "sol_budget_used() throws SOL_ERNO_PTR when passed" \
+                           " null pointers"
+        auto sol_budget budget;
+        auto sol_size used;
+
+SOL_TRY:
+                /* check test condition */
+        sol_assert (!sol_budget_init(&budget, 64), SOL_ERNO_TEST);
+        sol_assert (sol_budget_used(SOL_PTR_NULL, &used) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_assert (sol_budget_used(&budget, SOL_PTR_NULL) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      __sol_tests_budget() - declared in sol/test/suite.h
+ */
+extern sol_erno __sol_tests_budget(sol_tlog *log,
+                                   sol_uint *pass,
+                                   sol_uint *fail,
+                                   sol_uint *total)
+{
+        auto sol_tsuite __ts, *ts = &__ts;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (log && pass && fail && total, SOL_ERNO_PTR);
+
+                /* initialise test suite */
+        sol_try (sol_tsuite_init2(ts, log));
+
+                /* register test cases */
+        sol_try (sol_tsuite_register(ts, &test_init1, DESC_INIT1));
+        sol_try (sol_tsuite_register(ts, &test_init2, DESC_INIT2));
+        sol_try (sol_tsuite_register(ts, &test_charge1, DESC_CHARGE1));
+        sol_try (sol_tsuite_register(ts, &test_charge2, DESC_CHARGE2));
+        sol_try (sol_tsuite_register(ts, &test_uncharge1, DESC_UNCHARGE1));
+        sol_try (sol_tsuite_register(ts, &test_new1, DESC_NEW1));
+        sol_try (sol_tsuite_register(ts, &test_new2, DESC_NEW2));
+        sol_try (sol_tsuite_register(ts, &test_resize1, DESC_RESIZE1));
+        sol_try (sol_tsuite_register(ts, &test_free1, DESC_FREE1));
+        sol_try (sol_tsuite_register(ts, &test_used1, DESC_USED1));
+
+                /* execute test cases */
+        sol_try (sol_tsuite_exec(ts));
+
+                /* report test counts */
+        sol_try (sol_tsuite_pass(ts, pass));
+        sol_try (sol_tsuite_fail(ts, fail));
+        sol_try (sol_tsuite_total(ts, total));
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_tsuite_term(ts);
+        return sol_erno_get();
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -0,0 +1,449 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/test/ts-handle.c
+ *
+ * Description:
+ *      This file is part of the internal quality checking of the Sol Library.
+ *      It implements the test suite for the handle table module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "../inc/handle.h"
+#include "./suite.h"
+
+
+
+
+/*
+ *      test_init1() - sol_htable_init() unit test #1
+ */
+static sol_erno test_init1(void)
+{
+        #define DESC_INIT1 "sol_htable_init() throws SOL_ERNO_PTR when passed" \
+                           " a null pointer for @tbl"
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_htable_init(SOL_PTR_NULL, 16));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_init2() - sol_htable_init() unit test #2
+ */
+static sol_erno test_init2(void)
+{
+        #define DESC_INIT2 "sol_htable_init() throws SOL_ERNO_RANGE when" \
+                           " passed 0 for @sz"
+        auto sol_htable tbl;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_htable_init(&tbl, 0));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_RANGE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_new1() - sol_htable_new() unit test #1
+ */
+static sol_erno test_new1(void)
+{
+        #define DESC_NEW1 "sol_htable_new() throws SOL_ERNO_PTR when passed a" \
+                          " handle that is not null"
+        auto sol_htable tbl;
+        auto sol_handle hnd = SOL_HANDLE_NULL;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (!sol_htable_init(&tbl, 8), SOL_ERNO_TEST);
+        sol_assert (!sol_htable_new(&tbl, &hnd), SOL_ERNO_TEST);
+        sol_try (sol_htable_new(&tbl, &hnd));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        sol_htable_term(&tbl);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_new2() - sol_htable_new() unit test #2
+ */
+static sol_erno test_new2(void)
+{
+        #define DESC_NEW2 "sol_htable_new() returns distinct handles to" \
+                          " aligned objects that keep their contents as" \
+                          " storage grows"
+        auto sol_htable tbl;
+        auto sol_handle hnd[100];
+        auto sol_index *obj;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario, storing the index of each object in
+                 * the object itself */
+        sol_try (sol_htable_init(&tbl, sizeof *obj));
+
+        for (i = 0; i < 100; i++) {
+                hnd[i] = SOL_HANDLE_NULL;
+                sol_try (sol_htable_new(&tbl, &hnd[i]));
+                sol_try (sol_htable_get(&tbl, hnd[i], (sol_ptr**) &obj));
+                sol_assert (!((sol_word) obj & (sizeof (sol_ptr*) - 1)),
+                            SOL_ERNO_TEST);
+                *obj = i;
+        }
+
+                /* check test condition */
+        for (i = 0; i < 100; i++) {
+                sol_try (sol_htable_get(&tbl, hnd[i], (sol_ptr**) &obj));
+                sol_assert (*obj == i, SOL_ERNO_TEST);
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_htable_term(&tbl);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_free1() - sol_htable_free() unit test #1
+ */
+static sol_erno test_free1(void)
+{
+        #define DESC_FREE1 "sol_htable_free() nulls @hnd and relocates the" \
+                           " remaining objects without breaking their handles"
+        auto sol_htable tbl;
+        auto sol_handle hnd[64];
+        auto sol_index *obj;
+        auto sol_size len;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario, freeing every third object */
+        sol_try (sol_htable_init(&tbl, sizeof *obj));
+
+        for (i = 0; i < 64; i++) {
+                hnd[i] = SOL_HANDLE_NULL;
+                sol_try (sol_htable_new(&tbl, &hnd[i]));
+                sol_try (sol_htable_get(&tbl, hnd[i], (sol_ptr**) &obj));
+                *obj = i;
+        }
+
+        for (i = 0; i < 64; i += 3) {
+                sol_htable_free(&tbl, &hnd[i]);
+                sol_assert (hnd[i] == SOL_HANDLE_NULL, SOL_ERNO_TEST);
+        }
+
+                /* check test condition */
+        sol_try (sol_htable_len(&tbl, &len));
+        sol_assert (len == 64 - 22, SOL_ERNO_TEST);
+
+        for (i = 0; i < 64; i++) {
+                if (i % 3) {
+                        sol_try (sol_htable_get(&tbl, hnd[i],
+                                                (sol_ptr**) &obj));
+                        sol_assert (*obj == i, SOL_ERNO_TEST);
+                }
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_htable_term(&tbl);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_free2() - sol_htable_free() unit test #2
+ */
+static sol_erno test_free2(void)
+{
+        #define DESC_FREE2 "sol_htable_free() and sol_htable_term() execute" \
+                           " even if passed null pointers or stale handles"
+        auto sol_htable tbl;
+        auto sol_handle hnd = SOL_HANDLE_NULL, old;
+        auto sol_size len;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_htable_free(SOL_PTR_NULL, &hnd);
+        sol_htable_term(SOL_PTR_NULL);
+
+        sol_try (sol_htable_init(&tbl, 8));
+        sol_htable_free(&tbl, SOL_PTR_NULL);
+        sol_htable_free(&tbl, &hnd);
+        sol_try (sol_htable_new(&tbl, &hnd));
+        old = hnd;
+        sol_htable_free(&tbl, &hnd);
+        sol_try (sol_htable_new(&tbl, &hnd));
+        sol_htable_free(&tbl, &old);
+
+                /* check test condition */
+        sol_try (sol_htable_len(&tbl, &len));
+        sol_assert (len == 1 && old != SOL_HANDLE_NULL, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_htable_term(&tbl);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_get1() - sol_htable_get() unit test #1
+ */
+static sol_erno test_get1(void)
+{
+        #define DESC_GET1 "sol_htable_get() throws SOL_ERNO_PTR when passed a" \
+                          " stale handle, even if its slot has been reused"
+        auto sol_htable tbl;
+        auto sol_handle hnd = SOL_HANDLE_NULL, old;
+        auto sol_ptr *ptr;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (!sol_htable_init(&tbl, 8), SOL_ERNO_TEST);
+        sol_assert (!sol_htable_new(&tbl, &hnd), SOL_ERNO_TEST);
+        old = hnd;
+        sol_htable_free(&tbl, &hnd);
+        sol_assert (!sol_htable_new(&tbl, &hnd), SOL_ERNO_TEST);
+        sol_assert (hnd != old, SOL_ERNO_TEST);
+        sol_try (sol_htable_get(&tbl, old, &ptr));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        sol_htable_term(&tbl);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_get2() - sol_htable_get() unit test #2
+ */
+static sol_erno test_get2(void)
+{
+        #define DESC_GET2 "sol_htable_get() throws SOL_ERNO_PTR when passed" \
+                          " SOL_HANDLE_NULL"
+        auto sol_htable tbl;
+        auto sol_handle hnd = SOL_HANDLE_NULL;
+        auto sol_ptr *ptr;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (!sol_htable_init(&tbl, 8), SOL_ERNO_TEST);
+        sol_assert (!sol_htable_new(&tbl, &hnd), SOL_ERNO_TEST);
+        sol_try (sol_htable_get(&tbl, SOL_HANDLE_NULL, &ptr));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        sol_htable_term(&tbl);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_compact1() - sol_htable_compact() unit test #1
+ */
+static sol_erno test_compact1(void)
+{
+        #define DESC_COMPACT1 "sol_htable_free() and sol_htable_compact()" \
+                              " return storage to the heap as objects are" \
+                              " freed"
+        auto sol_htable tbl;
+        auto sol_handle hnd[1000];
+        auto sol_index *obj;
+        auto sol_size peak, cap;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario, freeing all but the last ten objects
+                 * and then compacting */
+        sol_try (sol_htable_init(&tbl, 64));
+
+        for (i = 0; i < 1000; i++) {
+                hnd[i] = SOL_HANDLE_NULL;
+                sol_try (sol_htable_new(&tbl, &hnd[i]));
+                sol_try (sol_htable_get(&tbl, hnd[i], (sol_ptr**) &obj));
+                *obj = i;
+        }
+
+        sol_try (sol_htable_cap(&tbl, &peak));
+        for (i = 0; i < 990; i++) {
+                sol_htable_free(&tbl, &hnd[i]);
+        }
+
+        sol_try (sol_htable_compact(&tbl));
+
+                /* check test condition */
+        sol_try (sol_htable_cap(&tbl, &cap));
+        sol_assert (cap < peak / 4, SOL_ERNO_TEST);
+
+        for (i = 990; i < 1000; i++) {
+                sol_try (sol_htable_get(&tbl, hnd[i], (sol_ptr**) &obj));
+                sol_assert (*obj == i, SOL_ERNO_TEST);
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_htable_term(&tbl);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_stat1() - sol_htable_len() and sol_htable_cap() unit test #1
+ */
+static sol_erno test_stat1(void)
+{
+        #define DESC_STAT1 "sol_htable_len() and sol_htable_cap() throw" \
+                           " SOL_ERNO_PTR when passed null pointers"
+        auto sol_size n;
+
+SOL_TRY:
+                /* check test condition */
+        sol_assert (sol_htable_len(SOL_PTR_NULL, &n) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_assert (sol_htable_cap(SOL_PTR_NULL, &n) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      __sol_tests_handle() - declared in sol/test/suite.h
+ */
+extern sol_erno __sol_tests_handle(sol_tlog *log,
+                                   sol_uint *pass,
+                                   sol_uint *fail,
+                                   sol_uint *total)
+{
+        auto sol_tsuite __ts, *ts = &__ts;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (log && pass && fail && total, SOL_ERNO_PTR);
+
+                /* initialise test suite */
+        sol_try (sol_tsuite_init2(ts, log));
+
+                /* register test cases */
+        sol_try (sol_tsuite_register(ts, &test_init1, DESC_INIT1));
+        sol_try (sol_tsuite_register(ts, &test_init2, DESC_INIT2));
+        sol_try (sol_tsuite_register(ts, &test_new1, DESC_NEW1));
+        sol_try (sol_tsuite_register(ts, &test_new2, DESC_NEW2));
+        sol_try (sol_tsuite_register(ts, &test_free1, DESC_FREE1));
+        sol_try (sol_tsuite_register(ts, &test_free2, DESC_FREE2));
+        sol_try (sol_tsuite_register(ts, &test_get1, DESC_GET1));
+        sol_try (sol_tsuite_register(ts, &test_get2, DESC_GET2));
+        sol_try (sol_tsuite_register(ts, &test_compact1, DESC_COMPACT1));
+        sol_try (sol_tsuite_register(ts, &test_stat1, DESC_STAT1));
+
+                /* execute test cases */
+        sol_try (sol_tsuite_exec(ts));
+
+                /* report test counts */
+        sol_try (sol_tsuite_pass(ts, pass));
+        sol_try (sol_tsuite_fail(ts, fail));
+        sol_try (sol_tsuite_total(ts, total));
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_tsuite_term(ts);
+        return sol_erno_get();
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -150,27 +150,143 @@ static int log_hasstr(const char *path, const char *str, int line)
 
 
 /*
- *      log_hasctm() - check log entry for current timestamp
+ *      log_hasctm() - check log entry for timestamp
  *        - path: path to log file
  *        - line: line in which to check
+ *        - since: time taken before the entry was logged
  *
  *      Return:
- *        - 0 if current timestamp not found
- *        - 1 if current timestamp found
+ *        - 0 if no timestamp from @since up to the current time is found
+ *        - 1 if such a timestamp is found
  */
-static int log_hasctm(const char *path, int line)
+static int log_hasctm(const char *path, int line, time_t since)
 {
         const int NEWLN = 24;
-        auto time_t tm;
+        auto time_t tm, now;
         auto char *ctm;
 
-                /* get current timestamp and trim away trailing newline */
-        (void) time(&tm);
-        ctm = ctime(&tm);
-        ctm[NEWLN] = '\0';
+                /* check each second from @since up to now, so that an entry
+                 * logged in an earlier second than the check is still found;
+                 * the trailing newline of each timestamp is trimmed away */
+        (void) time(&now);
+        for (tm = since; tm <= now; tm++) {
+                ctm = ctime(&tm);
+                ctm[NEWLN] = '\0';
 
-                /* check if current timestamp is in the log file at @path */
-        return log_hasstr(path, ctm, line);
+                if (log_hasstr(path, ctm, line)) {
+                        return 1;
+                }
+        }
+
+                /* wind up */
+        return 0;
+}
+
+
+
+
+/*
+ *      log_lines() - counts log entries
+ *        - path: path to log file
+ *
+ *      Return:
+ *        - number of lines in the log file at @path
+ */
+static int log_lines(const char *path)
+{
+        auto FILE *log = SOL_PTR_NULL;
+        auto int n = 0;
+        auto int c;
+
+                /* count newlines in the log file at @path, which is assumed to
+                 * be a valid string */
+        if ((log = fopen(path, "r"))) { /* NOLINT */
+                while ((c = fgetc(log)) != EOF) {
+                        n += (c == '\n');
+                }
+
+                fclose(log);
+        }
+
+                /* wind up */
+        return n;
+}
+
+
+
+
+/*
+ *      log_tail() - gets last byte of log file
+ *        - path: path to log file
+ *
+ *      Return:
+ *        - last byte of the log file at @path, or EOF if it is empty
+ */
+static int log_tail(const char *path)
+{
+        auto FILE *log = SOL_PTR_NULL;
+        auto int c = EOF;
+
+                /* read the last byte of the log file at @path, which is assumed
+                 * to be a valid string */
+        if ((log = fopen(path, "rb"))) { /* NOLINT */
+                if (!fseek(log, -1, SEEK_END)) {
+                        c = fgetc(log);
+                }
+
+                fclose(log);
+        }
+
+                /* wind up */
+        return c;
+}
+
+
+
+
+/*
+ *      log_burst() - writes a burst of numbered log entries
+ *        - path: path to log file
+ *        - fmt: format of log file
+ *        - cap: queue capacity of asynchronous mode
+ *        - policy: back-pressure policy of asynchronous mode
+ *        - n: number of entries
+ *        - dropped: count of entries dropped
+ *
+ *      The entries are written in asynchronous mode if it's available, and in
+ *      synchronous mode otherwise. The log file is closed once written.
+ */
+static sol_erno log_burst(const char *path,
+                          SOL_LOG_FORMAT fmt,
+                          sol_size cap,
+                          SOL_LOG_POLICY policy,
+                          int n,
+                          sol_size *dropped)
+{
+        auto char msg[32];
+        auto sol_erno rc;
+        register int i;
+
+SOL_TRY:
+                /* set up asynchronous mode, falling back to synchronous mode
+                 * if it has been compiled out */
+        sol_try (sol_log_open3(path, 1, fmt));
+        rc = sol_log_async(cap, policy);
+        sol_assert (!rc || rc == SOL_ERNO_STATE, rc);
+
+                /* write entries, and close log file after counting drops */
+        for (i = 0; i < n; i++) {
+                (void) sprintf(msg, "Burst message #%d.", i);
+                sol_log_trace(msg);
+        }
+
+        sol_try (sol_log_dropped(dropped));
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_log_close();
+        return sol_erno_get();
 }
 
 
@@ -239,15 +355,17 @@ static sol_erno open_test3(void)
                            " by @path"
         const char *PATH = "bld/dummy.test.log";
         const int line = 1;
+        auto time_t since;
 
 SOL_TRY:
                 /* set up test scenario */
+        (void) time(&since);
         sol_try (sol_log_open(PATH));
         sol_log_trace("Hello!");
         sol_log_close();
 
                 /* check test condition */
-        sol_assert (log_hasctm(PATH, line), SOL_ERNO_TEST);
+        sol_assert (log_hasctm(PATH, line, since), SOL_ERNO_TEST);
         sol_assert (log_hasstr(PATH, "[T]", line), SOL_ERNO_TEST);
         sol_assert (log_hasstr(PATH, "Hello!", line), SOL_ERNO_TEST);
 
@@ -354,15 +472,17 @@ static sol_erno open2_test3(void)
                             " by @path when @flush is false"
         const char *PATH = "bld/dummy.test.log";
         const int line = 1;
+        auto time_t since;
 
 SOL_TRY:
                 /* set up test scenario */
+        (void) time(&since);
         sol_try (sol_log_open2(PATH, 0));
         sol_log_trace("Hello!");
         sol_log_close();
 
                 /* check test condition */
-        sol_assert (log_hasctm(PATH, line), SOL_ERNO_TEST);
+        sol_assert (log_hasctm(PATH, line, since), SOL_ERNO_TEST);
         sol_assert (log_hasstr(PATH, "[T]", line), SOL_ERNO_TEST);
         sol_assert (log_hasstr(PATH, "Hello!", line), SOL_ERNO_TEST);
 
@@ -386,15 +506,17 @@ static sol_erno open2_test4(void)
                             " by @path when @flush is true"
         const char *PATH = "bld/dummy.test.log";
         const int line = 1;
+        auto time_t since;
 
 SOL_TRY:
                 /* set up test scenario */
+        (void) time(&since);
         sol_try (sol_log_open2(PATH, 1));
         sol_log_trace("Hello!");
         sol_log_close();
 
                 /* check test condition */
-        sol_assert (log_hasctm(PATH, line), SOL_ERNO_TEST);
+        sol_assert (log_hasctm(PATH, line, since), SOL_ERNO_TEST);
         sol_assert (log_hasstr(PATH, "[T]", line), SOL_ERNO_TEST);
         sol_assert (log_hasstr(PATH, "Hello!", line), SOL_ERNO_TEST);
 
@@ -419,9 +541,11 @@ static sol_erno open2_test5(void)
         const char *PATH = "bld/dummy.test.log";
         const int line = 1;
         const int sleep = 10;
+        auto time_t since;
 
 SOL_TRY:
                 /* set up test scenario */
+        (void) time(&since);
         sol_try (sol_log_open2(PATH, 1));
         sol_log_trace("Hello!");
         sol_log_close();
@@ -431,7 +555,7 @@ SOL_TRY:
         sol_log_close();
 
                 /* check test condition */
-        sol_assert (log_hasctm(PATH, line), SOL_ERNO_TEST);
+        sol_assert (log_hasctm(PATH, line, since), SOL_ERNO_TEST);
         sol_assert (log_hasstr(PATH, "[D]", line), SOL_ERNO_TEST);
         sol_assert (log_hasstr(PATH, "Goodbye!", line), SOL_ERNO_TEST);
 
@@ -456,9 +580,11 @@ static sol_erno open2_test6(void)
         const char *PATH = "bld/dummy.test.log";
         const int line = 2;
         const int sleep = 10;
+        auto time_t since;
 
 SOL_TRY:
                 /* set up test scenario */
+        (void) time(&since);
         sol_try (sol_log_open2(PATH, 1));
         sol_log_trace("Hello!");
         sol_log_close();
@@ -468,7 +594,7 @@ SOL_TRY:
         sol_log_close();
 
                 /* check test condition */
-        sol_assert (log_hasctm(PATH, line), SOL_ERNO_TEST);
+        sol_assert (log_hasctm(PATH, line, since), SOL_ERNO_TEST);
         sol_assert (log_hasstr(PATH, "[D]", line), SOL_ERNO_TEST);
         sol_assert (log_hasstr(PATH, "Goodbye!", line), SOL_ERNO_TEST);
 
@@ -513,32 +639,28 @@ SOL_FINALLY:
 
 
 /*
- *      trace_test1() - sol_log_trace() unit test #1
+ *      open3_test1() - sol_log_open3() unit test #1
  */
-static sol_erno trace_test1(void)
+static sol_erno open3_test1(void)
 {
-        #define TRACE_TEST1 "sol_log_trace() writes a time-stamped trace" \
-                            " message correctly"
+        #define OPEN3_TEST1 "sol_log_open3() throws SOL_ERNO_STATE if a log" \
+                            " file is already open"
         const char *PATH = "bld/dummy.test.log";
-        const char *msg = "This is a sample trace message.";
-        const int line = 1;
 
 SOL_TRY:
                 /* set up test scenario */
         sol_try (sol_log_open(PATH));
-        sol_log_trace(msg);
-        sol_log_close();
-
-                /* check test condition */
-        sol_assert (log_hasctm(PATH, line), SOL_ERNO_TEST);
-        sol_assert (log_hasstr(PATH, "[T]", line), SOL_ERNO_TEST);
-        sol_assert (log_hasstr(PATH, msg, line), SOL_ERNO_TEST);
+        sol_try (sol_log_open3(PATH, 1, SOL_LOG_FORMAT_BINARY));
 
 SOL_CATCH:
-                /* nothing to do in case of an exception */
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_STATE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
 
 SOL_FINALLY:
                 /* wind up */
+        sol_log_close();
         return sol_erno_get();
 }
 
@@ -546,38 +668,24 @@ SOL_FINALLY:
 
 
 /*
- *      trace_test2() - sol_log_trace() unit test #2
- */
-static sol_erno trace_test2(void)
-{
-        #define TRACE_TEST2 "sol_log_trace() performs a safe no-op if called" \
-                            " when no log file is open"
-
-                /* set up test scenario */
-        sol_log_trace("Dummy");
-        return SOL_ERNO_NULL;
-}
-
-
-
-
-/*
- *      trace_test3() - sol_log_trace() unit test #3
+ *      open3_test2() - sol_log_open3() unit test #2
  */
-static sol_erno trace_test3(void)
+static sol_erno open3_test2(void)
 {
-        #define TRACE_TEST3 "sol_log_trace() performs a safe no-op if passed" \
-                            " a null pointer for @msg"
-        const char *PATH = "bld/dummy.test.log";
+        #define OPEN3_TEST2 "sol_log_open3() throws SOL_ERNO_STR when passed" \
+                            " a null pointer or null string for @path"
 
 SOL_TRY:
                 /* set up test scenario */
-        sol_try (sol_log_open(PATH));
-        sol_log_trace(SOL_PTR_NULL);
-        sol_log_close();
+        sol_assert (sol_log_open3(SOL_PTR_NULL, 1, SOL_LOG_FORMAT_TEXT)
+                    == SOL_ERNO_STR, SOL_ERNO_TEST);
+        sol_try (sol_log_open3("", 1, SOL_LOG_FORMAT_TEXT));
 
 SOL_CATCH:
-                /* nothing to do in case of an exception */
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_STR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
 
 SOL_FINALLY:
                 /* wind up */
@@ -588,25 +696,27 @@ SOL_FINALLY:
 
 
 /*
- *      trace_test4() - sol_log_trace() unit test #4
+ *      open3_test3() - sol_log_open3() unit test #3
  */
-static sol_erno trace_test4(void)
+static sol_erno open3_test3(void)
 {
-        #define TRACE_TEST4 "sol_log_trace() performs a safe no-op if passed" \
-                            " a null string for @msg"
+        #define OPEN3_TEST3 "sol_log_open3() throws SOL_ERNO_RANGE when" \
+                            " passed an invalid @fmt"
         const char *PATH = "bld/dummy.test.log";
 
 SOL_TRY:
                 /* set up test scenario */
-        sol_try (sol_log_open(PATH));
-        sol_log_trace("");
-        sol_log_close();
+        sol_try (sol_log_open3(PATH, 1, SOL_LOG_FORMAT_BINARY + 1));
 
 SOL_CATCH:
-                /* nothing to do in case of an exception */
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_RANGE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
 
 SOL_FINALLY:
                 /* wind up */
+        sol_log_close();
         return sol_erno_get();
 }
 
@@ -614,32 +724,47 @@ SOL_FINALLY:
 
 
 /*
- *      debug_test1() - sol_log_debug() unit test #1
+ *      open3_test4() - sol_log_open3() unit test #4
  */
-static sol_erno debug_test1(void)
+static sol_erno open3_test4(void)
 {
-        #define DEBUG_TEST1 "sol_log_debug() writes a time-stamped debug" \
-                            " message correctly"
+        #define OPEN3_TEST4 "sol_log_open3() with SOL_LOG_FORMAT_BINARY" \
+                            " writes entries that sol_log_decode() turns into" \
+                            " text entries"
+        const char *BIN = "bld/dummy.test.blog";
         const char *PATH = "bld/dummy.test.log";
-        const char *msg = "This is a sample debug message.";
-        const int line = 1;
+        register int i;
+        auto time_t since;
 
 SOL_TRY:
-                /* set up test scenario */
-        sol_try (sol_log_open(PATH));
-        sol_log_debug(msg);
+                /* set up test scenario, logging from the same call site
+                 * twice */
+        (void) time(&since);
+        sol_try (sol_log_open3(BIN, 1, SOL_LOG_FORMAT_BINARY));
+        for (i = 0; i < 2; i++) {
+                sol_log_trace("This is a sample trace message.");
+        }
+        sol_log_warn("This is a sample warning message.");
+        sol_log_erno(SOL_ERNO_STR);
         sol_log_close();
+        sol_try (sol_log_decode(BIN, PATH));
 
                 /* check test condition */
-        sol_assert (log_hasctm(PATH, line), SOL_ERNO_TEST);
-        sol_assert (log_hasstr(PATH, "[D]", line), SOL_ERNO_TEST);
-        sol_assert (log_hasstr(PATH, msg, line), SOL_ERNO_TEST);
+        sol_assert (log_lines(PATH) == 4, SOL_ERNO_TEST);
+        sol_assert (log_hasctm(PATH, 1, since), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[T]", 2), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "] [#", 2), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[open3_test4():", 2), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "sample trace message.\n", 2),
+                    SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[W]", 3), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "sample warning", 3), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[E]", 4), SOL_ERNO_TEST);
 
 SOL_CATCH:
-                /* nothing to do in case of an exception */
-
 SOL_FINALLY:
                 /* wind up */
+        sol_log_close();
         return sol_erno_get();
 }
 
@@ -647,41 +772,67 @@ SOL_FINALLY:
 
 
 /*
- *      debug_test2() - sol_log_debug() unit test #2
+ *      open3_test5() - sol_log_open3() unit test #5
  */
-static sol_erno debug_test2(void)
+static sol_erno open3_test5(void)
 {
-        #define DEBUG_TEST2 "sol_log_debug() performs a safe no-op if called" \
-                            " when no log file is open"
+        #define OPEN3_TEST5 "sol_log_open3() appends to a binary log file" \
+                            " when @flush is false"
+        const char *BIN = "bld/dummy.test.blog";
+        const char *PATH = "bld/dummy.test.log";
+        register int i;
 
-                /* set up test scenario */
-        sol_log_debug("Dummy");
-        return SOL_ERNO_NULL;
+SOL_TRY:
+                /* set up test scenario with two logging sessions */
+        for (i = 0; i < 2; i++) {
+                sol_try (sol_log_open3(BIN, !i, SOL_LOG_FORMAT_BINARY));
+                sol_log_debug(i ? "Second session." : "First session.");
+                sol_log_close();
+        }
+
+        sol_try (sol_log_decode(BIN, PATH));
+
+                /* check test condition */
+        sol_assert (log_lines(PATH) == 2, SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[D]", 1), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "First session.", 1), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Second session.", 2), SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_log_close();
+        return sol_erno_get();
 }
 
 
 
 
 /*
- *      debug_test3() - sol_log_debug() unit test #3
+ *      open4_test1() - sol_log_open4() unit test #1
  */
-static sol_erno debug_test3(void)
+static sol_erno open4_test1(void)
 {
-        #define DEBUG_TEST3 "sol_log_debug() performs a safe no-op if passed" \
-                            " a null pointer for @msg"
+        #define OPEN4_TEST1 "sol_log_open4() throws SOL_ERNO_RANGE if passed" \
+                            " an invalid @backend"
         const char *PATH = "bld/dummy.test.log";
 
 SOL_TRY:
                 /* set up test scenario */
-        sol_try (sol_log_open(PATH));
-        sol_log_debug(SOL_PTR_NULL);
-        sol_log_close();
+        sol_assert (sol_log_open4(PATH, 1, SOL_LOG_FORMAT_TEXT, -1)
+                    == SOL_ERNO_RANGE, SOL_ERNO_TEST);
+        sol_try (sol_log_open4(PATH, 1, SOL_LOG_FORMAT_TEXT,
+                               SOL_LOG_BACKEND_URING + 1));
 
 SOL_CATCH:
-                /* nothing to do in case of an exception */
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_RANGE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
 
 SOL_FINALLY:
                 /* wind up */
+        sol_log_close();
         return sol_erno_get();
 }
 
@@ -689,25 +840,38 @@ SOL_FINALLY:
 
 
 /*
- *      debug_test4() - sol_log_debug() unit test #4
+ *      open4_test2() - sol_log_open4() unit test #2
  */
-static sol_erno debug_test4(void)
+static sol_erno open4_test2(void)
 {
-        #define DEBUG_TEST4 "sol_log_debug() performs a safe no-op if passed" \
-                            " a null string for @msg"
+        #define OPEN4_TEST2 "sol_log_open4() with SOL_LOG_BACKEND_MMAP writes" \
+                            " text entries, and the log file is cut to their" \
+                            " length on closing"
         const char *PATH = "bld/dummy.test.log";
+        register int i;
+        auto time_t since;
 
 SOL_TRY:
                 /* set up test scenario */
-        sol_try (sol_log_open(PATH));
-        sol_log_debug("");
+        (void) time(&since);
+        sol_try (sol_log_open4(PATH, 1, SOL_LOG_FORMAT_TEXT,
+                               SOL_LOG_BACKEND_MMAP));
+        for (i = 0; i < 3; i++) {
+                sol_log_tracef("Mapped entry #%d.", i);
+        }
         sol_log_close();
 
-SOL_CATCH:
-                /* nothing to do in case of an exception */
+                /* check test condition */
+        sol_assert (log_lines(PATH) == 3, SOL_ERNO_TEST);
+        sol_assert (log_tail(PATH) == '\n', SOL_ERNO_TEST);
+        sol_assert (log_hasctm(PATH, 1, since), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[T]", 2), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Mapped entry #2.", 3), SOL_ERNO_TEST);
 
+SOL_CATCH:
 SOL_FINALLY:
                 /* wind up */
+        sol_log_close();
         return sol_erno_get();
 }
 
@@ -715,32 +879,37 @@ SOL_FINALLY:
 
 
 /*
- *      warn_test1() - sol_log_warn() unit test #1
+ *      open4_test3() - sol_log_open4() unit test #3
  */
-static sol_erno warn_test1(void)
+static sol_erno open4_test3(void)
 {
-        #define WARN_TEST1 "sol_log_warn() writes a time-stamped warning" \
-                           " message correctly"
+        #define OPEN4_TEST3 "sol_log_open4() with SOL_LOG_BACKEND_MMAP" \
+                            " appends to a text log file when @flush is" \
+                            " false"
         const char *PATH = "bld/dummy.test.log";
-        const char *msg = "This is a sample warning message.";
-        const int line = 1;
 
 SOL_TRY:
-                /* set up test scenario */
+                /* set up test scenario with a stdio session followed by a
+                 * memory-mapped one */
         sol_try (sol_log_open(PATH));
-        sol_log_warn(msg);
+        sol_log_debug("First session.");
+        sol_log_close();
+
+        sol_try (sol_log_open4(PATH, 0, SOL_LOG_FORMAT_TEXT,
+                               SOL_LOG_BACKEND_MMAP));
+        sol_log_debug("Second session.");
         sol_log_close();
 
                 /* check test condition */
-        sol_assert (log_hasctm(PATH, line), SOL_ERNO_TEST);
-        sol_assert (log_hasstr(PATH, "[W]", line), SOL_ERNO_TEST);
-        sol_assert (log_hasstr(PATH, msg, line), SOL_ERNO_TEST);
+        sol_assert (log_lines(PATH) == 2, SOL_ERNO_TEST);
+        sol_assert (log_tail(PATH) == '\n', SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "First session.", 1), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Second session.", 2), SOL_ERNO_TEST);
 
 SOL_CATCH:
-                /* nothing to do in case of an exception */
-
 SOL_FINALLY:
                 /* wind up */
+        sol_log_close();
         return sol_erno_get();
 }
 
@@ -748,41 +917,86 @@ SOL_FINALLY:
 
 
 /*
- *      warn_test2() - sol_log_warn() unit test #2
+ *      open4_test4() - sol_log_open4() unit test #4
  */
-static sol_erno warn_test2(void)
+static sol_erno open4_test4(void)
 {
-        #define WARN_TEST2 "sol_log_warn() performs a safe no-op if called" \
-                           " when no log file is open"
+        #define OPEN4_TEST4 "sol_log_open4() with SOL_LOG_BACKEND_MMAP writes" \
+                            " binary log files that sol_log_decode() turns" \
+                            " into text entries"
+        const char *BIN = "bld/dummy.test.blog";
+        const char *PATH = "bld/dummy.test.log";
+        register int i;
 
-                /* set up test scenario */
-        sol_log_warn("Dummy");
-        return SOL_ERNO_NULL;
+SOL_TRY:
+                /* set up test scenario with two logging sessions */
+        for (i = 0; i < 2; i++) {
+                sol_try (sol_log_open4(BIN, !i, SOL_LOG_FORMAT_BINARY,
+                                       SOL_LOG_BACKEND_MMAP));
+                sol_log_warn(i ? "Second session." : "First session.");
+                sol_log_close();
+        }
+
+        sol_try (sol_log_decode(BIN, PATH));
+
+                /* check test condition */
+        sol_assert (log_lines(PATH) == 2, SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[W]", 1), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "First session.", 1), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Second session.", 2), SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_log_close();
+        return sol_erno_get();
 }
 
 
 
 
 /*
- *      warn_test3() - sol_log_warn() unit test #3
+ *      open4_test5() - sol_log_open4() unit test #5
  */
-static sol_erno warn_test3(void)
+static sol_erno open4_test5(void)
 {
-        #define WARN_TEST3 "sol_log_warn() performs a safe no-op if passed" \
-                           " a null pointer for @msg"
+        #define OPEN4_TEST5 "sol_log_open4() with SOL_LOG_BACKEND_WRITEV" \
+                            " writes text entries spanning several rounds of" \
+                            " chunks, along with an overlong message"
         const char *PATH = "bld/dummy.test.log";
+        auto char big[3000];
+        auto time_t since;
+        register int i;
 
 SOL_TRY:
-                /* set up test scenario */
-        sol_try (sol_log_open(PATH));
-        sol_log_warn(SOL_PTR_NULL);
+                /* set up test scenario with enough entries to fill all the
+                 * chunks more than once */
+        (void) time(&since);
+        sol_try (sol_log_open4(PATH, 1, SOL_LOG_FORMAT_TEXT,
+                               SOL_LOG_BACKEND_WRITEV));
+        for (i = 0; i < 30000; i++) {
+                sol_log_tracef("Gathered entry #%d.", i);
+        }
+
+        for (i = 0; i < (int) sizeof big - 1; i++) {
+                big[i] = 'x';
+        }
+        big[i] = '\0';
+        sol_log_debug(big);
         sol_log_close();
 
-SOL_CATCH:
-                /* nothing to do in case of an exception */
+                /* check test condition */
+        sol_assert (log_lines(PATH) == 30001, SOL_ERNO_TEST);
+        sol_assert (log_tail(PATH) == '\n', SOL_ERNO_TEST);
+        sol_assert (log_hasctm(PATH, 1, since), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Gathered entry #0.", 1), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Gathered entry #29999.", 30000),
+                    SOL_ERNO_TEST);
 
+SOL_CATCH:
 SOL_FINALLY:
                 /* wind up */
+        sol_log_close();
         return sol_erno_get();
 }
 
@@ -790,25 +1004,38 @@ SOL_FINALLY:
 
 
 /*
- *      warn_test3() - sol_log_warn() unit test #3
+ *      open4_test6() - sol_log_open4() unit test #6
  */
-static sol_erno warn_test4(void)
+static sol_erno open4_test6(void)
 {
-        #define WARN_TEST4 "sol_log_warn() performs a safe no-op if passed" \
-                           " a null string for @msg"
+        #define OPEN4_TEST6 "sol_log_open4() with SOL_LOG_BACKEND_WRITEV" \
+                            " appends to binary log files that" \
+                            " sol_log_decode() turns into text entries"
+        const char *BIN = "bld/dummy.test.blog";
         const char *PATH = "bld/dummy.test.log";
+        register int i;
 
 SOL_TRY:
-                /* set up test scenario */
-        sol_try (sol_log_open(PATH));
-        sol_log_warn("");
-        sol_log_close();
+                /* set up test scenario with two logging sessions */
+        for (i = 0; i < 2; i++) {
+                sol_try (sol_log_open4(BIN, !i, SOL_LOG_FORMAT_BINARY,
+                                       SOL_LOG_BACKEND_WRITEV));
+                sol_log_warn(i ? "Second session." : "First session.");
+                sol_log_close();
+        }
 
-SOL_CATCH:
-                /* nothing to do in case of an exception */
+        sol_try (sol_log_decode(BIN, PATH));
+
+                /* check test condition */
+        sol_assert (log_lines(PATH) == 2, SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[W]", 1), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "First session.", 1), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Second session.", 2), SOL_ERNO_TEST);
 
+SOL_CATCH:
 SOL_FINALLY:
                 /* wind up */
+        sol_log_close();
         return sol_erno_get();
 }
 
@@ -816,25 +1043,115 @@ SOL_FINALLY:
 
 
 /*
- *      error_test1() - sol_log_error() unit test #1
+ *      open4_test7() - sol_log_open4() unit test #7
  */
-static sol_erno error_test1(void)
+static sol_erno open4_test7(void)
 {
-        #define ERROR_TEST1 "sol_log_error() writes a time-stamped error" \
-                            " message correctly"
+        #define OPEN4_TEST7 "sol_log_open4() with SOL_LOG_BACKEND_URING" \
+                            " appends text entries spanning several rounds of" \
+                            " chunks, or throws SOL_ERNO_STATE if it has been" \
+                            " compiled out"
         const char *PATH = "bld/dummy.test.log";
-        const char *msg = "This is a sample error message.";
-        const int line = 1;
+        auto sol_erno rc;
+        register int i, n;
+
+SOL_TRY:
+                /* set up test scenario with a stdio session followed by an
+                 * io_uring one, which writes nothing if the backend has been
+                 * compiled out or the kernel refuses io_uring */
+        sol_try (sol_log_open(PATH));
+        sol_log_debug("First session.");
+        sol_log_close();
+
+        rc = sol_log_open4(PATH, 0, SOL_LOG_FORMAT_TEXT,
+                           SOL_LOG_BACKEND_URING);
+        sol_assert (!rc || rc == SOL_ERNO_STATE || rc == SOL_ERNO_FILE, rc);
+
+        n = rc ? 0 : 30000;
+        for (i = 0; i < n; i++) {
+                sol_log_tracef("Submitted entry #%d.", i);
+        }
+        sol_log_close();
+
+                /* check test condition */
+        sol_assert (log_lines(PATH) == n + 1, SOL_ERNO_TEST);
+        sol_assert (log_tail(PATH) == '\n', SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "First session.", 1), SOL_ERNO_TEST);
+        sol_assert (!n || log_hasstr(PATH, "Submitted entry #29999.", n + 1),
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_log_close();
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      open4_test8() - sol_log_open4() unit test #8
+ */
+static sol_erno open4_test8(void)
+{
+        #define OPEN4_TEST8 "sol_log_open4() throws SOL_ERNO_STATE if a" \
+                            " memory-mapped log file is already open, and" \
+                            " leaves it intact"
+        const char *PATH = "bld/dummy.test.log";
+        const char *PATH2 = "bld/dummy.test2.log";
+
+SOL_TRY:
+                /* set up test scenario with a second log file opened while a
+                 * memory-mapped one is still open */
+        sol_try (sol_log_open4(PATH, 1, SOL_LOG_FORMAT_TEXT,
+                               SOL_LOG_BACKEND_MMAP));
+        sol_log_debug("Before second open.");
+        sol_assert (sol_log_open4(PATH2, 1, SOL_LOG_FORMAT_TEXT,
+                                  SOL_LOG_BACKEND_STDIO) == SOL_ERNO_STATE,
+                    SOL_ERNO_TEST);
+        sol_log_debug("After second open.");
+        sol_log_close();
+
+                /* check test condition */
+        sol_assert (log_lines(PATH) == 2, SOL_ERNO_TEST);
+        sol_assert (log_tail(PATH) == '\n', SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Before second open.", 1),
+                    SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "After second open.", 2), SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_log_close();
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      trace_test1() - sol_log_trace() unit test #1
+ */
+static sol_erno trace_test1(void)
+{
+        #define TRACE_TEST1 "sol_log_trace() writes a time-stamped trace" \
+                            " message correctly"
+        const char *PATH = "bld/dummy.test.log";
+        const char *msg = "This is a sample trace message.";
+        const int line = 1;
+        auto time_t since;
 
 SOL_TRY:
                 /* set up test scenario */
+        (void) time(&since);
         sol_try (sol_log_open(PATH));
-        sol_log_error(msg);
+        sol_log_trace(msg);
         sol_log_close();
 
                 /* check test condition */
-        sol_assert (log_hasctm(PATH, line), SOL_ERNO_TEST);
-        sol_assert (log_hasstr(PATH, "[E]", line), SOL_ERNO_TEST);
+        sol_assert (log_hasctm(PATH, line, since), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[T]", line), SOL_ERNO_TEST);
         sol_assert (log_hasstr(PATH, msg, line), SOL_ERNO_TEST);
 
 SOL_CATCH:
@@ -849,15 +1166,15 @@ SOL_FINALLY:
 
 
 /*
- *      error_test2() - sol_log_error() unit test #2
+ *      trace_test2() - sol_log_trace() unit test #2
  */
-static sol_erno error_test2(void)
+static sol_erno trace_test2(void)
 {
-        #define ERROR_TEST2 "sol_log_error() performs a safe no-op if called" \
+        #define TRACE_TEST2 "sol_log_trace() performs a safe no-op if called" \
                             " when no log file is open"
 
                 /* set up test scenario */
-        sol_log_error("Dummy");
+        sol_log_trace("Dummy");
         return SOL_ERNO_NULL;
 }
 
@@ -865,18 +1182,18 @@ static sol_erno error_test2(void)
 
 
 /*
- *      error_test3() - sol_log_error() unit test #3
+ *      trace_test3() - sol_log_trace() unit test #3
  */
-static sol_erno error_test3(void)
+static sol_erno trace_test3(void)
 {
-        #define ERROR_TEST3 "sol_log_error() performs a safe no-op if passed" \
+        #define TRACE_TEST3 "sol_log_trace() performs a safe no-op if passed" \
                             " a null pointer for @msg"
         const char *PATH = "bld/dummy.test.log";
 
 SOL_TRY:
                 /* set up test scenario */
         sol_try (sol_log_open(PATH));
-        sol_log_error(SOL_PTR_NULL);
+        sol_log_trace(SOL_PTR_NULL);
         sol_log_close();
 
 SOL_CATCH:
@@ -891,18 +1208,18 @@ SOL_FINALLY:
 
 
 /*
- *      error_test4() - sol_log_error() unit test #4
+ *      trace_test4() - sol_log_trace() unit test #4
  */
-static sol_erno error_test4(void)
+static sol_erno trace_test4(void)
 {
-        #define ERROR_TEST4 "sol_log_error() performs a safe no-op if passed" \
+        #define TRACE_TEST4 "sol_log_trace() performs a safe no-op if passed" \
                             " a null string for @msg"
         const char *PATH = "bld/dummy.test.log";
 
 SOL_TRY:
                 /* set up test scenario */
         sol_try (sol_log_open(PATH));
-        sol_log_error("");
+        sol_log_trace("");
         sol_log_close();
 
 SOL_CATCH:
@@ -917,25 +1234,175 @@ SOL_FINALLY:
 
 
 /*
- *      erno_test1() - sol_log_erno() unit test #1
+ *      trace_test5() - sol_log_trace() unit test #5
  */
-static sol_erno erno_test1(void)
+static sol_erno trace_test5(void)
 {
-        #define ERNO_TEST1 "sol_log_erno() writes a time-stamped error code" \
+        #define TRACE_TEST5 "sol_log_trace() stamps every entry of a thread" \
+                            " with the same thread number"
+        const char *PATH = "bld/dummy.test.log";
+        auto FILE *log = SOL_PTR_NULL;
+        auto char bfr[256], tid[32];
+        register int i, j;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_open(PATH));
+        sol_log_trace("This is the first sample trace message.");
+        sol_log_trace("This is the second sample trace message.");
+        sol_log_close();
+
+                /* extract the thread number of the first entry, which follows
+                 * its timestamp */
+        log = fopen(PATH, "r"); /* NOLINT */
+        sol_assert (log && fgets(bfr, sizeof bfr, log), SOL_ERNO_TEST);
+
+        for (i = 0; bfr[i] && !(bfr[i] == '[' && bfr[i + 1] == '#'); i++);
+        for (j = 0; bfr[i] && bfr[i] != ']' && j < 30; tid[j++] = bfr[i++]);
+        tid[j] = '\0';
+
+                /* check test condition */
+        sol_assert (j > 2 && bfr[i] == ']', SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, tid, 2), SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        if (log) {
+                fclose(log);
+        }
+
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      debug_test1() - sol_log_debug() unit test #1
+ */
+static sol_erno debug_test1(void)
+{
+        #define DEBUG_TEST1 "sol_log_debug() writes a time-stamped debug" \
+                            " message correctly"
+        const char *PATH = "bld/dummy.test.log";
+        const char *msg = "This is a sample debug message.";
+        const int line = 1;
+        auto time_t since;
+
+SOL_TRY:
+                /* set up test scenario */
+        (void) time(&since);
+        sol_try (sol_log_open(PATH));
+        sol_log_debug(msg);
+        sol_log_close();
+
+                /* check test condition */
+        sol_assert (log_hasctm(PATH, line, since), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[D]", line), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, msg, line), SOL_ERNO_TEST);
+
+SOL_CATCH:
+                /* nothing to do in case of an exception */
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      debug_test2() - sol_log_debug() unit test #2
+ */
+static sol_erno debug_test2(void)
+{
+        #define DEBUG_TEST2 "sol_log_debug() performs a safe no-op if called" \
+                            " when no log file is open"
+
+                /* set up test scenario */
+        sol_log_debug("Dummy");
+        return SOL_ERNO_NULL;
+}
+
+
+
+
+/*
+ *      debug_test3() - sol_log_debug() unit test #3
+ */
+static sol_erno debug_test3(void)
+{
+        #define DEBUG_TEST3 "sol_log_debug() performs a safe no-op if passed" \
+                            " a null pointer for @msg"
+        const char *PATH = "bld/dummy.test.log";
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_open(PATH));
+        sol_log_debug(SOL_PTR_NULL);
+        sol_log_close();
+
+SOL_CATCH:
+                /* nothing to do in case of an exception */
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      debug_test4() - sol_log_debug() unit test #4
+ */
+static sol_erno debug_test4(void)
+{
+        #define DEBUG_TEST4 "sol_log_debug() performs a safe no-op if passed" \
+                            " a null string for @msg"
+        const char *PATH = "bld/dummy.test.log";
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_open(PATH));
+        sol_log_debug("");
+        sol_log_close();
+
+SOL_CATCH:
+                /* nothing to do in case of an exception */
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      warn_test1() - sol_log_warn() unit test #1
+ */
+static sol_erno warn_test1(void)
+{
+        #define WARN_TEST1 "sol_log_warn() writes a time-stamped warning" \
                            " message correctly"
         const char *PATH = "bld/dummy.test.log";
-        const char *msg = sol_erno_str(SOL_ERNO_STR);
+        const char *msg = "This is a sample warning message.";
         const int line = 1;
+        auto time_t since;
 
 SOL_TRY:
                 /* set up test scenario */
+        (void) time(&since);
         sol_try (sol_log_open(PATH));
-        sol_log_erno(SOL_ERNO_STR);
+        sol_log_warn(msg);
         sol_log_close();
 
                 /* check test condition */
-        sol_assert (log_hasctm(PATH, line), SOL_ERNO_TEST);
-        sol_assert (log_hasstr(PATH, "[E]", line), SOL_ERNO_TEST);
+        sol_assert (log_hasctm(PATH, line, since), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[W]", line), SOL_ERNO_TEST);
         sol_assert (log_hasstr(PATH, msg, line), SOL_ERNO_TEST);
 
 SOL_CATCH:
@@ -950,21 +1417,967 @@ SOL_FINALLY:
 
 
 /*
- *      erno_test2() - sol_log_erno() unit test #2
+ *      warn_test2() - sol_log_warn() unit test #2
  */
-static sol_erno erno_test2(void)
+static sol_erno warn_test2(void)
 {
-        #define ERNO_TEST2 "sol_log_erno() performs a safe no-op if called" \
+        #define WARN_TEST2 "sol_log_warn() performs a safe no-op if called" \
                            " when no log file is open"
 
                 /* set up test scenario */
-        sol_log_erno(SOL_ERNO_STR);
+        sol_log_warn("Dummy");
         return SOL_ERNO_NULL;
 }
 
 
 
 
+/*
+ *      warn_test3() - sol_log_warn() unit test #3
+ */
+static sol_erno warn_test3(void)
+{
+        #define WARN_TEST3 "sol_log_warn() performs a safe no-op if passed" \
+                           " a null pointer for @msg"
+        const char *PATH = "bld/dummy.test.log";
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_open(PATH));
+        sol_log_warn(SOL_PTR_NULL);
+        sol_log_close();
+
+SOL_CATCH:
+                /* nothing to do in case of an exception */
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      warn_test3() - sol_log_warn() unit test #3
+ */
+static sol_erno warn_test4(void)
+{
+        #define WARN_TEST4 "sol_log_warn() performs a safe no-op if passed" \
+                           " a null string for @msg"
+        const char *PATH = "bld/dummy.test.log";
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_open(PATH));
+        sol_log_warn("");
+        sol_log_close();
+
+SOL_CATCH:
+                /* nothing to do in case of an exception */
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      error_test1() - sol_log_error() unit test #1
+ */
+static sol_erno error_test1(void)
+{
+        #define ERROR_TEST1 "sol_log_error() writes a time-stamped error" \
+                            " message correctly"
+        const char *PATH = "bld/dummy.test.log";
+        const char *msg = "This is a sample error message.";
+        const int line = 1;
+        auto time_t since;
+
+SOL_TRY:
+                /* set up test scenario */
+        (void) time(&since);
+        sol_try (sol_log_open(PATH));
+        sol_log_error(msg);
+        sol_log_close();
+
+                /* check test condition */
+        sol_assert (log_hasctm(PATH, line, since), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[E]", line), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, msg, line), SOL_ERNO_TEST);
+
+SOL_CATCH:
+                /* nothing to do in case of an exception */
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      error_test2() - sol_log_error() unit test #2
+ */
+static sol_erno error_test2(void)
+{
+        #define ERROR_TEST2 "sol_log_error() performs a safe no-op if called" \
+                            " when no log file is open"
+
+                /* set up test scenario */
+        sol_log_error("Dummy");
+        return SOL_ERNO_NULL;
+}
+
+
+
+
+/*
+ *      error_test3() - sol_log_error() unit test #3
+ */
+static sol_erno error_test3(void)
+{
+        #define ERROR_TEST3 "sol_log_error() performs a safe no-op if passed" \
+                            " a null pointer for @msg"
+        const char *PATH = "bld/dummy.test.log";
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_open(PATH));
+        sol_log_error(SOL_PTR_NULL);
+        sol_log_close();
+
+SOL_CATCH:
+                /* nothing to do in case of an exception */
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      error_test4() - sol_log_error() unit test #4
+ */
+static sol_erno error_test4(void)
+{
+        #define ERROR_TEST4 "sol_log_error() performs a safe no-op if passed" \
+                            " a null string for @msg"
+        const char *PATH = "bld/dummy.test.log";
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_open(PATH));
+        sol_log_error("");
+        sol_log_close();
+
+SOL_CATCH:
+                /* nothing to do in case of an exception */
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      erno_test1() - sol_log_erno() unit test #1
+ */
+static sol_erno erno_test1(void)
+{
+        #define ERNO_TEST1 "sol_log_erno() writes a time-stamped error code" \
+                           " message correctly"
+        const char *PATH = "bld/dummy.test.log";
+        const char *msg = sol_erno_str(SOL_ERNO_STR);
+        const int line = 1;
+        auto time_t since;
+
+SOL_TRY:
+                /* set up test scenario */
+        (void) time(&since);
+        sol_try (sol_log_open(PATH));
+        sol_log_erno(SOL_ERNO_STR);
+        sol_log_close();
+
+                /* check test condition */
+        sol_assert (log_hasctm(PATH, line, since), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[E]", line), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, msg, line), SOL_ERNO_TEST);
+
+SOL_CATCH:
+                /* nothing to do in case of an exception */
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      erno_test2() - sol_log_erno() unit test #2
+ */
+static sol_erno erno_test2(void)
+{
+        #define ERNO_TEST2 "sol_log_erno() performs a safe no-op if called" \
+                           " when no log file is open"
+
+                /* set up test scenario */
+        sol_log_erno(SOL_ERNO_STR);
+        return SOL_ERNO_NULL;
+}
+
+
+
+
+/*
+ *      tracef_test1() - sol_log_tracef() unit test #1
+ */
+static sol_erno tracef_test1(void)
+{
+        #define TRACEF_TEST1 "sol_log_tracef() formats integers, hexadecimals" \
+                             ", pointers and strings as printf() does"
+        const char *PATH = "bld/dummy.test.log";
+        const int line = 1;
+        auto char msg[128];
+
+SOL_TRY:
+                /* set up test scenario */
+        (void) snprintf(msg, sizeof msg, "%d|%5u|%-4ld|%#x|%08X|%p|%s|%.2s|%c",
+                        -42, 7u, 3L, 255u, 0xbeefu, (void*) msg, "sol", "log",
+                        'z');
+        sol_try (sol_log_open(PATH));
+        sol_log_tracef("%d|%5u|%-4ld|%#x|%08X|%p|%s|%.2s|%c", -42, 7u, 3L,
+                       255u, 0xbeefu, (void*) msg, "sol", "log", 'z');
+        sol_log_close();
+
+                /* check test condition */
+        sol_assert (log_hasstr(PATH, "[T]", line), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, msg, line), SOL_ERNO_TEST);
+
+SOL_CATCH:
+                /* nothing to do in case of an exception */
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      tracef_test2() - sol_log_tracef() unit test #2
+ */
+static sol_erno tracef_test2(void)
+{
+        #define TRACEF_TEST2 "sol_log_tracef() formats sol_f64 values as" \
+                             " printf() does"
+        const char *PATH = "bld/dummy.test.log";
+        const int line = 1;
+        auto char msg[128];
+
+SOL_TRY:
+                /* set up test scenario */
+        (void) snprintf(msg, sizeof msg, "%f|%.2f|%8.3f|%e|%g|%g|%f",
+                        3.14159, -0.005, 2.5, 12345.678, 0.0001, 1e20,
+                        1.0 / 0.0);
+        sol_try (sol_log_open(PATH));
+        sol_log_tracef("%f|%.2f|%8.3f|%e|%g|%g|%f", 3.14159, -0.005, 2.5,
+                       12345.678, 0.0001, 1e20, 1.0 / 0.0);
+        sol_log_close();
+
+                /* check test condition */
+        sol_assert (log_hasstr(PATH, msg, line), SOL_ERNO_TEST);
+
+SOL_CATCH:
+                /* nothing to do in case of an exception */
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      tracef_test3() - sol_log_tracef() unit test #3
+ */
+static sol_erno tracef_test3(void)
+{
+        #define TRACEF_TEST3 "sol_log_tracef() performs a safe no-op if" \
+                             " called when no log file is open"
+
+                /* set up test scenario */
+        sol_log_tracef("%s %d", "Dummy", 1);
+        return SOL_ERNO_NULL;
+}
+
+
+
+
+/*
+ *      tracef_test4() - sol_log_debugf(), sol_log_warnf(), sol_log_errorf()
+ *                       unit test #4
+ */
+static sol_erno tracef_test4(void)
+{
+        #define TRACEF_TEST4 "sol_log_debugf(), sol_log_warnf() and" \
+                             " sol_log_errorf() write formatted messages of" \
+                             " their own type"
+        const char *PATH = "bld/dummy.test.log";
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_open(PATH));
+        sol_log_debugf("Debug #%d", 1);
+        sol_log_warnf("Warning #%d", 2);
+        sol_log_errorf("Error #%d", 3);
+        sol_log_close();
+
+                /* check test condition */
+        sol_assert (log_hasstr(PATH, "[D]", 1), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Debug #1", 1), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[W]", 2), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Warning #2", 2), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[E]", 3), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Error #3", 3), SOL_ERNO_TEST);
+
+SOL_CATCH:
+                /* nothing to do in case of an exception */
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      async_test1() - sol_log_async() unit test #1
+ */
+static sol_erno async_test1(void)
+{
+        #define ASYNC_TEST1 "sol_log_async() throws SOL_ERNO_STATE if no log" \
+                            " file is open"
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_async(16, SOL_LOG_POLICY_BLOCK));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_STATE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      async_test2() - sol_log_async() unit test #2
+ */
+static sol_erno async_test2(void)
+{
+        #define ASYNC_TEST2 "sol_log_async() throws SOL_ERNO_RANGE when" \
+                            " passed 0 for @cap or an invalid @policy, and" \
+                            " SOL_ERNO_STATE if it has been compiled out"
+        const char *PATH = "bld/dummy.test.log";
+        auto sol_erno rc1, rc2;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_open(PATH));
+        rc1 = sol_log_async(0, SOL_LOG_POLICY_BLOCK);
+        rc2 = sol_log_async(16, SOL_LOG_POLICY_DROP_OLDEST + 1);
+
+                /* check test condition */
+        sol_assert ((rc1 == SOL_ERNO_RANGE && rc2 == SOL_ERNO_RANGE)
+                    || (rc1 == SOL_ERNO_STATE && rc2 == SOL_ERNO_STATE),
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_log_close();
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      async_test3() - sol_log_async() unit test #3
+ */
+static sol_erno async_test3(void)
+{
+        #define ASYNC_TEST3 "sol_log_async() throws SOL_ERNO_STATE if the log" \
+                            " file is already in asynchronous mode"
+        const char *PATH = "bld/dummy.test.log";
+        auto sol_erno rc;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_open(PATH));
+        rc = sol_log_async(16, SOL_LOG_POLICY_BLOCK);
+        sol_assert (!rc || rc == SOL_ERNO_STATE, SOL_ERNO_TEST);
+
+                /* check test condition */
+        sol_assert (sol_log_async(16, SOL_LOG_POLICY_BLOCK) == SOL_ERNO_STATE,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_log_close();
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      async_test4() - sol_log_async() unit test #4
+ */
+static sol_erno async_test4(void)
+{
+        #define ASYNC_TEST4 "sol_log_async() with SOL_LOG_POLICY_BLOCK writes" \
+                            " every entry in order by the time" \
+                            " sol_log_close() returns"
+        const char *PATH = "bld/dummy.test.log";
+        const int N = 1000;
+        auto sol_size dropped;
+        auto time_t since;
+
+SOL_TRY:
+                /* set up test scenario with a queue much smaller than the
+                 * burst of entries */
+        (void) time(&since);
+        sol_try (log_burst(PATH, SOL_LOG_FORMAT_TEXT, 8,
+                           SOL_LOG_POLICY_BLOCK, N, &dropped));
+
+                /* check test condition */
+        sol_assert (!dropped && log_lines(PATH) == N, SOL_ERNO_TEST);
+        sol_assert (log_hasctm(PATH, 1, since), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[T]", 1), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Burst message #0.", 1), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Burst message #999.", N), SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      async_test5() - sol_log_async() unit test #5
+ */
+static sol_erno async_test5(void)
+{
+        #define ASYNC_TEST5 "sol_log_async() with SOL_LOG_POLICY_DROP_NEWEST" \
+                            " keeps the first entry and counts every entry" \
+                            " it drops"
+        const char *PATH = "bld/dummy.test.log";
+        const int N = 1000;
+        auto sol_size dropped;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (log_burst(PATH, SOL_LOG_FORMAT_TEXT, 8,
+                           SOL_LOG_POLICY_DROP_NEWEST, N, &dropped));
+
+                /* check test condition */
+        sol_assert (log_lines(PATH) + (int) dropped == N, SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Burst message #0.", 1), SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      async_test6() - sol_log_async() unit test #6
+ */
+static sol_erno async_test6(void)
+{
+        #define ASYNC_TEST6 "sol_log_async() with SOL_LOG_POLICY_DROP_OLDEST" \
+                            " keeps the last entry and counts every entry" \
+                            " it drops"
+        const char *PATH = "bld/dummy.test.log";
+        const int N = 1000;
+        auto sol_size dropped;
+        auto int lines;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (log_burst(PATH, SOL_LOG_FORMAT_TEXT, 8,
+                           SOL_LOG_POLICY_DROP_OLDEST, N, &dropped));
+
+                /* check test condition */
+        lines = log_lines(PATH);
+        sol_assert (lines + (int) dropped == N, SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Burst message #999.", lines),
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      dropped_test1() - sol_log_dropped() unit test #1
+ */
+static sol_erno dropped_test1(void)
+{
+        #define DROPPED_TEST1 "sol_log_dropped() throws SOL_ERNO_PTR when" \
+                              " passed a null pointer for @dropped"
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_dropped(SOL_PTR_NULL));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      dropped_test2() - sol_log_dropped() unit test #2
+ */
+static sol_erno dropped_test2(void)
+{
+        #define DROPPED_TEST2 "sol_log_dropped() reports 0 when the log file" \
+                              " is in synchronous mode"
+        const char *PATH = "bld/dummy.test.log";
+        auto sol_size dropped = 1;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_open(PATH));
+        sol_try (sol_log_dropped(&dropped));
+
+                /* check test condition */
+        sol_assert (!dropped, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_log_close();
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      level_test1() - sol_log_level() unit test #1
+ */
+static sol_erno level_test1(void)
+{
+        #define LEVEL_TEST1 "sol_log_level() throws SOL_ERNO_PTR when passed" \
+                            " a null pointer for @level"
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_level(SOL_PTR_NULL));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      level_set_test1() - sol_log_level_set() unit test #1
+ */
+static sol_erno level_set_test1(void)
+{
+        #define LEVEL_SET_TEST1 "sol_log_level_set() throws SOL_ERNO_RANGE" \
+                                " when passed an invalid @level"
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (sol_log_level_set(SOL_LOG_LEVEL_TRACE - 1)
+                    == SOL_ERNO_RANGE, SOL_ERNO_TEST);
+        sol_try (sol_log_level_set(SOL_LOG_LEVEL_NONE + 1));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_RANGE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      level_set_test2() - sol_log_level_set() unit test #2
+ */
+static sol_erno level_set_test2(void)
+{
+        #define LEVEL_SET_TEST2 "sol_log_level() returns SOL_LOG_LEVEL_TRACE" \
+                                " by default, and the level last set by" \
+                                " sol_log_level_set()"
+        auto int lvl1, lvl2;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_level(&lvl1));
+        sol_try (sol_log_level_set(SOL_LOG_LEVEL_WARN));
+        sol_try (sol_log_level(&lvl2));
+
+                /* check test condition */
+        sol_assert (lvl1 == SOL_LOG_LEVEL_TRACE && lvl2 == SOL_LOG_LEVEL_WARN,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        (void) sol_log_level_set(SOL_LOG_LEVEL_TRACE);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      level_set_test3() - sol_log_level_set() unit test #3
+ */
+static sol_erno level_set_test3(void)
+{
+        #define LEVEL_SET_TEST3 "sol_log_level_set() filters out the" \
+                                " messages less severe than @level"
+        const char *PATH = "bld/dummy.test.log";
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_open(PATH));
+        sol_try (sol_log_level_set(SOL_LOG_LEVEL_WARN));
+        sol_log_trace("Filtered trace message.");
+        sol_log_debug("Filtered debug message.");
+        sol_log_warn("Warning message.");
+        sol_log_error("Error message.");
+        sol_log_erno(SOL_ERNO_STR);
+        sol_try (sol_log_level_set(SOL_LOG_LEVEL_NONE));
+        sol_log_error("Filtered error message.");
+        sol_log_close();
+
+                /* check test condition */
+        sol_assert (log_lines(PATH) == 3, SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[W]", 1), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "[E]", 2), SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_log_close();
+        (void) sol_log_level_set(SOL_LOG_LEVEL_TRACE);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      limit_test1() - sol_log_limit() unit test #1
+ */
+static sol_erno limit_test1(void)
+{
+        #define LIMIT_TEST1 "sol_log_limit() throws SOL_ERNO_PTR when passed" \
+                            " a null pointer, and sol_log_limit_set() throws" \
+                            " SOL_ERNO_RANGE when passed 0 for @sample"
+        auto sol_uint rate;
+
+SOL_TRY:
+                /* check test condition */
+        sol_assert (sol_log_limit(&rate, SOL_PTR_NULL) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_assert (sol_log_limit_set(10, 0) == SOL_ERNO_RANGE,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      limit_set_test1() - sol_log_limit_set() unit test #1
+ */
+static sol_erno limit_set_test1(void)
+{
+        #define LIMIT_SET_TEST1 "sol_log_limit_set() writes one in every" \
+                                " @sample calls of each call site, as" \
+                                " reported by sol_log_limit()"
+        const char *PATH = "bld/dummy.test.log";
+        auto sol_uint rate, sample;
+        register int i;
+
+SOL_TRY:
+                /* set up test scenario with two call sites sampled one in
+                 * four calls */
+        sol_try (sol_log_open(PATH));
+        sol_try (sol_log_limit_set(0, 4));
+        sol_try (sol_log_limit(&rate, &sample));
+
+        for (i = 0; i < 10; i++) {
+                sol_log_tracef("Sampled trace #%d.", i);
+                sol_log_erno(SOL_ERNO_FILE);
+        }
+        sol_log_close();
+
+                /* check test condition */
+        sol_assert (rate == 0 && sample == 4, SOL_ERNO_TEST);
+        sol_assert (log_lines(PATH) == 6, SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Sampled trace #0.", 1), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Sampled trace #4.", 3), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Sampled trace #8.", 5), SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_log_close();
+        (void) sol_log_limit_set(0, 1);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      limit_set_test2() - sol_log_limit_set() unit test #2
+ */
+static sol_erno limit_set_test2(void)
+{
+        #define LIMIT_SET_TEST2 "sol_log_limit_set() writes at most @rate" \
+                                " entries per call site per second, and" \
+                                " reports the count of the calls dropped"
+        const char *PATH = "bld/dummy.test.log";
+        register int i;
+
+SOL_TRY:
+                /* set up test scenario with a burst of calls at the same call
+                 * site, followed by more calls after its second is ended by
+                 * shrinking the second instead of waiting for it to pass */
+        sol_try (sol_log_open(PATH));
+        sol_try (sol_log_limit_set(3, 1));
+
+        for (i = 0; i < 102; i++) {
+                if (i == 100) {
+                        __sol_log_limit_win(0);
+                }
+
+                sol_log_errorf("Limited error #%d.", i);
+        }
+        sol_log_close();
+
+                /* check test condition */
+        sol_assert (log_lines(PATH) == 6, SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Limited error #2.", 3), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Dropped 97 entries", 4), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Limited error #100.", 5), SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Limited error #101.", 6), SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_log_close();
+        (void) sol_log_limit_set(0, 1);
+        __sol_log_limit_win(1000000000ULL);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      decode_test1() - sol_log_decode() unit test #1
+ */
+static sol_erno decode_test1(void)
+{
+        #define DECODE_TEST1 "sol_log_decode() throws SOL_ERNO_STR when" \
+                             " passed a null pointer or null string for @src" \
+                             " or @dst"
+        const char *PATH = "bld/dummy.test.log";
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (sol_log_decode(SOL_PTR_NULL, PATH) == SOL_ERNO_STR,
+                    SOL_ERNO_TEST);
+        sol_assert (sol_log_decode(PATH, "") == SOL_ERNO_STR, SOL_ERNO_TEST);
+        sol_try (sol_log_decode("", PATH));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_STR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      decode_test2() - sol_log_decode() unit test #2
+ */
+static sol_erno decode_test2(void)
+{
+        #define DECODE_TEST2 "sol_log_decode() throws SOL_ERNO_FILE when" \
+                             " @src is not a binary log file"
+        const char *PATH = "bld/dummy.test.log";
+        const char *OUT = "bld/dummy.test.out";
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_log_open(PATH));
+        sol_log_trace("This is a text log file.");
+        sol_log_close();
+        sol_try (sol_log_decode(PATH, OUT));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_FILE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      decode_test3() - sol_log_decode() unit test #3
+ */
+static sol_erno decode_test3(void)
+{
+        #define DECODE_TEST3 "sol_log_decode() decodes every entry of a" \
+                             " binary log file written in asynchronous mode" \
+                             " with SOL_LOG_POLICY_DROP_OLDEST"
+        const char *BIN = "bld/dummy.test.blog";
+        const char *PATH = "bld/dummy.test.log";
+        const int N = 1000;
+        auto sol_size dropped;
+        auto int lines;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (log_burst(BIN, SOL_LOG_FORMAT_BINARY, 8,
+                           SOL_LOG_POLICY_DROP_OLDEST, N, &dropped));
+        sol_try (sol_log_decode(BIN, PATH));
+
+                /* check test condition */
+        lines = log_lines(PATH);
+        sol_assert (lines + (int) dropped == N, SOL_ERNO_TEST);
+        sol_assert (log_hasstr(PATH, "Burst message #999.", lines),
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      decode_test4() - sol_log_decode() unit test #4
+ */
+static sol_erno decode_test4(void)
+{
+        #define DECODE_TEST4 "sol_log_decode() throws SOL_ERNO_FILE when" \
+                             " @src holds a call site record with an" \
+                             " implausible identifier"
+        const char *BIN = "bld/dummy.test.blog";
+        const char *OUT = "bld/dummy.test.out";
+        static const sol_w8 REC[30] = {
+                'S', 'O', 'L', 'B', 'L', 'O', 'G', '1',
+                'S', 0xf0, 0xff, 0xff, 0xff, 'T', 1, 0, 0, 0, 1, 0, 1, 0,
+                'f', 'c'
+        };
+        auto FILE *hnd;
+
+SOL_TRY:
+                /* set up test scenario with a 30 byte binary log file whose
+                 * only call site record claims identifier 0xfffffff0 */
+        sol_assert ((hnd = fopen(BIN, "wb")), SOL_ERNO_TEST);
+        sol_assert (fwrite(REC, 1, sizeof REC, hnd) == sizeof REC,
+                    SOL_ERNO_TEST);
+        sol_assert (!fclose(hnd), SOL_ERNO_TEST);
+        sol_try (sol_log_decode(BIN, OUT));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_FILE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
 /*
  *      __sol_tests_log() - declared in sol/test/suite.h
  */
@@ -994,10 +2407,24 @@ SOL_TRY:
         sol_try (sol_tsuite_register(ts, &open2_test5, OPEN2_TEST5));
         sol_try (sol_tsuite_register(ts, &open2_test6, OPEN2_TEST6));
         sol_try (sol_tsuite_register(ts, &open2_test7, OPEN2_TEST7));
+        sol_try (sol_tsuite_register(ts, &open3_test1, OPEN3_TEST1));
+        sol_try (sol_tsuite_register(ts, &open3_test2, OPEN3_TEST2));
+        sol_try (sol_tsuite_register(ts, &open3_test3, OPEN3_TEST3));
+        sol_try (sol_tsuite_register(ts, &open3_test4, OPEN3_TEST4));
+        sol_try (sol_tsuite_register(ts, &open3_test5, OPEN3_TEST5));
+        sol_try (sol_tsuite_register(ts, &open4_test1, OPEN4_TEST1));
+        sol_try (sol_tsuite_register(ts, &open4_test2, OPEN4_TEST2));
+        sol_try (sol_tsuite_register(ts, &open4_test3, OPEN4_TEST3));
+        sol_try (sol_tsuite_register(ts, &open4_test4, OPEN4_TEST4));
+        sol_try (sol_tsuite_register(ts, &open4_test5, OPEN4_TEST5));
+        sol_try (sol_tsuite_register(ts, &open4_test6, OPEN4_TEST6));
+        sol_try (sol_tsuite_register(ts, &open4_test7, OPEN4_TEST7));
+        sol_try (sol_tsuite_register(ts, &open4_test8, OPEN4_TEST8));
         sol_try (sol_tsuite_register(ts, &trace_test1, TRACE_TEST1));
         sol_try (sol_tsuite_register(ts, &trace_test2, TRACE_TEST2));
         sol_try (sol_tsuite_register(ts, &trace_test3, TRACE_TEST3));
         sol_try (sol_tsuite_register(ts, &trace_test4, TRACE_TEST4));
+        sol_try (sol_tsuite_register(ts, &trace_test5, TRACE_TEST5));
         sol_try (sol_tsuite_register(ts, &debug_test1, DEBUG_TEST1));
         sol_try (sol_tsuite_register(ts, &debug_test2, DEBUG_TEST2));
         sol_try (sol_tsuite_register(ts, &debug_test3, DEBUG_TEST3));
@@ -1012,6 +2439,29 @@ SOL_TRY:
         sol_try (sol_tsuite_register(ts, &error_test4, ERROR_TEST4));
         sol_try (sol_tsuite_register(ts, &erno_test1, ERNO_TEST1));
         sol_try (sol_tsuite_register(ts, &erno_test2, ERNO_TEST2));
+        sol_try (sol_tsuite_register(ts, &tracef_test1, TRACEF_TEST1));
+        sol_try (sol_tsuite_register(ts, &tracef_test2, TRACEF_TEST2));
+        sol_try (sol_tsuite_register(ts, &tracef_test3, TRACEF_TEST3));
+        sol_try (sol_tsuite_register(ts, &tracef_test4, TRACEF_TEST4));
+        sol_try (sol_tsuite_register(ts, &async_test1, ASYNC_TEST1));
+        sol_try (sol_tsuite_register(ts, &async_test2, ASYNC_TEST2));
+        sol_try (sol_tsuite_register(ts, &async_test3, ASYNC_TEST3));
+        sol_try (sol_tsuite_register(ts, &async_test4, ASYNC_TEST4));
+        sol_try (sol_tsuite_register(ts, &async_test5, ASYNC_TEST5));
+        sol_try (sol_tsuite_register(ts, &async_test6, ASYNC_TEST6));
+        sol_try (sol_tsuite_register(ts, &dropped_test1, DROPPED_TEST1));
+        sol_try (sol_tsuite_register(ts, &dropped_test2, DROPPED_TEST2));
+        sol_try (sol_tsuite_register(ts, &level_test1, LEVEL_TEST1));
+        sol_try (sol_tsuite_register(ts, &level_set_test1, LEVEL_SET_TEST1));
+        sol_try (sol_tsuite_register(ts, &level_set_test2, LEVEL_SET_TEST2));
+        sol_try (sol_tsuite_register(ts, &level_set_test3, LEVEL_SET_TEST3));
+        sol_try (sol_tsuite_register(ts, &limit_test1, LIMIT_TEST1));
+        sol_try (sol_tsuite_register(ts, &limit_set_test1, LIMIT_SET_TEST1));
+        sol_try (sol_tsuite_register(ts, &limit_set_test2, LIMIT_SET_TEST2));
+        sol_try (sol_tsuite_register(ts, &decode_test1, DECODE_TEST1));
+        sol_try (sol_tsuite_register(ts, &decode_test2, DECODE_TEST2));
+        sol_try (sol_tsuite_register(ts, &decode_test3, DECODE_TEST3));
+        sol_try (sol_tsuite_register(ts, &decode_test4, DECODE_TEST4));
 
                 /* execute test cases */
         sol_try (sol_tsuite_exec(ts));
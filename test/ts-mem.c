@@ -0,0 +1,355 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/test/ts-mem.c
+ *
+ * Description:
+ *      This file is part of the internal quality checking of the Sol Library.
+ *      It implements the test suite for the memory kernels module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "../inc/mem.h"
+#include "./suite.h"
+
+
+
+
+/*
+ *      BFR_LEN - length of test buffers; this is long enough to exercise the
+ *      widest unrolled loop of every kernel set along with its tails
+ */
+#define BFR_LEN 512
+
+
+
+
+/*
+ *      bfr_src - source test buffer
+ *      bfr_dst - destination test buffer
+ */
+static sol_w8 bfr_src[BFR_LEN];
+static sol_w8 bfr_dst[BFR_LEN];
+
+
+
+
+/*
+ *      bfr_fill() - fills test buffer with a known pattern
+ *        - bfr: test buffer
+ *        - seed: pattern seed
+ */
+static void bfr_fill(sol_w8 *bfr, sol_w8 seed)
+{
+        register sol_index i;
+
+        for (i = 0; i < BFR_LEN; i++) {
+                bfr[i] = (sol_w8) (i * 7 + seed);
+        }
+}
+
+
+
+
+/*
+ *      test_copy1() - sol_mem_copy() unit test #1
+ */
+static sol_erno test_copy1(void)
+{
+        #define DESC_COPY1 "sol_mem_copy() correctly copies buffers of every" \
+                           " length and misalignment"
+        register sol_index off, len, i;
+
+SOL_TRY:
+                /* set up test scenario */
+        bfr_fill(bfr_src, 3);
+
+                /* check test condition for each offset and length, ensuring
+                 * that the bytes around the copied range are untouched */
+        for (off = 0; off < 8; off++) {
+                for (len = 1; len + off + 1 < BFR_LEN; len++) {
+                        bfr_fill(bfr_dst, 0);
+                        sol_mem_copy(bfr_dst + off, bfr_src + 1, len);
+
+                        for (i = 0; i < len; i++) {
+                                sol_assert (bfr_dst[off + i] == bfr_src[i + 1],
+                                            SOL_ERNO_TEST);
+                        }
+                        sol_assert (bfr_dst[off + len] == (sol_w8) ((off + len)
+                                    * 7), SOL_ERNO_TEST);
+                }
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_copy2() - sol_mem_copy() unit test #2
+ */
+static sol_erno test_copy2(void)
+{
+        #define DESC_COPY2 "sol_mem_copy() performs a safe no-op if passed a" \
+                           " null pointer"
+
+                /* set up test scenario */
+        sol_mem_copy(SOL_PTR_NULL, bfr_src, BFR_LEN);
+        sol_mem_copy(bfr_dst, SOL_PTR_NULL, BFR_LEN);
+        return SOL_ERNO_NULL;
+}
+
+
+
+
+/*
+ *      test_move1() - sol_mem_move() unit test #1
+ */
+static sol_erno test_move1(void)
+{
+        #define DESC_MOVE1 "sol_mem_move() correctly moves a buffer on to an" \
+                           " overlapping higher address"
+        register sol_index i, shift;
+        const sol_size LEN = BFR_LEN / 2;
+
+SOL_TRY:
+                /* check test condition for small and large shifts */
+        for (shift = 1; shift < 80; shift++) {
+                bfr_fill(bfr_dst, 5);
+                sol_mem_move(bfr_dst + shift, bfr_dst, LEN);
+
+                for (i = 0; i < LEN; i++) {
+                        sol_assert (bfr_dst[i + shift] == (sol_w8) (i * 7 + 5),
+                                    SOL_ERNO_TEST);
+                }
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_move2() - sol_mem_move() unit test #2
+ */
+static sol_erno test_move2(void)
+{
+        #define DESC_MOVE2 "sol_mem_move() correctly moves a buffer on to an" \
+                           " overlapping lower address"
+        register sol_index i, shift;
+        const sol_size LEN = BFR_LEN / 2;
+
+SOL_TRY:
+                /* check test condition for small and large shifts */
+        for (shift = 1; shift < 80; shift++) {
+                bfr_fill(bfr_dst, 9);
+                sol_mem_move(bfr_dst, bfr_dst + shift, LEN);
+
+                for (i = 0; i < LEN; i++) {
+                        sol_assert (bfr_dst[i] == (sol_w8) ((i + shift) * 7
+                                    + 9), SOL_ERNO_TEST);
+                }
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_set1() - sol_mem_set() unit test #1
+ */
+static sol_erno test_set1(void)
+{
+        #define DESC_SET1 "sol_mem_set() correctly fills buffers of every" \
+                          " length and misalignment"
+        register sol_index off, len, i;
+
+SOL_TRY:
+                /* check test condition for each offset and length */
+        for (off = 0; off < 8; off++) {
+                for (len = 1; len + off + 1 < BFR_LEN; len += 3) {
+                        bfr_fill(bfr_dst, 1);
+                        sol_mem_set(bfr_dst + off, 0xA5, len);
+
+                        for (i = 0; i < len; i++) {
+                                sol_assert (bfr_dst[off + i] == 0xA5,
+                                            SOL_ERNO_TEST);
+                        }
+                        sol_assert (bfr_dst[off + len] == (sol_w8) ((off + len)
+                                    * 7 + 1), SOL_ERNO_TEST);
+                }
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_cmp1() - sol_mem_cmp() unit test #1
+ */
+static sol_erno test_cmp1(void)
+{
+        #define DESC_CMP1 "sol_mem_cmp() returns 0 for equal buffers"
+
+SOL_TRY:
+                /* set up test scenario */
+        bfr_fill(bfr_src, 11);
+        bfr_fill(bfr_dst, 11);
+
+                /* check test condition */
+        sol_assert (!sol_mem_cmp(bfr_dst, bfr_src, BFR_LEN), SOL_ERNO_TEST);
+        sol_assert (!sol_mem_cmp(SOL_PTR_NULL, bfr_src, BFR_LEN),
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_cmp2() - sol_mem_cmp() unit test #2
+ */
+static sol_erno test_cmp2(void)
+{
+        #define DESC_CMP2 "sol_mem_cmp() orders buffers by their first unequal" \
+                          " unsigned byte"
+        register sol_index pos;
+
+SOL_TRY:
+                /* check test condition with the difference at every position,
+                 * using a high byte to verify unsigned ordering and ensuring
+                 * that the bytes after the difference are ignored */
+        for (pos = 0; pos < BFR_LEN - 1; pos++) {
+                bfr_fill(bfr_src, 13);
+                bfr_fill(bfr_dst, 13);
+                bfr_src[pos] = 0x01;
+                bfr_dst[pos] = 0x80;
+                bfr_src[BFR_LEN - 1] = 0xFF;
+
+                sol_assert (sol_mem_cmp(bfr_dst, bfr_src, BFR_LEN) > 0,
+                            SOL_ERNO_TEST);
+                sol_assert (sol_mem_cmp(bfr_src, bfr_dst, BFR_LEN) < 0,
+                            SOL_ERNO_TEST);
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_kernel1() - sol_mem_kernel() unit test #1
+ */
+static sol_erno test_kernel1(void)
+{
+        #define DESC_KERNEL1 "sol_mem_kernel() reports a valid kernel set"
+        const SOL_MEM_KERNEL id = sol_mem_kernel();
+
+SOL_TRY:
+                /* check test condition */
+        sol_assert (id >= SOL_MEM_KERNEL_WORD && id <= SOL_MEM_KERNEL_NEON,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      __sol_tests_mem() - declared in sol/test/suite.h
+ */
+extern sol_erno __sol_tests_mem(sol_tlog *log,
+                                sol_uint *pass,
+                                sol_uint *fail,
+                                sol_uint *total)
+{
+        auto sol_tsuite __ts, *ts = &__ts;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (log && pass && fail && total, SOL_ERNO_PTR);
+
+                /* initialise test suite */
+        sol_try (sol_tsuite_init2(ts, log));
+
+                /* register test cases */
+        sol_try (sol_tsuite_register(ts, &test_copy1, DESC_COPY1));
+        sol_try (sol_tsuite_register(ts, &test_copy2, DESC_COPY2));
+        sol_try (sol_tsuite_register(ts, &test_move1, DESC_MOVE1));
+        sol_try (sol_tsuite_register(ts, &test_move2, DESC_MOVE2));
+        sol_try (sol_tsuite_register(ts, &test_set1, DESC_SET1));
+        sol_try (sol_tsuite_register(ts, &test_cmp1, DESC_CMP1));
+        sol_try (sol_tsuite_register(ts, &test_cmp2, DESC_CMP2));
+        sol_try (sol_tsuite_register(ts, &test_kernel1, DESC_KERNEL1));
+
+                /* execute test cases */
+        sol_try (sol_tsuite_exec(ts));
+
+                /* report test counts */
+        sol_try (sol_tsuite_pass(ts, pass));
+        sol_try (sol_tsuite_fail(ts, fail));
+        sol_try (sol_tsuite_total(ts, total));
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_tsuite_term(ts);
+        return sol_erno_get();
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
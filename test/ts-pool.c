@@ -0,0 +1,336 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/test/ts-pool.c
+ *
+ * Description:
+ *      This file is part of the internal quality checking of the Sol Library.
+ *      It implements the test suite for the object pool module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "../inc/pool.h"
+#include "./suite.h"
+
+
+
+
+/*
+ *      test_init1() - sol_pool_init() unit test #1
+ */
+static sol_erno test_init1(void)
+{
+        #define DESC_INIT1 "sol_pool_init() throws SOL_ERNO_PTR when passed a" \
+                           " null pointer for @pool"
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_pool_init(SOL_PTR_NULL, 16, 4));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_init2() - sol_pool_init() unit test #2
+ */
+static sol_erno test_init2(void)
+{
+        #define DESC_INIT2 "sol_pool_init() throws SOL_ERNO_RANGE when passed" \
+                           " 0 for @sz or @nslot"
+        auto sol_pool pool;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (sol_pool_init(&pool, 0, 4) == SOL_ERNO_RANGE,
+                    SOL_ERNO_TEST);
+        sol_try (sol_pool_init(&pool, 16, 0));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_RANGE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_alloc1() - sol_pool_alloc() unit test #1
+ */
+static sol_erno test_alloc1(void)
+{
+        #define DESC_ALLOC1 "sol_pool_alloc() throws SOL_ERNO_PTR when passed" \
+                            " a pointer for @ptr that has already been" \
+                            " allocated"
+        auto sol_pool pool;
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (!sol_pool_init(&pool, 16, 4), SOL_ERNO_TEST);
+        sol_assert (!sol_pool_alloc(&pool, &ptr), SOL_ERNO_TEST);
+        sol_try (sol_pool_alloc(&pool, &ptr));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        sol_pool_term(&pool);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_alloc2() - sol_pool_alloc() unit test #2
+ */
+static sol_erno test_alloc2(void)
+{
+        #define DESC_ALLOC2 "sol_pool_alloc() returns disjoint aligned slots" \
+                            " across several slabs"
+        auto sol_pool pool;
+        auto sol_w8 *obj[40];
+        register sol_index i, j;
+
+SOL_TRY:
+                /* set up test scenario with an odd slot size, filling each
+                 * object with its index */
+        sol_try (sol_pool_init(&pool, 13, 8));
+
+        for (i = 0; i < 40; i++) {
+                obj[i] = SOL_PTR_NULL;
+                sol_try (sol_pool_alloc(&pool, (sol_ptr**) &obj[i]));
+                sol_assert (!((sol_word) obj[i] & (sizeof (sol_ptr*) - 1)),
+                            SOL_ERNO_TEST);
+                for (j = 0; j < 13; j++) {
+                        obj[i][j] = (sol_w8) i;
+                }
+        }
+
+                /* check test condition */
+        for (i = 0; i < 40; i++) {
+                for (j = 0; j < 13; j++) {
+                        sol_assert (obj[i][j] == (sol_w8) i, SOL_ERNO_TEST);
+                }
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_pool_term(&pool);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_free1() - sol_pool_free() unit test #1
+ */
+static sol_erno test_free1(void)
+{
+        #define DESC_FREE1 "sol_pool_free() recycles the freed slot and nulls" \
+                           " @ptr"
+        auto sol_pool pool;
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+        auto sol_ptr *old;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_pool_init(&pool, 32, 4));
+        sol_try (sol_pool_alloc(&pool, &ptr));
+        old = ptr;
+        sol_pool_free(&pool, &ptr);
+
+                /* check test condition */
+        sol_assert (!ptr, SOL_ERNO_TEST);
+        sol_try (sol_pool_alloc(&pool, &ptr));
+        sol_assert (ptr == old, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_pool_term(&pool);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_free2() - sol_pool_free() unit test #2
+ */
+static sol_erno test_free2(void)
+{
+        #define DESC_FREE2 "sol_pool_free() and sol_pool_term() execute even if" \
+                           " passed null pointers"
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+
+                /* set up test scenario */
+        sol_pool_free(SOL_PTR_NULL, &ptr);
+        sol_pool_free(SOL_PTR_NULL, SOL_PTR_NULL);
+        sol_pool_term(SOL_PTR_NULL);
+        return SOL_ERNO_NULL;
+}
+
+
+
+
+/*
+ *      test_stat1() - sol_pool_cap(), sol_pool_used(), sol_pool_peak() test #1
+ */
+static sol_erno test_stat1(void)
+{
+        #define DESC_STAT1 "sol_pool_cap(), sol_pool_used() and sol_pool_peak()" \
+                           " track slab reservations and slot usage"
+        auto sol_pool pool;
+        auto sol_ptr *obj[10];
+        auto sol_size cap, used, peak;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario: allocate ten slots across three slabs
+                 * of four, then free six of them */
+        sol_try (sol_pool_init(&pool, 8, 4));
+
+        for (i = 0; i < 10; i++) {
+                obj[i] = SOL_PTR_NULL;
+                sol_try (sol_pool_alloc(&pool, &obj[i]));
+        }
+
+        for (i = 0; i < 6; i++) {
+                sol_pool_free(&pool, &obj[i]);
+        }
+
+                /* check test condition */
+        sol_try (sol_pool_cap(&pool, &cap));
+        sol_try (sol_pool_used(&pool, &used));
+        sol_try (sol_pool_peak(&pool, &peak));
+        sol_assert (cap == 12 && used == 4 && peak == 10, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_pool_term(&pool);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_stat2() - sol_pool_cap(), sol_pool_used(), sol_pool_peak() test #2
+ */
+static sol_erno test_stat2(void)
+{
+        #define DESC_STAT2 "sol_pool_cap(), sol_pool_used() and sol_pool_peak()" \
+                           " throw SOL_ERNO_PTR when passed null pointers"
+        auto sol_size n;
+
+SOL_TRY:
+                /* check test condition */
+        sol_assert (sol_pool_cap(SOL_PTR_NULL, &n) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_assert (sol_pool_used(SOL_PTR_NULL, &n) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_assert (sol_pool_peak(SOL_PTR_NULL, &n) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      __sol_tests_pool() - declared in sol/test/suite.h
+ */
+extern sol_erno __sol_tests_pool(sol_tlog *log,
+                                 sol_uint *pass,
+                                 sol_uint *fail,
+                                 sol_uint *total)
+{
+        auto sol_tsuite __ts, *ts = &__ts;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (log && pass && fail && total, SOL_ERNO_PTR);
+
+                /* initialise test suite */
+        sol_try (sol_tsuite_init2(ts, log));
+
+                /* register test cases */
+        sol_try (sol_tsuite_register(ts, &test_init1, DESC_INIT1));
+        sol_try (sol_tsuite_register(ts, &test_init2, DESC_INIT2));
+        sol_try (sol_tsuite_register(ts, &test_alloc1, DESC_ALLOC1));
+        sol_try (sol_tsuite_register(ts, &test_alloc2, DESC_ALLOC2));
+        sol_try (sol_tsuite_register(ts, &test_free1, DESC_FREE1));
+        sol_try (sol_tsuite_register(ts, &test_free2, DESC_FREE2));
+        sol_try (sol_tsuite_register(ts, &test_stat1, DESC_STAT1));
+        sol_try (sol_tsuite_register(ts, &test_stat2, DESC_STAT2));
+
+                /* execute test cases */
+        sol_try (sol_tsuite_exec(ts));
+
+                /* report test counts */
+        sol_try (sol_tsuite_pass(ts, pass));
+        sol_try (sol_tsuite_fail(ts, fail));
+        sol_try (sol_tsuite_total(ts, total));
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_tsuite_term(ts);
+        return sol_erno_get();
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
@@ -27,8 +27,43 @@
 
 
         /* include required header files */
+#include "../inc/libc.h"
 #include "../inc/ptr.h"
 #include "./suite.h"
+#include <string.h>
+
+
+
+
+/*
+ *      count_alloc() - counting allocator callback for alloc
+ *      count_realloc() - counting allocator callback for realloc
+ *      count_free() - counting allocator callback for free
+ *
+ *      These callbacks count the calls made to them in the sol_size array
+ *      passed as their context, and forward the calls to the heap.
+ */
+static sol_ptr *count_alloc(sol_ptr *ctx,
+                            sol_size sz)
+{
+        ((sol_size*) ctx)[0]++;
+        return malloc(sz);
+}
+
+static sol_ptr *count_realloc(sol_ptr *ctx,
+                              sol_ptr *ptr,
+                              sol_size sz)
+{
+        ((sol_size*) ctx)[1]++;
+        return realloc(ptr, sz);
+}
+
+static void count_free(sol_ptr *ctx,
+                       sol_ptr *ptr)
+{
+        ((sol_size*) ctx)[2]++;
+        free(ptr);
+}
 
 
 
@@ -142,6 +177,270 @@ SOL_FINALLY:
 
 
 
+/*
+ *      test_aligned1() - sol_ptr_new_aligned() unit test #1
+ */
+static sol_erno test_aligned1(void)
+{
+        #define DESC_ALIGNED1 "sol_ptr_new_aligned() throws SOL_ERNO_RANGE" \
+                              " when passed 0 for @sz, or an @align that is" \
+                              " not a power of two"
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (sol_ptr_new_aligned(&ptr, 0, 64) == SOL_ERNO_RANGE,
+                    SOL_ERNO_TEST);
+        sol_assert (sol_ptr_new_aligned(&ptr, 8, 0) == SOL_ERNO_RANGE,
+                    SOL_ERNO_TEST);
+        sol_try (sol_ptr_new_aligned(&ptr, 8, 48));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_RANGE == sol_erno_get() && !ptr
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_aligned2() - sol_ptr_new_aligned() unit test #2
+ */
+static sol_erno test_aligned2(void)
+{
+        #define DESC_ALIGNED2 "sol_ptr_new_aligned() returns writable buffers" \
+                              " aligned to @align for small and mapped sizes"
+        const sol_size SZ[] = {1, 100, 4096, SOL_PTR_MMAP_MIN + 1};
+        auto sol_w8 *ptr = SOL_PTR_NULL;
+        register sol_size align;
+        register sol_index i;
+
+SOL_TRY:
+                /* check test condition for each size and alignment */
+        for (i = 0; i < sizeof SZ / sizeof *SZ; i++) {
+                for (align = 1; align <= 8192; align <<= 1) {
+                        sol_try (sol_ptr_new_aligned((sol_ptr**) &ptr, SZ[i],
+                                                     align));
+                        sol_assert (!((sol_word) ptr & (align - 1)),
+                                    SOL_ERNO_TEST);
+
+                        ptr[0] = 1;
+                        ptr[SZ[i] - 1] = 2;
+                        sol_assert (ptr[SZ[i] - 1] == 2, SOL_ERNO_TEST);
+
+                        sol_ptr_free((sol_ptr**) &ptr);
+                        sol_assert (!ptr, SOL_ERNO_TEST);
+                }
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ptr_free((sol_ptr**) &ptr);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_huge1() - sol_ptr_new_huge() unit test #1
+ */
+static sol_erno test_huge1(void)
+{
+        #define DESC_HUGE1 "sol_ptr_new_huge() returns a writable buffer" \
+                           " aligned to 2 MiB that is released by" \
+                           " sol_ptr_free()"
+        const sol_size SZ = 3 * 1024 * 1024;
+        auto sol_w8 *ptr = SOL_PTR_NULL;
+        auto sol_ptr *tmp = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* set up test scenario, interleaving a heap allocation */
+        sol_assert (sol_ptr_new_huge(&tmp, 0) == SOL_ERNO_RANGE,
+                    SOL_ERNO_TEST);
+        sol_try (sol_ptr_new_huge((sol_ptr**) &ptr, SZ));
+        sol_try (sol_ptr_new(&tmp, 8));
+
+                /* check test condition */
+        sol_assert (!((sol_word) ptr & (2 * 1024 * 1024 - 1)), SOL_ERNO_TEST);
+        ptr[0] = 1;
+        ptr[SZ - 1] = 2;
+        sol_assert (ptr[0] + ptr[SZ - 1] == 3, SOL_ERNO_TEST);
+
+        sol_ptr_free(&tmp);
+        sol_ptr_free((sol_ptr**) &ptr);
+        sol_assert (!ptr && !tmp, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ptr_free(&tmp);
+        sol_ptr_free((sol_ptr**) &ptr);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_mirror1() - sol_ptr_new_mirror() unit test #1
+ */
+static sol_erno test_mirror1(void)
+{
+        #define DESC_MIRROR1 "sol_ptr_new_mirror() returns a page-rounded" \
+                             " buffer whose bytes alias those one size" \
+                             " above them"
+        auto sol_w8 *ptr = SOL_PTR_NULL;
+        auto sol_size sz = 0;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (sol_ptr_new_mirror((sol_ptr**) &ptr, &sz)
+                    == SOL_ERNO_RANGE, SOL_ERNO_TEST);
+        sz = 100;
+        sol_try (sol_ptr_new_mirror((sol_ptr**) &ptr, &sz));
+
+                /* check test condition */
+        sol_assert (sz >= 4096 && !(sz & 4095), SOL_ERNO_TEST);
+        ptr[sz - 1] = 1;
+        ptr[sz] = 2;
+        sol_assert (ptr[2 * sz - 1] == 1 && ptr[0] == 2, SOL_ERNO_TEST);
+
+        sol_ptr_free((sol_ptr**) &ptr);
+        sol_assert (!ptr, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ptr_free((sol_ptr**) &ptr);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_newn1() - sol_ptr_new_n() unit test #1
+ */
+static sol_erno test_newn1(void)
+{
+        #define DESC_NEWN1 "sol_ptr_new_n() and sol_ptr_new_n2() throw" \
+                           " SOL_ERNO_PTR or SOL_ERNO_RANGE for invalid" \
+                           " batches, leaving @ptr unchanged"
+        auto sol_ptr *ptr[3] = {SOL_PTR_NULL, SOL_PTR_NULL, SOL_PTR_NULL};
+        auto sol_size sz[3] = {8, 0, 8};
+        auto sol_w8 tmp;
+
+SOL_TRY:
+                /* check test condition */
+        sol_assert (sol_ptr_new_n(SOL_PTR_NULL, sz, 3) == SOL_ERNO_PTR
+                    && sol_ptr_new_n(ptr, SOL_PTR_NULL, 3) == SOL_ERNO_PTR
+                    && sol_ptr_new_n(ptr, sz, 0) == SOL_ERNO_RANGE
+                    && sol_ptr_new_n(ptr, sz, 3) == SOL_ERNO_RANGE
+                    && sol_ptr_new_n2(ptr, sz, 3) == SOL_ERNO_RANGE,
+                    SOL_ERNO_TEST);
+        sol_assert (!ptr[0] && !ptr[1] && !ptr[2], SOL_ERNO_TEST);
+
+        sz[1] = 8;
+        ptr[2] = &tmp;
+        sol_assert (sol_ptr_new_n(ptr, sz, 3) == SOL_ERNO_PTR
+                    && sol_ptr_new_n2(ptr, sz, 3) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_assert (!ptr[0] && !ptr[1] && ptr[2] == &tmp, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_newn2() - sol_ptr_new_n() unit test #2
+ */
+static sol_erno test_newn2(void)
+{
+        #define DESC_NEWN2 "sol_ptr_new_n() returns disjoint aligned buffers" \
+                           " that are released together by sol_ptr_free_n()"
+        auto sol_w8 *ptr[5] = {SOL_PTR_NULL};
+        auto const sol_size sz[5] = {1, 24, 7, 100, 16};
+        register sol_index i, j;
+
+SOL_TRY:
+                /* set up test scenario, filling each buffer with its index */
+        sol_try (sol_ptr_new_n((sol_ptr**) ptr, sz, 5));
+
+        for (i = 0; i < 5; i++) {
+                sol_assert (!((sol_word) ptr[i] & (2 * sizeof (sol_ptr*) - 1)),
+                            SOL_ERNO_TEST);
+                memset(ptr[i], (int) i, sz[i]);
+        }
+
+                /* check test condition */
+        for (i = 0; i < 5; i++) {
+                for (j = 0; j < sz[i]; j++) {
+                        sol_assert (ptr[i][j] == i, SOL_ERNO_TEST);
+                }
+        }
+
+        sol_ptr_free_n((sol_ptr**) ptr, 5);
+        for (i = 0; i < 5; i++) {
+                sol_assert (!ptr[i], SOL_ERNO_TEST);
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ptr_free_n((sol_ptr**) ptr, 5);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_newn3() - sol_ptr_new_n2() unit test #1
+ */
+static sol_erno test_newn3(void)
+{
+        #define DESC_NEWN3 "sol_ptr_new_n2() returns independent buffers that" \
+                           " can be resized and freed individually or by" \
+                           " sol_ptr_free_n2()"
+        auto sol_ptr *ptr[4] = {SOL_PTR_NULL};
+        auto sol_size sz[4] = {16, 200, 3000, 40};
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_ptr_new_n2(ptr, sz, 4));
+        sol_ptr_free_sized(&ptr[1], sz[1]);
+        sol_try (sol_ptr_resize(&ptr[2], 20));
+        sz[2] = 20;
+        memset(ptr[2], 0x5A, sz[2]);
+
+                /* check test condition */
+        sol_ptr_free_n2(ptr, sz, 4);
+        sol_assert (!ptr[0] && !ptr[1] && !ptr[2] && !ptr[3], SOL_ERNO_TEST);
+        sol_ptr_free_n2(SOL_PTR_NULL, sz, 4);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ptr_free_n2(ptr, SOL_PTR_NULL, 4);
+        return sol_erno_get();
+}
+
+
+
+
 /*
  *      test_copy1() - sol_ptr_copy() unit test #1
  */
@@ -289,6 +588,187 @@ SOL_FINALLY:
 
 
 
+/*
+ *      test_resize1() - sol_ptr_resize() unit test #1
+ */
+static sol_erno test_resize1(void)
+{
+        #define DESC_RESIZE1 "sol_ptr_resize() throws SOL_ERNO_PTR when passed" \
+                             " a null pointer or a pointer to a null pointer" \
+                             " for @ptr"
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (sol_ptr_resize(SOL_PTR_NULL, 8) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_try (sol_ptr_resize(&ptr, 8));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_resize2() - sol_ptr_resize() unit test #2
+ */
+static sol_erno test_resize2(void)
+{
+        #define DESC_RESIZE2 "sol_ptr_resize() throws SOL_ERNO_RANGE when" \
+                             " passed 0 for @sz, leaving @ptr intact"
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+        auto sol_ptr *old;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (!sol_ptr_new(&ptr, 8), SOL_ERNO_TEST);
+        old = ptr;
+        sol_try (sol_ptr_resize(&ptr, 0));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_RANGE == sol_erno_get() && ptr == old
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        sol_ptr_free(&ptr);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_resize3() - sol_ptr_resize() unit test #3
+ */
+static sol_erno test_resize3(void)
+{
+        #define DESC_RESIZE3 "sol_ptr_resize() preserves the contents of @ptr" \
+                             " when growing and shrinking it"
+        auto sol_w8 *ptr = SOL_PTR_NULL;
+        register sol_size sz;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_ptr_new((sol_ptr**) &ptr, 5));
+        for (i = 0; i < 5; i++) {
+                ptr[i] = (sol_w8) i;
+        }
+
+                /* check test condition while growing and then shrinking */
+        for (sz = 5; sz < 100000; sz = sz * 2 + 3) {
+                sol_try (sol_ptr_resize((sol_ptr**) &ptr, sz * 2 + 3));
+                for (i = 0; i < sz; i++) {
+                        sol_assert (ptr[i] == (sol_w8) i, SOL_ERNO_TEST);
+                }
+                for (; i < sz * 2 + 3; i++) {
+                        ptr[i] = (sol_w8) i;
+                }
+        }
+
+        for (; sz > 5; sz /= 3) {
+                sol_try (sol_ptr_resize((sol_ptr**) &ptr, sz));
+                for (i = 0; i < sz; i++) {
+                        sol_assert (ptr[i] == (sol_w8) i, SOL_ERNO_TEST);
+                }
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ptr_free((sol_ptr**) &ptr);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_reserve1() - sol_ptr_reserve() unit test #1
+ */
+static sol_erno test_reserve1(void)
+{
+        #define DESC_RESERVE1 "sol_ptr_reserve() throws SOL_ERNO_PTR when" \
+                              " passed a null pointer for @ptr or @cap, or a" \
+                              " non-zero @cap with a null @ptr"
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+        auto sol_size cap = 8;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (sol_ptr_reserve(SOL_PTR_NULL, &cap, 8) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_assert (sol_ptr_reserve(&ptr, SOL_PTR_NULL, 8) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_try (sol_ptr_reserve(&ptr, &cap, 16));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get() && !ptr && cap == 8
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_reserve2() - sol_ptr_reserve() unit test #2
+ */
+static sol_erno test_reserve2(void)
+{
+        #define DESC_RESERVE2 "sol_ptr_reserve() grows @ptr geometrically" \
+                              " while appending to it byte by byte"
+        auto sol_w8 *ptr = SOL_PTR_NULL;
+        auto sol_size cap = 0, last = 0, grow = 0;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario, counting the times @ptr grows */
+        for (i = 0; i < 1024 * 1024; i++) {
+                sol_try (sol_ptr_reserve((sol_ptr**) &ptr, &cap, i + 1));
+                sol_assert (cap > i, SOL_ERNO_TEST);
+                ptr[i] = (sol_w8) i;
+
+                if (cap != last) {
+                        last = cap;
+                        grow++;
+                }
+        }
+
+                /* check test condition; growing from 64 bytes to 1 MiB by
+                 * half each time takes 24 steps */
+        sol_assert (grow <= 25, SOL_ERNO_TEST);
+        for (i = 0; i < 1024 * 1024; i++) {
+                sol_assert (ptr[i] == (sol_w8) i, SOL_ERNO_TEST);
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ptr_free_sized((sol_ptr**) &ptr, cap);
+        return sol_erno_get();
+}
+
+
+
+
 /*
  *      test_free1() - sol_ptr_free() unit test #1
  */
@@ -332,6 +812,424 @@ SOL_FINALLY:
 
 
 
+/*
+ *      test_free3() - sol_ptr_free_sized() unit test #1
+ */
+static sol_erno test_free3(void)
+{
+        #define DESC_FREE3 "sol_ptr_free_sized() executes even if passed an" \
+                           " invalid pointer for @ptr"
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+
+                /* set up test scenario */
+        sol_ptr_free_sized(SOL_PTR_NULL, 8);
+        sol_ptr_free_sized(&ptr, 8);
+        return SOL_ERNO_NULL;
+}
+
+
+
+
+/*
+ *      test_free4() - sol_ptr_free_sized() unit test #2
+ */
+static sol_erno test_free4(void)
+{
+        #define DESC_FREE4 "sol_ptr_free_sized() releases the heap memory" \
+                           " allocated to @ptr for small and large sizes"
+        auto sol_w8 *ptr[96];
+        register sol_size sz;
+        register sol_index i, j;
+
+SOL_TRY:
+                /* set up test scenario, repeating enough times to cycle the
+                 * blocks of each size through any caches */
+        for (sz = 1; sz <= 4096; sz = sz * 3 + 1) {
+                for (i = 0; i < 96; i++) {
+                        ptr[i] = SOL_PTR_NULL;
+                        sol_try (sol_ptr_new((sol_ptr**) &ptr[i], sz));
+                        for (j = 0; j < sz; j++) {
+                                ptr[i][j] = (sol_w8) i;
+                        }
+                }
+
+                        /* check test condition */
+                for (i = 0; i < 96; i++) {
+                        sol_assert (ptr[i][0] == (sol_w8) i
+                                    && ptr[i][sz - 1] == (sol_w8) i,
+                                    SOL_ERNO_TEST);
+                        sol_ptr_free_sized((sol_ptr**) &ptr[i], sz);
+                        sol_assert (!ptr[i], SOL_ERNO_TEST);
+                }
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+/*
+ *      test_allocator1() - sol_ptr_allocator_local() unit test #1
+ */
+static sol_erno test_allocator1(void)
+{
+        #define DESC_ALLOCATOR1 "sol_ptr_allocator_local() routes the heap" \
+                                " memory of the calling thread through the" \
+                                " given allocator"
+        auto sol_size count[3] = {0, 0, 0};
+        auto sol_allocator alloc = {count_alloc, count_realloc, count_free,
+                                    SOL_PTR_NULL};
+        auto const sol_allocator *cur = SOL_PTR_NULL;
+        auto sol_ptr *ptr = SOL_PTR_NULL, *cpy = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* set up test scenario */
+        alloc.ctx = count;
+        sol_try (sol_ptr_allocator_local(&alloc));
+        sol_try (sol_ptr_allocator(&cur));
+        sol_try (sol_ptr_new(&ptr, 16));
+        sol_try (sol_ptr_resize(&ptr, 4096));
+        sol_try (sol_ptr_copy(&cpy, ptr, 16));
+        sol_ptr_free(&ptr);
+        sol_ptr_free_sized(&cpy, 16);
+
+                /* check test condition */
+        sol_assert (cur == &alloc, SOL_ERNO_TEST);
+        sol_assert (count[0] == 2 && count[1] == 1 && count[2] == 2,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ptr_free(&ptr);
+        sol_ptr_free(&cpy);
+        (void) sol_ptr_allocator_local(SOL_PTR_NULL);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_allocator2() - sol_ptr_allocator_global() unit test #1
+ */
+static sol_erno test_allocator2(void)
+{
+        #define DESC_ALLOCATOR2 "sol_ptr_allocator_local() takes precedence" \
+                                " over sol_ptr_allocator_global(), and both" \
+                                " restore the default allocator when passed" \
+                                " null"
+        auto sol_size gcount[3] = {0, 0, 0}, lcount[3] = {0, 0, 0};
+        auto sol_allocator galloc = {count_alloc, count_realloc, count_free,
+                                     SOL_PTR_NULL};
+        auto sol_allocator lalloc = {count_alloc, count_realloc, count_free,
+                                     SOL_PTR_NULL};
+        auto const sol_allocator *cur = &galloc;
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* set up test scenario with both allocators in effect */
+        galloc.ctx = gcount;
+        lalloc.ctx = lcount;
+        sol_try (sol_ptr_allocator_global(&galloc));
+        sol_try (sol_ptr_allocator_local(&lalloc));
+        sol_try (sol_ptr_new(&ptr, 8));
+        sol_ptr_free(&ptr);
+
+                /* then with only the global allocator in effect */
+        sol_try (sol_ptr_allocator_local(SOL_PTR_NULL));
+        sol_try (sol_ptr_new(&ptr, 8));
+        sol_ptr_free(&ptr);
+
+                /* and finally with the default allocator in effect */
+        sol_try (sol_ptr_allocator_global(SOL_PTR_NULL));
+        sol_try (sol_ptr_new(&ptr, 8));
+        sol_ptr_free(&ptr);
+        sol_try (sol_ptr_allocator(&cur));
+
+                /* check test condition */
+        sol_assert (lcount[0] == 1 && lcount[2] == 1, SOL_ERNO_TEST);
+        sol_assert (gcount[0] == 1 && gcount[2] == 1, SOL_ERNO_TEST);
+        sol_assert (!cur, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ptr_free(&ptr);
+        (void) sol_ptr_allocator_local(SOL_PTR_NULL);
+        (void) sol_ptr_allocator_global(SOL_PTR_NULL);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_allocator3() - sol_ptr_allocator_global() unit test #2
+ */
+static sol_erno test_allocator3(void)
+{
+        #define DESC_ALLOCATOR3 "sol_ptr_allocator_global() and" \
+                                " sol_ptr_allocator_local() throw SOL_ERNO_PTR" \
+                                " when passed an allocator with a null" \
+                                " callback, and sol_ptr_new_aligned() throws" \
+                                " SOL_ERNO_STATE for alignments the allocator" \
+                                " can't meet"
+        auto sol_size count[3] = {0, 0, 0};
+        auto sol_allocator alloc = {count_alloc, count_realloc, SOL_PTR_NULL,
+                                    SOL_PTR_NULL};
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* check test condition */
+        alloc.ctx = count;
+        sol_assert (sol_ptr_allocator_global(&alloc) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_assert (sol_ptr_allocator_local(&alloc) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+
+        alloc.free = count_free;
+        sol_try (sol_ptr_allocator_local(&alloc));
+        sol_assert (sol_ptr_new_aligned(&ptr, 8, 64) == SOL_ERNO_STATE,
+                    SOL_ERNO_TEST);
+        sol_try (sol_ptr_new_aligned(&ptr, 8, 8));
+        sol_ptr_free(&ptr);
+        sol_assert (count[0] == 1 && count[2] == 1, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ptr_free(&ptr);
+        (void) sol_ptr_allocator_local(SOL_PTR_NULL);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_prof1() - sol_ptr_prof_live(), sol_ptr_prof_peak() unit test #1
+ */
+static sol_erno test_prof1(void)
+{
+#if (defined SOL_PTR_PROFILE)
+        #define DESC_PROF1 "sol_ptr_prof_live() and sol_ptr_prof_peak() track" \
+                           " the bytes allocated by sol_ptr_new()"
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+        auto sol_size live0, live1, live2, peak;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_ptr_prof_live(&live0));
+        sol_try (sol_ptr_new(&ptr, 1000));
+        sol_try (sol_ptr_prof_live(&live1));
+        sol_try (sol_ptr_prof_peak(&peak));
+        sol_ptr_free(&ptr);
+        sol_try (sol_ptr_prof_live(&live2));
+
+                /* check test condition */
+        sol_assert (live1 == live0 + 1000 && live2 == live0 && peak >= live1,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ptr_free(&ptr);
+        return sol_erno_get();
+#else
+        #define DESC_PROF1 "sol_ptr_prof_live() and sol_ptr_prof_peak() throw" \
+                           " SOL_ERNO_STATE when the profiler is compiled out"
+        auto sol_size n;
+
+        return sol_ptr_prof_live(&n) == SOL_ERNO_STATE
+               && sol_ptr_prof_peak(&n) == SOL_ERNO_STATE
+               ? SOL_ERNO_NULL
+               : SOL_ERNO_TEST;
+#endif
+}
+
+
+
+
+/*
+ *      test_prof2() - sol_ptr_prof_report() unit test #1
+ */
+static sol_erno test_prof2(void)
+{
+#if (defined SOL_PTR_PROFILE)
+        #define DESC_PROF2 "sol_ptr_prof_report() writes a report that lists" \
+                           " the call sites of allocations"
+        const char *PATH = "bld/dummy.prof.log";
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+        auto FILE *hnd = SOL_PTR_NULL;
+        auto char line[256];
+        auto int found = 0;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (sol_ptr_prof_report(SOL_PTR_NULL) == SOL_ERNO_STR,
+                    SOL_ERNO_TEST);
+        sol_try (sol_ptr_new(&ptr, 100));
+        sol_try (sol_ptr_prof_report(PATH));
+
+                /* check test condition */
+        sol_assert ((hnd = fopen(PATH, "r")), SOL_ERNO_TEST);
+        while (fgets(line, sizeof line, hnd)) {
+                found |= !!strstr(line, "test_prof2():");
+        }
+        sol_assert (found, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        if (hnd) {
+                (void) fclose(hnd);
+        }
+
+        sol_ptr_free(&ptr);
+        return sol_erno_get();
+#else
+        #define DESC_PROF2 "sol_ptr_prof_report() throws SOL_ERNO_STATE when" \
+                           " the profiler is compiled out"
+
+        return sol_ptr_prof_report("bld/dummy.prof.log") == SOL_ERNO_STATE
+               ? SOL_ERNO_NULL
+               : SOL_ERNO_TEST;
+#endif
+}
+
+
+
+
+/*
+ *      test_prof3() - sol_ptr_prof_report() unit test #2
+ */
+static sol_erno test_prof3(void)
+{
+#if (defined SOL_PTR_PROFILE)
+        #define DESC_PROF3 "sol_ptr_prof_report() lists call sites that are" \
+                           " two lines apart separately"
+        const char *PATH = "bld/dummy.prof.log";
+        auto sol_ptr *ptr[3] = {SOL_PTR_NULL, SOL_PTR_NULL, SOL_PTR_NULL};
+        auto FILE *hnd = SOL_PTR_NULL;
+        auto char line[256], site[3][128];
+        auto int found[3] = {0, 0, 0}, ln;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario with three call sites, each two lines
+                 * apart, so that any hash that ignores one of the low bits of
+                 * the line number merges at least two of them */
+        ln = __LINE__ + 1;
+        sol_try (sol_ptr_new(&ptr[0], 24));
+
+        sol_try (sol_ptr_new(&ptr[1], 24));
+
+        sol_try (sol_ptr_new(&ptr[2], 24));
+        sol_try (sol_ptr_prof_report(PATH));
+
+                /* check test condition */
+        for (i = 0; i < 3; i++) {
+                (void) sprintf(site[i], "test_prof3():%s:%d\n", __FILE__,
+                               ln + 2 * (int) i);
+        }
+
+        sol_assert ((hnd = fopen(PATH, "r")), SOL_ERNO_TEST);
+        while (fgets(line, sizeof line, hnd)) {
+                for (i = 0; i < 3; i++) {
+                        found[i] |= !!strstr(line, site[i]);
+                }
+        }
+        sol_assert (found[0] && found[1] && found[2], SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        if (hnd) {
+                (void) fclose(hnd);
+        }
+
+        for (i = 0; i < 3; i++) {
+                sol_ptr_free(&ptr[i]);
+        }
+
+        return sol_erno_get();
+#else
+        #define DESC_PROF3 "sol_ptr_prof_report() throws SOL_ERNO_STATE when" \
+                           " the profiler is compiled out, whatever the path"
+
+        return sol_ptr_prof_report("bld/dummy2.prof.log") == SOL_ERNO_STATE
+               ? SOL_ERNO_NULL
+               : SOL_ERNO_TEST;
+#endif
+}
+
+
+
+
+/*
+ *      test_prof4() - sol_ptr_prof_report() unit test #3
+ */
+static sol_erno test_prof4(void)
+{
+#if (defined SOL_PTR_PROFILE)
+        #define DESC_PROF4 "sol_ptr_prof_report() doesn't charge a failed" \
+                           " call with the next allocation of the thread"
+        const char *PATH = "bld/dummy.prof.log";
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+        auto FILE *hnd = SOL_PTR_NULL;
+        auto char line[256], site[128];
+        auto int found = 0, ln;
+
+SOL_TRY:
+                /* set up test scenario with a call that fails its precondition
+                 * checks, followed by an allocation without a call site; the
+                 * parentheses around the function name keep the call site
+                 * macro from expanding */
+        ln = __LINE__ + 1;
+        sol_assert (sol_ptr_new(SOL_PTR_NULL, 24) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_try ((sol_ptr_new)(&ptr, 24));
+        sol_try (sol_ptr_prof_report(PATH));
+
+                /* check test condition */
+        (void) sprintf(site, "test_prof4():%s:%d\n", __FILE__, ln);
+
+        sol_assert ((hnd = fopen(PATH, "r")), SOL_ERNO_TEST);
+        while (fgets(line, sizeof line, hnd)) {
+                found |= !!strstr(line, site);
+        }
+        sol_assert (!found, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        if (hnd) {
+                (void) fclose(hnd);
+        }
+
+        sol_ptr_free(&ptr);
+        return sol_erno_get();
+#else
+        #define DESC_PROF4 "sol_ptr_prof_report() throws SOL_ERNO_STATE when" \
+                           " the profiler is compiled out, even after a" \
+                           " failed allocation"
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+
+        return sol_ptr_new(SOL_PTR_NULL, 24) == SOL_ERNO_PTR
+               && sol_ptr_new(&ptr, 0) == SOL_ERNO_RANGE
+               && sol_ptr_prof_report("bld/dummy.prof.log") == SOL_ERNO_STATE
+               ? SOL_ERNO_NULL
+               : SOL_ERNO_TEST;
+#endif
+}
+
+
+
+
 /*
  *      __sol_tests_ptr() - declared in sol/test/suite.h
  */
@@ -354,13 +1252,34 @@ SOL_TRY:
         sol_try (sol_tsuite_register(ts, &test_new2, DESC_NEW2));
         sol_try (sol_tsuite_register(ts, &test_new3, DESC_NEW3));
         sol_try (sol_tsuite_register(ts, &test_new4, DESC_NEW4));
+        sol_try (sol_tsuite_register(ts, &test_aligned1, DESC_ALIGNED1));
+        sol_try (sol_tsuite_register(ts, &test_aligned2, DESC_ALIGNED2));
+        sol_try (sol_tsuite_register(ts, &test_huge1, DESC_HUGE1));
+        sol_try (sol_tsuite_register(ts, &test_mirror1, DESC_MIRROR1));
+        sol_try (sol_tsuite_register(ts, &test_newn1, DESC_NEWN1));
+        sol_try (sol_tsuite_register(ts, &test_newn2, DESC_NEWN2));
+        sol_try (sol_tsuite_register(ts, &test_newn3, DESC_NEWN3));
         sol_try (sol_tsuite_register(ts, &test_copy1, DESC_COPY1));
         sol_try (sol_tsuite_register(ts, &test_copy2, DESC_COPY2));
         sol_try (sol_tsuite_register(ts, &test_copy3, DESC_COPY3));
         sol_try (sol_tsuite_register(ts, &test_copy4, DESC_COPY4));
         sol_try (sol_tsuite_register(ts, &test_copy5, DESC_COPY5));
+        sol_try (sol_tsuite_register(ts, &test_resize1, DESC_RESIZE1));
+        sol_try (sol_tsuite_register(ts, &test_resize2, DESC_RESIZE2));
+        sol_try (sol_tsuite_register(ts, &test_resize3, DESC_RESIZE3));
+        sol_try (sol_tsuite_register(ts, &test_reserve1, DESC_RESERVE1));
+        sol_try (sol_tsuite_register(ts, &test_reserve2, DESC_RESERVE2));
         sol_try (sol_tsuite_register(ts, &test_free1, DESC_FREE1));
         sol_try (sol_tsuite_register(ts, &test_free2, DESC_FREE2));
+        sol_try (sol_tsuite_register(ts, &test_free3, DESC_FREE3));
+        sol_try (sol_tsuite_register(ts, &test_free4, DESC_FREE4));
+        sol_try (sol_tsuite_register(ts, &test_allocator1, DESC_ALLOCATOR1));
+        sol_try (sol_tsuite_register(ts, &test_allocator2, DESC_ALLOCATOR2));
+        sol_try (sol_tsuite_register(ts, &test_allocator3, DESC_ALLOCATOR3));
+        sol_try (sol_tsuite_register(ts, &test_prof1, DESC_PROF1));
+        sol_try (sol_tsuite_register(ts, &test_prof2, DESC_PROF2));
+        sol_try (sol_tsuite_register(ts, &test_prof3, DESC_PROF3));
+        sol_try (sol_tsuite_register(ts, &test_prof4, DESC_PROF4));
 
                 /* execute test cases */
         sol_try (sol_tsuite_exec(ts));
@@ -0,0 +1,629 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/test/ts-rc.c
+ *
+ * Description:
+ *      This file is part of the internal quality checking of the Sol Library.
+ *      It implements the test suite for the reference counted buffer module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* enable mmap() in strict C99 mode, along with its flags beyond
+         * POSIX */
+#if (!defined _POSIX_C_SOURCE)
+#       define _POSIX_C_SOURCE 200809L
+#endif
+
+#if (!defined _DEFAULT_SOURCE)
+#       define _DEFAULT_SOURCE
+#endif
+
+
+
+
+        /* include required header files */
+#include <sys/mman.h>
+#include <unistd.h>
+#include "../inc/rc.h"
+#include "./suite.h"
+
+
+
+
+/*
+ *      test_new1() - sol_rc_new() unit test #1
+ */
+static sol_erno test_new1(void)
+{
+        #define DESC_NEW1 "sol_rc_new() throws SOL_ERNO_PTR when passed a" \
+                          " null pointer or a pointer that has already been" \
+                          " allocated"
+        auto sol_rc *rc = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (sol_rc_new(SOL_PTR_NULL, 16) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_assert (!sol_rc_new(&rc, 16), SOL_ERNO_TEST);
+        sol_try (sol_rc_new(&rc, 16));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        sol_rc_release(&rc);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_new2() - sol_rc_new() unit test #2
+ */
+static sol_erno test_new2(void)
+{
+        #define DESC_NEW2 "sol_rc_new() throws SOL_ERNO_RANGE when passed 0" \
+                          " for @sz"
+        auto sol_rc *rc = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_rc_new(&rc, 0));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_RANGE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        sol_rc_release(&rc);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_new3() - sol_rc_new2() unit test #1
+ */
+static sol_erno test_new3(void)
+{
+        #define DESC_NEW3 "sol_rc_new2() creates an aligned buffer of the" \
+                          " requested size with a reference count of one"
+        auto sol_rc *rc = SOL_PTR_NULL, *arc = SOL_PTR_NULL;
+        auto sol_size sz, count;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_rc_new2(&rc, 100, SOL_BOOL_FALSE));
+        sol_try (sol_rc_new2(&arc, 100, SOL_BOOL_TRUE));
+
+                /* check test condition */
+        sol_assert (!((sol_word) rc & (2 * sizeof (sol_ptr*) - 1))
+                    && !((sol_word) arc & (2 * sizeof (sol_ptr*) - 1)),
+                    SOL_ERNO_TEST);
+        sol_try (sol_rc_size(arc, &sz));
+        sol_try (sol_rc_count(arc, &count));
+        sol_assert (sz == 100 && count == 1, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_rc_release(&rc);
+        sol_rc_release(&arc);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_retain1() - sol_rc_retain() unit test #1
+ */
+static sol_erno test_retain1(void)
+{
+        #define DESC_RETAIN1 "sol_rc_retain() throws SOL_ERNO_PTR when passed" \
+                             " a null pointer for @src or an allocated" \
+                             " pointer for @rc"
+        auto sol_rc *rc = SOL_PTR_NULL, *cp = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_rc_new(&rc, 8));
+        sol_assert (sol_rc_retain(&cp, SOL_PTR_NULL) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_try (sol_rc_retain(&rc, rc));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        sol_rc_release(&rc);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_retain2() - sol_rc_retain() unit test #2
+ */
+static sol_erno test_retain2(void)
+{
+        #define DESC_RETAIN2 "sol_rc_retain() shares the payload without" \
+                             " copying it and increments the reference count"
+        auto sol_rc *rc = SOL_PTR_NULL, *cp1 = SOL_PTR_NULL;
+        auto sol_rc *cp2 = SOL_PTR_NULL;
+        auto sol_size count;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_rc_new(&rc, 4));
+        ((sol_w8*) rc)[0] = 42;
+        sol_try (sol_rc_retain(&cp1, rc));
+        sol_try (sol_rc_retain(&cp2, cp1));
+
+                /* check test condition */
+        sol_try (sol_rc_count(rc, &count));
+        sol_assert (cp1 == rc && cp2 == rc && count == 3, SOL_ERNO_TEST);
+        sol_assert (((sol_w8*) cp2)[0] == 42, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_rc_release(&cp2);
+        sol_rc_release(&cp1);
+        sol_rc_release(&rc);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_release1() - sol_rc_release() unit test #1
+ */
+static sol_erno test_release1(void)
+{
+        #define DESC_RELEASE1 "sol_rc_release() nulls each owner and keeps" \
+                              " the buffer alive until the last owner" \
+                              " releases it"
+        auto sol_rc *rc = SOL_PTR_NULL, *cp = SOL_PTR_NULL;
+        auto sol_size count;
+
+SOL_TRY:
+                /* set up test scenario with an atomic buffer */
+        sol_try (sol_rc_new2(&rc, 32, SOL_BOOL_TRUE));
+        sol_try (sol_rc_retain(&cp, rc));
+        sol_rc_release(&rc);
+
+                /* check test condition */
+        sol_assert (!rc, SOL_ERNO_TEST);
+        sol_try (sol_rc_count(cp, &count));
+        sol_assert (count == 1, SOL_ERNO_TEST);
+        ((sol_w8*) cp)[31] = 1;
+        sol_rc_release(&cp);
+        sol_assert (!cp, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_rc_release(&cp);
+        sol_rc_release(&rc);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_release2() - sol_rc_release() unit test #2
+ */
+static sol_erno test_release2(void)
+{
+        #define DESC_RELEASE2 "sol_rc_release() executes even if passed null" \
+                              " pointers"
+        auto sol_rc *rc = SOL_PTR_NULL;
+
+                /* set up test scenario */
+        sol_rc_release(&rc);
+        sol_rc_release(SOL_PTR_NULL);
+        return SOL_ERNO_NULL;
+}
+
+
+
+
+/*
+ *      test_copy1() - sol_rc_copy() unit test #1
+ */
+static sol_erno test_copy1(void)
+{
+        #define DESC_COPY1 "sol_rc_copy() throws SOL_ERNO_PTR for a null @src" \
+                           " and SOL_ERNO_RANGE for a zero @len"
+        auto sol_rc *rc = SOL_PTR_NULL;
+        auto sol_w8 bfr[4] = {0};
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (sol_rc_copy(&rc, SOL_PTR_NULL, 4) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_try (sol_rc_copy(&rc, bfr, 0));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_RANGE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        sol_rc_release(&rc);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_copy2() - sol_rc_copy() unit test #2
+ */
+static sol_erno test_copy2(void)
+{
+        #define DESC_COPY2 "sol_rc_copy() copies a reference counted source" \
+                           " instead of sharing it"
+        auto sol_rc *src = SOL_PTR_NULL, *rc = SOL_PTR_NULL;
+        auto sol_size count;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_rc_new(&src, 64));
+        sol_try (sol_rc_copy(&rc, src, 64));
+
+                /* check test condition */
+        sol_try (sol_rc_count(src, &count));
+        sol_assert (rc != src && count == 1, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_rc_release(&rc);
+        sol_rc_release(&src);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_copy3() - sol_rc_copy() unit test #3
+ */
+static sol_erno test_copy3(void)
+{
+        #define DESC_COPY3 "sol_rc_copy() copies a source that is not" \
+                           " reference counted eagerly"
+        auto sol_ptr *src = SOL_PTR_NULL;
+        auto sol_rc *rc = SOL_PTR_NULL;
+        auto sol_size count;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_ptr_new(&src, 64));
+        for (i = 0; i < 64; i++) {
+                ((sol_w8*) src)[i] = (sol_w8) i;
+        }
+
+        sol_try (sol_rc_copy(&rc, src, 64));
+
+                /* check test condition */
+        sol_try (sol_rc_count(rc, &count));
+        sol_assert (rc != src && count == 1, SOL_ERNO_TEST);
+        for (i = 0; i < 64; i++) {
+                sol_assert (((sol_w8*) rc)[i] == (sol_w8) i, SOL_ERNO_TEST);
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_rc_release(&rc);
+        sol_ptr_free(&src);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_copy4() - sol_rc_copy() unit test #4
+ */
+static sol_erno test_copy4(void)
+{
+        #define DESC_COPY4 "sol_rc_copy() copies a source near the start of a" \
+                           " page whose lower page is unmapped"
+        auto sol_w8 *map = MAP_FAILED, *src;
+        auto sol_rc *rc = SOL_PTR_NULL;
+        auto long pg = sysconf(_SC_PAGESIZE);
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario with a source 8 bytes into the second
+                 * of two pages, the first of which is then unmapped */
+        map = mmap(SOL_PTR_NULL, (size_t) (2 * pg), PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        sol_assert (map != MAP_FAILED, SOL_ERNO_TEST);
+        sol_assert (!munmap(map, (size_t) pg), SOL_ERNO_TEST);
+        src = map + pg + 8;
+        for (i = 0; i < 32; i++) {
+                src[i] = (sol_w8) i;
+        }
+
+        sol_try (sol_rc_copy(&rc, src, 32));
+
+                /* check test condition */
+        sol_assert ((sol_w8*) rc != src, SOL_ERNO_TEST);
+        for (i = 0; i < 32; i++) {
+                sol_assert (((sol_w8*) rc)[i] == (sol_w8) i, SOL_ERNO_TEST);
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_rc_release(&rc);
+        if (map != MAP_FAILED) {
+                (void) munmap(map + pg, (size_t) pg);
+        }
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_copy5() - sol_rc_copy() unit test #5
+ */
+static sol_erno test_copy5(void)
+{
+        #define DESC_COPY5 "sol_rc_copy() copies a source that is not on the" \
+                           " heap"
+        static const sol_w8 src[24] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+        auto sol_rc *rc = SOL_PTR_NULL;
+        auto sol_size count;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_rc_copy(&rc, src, sizeof src));
+
+                /* check test condition */
+        sol_try (sol_rc_count(rc, &count));
+        sol_assert ((const sol_w8*) rc != src && count == 1, SOL_ERNO_TEST);
+        for (i = 0; i < sizeof src; i++) {
+                sol_assert (((sol_w8*) rc)[i] == src[i], SOL_ERNO_TEST);
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_rc_release(&rc);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_copy6() - sol_rc_copy2() unit test #1
+ */
+static sol_erno test_copy6(void)
+{
+        #define DESC_COPY6 "sol_rc_copy2() shares a reference counted source" \
+                           " instead of copying it, and throws SOL_ERNO_PTR" \
+                           " for a null @src"
+        auto sol_rc *src = SOL_PTR_NULL, *rc = SOL_PTR_NULL;
+        auto sol_rc *nul = SOL_PTR_NULL;
+        auto sol_size count;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_rc_new(&src, 64));
+        sol_try (sol_rc_copy2(&rc, src));
+
+                /* check test condition */
+        sol_try (sol_rc_count(src, &count));
+        sol_assert (rc == src && count == 2, SOL_ERNO_TEST);
+        sol_assert (sol_rc_copy2(&nul, SOL_PTR_NULL) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_rc_release(&rc);
+        sol_rc_release(&src);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_write1() - sol_rc_write() unit test #1
+ */
+static sol_erno test_write1(void)
+{
+        #define DESC_WRITE1 "sol_rc_write() gives a shared buffer a private" \
+                            " copy, leaving the other owners untouched"
+        auto sol_rc *src = SOL_PTR_NULL, *rc = SOL_PTR_NULL;
+        auto sol_size count;
+
+SOL_TRY:
+                /* set up test scenario with an atomic source */
+        sol_try (sol_rc_new2(&src, 16, SOL_BOOL_TRUE));
+        ((sol_w8*) src)[0] = 1;
+        ((sol_w8*) src)[15] = 2;
+        sol_try (sol_rc_copy2(&rc, src));
+        sol_try (sol_rc_write(&rc));
+        ((sol_w8*) rc)[0] = 3;
+
+                /* check test condition */
+        sol_assert (rc != src && ((sol_w8*) src)[0] == 1
+                    && ((sol_w8*) rc)[15] == 2, SOL_ERNO_TEST);
+        sol_try (sol_rc_count(src, &count));
+        sol_assert (count == 1, SOL_ERNO_TEST);
+        sol_try (sol_rc_count(rc, &count));
+        sol_assert (count == 1, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_rc_release(&rc);
+        sol_rc_release(&src);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_write2() - sol_rc_write() unit test #2
+ */
+static sol_erno test_write2(void)
+{
+        #define DESC_WRITE2 "sol_rc_write() leaves a buffer with a sole owner" \
+                            " in place, and throws SOL_ERNO_PTR for a null" \
+                            " pointer"
+        auto sol_rc *rc = SOL_PTR_NULL, *old;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_rc_new(&rc, 16));
+        old = rc;
+        sol_try (sol_rc_write(&rc));
+
+                /* check test condition */
+        sol_assert (rc == old, SOL_ERNO_TEST);
+        sol_assert (sol_rc_write(SOL_PTR_NULL) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_rc_release(&rc);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_stat1() - sol_rc_count() and sol_rc_size() unit test #1
+ */
+static sol_erno test_stat1(void)
+{
+        #define DESC_STAT1 "sol_rc_count() and sol_rc_size() throw" \
+                           " SOL_ERNO_PTR when passed null pointers"
+        auto sol_size n;
+
+SOL_TRY:
+                /* check test condition */
+        sol_assert (sol_rc_count(SOL_PTR_NULL, &n) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_assert (sol_rc_size(SOL_PTR_NULL, &n) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      __sol_tests_rc() - declared in sol/test/suite.h
+ */
+extern sol_erno __sol_tests_rc(sol_tlog *log,
+                               sol_uint *pass,
+                               sol_uint *fail,
+                               sol_uint *total)
+{
+        auto sol_tsuite __ts, *ts = &__ts;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (log && pass && fail && total, SOL_ERNO_PTR);
+
+                /* initialise test suite */
+        sol_try (sol_tsuite_init2(ts, log));
+
+                /* register test cases */
+        sol_try (sol_tsuite_register(ts, &test_new1, DESC_NEW1));
+        sol_try (sol_tsuite_register(ts, &test_new2, DESC_NEW2));
+        sol_try (sol_tsuite_register(ts, &test_new3, DESC_NEW3));
+        sol_try (sol_tsuite_register(ts, &test_retain1, DESC_RETAIN1));
+        sol_try (sol_tsuite_register(ts, &test_retain2, DESC_RETAIN2));
+        sol_try (sol_tsuite_register(ts, &test_release1, DESC_RELEASE1));
+        sol_try (sol_tsuite_register(ts, &test_release2, DESC_RELEASE2));
+        sol_try (sol_tsuite_register(ts, &test_copy1, DESC_COPY1));
+        sol_try (sol_tsuite_register(ts, &test_copy2, DESC_COPY2));
+        sol_try (sol_tsuite_register(ts, &test_copy3, DESC_COPY3));
+        sol_try (sol_tsuite_register(ts, &test_copy4, DESC_COPY4));
+        sol_try (sol_tsuite_register(ts, &test_copy5, DESC_COPY5));
+        sol_try (sol_tsuite_register(ts, &test_copy6, DESC_COPY6));
+        sol_try (sol_tsuite_register(ts, &test_write1, DESC_WRITE1));
+        sol_try (sol_tsuite_register(ts, &test_write2, DESC_WRITE2));
+        sol_try (sol_tsuite_register(ts, &test_stat1, DESC_STAT1));
+
+                /* execute test cases */
+        sol_try (sol_tsuite_exec(ts));
+
+                /* report test counts */
+        sol_try (sol_tsuite_pass(ts, pass));
+        sol_try (sol_tsuite_fail(ts, fail));
+        sol_try (sol_tsuite_total(ts, total));
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_tsuite_term(ts);
+        return sol_erno_get();
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
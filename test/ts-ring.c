@@ -0,0 +1,520 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/test/ts-ring.c
+ *
+ * Description:
+ *      This file is part of the internal quality checking of the Sol Library.
+ *      It implements the test suite for the ring buffer module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "../inc/ring.h"
+#include "./suite.h"
+
+
+
+
+/*
+ *      round_trip() - checks that wrapped data survives a ring buffer
+ *        - ring: contextual ring buffer
+ *
+ *      Writes and reads records of a size co-prime with the capacity of @ring,
+ *      so that every offset is eventually wrapped around, and checks that each
+ *      record is read back intact.
+ */
+static sol_erno round_trip(sol_ring *ring)
+{
+        auto sol_w8 src[97], dst[97];
+        auto sol_size cap;
+        register sol_index i, j;
+
+SOL_TRY:
+                /* set up test scenario, leaving one record unread */
+        sol_try (sol_ring_cap(ring, &cap));
+        for (j = 0; j < sizeof src; j++) {
+                src[j] = (sol_w8) j;
+        }
+        sol_try (sol_ring_write(ring, src, sizeof src));
+
+                /* check test condition */
+        for (i = 0; i < 2 * cap / sizeof src + 1; i++) {
+                src[0] = (sol_w8) i;
+                sol_try (sol_ring_write(ring, src, sizeof src));
+                sol_try (sol_ring_read(ring, dst, sizeof dst));
+                for (j = 1; j < sizeof dst; j++) {
+                        sol_assert (dst[j] == (sol_w8) j, SOL_ERNO_TEST);
+                }
+                sol_assert (!i || dst[0] == (sol_w8) (i - 1), SOL_ERNO_TEST);
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_init1() - sol_ring_init() unit test #1
+ */
+static sol_erno test_init1(void)
+{
+        #define DESC_INIT1 "sol_ring_init() and sol_ring_init2() throw" \
+                           " SOL_ERNO_PTR when passed a null pointer for @ring"
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (sol_ring_init2(SOL_PTR_NULL, 16, SOL_BOOL_FALSE)
+                    == SOL_ERNO_PTR, SOL_ERNO_TEST);
+        sol_try (sol_ring_init(SOL_PTR_NULL, 16));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_init2() - sol_ring_init() unit test #2
+ */
+static sol_erno test_init2(void)
+{
+        #define DESC_INIT2 "sol_ring_init() and sol_ring_init2() throw" \
+                           " SOL_ERNO_RANGE when passed 0 for @sz"
+        auto sol_ring ring;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (sol_ring_init2(&ring, 0, SOL_BOOL_TRUE) == SOL_ERNO_RANGE,
+                    SOL_ERNO_TEST);
+        sol_try (sol_ring_init(&ring, 0));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_RANGE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_init3() - sol_ring_init() unit test #3
+ */
+static sol_erno test_init3(void)
+{
+        #define DESC_INIT3 "sol_ring_init() rounds the capacity up to whole" \
+                           " pages for mirrored buffers, and keeps it exact" \
+                           " otherwise"
+        auto sol_ring ring, heap;
+        auto sol_size cap;
+
+SOL_TRY:
+                /* set up test scenario */
+        ring.buf = heap.buf = SOL_PTR_NULL;
+        sol_try (sol_ring_init(&ring, 100));
+        sol_try (sol_ring_init2(&heap, 100, SOL_BOOL_FALSE));
+
+                /* check test condition */
+        sol_try (sol_ring_cap(&ring, &cap));
+        sol_assert (ring.mirror ? cap >= 4096 && !(cap & 4095) : cap == 100,
+                    SOL_ERNO_TEST);
+        sol_try (sol_ring_cap(&heap, &cap));
+        sol_assert (cap == 100, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ring_term(&ring);
+        sol_ring_term(&heap);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_term1() - sol_ring_term() unit test #1
+ */
+static sol_erno test_term1(void)
+{
+        #define DESC_TERM1 "sol_ring_term() executes even if passed a null" \
+                           " pointer, and may be called more than once"
+        auto sol_ring ring;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_ring_term(SOL_PTR_NULL);
+        sol_try (sol_ring_init2(&ring, 32, SOL_BOOL_FALSE));
+        sol_ring_term(&ring);
+        sol_ring_term(&ring);
+
+                /* check test condition */
+        sol_assert (!ring.buf && !ring.cap, SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_write1() - sol_ring_write() unit test #1
+ */
+static sol_erno test_write1(void)
+{
+        #define DESC_WRITE1 "sol_ring_write() throws SOL_ERNO_PTR when passed" \
+                            " a null pointer for @ring or @src"
+        auto sol_ring ring;
+        auto sol_w8 src[4] = {0};
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (!sol_ring_init2(&ring, 16, SOL_BOOL_FALSE),
+                    SOL_ERNO_TEST);
+        sol_assert (sol_ring_write(SOL_PTR_NULL, src, 4) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_try (sol_ring_write(&ring, SOL_PTR_NULL, 4));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        sol_ring_term(&ring);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_write2() - sol_ring_write() unit test #2
+ */
+static sol_erno test_write2(void)
+{
+        #define DESC_WRITE2 "sol_ring_write() throws SOL_ERNO_RANGE and" \
+                            " leaves @ring unchanged when it lacks free space"
+        auto sol_ring ring;
+        auto sol_w8 src[16] = {0};
+        auto sol_size len;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (!sol_ring_init2(&ring, 16, SOL_BOOL_FALSE),
+                    SOL_ERNO_TEST);
+        sol_assert (!sol_ring_write(&ring, src, 10), SOL_ERNO_TEST);
+        sol_assert (sol_ring_write(&ring, src, 7) == SOL_ERNO_RANGE,
+                    SOL_ERNO_TEST);
+
+                /* check test condition */
+        sol_try (sol_ring_len(&ring, &len));
+        sol_assert (len == 10, SOL_ERNO_TEST);
+        sol_try (sol_ring_write(&ring, src, 6));
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ring_term(&ring);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_read1() - sol_ring_read() unit test #1
+ */
+static sol_erno test_read1(void)
+{
+        #define DESC_READ1 "sol_ring_read() returns wrapped data intact from" \
+                           " a heap ring buffer by splitting copies"
+        auto sol_ring ring;
+
+SOL_TRY:
+                /* set up test scenario */
+        ring.buf = SOL_PTR_NULL;
+        sol_try (sol_ring_init2(&ring, 1000, SOL_BOOL_FALSE));
+
+                /* check test condition */
+        sol_try (round_trip(&ring));
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ring_term(&ring);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_read2() - sol_ring_read() unit test #2
+ */
+static sol_erno test_read2(void)
+{
+        #define DESC_READ2 "sol_ring_read() returns wrapped data intact from" \
+                           " a mirrored ring buffer"
+        auto sol_ring ring;
+
+SOL_TRY:
+                /* set up test scenario */
+        ring.buf = SOL_PTR_NULL;
+        sol_try (sol_ring_init2(&ring, 1000, SOL_BOOL_TRUE));
+
+                /* check test condition */
+        sol_try (round_trip(&ring));
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ring_term(&ring);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_read3() - sol_ring_read() unit test #3
+ */
+static sol_erno test_read3(void)
+{
+        #define DESC_READ3 "sol_ring_read() and sol_ring_skip() throw" \
+                           " SOL_ERNO_RANGE when @ring holds too little data"
+        auto sol_ring ring;
+        auto sol_w8 buf[8] = {0};
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (!sol_ring_init2(&ring, 16, SOL_BOOL_FALSE),
+                    SOL_ERNO_TEST);
+        sol_assert (!sol_ring_write(&ring, buf, 4), SOL_ERNO_TEST);
+        sol_assert (sol_ring_skip(&ring, 5) == SOL_ERNO_RANGE,
+                    SOL_ERNO_TEST);
+        sol_try (sol_ring_read(&ring, buf, 5));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_RANGE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        sol_ring_term(&ring);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_peek1() - sol_ring_peek() unit test #1
+ */
+static sol_erno test_peek1(void)
+{
+        #define DESC_PEEK1 "sol_ring_peek() stops at the end of a heap ring" \
+                           " buffer, and sol_ring_skip() exposes the rest"
+        auto sol_ring ring;
+        auto sol_w8 buf[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+        auto const sol_ptr *data;
+        auto sol_size len;
+
+SOL_TRY:
+                /* set up test scenario, wrapping the last 4 bytes */
+        ring.buf = SOL_PTR_NULL;
+        sol_try (sol_ring_init2(&ring, 16, SOL_BOOL_FALSE));
+        sol_try (sol_ring_write(&ring, buf, 8));
+        sol_try (sol_ring_skip(&ring, 8));
+        sol_try (sol_ring_write(&ring, buf, 12));
+
+                /* check test condition */
+        sol_try (sol_ring_peek(&ring, &data, &len));
+        sol_assert (len == 8 && ((const sol_w8*) data)[7] == 7,
+                    SOL_ERNO_TEST);
+        sol_try (sol_ring_skip(&ring, len));
+        sol_try (sol_ring_peek(&ring, &data, &len));
+        sol_assert (len == 4 && ((const sol_w8*) data)[3] == 11,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ring_term(&ring);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_peek2() - sol_ring_peek() unit test #2
+ */
+static sol_erno test_peek2(void)
+{
+        #define DESC_PEEK2 "sol_ring_peek() returns all wrapped data of a" \
+                           " mirrored ring buffer contiguously"
+        auto sol_ring ring;
+        auto sol_w8 buf[64];
+        auto const sol_ptr *data;
+        auto sol_size cap, len;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario, wrapping 32 bytes around the end */
+        ring.buf = SOL_PTR_NULL;
+        sol_try (sol_ring_init2(&ring, 4096, SOL_BOOL_TRUE));
+        sol_try (sol_ring_cap(&ring, &cap));
+        for (i = 0; i < sizeof buf; i++) {
+                buf[i] = (sol_w8) i;
+        }
+
+        for (i = 0; i < cap / 32 - 1; i++) {
+                sol_try (sol_ring_write(&ring, buf, 32));
+                sol_try (sol_ring_skip(&ring, 32));
+        }
+        sol_try (sol_ring_write(&ring, buf, sizeof buf));
+
+                /* check test condition */
+        sol_try (sol_ring_peek(&ring, &data, &len));
+        sol_assert (len == sizeof buf, SOL_ERNO_TEST);
+        for (i = 0; i < sizeof buf; i++) {
+                sol_assert (((const sol_w8*) data)[i] == (sol_w8) i,
+                            SOL_ERNO_TEST);
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_ring_term(&ring);
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_stat1() - sol_ring_len(), sol_ring_cap(), sol_ring_peek() test #1
+ */
+static sol_erno test_stat1(void)
+{
+        #define DESC_STAT1 "sol_ring_len(), sol_ring_cap() and" \
+                           " sol_ring_peek() throw SOL_ERNO_PTR when passed" \
+                           " null pointers"
+        auto const sol_ptr *data;
+        auto sol_size n;
+
+SOL_TRY:
+                /* check test condition */
+        sol_assert (sol_ring_len(SOL_PTR_NULL, &n) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_assert (sol_ring_cap(SOL_PTR_NULL, &n) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+        sol_assert (sol_ring_peek(SOL_PTR_NULL, &data, &n) == SOL_ERNO_PTR,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      __sol_tests_ring() - declared in sol/test/suite.h
+ */
+extern sol_erno __sol_tests_ring(sol_tlog *log,
+                                 sol_uint *pass,
+                                 sol_uint *fail,
+                                 sol_uint *total)
+{
+        auto sol_tsuite __ts, *ts = &__ts;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (log && pass && fail && total, SOL_ERNO_PTR);
+
+                /* initialise test suite */
+        sol_try (sol_tsuite_init2(ts, log));
+
+                /* register test cases */
+        sol_try (sol_tsuite_register(ts, &test_init1, DESC_INIT1));
+        sol_try (sol_tsuite_register(ts, &test_init2, DESC_INIT2));
+        sol_try (sol_tsuite_register(ts, &test_init3, DESC_INIT3));
+        sol_try (sol_tsuite_register(ts, &test_term1, DESC_TERM1));
+        sol_try (sol_tsuite_register(ts, &test_write1, DESC_WRITE1));
+        sol_try (sol_tsuite_register(ts, &test_write2, DESC_WRITE2));
+        sol_try (sol_tsuite_register(ts, &test_read1, DESC_READ1));
+        sol_try (sol_tsuite_register(ts, &test_read2, DESC_READ2));
+        sol_try (sol_tsuite_register(ts, &test_read3, DESC_READ3));
+        sol_try (sol_tsuite_register(ts, &test_peek1, DESC_PEEK1));
+        sol_try (sol_tsuite_register(ts, &test_peek2, DESC_PEEK2));
+        sol_try (sol_tsuite_register(ts, &test_stat1, DESC_STAT1));
+
+                /* execute test cases */
+        sol_try (sol_tsuite_exec(ts));
+
+                /* report test counts */
+        sol_try (sol_tsuite_pass(ts, pass));
+        sol_try (sol_tsuite_fail(ts, fail));
+        sol_try (sol_tsuite_total(ts, total));
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_tsuite_term(ts);
+        return sol_erno_get();
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
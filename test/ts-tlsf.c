@@ -0,0 +1,445 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/test/ts-tlsf.c
+ *
+ * Description:
+ *      This file is part of the internal quality checking of the Sol Library.
+ *      It implements the test suite for the TLSF heap module.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "../inc/tlsf.h"
+#include "./suite.h"
+
+
+
+
+/*
+ *      mem - memory region of test heaps
+ */
+static sol_w8 mem[64 * 1024];
+
+
+
+
+/*
+ *      test_init1() - sol_tlsf_init() unit test #1
+ */
+static sol_erno test_init1(void)
+{
+        #define DESC_INIT1 "sol_tlsf_init() throws SOL_ERNO_PTR when passed a" \
+                           " null pointer for @tlsf or @mem"
+        auto sol_tlsf *tlsf = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_assert (sol_tlsf_init(SOL_PTR_NULL, mem, sizeof mem)
+                    == SOL_ERNO_PTR, SOL_ERNO_TEST);
+        sol_try (sol_tlsf_init(&tlsf, SOL_PTR_NULL, sizeof mem));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_PTR == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_init2() - sol_tlsf_init() unit test #2
+ */
+static sol_erno test_init2(void)
+{
+        #define DESC_INIT2 "sol_tlsf_init() throws SOL_ERNO_RANGE when passed" \
+                           " a region smaller than SOL_TLSF_MIN"
+        auto sol_tlsf *tlsf = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_tlsf_init(&tlsf, mem, SOL_TLSF_MIN - 1));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_RANGE == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_alloc1() - sol_tlsf_alloc() unit test #1
+ */
+static sol_erno test_alloc1(void)
+{
+        #define DESC_ALLOC1 "sol_tlsf_alloc() returns disjoint blocks aligned" \
+                            " to 16 bytes from an unaligned region"
+        auto sol_tlsf *tlsf = SOL_PTR_NULL;
+        auto sol_w8 *blk[32];
+        register sol_index i, j;
+
+SOL_TRY:
+                /* set up test scenario with blocks of varying sizes, filling
+                 * each with its index */
+        sol_try (sol_tlsf_init(&tlsf, mem + 3, sizeof mem - 3));
+
+        for (i = 0; i < 32; i++) {
+                blk[i] = SOL_PTR_NULL;
+                sol_try (sol_tlsf_alloc(tlsf, (sol_ptr**) &blk[i], 1 + i * 37));
+                sol_assert (!((sol_word) blk[i] & 15), SOL_ERNO_TEST);
+                for (j = 0; j < 1 + i * 37; j++) {
+                        blk[i][j] = (sol_w8) i;
+                }
+        }
+
+                /* check test condition */
+        for (i = 0; i < 32; i++) {
+                for (j = 0; j < 1 + i * 37; j++) {
+                        sol_assert (blk[i][j] == (sol_w8) i, SOL_ERNO_TEST);
+                }
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_alloc2() - sol_tlsf_alloc() unit test #2
+ */
+static sol_erno test_alloc2(void)
+{
+        #define DESC_ALLOC2 "sol_tlsf_alloc() throws SOL_ERNO_RANGE for a" \
+                            " zero size and SOL_ERNO_HEAP when the heap is" \
+                            " exhausted"
+        auto sol_tlsf *tlsf = SOL_PTR_NULL;
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_tlsf_init(&tlsf, mem, sizeof mem));
+        sol_assert (sol_tlsf_alloc(tlsf, &ptr, 0) == SOL_ERNO_RANGE,
+                    SOL_ERNO_TEST);
+        sol_try (sol_tlsf_alloc(tlsf, &ptr, sizeof mem));
+
+SOL_CATCH:
+                /* check test condition */
+        sol_erno_set(SOL_ERNO_HEAP == sol_erno_get()
+                     ? SOL_ERNO_NULL
+                     : SOL_ERNO_TEST);
+
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_realloc1() - sol_tlsf_realloc() unit test #1
+ */
+static sol_erno test_realloc1(void)
+{
+        #define DESC_REALLOC1 "sol_tlsf_realloc() grows a block in place when" \
+                              " its neighbour is free, preserving its contents"
+        auto sol_tlsf *tlsf = SOL_PTR_NULL;
+        auto sol_w8 *ptr = SOL_PTR_NULL, *old;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_tlsf_init(&tlsf, mem, sizeof mem));
+        sol_try (sol_tlsf_alloc(tlsf, (sol_ptr**) &ptr, 100));
+        for (i = 0; i < 100; i++) {
+                ptr[i] = (sol_w8) i;
+        }
+
+        old = ptr;
+        sol_try (sol_tlsf_realloc(tlsf, (sol_ptr**) &ptr, 4000));
+
+                /* check test condition */
+        sol_assert (ptr == old, SOL_ERNO_TEST);
+        for (i = 0; i < 100; i++) {
+                sol_assert (ptr[i] == (sol_w8) i, SOL_ERNO_TEST);
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_realloc2() - sol_tlsf_realloc() unit test #2
+ */
+static sol_erno test_realloc2(void)
+{
+        #define DESC_REALLOC2 "sol_tlsf_realloc() moves a block hemmed in by" \
+                              " an allocated neighbour, preserving its contents"
+        auto sol_tlsf *tlsf = SOL_PTR_NULL;
+        auto sol_w8 *ptr = SOL_PTR_NULL, *nbr = SOL_PTR_NULL, *old;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario */
+        sol_try (sol_tlsf_init(&tlsf, mem, sizeof mem));
+        sol_try (sol_tlsf_alloc(tlsf, (sol_ptr**) &ptr, 64));
+        sol_try (sol_tlsf_alloc(tlsf, (sol_ptr**) &nbr, 64));
+        for (i = 0; i < 64; i++) {
+                ptr[i] = (sol_w8) i;
+        }
+
+        old = ptr;
+        sol_try (sol_tlsf_realloc(tlsf, (sol_ptr**) &ptr, 1000));
+
+                /* check test condition */
+        sol_assert (ptr != old, SOL_ERNO_TEST);
+        for (i = 0; i < 64; i++) {
+                sol_assert (ptr[i] == (sol_w8) i, SOL_ERNO_TEST);
+        }
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_free1() - sol_tlsf_free() unit test #1
+ */
+static sol_erno test_free1(void)
+{
+        #define DESC_FREE1 "sol_tlsf_free() nulls @ptr and coalesces freed" \
+                           " blocks back into a single free block"
+        auto sol_tlsf *tlsf = SOL_PTR_NULL;
+        auto sol_ptr *blk[16];
+        auto sol_tlsf_stat init, stat;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario, freeing blocks out of order */
+        sol_try (sol_tlsf_init(&tlsf, mem, sizeof mem));
+        sol_try (sol_tlsf_stats(tlsf, &init));
+
+        for (i = 0; i < 16; i++) {
+                blk[i] = SOL_PTR_NULL;
+                sol_try (sol_tlsf_alloc(tlsf, &blk[i], 100 + i * 300));
+        }
+
+        for (i = 0; i < 16; i += 2) {
+                sol_tlsf_free(tlsf, &blk[i]);
+                sol_assert (!blk[i], SOL_ERNO_TEST);
+        }
+
+        for (i = 1; i < 16; i += 2) {
+                sol_tlsf_free(tlsf, &blk[i]);
+        }
+
+                /* check test condition */
+        sol_try (sol_tlsf_stats(tlsf, &stat));
+        sol_assert (stat.used == 0 && stat.nfree == 1 && stat.frag == 0
+                    && stat.free == init.free && stat.largest == init.free,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_free2() - sol_tlsf_free() unit test #2
+ */
+static sol_erno test_free2(void)
+{
+        #define DESC_FREE2 "sol_tlsf_free() executes even if passed null" \
+                           " pointers"
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+
+                /* set up test scenario */
+        sol_tlsf_free(SOL_PTR_NULL, &ptr);
+        sol_tlsf_free(SOL_PTR_NULL, SOL_PTR_NULL);
+        return SOL_ERNO_NULL;
+}
+
+
+
+
+/*
+ *      test_stats1() - sol_tlsf_stats() unit test #1
+ */
+static sol_erno test_stats1(void)
+{
+        #define DESC_STATS1 "sol_tlsf_stats() reports usage and fragmentation" \
+                            " of a heap with holes"
+        auto sol_tlsf *tlsf = SOL_PTR_NULL;
+        auto sol_ptr *blk[8];
+        auto sol_tlsf_stat stat;
+        register sol_index i;
+
+SOL_TRY:
+                /* set up test scenario: eight blocks of 1 KiB with every other
+                 * one freed, leaving four 1 KiB holes before the tail */
+        sol_try (sol_tlsf_init(&tlsf, mem, sizeof mem));
+
+        for (i = 0; i < 8; i++) {
+                blk[i] = SOL_PTR_NULL;
+                sol_try (sol_tlsf_alloc(tlsf, &blk[i], 1024));
+        }
+
+        for (i = 0; i < 8; i += 2) {
+                sol_tlsf_free(tlsf, &blk[i]);
+        }
+
+                /* check test condition */
+        sol_try (sol_tlsf_stats(tlsf, &stat));
+        sol_assert (stat.used == 4 * 1024 && stat.nfree == 5
+                    && stat.free == stat.largest + 4 * 1024 && stat.frag > 0,
+                    SOL_ERNO_TEST);
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      test_heap1() - sol_tlsf_heap() unit test #1
+ */
+static sol_erno test_heap1(void)
+{
+        #define DESC_HEAP1 "sol_tlsf_heap_stats() reports the fallback heap" \
+                           " only if the pointer module is backed by it"
+        auto sol_tlsf_stat stat;
+#if (defined SOL_PTR_TLSF)
+        auto sol_tlsf_stat stat2;
+        auto sol_ptr *ptr = SOL_PTR_NULL;
+#endif
+
+SOL_TRY:
+                /* check test condition; the test runner sets up the fallback
+                 * heap if SOL_PTR_TLSF is defined, and so it cannot be set up
+                 * a second time */
+#if (defined SOL_PTR_TLSF)
+        sol_try (sol_tlsf_heap_stats(&stat));
+        sol_try (sol_ptr_new(&ptr, 100));
+        sol_try (sol_tlsf_heap_stats(&stat2));
+        sol_assert (stat2.used > stat.used, SOL_ERNO_TEST);
+        sol_assert (sol_tlsf_heap(mem, sizeof mem) == SOL_ERNO_STATE,
+                    SOL_ERNO_TEST);
+#else
+        sol_assert (sol_tlsf_heap_stats(&stat) == SOL_ERNO_STATE,
+                    SOL_ERNO_TEST);
+#endif
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+#if (defined SOL_PTR_TLSF)
+        sol_ptr_free(&ptr);
+#endif
+        return sol_erno_get();
+}
+
+
+
+
+/*
+ *      __sol_tests_tlsf() - declared in sol/test/suite.h
+ */
+extern sol_erno __sol_tests_tlsf(sol_tlog *log,
+                                 sol_uint *pass,
+                                 sol_uint *fail,
+                                 sol_uint *total)
+{
+        auto sol_tsuite __ts, *ts = &__ts;
+
+SOL_TRY:
+                /* check preconditions */
+        sol_assert (log && pass && fail && total, SOL_ERNO_PTR);
+
+                /* initialise test suite */
+        sol_try (sol_tsuite_init2(ts, log));
+
+                /* register test cases */
+        sol_try (sol_tsuite_register(ts, &test_init1, DESC_INIT1));
+        sol_try (sol_tsuite_register(ts, &test_init2, DESC_INIT2));
+        sol_try (sol_tsuite_register(ts, &test_alloc1, DESC_ALLOC1));
+        sol_try (sol_tsuite_register(ts, &test_alloc2, DESC_ALLOC2));
+        sol_try (sol_tsuite_register(ts, &test_realloc1, DESC_REALLOC1));
+        sol_try (sol_tsuite_register(ts, &test_realloc2, DESC_REALLOC2));
+        sol_try (sol_tsuite_register(ts, &test_free1, DESC_FREE1));
+        sol_try (sol_tsuite_register(ts, &test_free2, DESC_FREE2));
+        sol_try (sol_tsuite_register(ts, &test_stats1, DESC_STATS1));
+        sol_try (sol_tsuite_register(ts, &test_heap1, DESC_HEAP1));
+
+                /* execute test cases */
+        sol_try (sol_tsuite_exec(ts));
+
+                /* report test counts */
+        sol_try (sol_tsuite_pass(ts, pass));
+        sol_try (sol_tsuite_fail(ts, fail));
+        sol_try (sol_tsuite_total(ts, total));
+
+SOL_CATCH:
+SOL_FINALLY:
+                /* wind up */
+        sol_tsuite_term(ts);
+        return sol_erno_get();
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+
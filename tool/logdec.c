@@ -0,0 +1,71 @@
+/******************************************************************************
+ *                           SOL LIBRARY v1.0.0+41
+ *
+ * File: sol/tool/logdec.c
+ *
+ * Description:
+ *      This file is part of the tooling of the Sol Library. It implements the
+ *      decoder that turns binary log files into text log files.
+ *
+ * Authors:
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *
+ * Copyright:
+ *      (c) 2019 Abhishek Chakravarti
+ *      <abhishek@taranjali.org>
+ *
+ * License:
+ *      Released under the GNU General Public License version 3 (GPLv3)
+ *      <http://opensource.org/licenses/GPL-3.0>. See the accompanying LICENSE
+ *      file for complete licensing details.
+ *
+ *      BY CONTINUING TO USE AND/OR DISTRIBUTE THIS FILE, YOU ACKNOWLEDGE THAT
+ *      YOU HAVE UNDERSTOOD THESE LICENSE TERMS AND ACCEPT THEM.
+ ******************************************************************************/
+
+
+
+
+        /* include required header files */
+#include "../inc/libc.h"
+#include "../inc/log.h"
+
+
+
+
+/*
+ *      main() - main entry point of binary log decoder
+ *        - argc: count of command line arguments
+ *        - argv: command line arguments
+ *
+ *      Usage:
+ *        - logdec <binary log file> <text log file>
+ */
+int main(int argc,
+         char **argv)
+{
+                /* check usage */
+        if (argc != 3) {
+                (void) fprintf(stderr, "usage: %s <binary log> <text log>\n",
+                               argc ? argv[0] : "logdec");
+                return EXIT_FAILURE;
+        }
+
+                /* decode binary log file */
+        if (sol_log_decode(argv[1], argv[2])) {
+                (void) fprintf(stderr, "%s: can't decode %s\n", argv[0],
+                               argv[1]);
+                return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+}
+
+
+
+
+/******************************************************************************
+ *                                    EOF
+ *          Built on hyperion [Tue Jan 29 02:37:24 UTC 2019]
+ ******************************************************************************/
+